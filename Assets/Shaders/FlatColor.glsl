@@ -5,9 +5,11 @@ layout(location = 0) in vec3 aPos;
 uniform mat4 u_ViewProjection;
 uniform mat4 u_Model;
 
+invariant gl_Position; // matches the depth pre-pass (ShadowDepth.shader)
+
 void main()
 {
-    gl_Position = u_ViewProjection * u_Model * vec4(aPos, 1.0);
+    gl_Position = u_ViewProjection * (u_Model * vec4(aPos, 1.0));
 }
 
 #type fragment
@@ -7,6 +7,8 @@ uniform mat4 u_Model;
 
 out vec3 vWorldPos;
 
+invariant gl_Position; // matches the depth pre-pass (ShadowDepth.shader)
+
 void main() {
     vec4 world = u_Model * vec4(aPos, 1.0);
     vWorldPos = world.xyz;
@@ -0,0 +1,101 @@
+// Cascaded shadow lookup for lit fragment shaders.
+// Compiled in with RECEIVE_SHADOWS; sized by CASCADE_COUNT (both from the permutation).
+
+// Reason codes (DEBUG_VIEW==4)
+const int REASON_OK              = 0;
+const int REASON_TEX_UNBOUND     = 1; // textureSize == 0
+const int REASON_BAD_W           = 2; // lp.w <= 0
+const int REASON_OUTSIDE_XY      = 3; // proj x/y out of [0..1]
+const int REASON_OUTSIDE_Z       = 4; // proj z out of [0..1]
+const int REASON_CASCADE_INVALID = 5; // cascadeIdx out of range
+const int REASON_SHADOWS_DISABLED = 6;
+const int REASON_NO_CASCADES      = 7;
+
+#ifdef RECEIVE_SHADOWS
+uniform sampler2DArray u_ShadowMapArray;
+uniform float u_CascadeSplits[CASCADE_COUNT];
+uniform mat4  u_LightSpaceMatrices[CASCADE_COUNT];
+uniform float u_ShadowBias;
+
+uniform mat4 u_View;
+
+// Choose cascade based on view-space depth (positive forward)
+int SelectCascade(vec3 worldPos)
+{
+    float viewDepth = -(u_View * vec4(worldPos, 1.0)).z;
+
+    int cascadeIdx = 0;
+#if CASCADE_COUNT > 1
+    if (viewDepth > u_CascadeSplits[0]) cascadeIdx = 1;
+#endif
+#if CASCADE_COUNT > 2
+    if (viewDepth > u_CascadeSplits[1]) cascadeIdx = 2;
+#endif
+#if CASCADE_COUNT > 3
+    if (viewDepth > u_CascadeSplits[2]) cascadeIdx = 3;
+#endif
+    return cascadeIdx;
+}
+
+float ShadowFactor(int cascadeIdx, vec3 worldPos, vec3 N, vec3 L, out int reason, out vec3 outProj01)
+{
+    reason = REASON_OK;
+    outProj01 = vec3(0.0);
+
+    if (cascadeIdx < 0 || cascadeIdx >= CASCADE_COUNT) {
+        reason = REASON_CASCADE_INVALID;
+        return 0.0;
+    }
+
+    // If the shadow texture isn't bound/created correctly, textureSize can be 0.
+    ivec3 ts = textureSize(u_ShadowMapArray, 0);
+    if (ts.x <= 0 || ts.y <= 0) {
+        reason = REASON_TEX_UNBOUND;
+        return 0.0;
+    }
+
+    mat4 lightMat = u_LightSpaceMatrices[cascadeIdx];
+    vec4 lp = lightMat * vec4(worldPos, 1.0);
+
+    if (lp.w <= 0.000001) {
+        reason = REASON_BAD_W;
+        return 0.0;
+    }
+
+    vec3 proj = lp.xyz / lp.w;        // NDC (-1..1)
+    vec3 proj01 = proj * 0.5 + 0.5;   // (0..1)
+    outProj01 = proj01;
+
+    // outside shadow map => no shadow (lit)
+    if (proj01.x < 0.0 || proj01.x > 1.0 || proj01.y < 0.0 || proj01.y > 1.0) {
+        reason = REASON_OUTSIDE_XY;
+        return 0.0;
+    }
+    if (proj01.z < 0.0 || proj01.z > 1.0) {
+        reason = REASON_OUTSIDE_Z;
+        return 0.0;
+    }
+
+    float current = proj01.z;
+
+    // slope-scaled bias helps acne
+    float bias = max(u_ShadowBias * (1.0 - dot(N, L)), u_ShadowBias);
+
+    vec2 texel = 1.0 / vec2(ts.xy);
+
+    // 3x3 PCF
+    float shadow = 0.0;
+    for (int x = -1; x <= 1; x++) {
+        for (int y = -1; y <= 1; y++) {
+            float pcfDepth = texture(
+                u_ShadowMapArray,
+                vec3(proj01.xy + vec2(x, y) * texel, float(cascadeIdx))
+            ).r;
+
+            shadow += (current - bias > pcfDepth) ? 1.0 : 0.0;
+        }
+    }
+    shadow *= (1.0 / 9.0);
+    return shadow;
+}
+#endif
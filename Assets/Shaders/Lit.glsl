@@ -1,3 +1,6 @@
+// Variants: see Engine/Renderer/ShaderKeywords.h
+#pragma keywords HAS_TEXTURE0 HAS_TEXTURE0_ARRAY USE_LIGHTING RECEIVE_SHADOWS CASCADE_COUNT
+
 #type vertex
 #version 330 core
 layout(location = 0) in vec3 a_Position;
@@ -11,6 +14,8 @@ out vec3 v_NormalWS;
 out vec2 v_TexCoord;
 out vec3 v_WorldPos;
 
+invariant gl_Position; // matches the depth pre-pass (ShadowDepth.shader)
+
 void main() {
     mat3 normalMat = transpose(inverse(mat3(u_Model)));
     v_NormalWS = normalize(normalMat * a_Normal);
@@ -28,11 +33,15 @@ in vec3 v_NormalWS;
 in vec2 v_TexCoord;
 in vec3 v_WorldPos;
 
-uniform vec4 u_Color;
-uniform int  u_UseTexture;
+layout(std140) uniform MaterialBlock {
+    vec4  u_Color;
+    float u_Texture0Layer;
+};
+#if defined(HAS_TEXTURE0_ARRAY)
+uniform sampler2DArray u_Texture0; // texture page, see Model::PackTextures
+#elif defined(HAS_TEXTURE0)
 uniform sampler2D u_Texture0;
-
-uniform int   u_UseLighting;
+#endif
 
 // Convention used here:
 // u_LightDir = direction light RAYS travel in world space (sun direction).
@@ -41,15 +50,6 @@ uniform vec3  u_LightDir;
 uniform vec3  u_LightColor;
 uniform float u_Ambient;
 
-uniform int   u_UseShadows;
-uniform sampler2DArray u_ShadowMapArray;
-uniform int   u_CascadeCount;
-uniform float u_CascadeSplits[4];
-uniform mat4  u_LightSpaceMatrices[4];
-uniform float u_ShadowBias;
-
-uniform mat4 u_View;
-
 // ---------------- DEBUG SWITCH ----------------
 // 0 = normal shading
 // 1 = shadow factor (white lit, black shadow)
@@ -59,112 +59,32 @@ uniform mat4 u_View;
 #define DEBUG_VIEW 0
 // ------------------------------------------------
 
-// Reason codes (DEBUG_VIEW==4)
-const int REASON_OK              = 0;
-const int REASON_TEX_UNBOUND     = 1; // textureSize == 0
-const int REASON_BAD_W           = 2; // lp.w <= 0
-const int REASON_OUTSIDE_XY      = 3; // proj x/y out of [0..1]
-const int REASON_OUTSIDE_Z       = 4; // proj z out of [0..1]
-const int REASON_CASCADE_INVALID = 5; // cascadeIdx out of range
-const int REASON_SHADOWS_DISABLED = 6;
-const int REASON_NO_CASCADES      = 7;
-
-float ShadowFactor(int cascadeIdx, vec3 worldPos, vec3 N, vec3 L, out int reason, out vec3 outProj01)
-{
-    reason = REASON_OK;
-    outProj01 = vec3(0.0);
-
-    if (cascadeIdx < 0 || cascadeIdx >= u_CascadeCount) {
-        reason = REASON_CASCADE_INVALID;
-        return 0.0;
-    }
-
-    // If the shadow texture isn't bound/created correctly, textureSize can be 0.
-    ivec3 ts = textureSize(u_ShadowMapArray, 0);
-    if (ts.x <= 0 || ts.y <= 0) {
-        reason = REASON_TEX_UNBOUND;
-        return 0.0;
-    }
-
-    mat4 lightMat = u_LightSpaceMatrices[cascadeIdx];
-    vec4 lp = lightMat * vec4(worldPos, 1.0);
-
-    if (lp.w <= 0.000001) {
-        reason = REASON_BAD_W;
-        return 0.0;
-    }
-
-    vec3 proj = lp.xyz / lp.w;        // NDC (-1..1)
-    vec3 proj01 = proj * 0.5 + 0.5;   // (0..1)
-    outProj01 = proj01;
-
-    // outside shadow map => no shadow (lit)
-    if (proj01.x < 0.0 || proj01.x > 1.0 || proj01.y < 0.0 || proj01.y > 1.0) {
-        reason = REASON_OUTSIDE_XY;
-        return 0.0;
-    }
-    if (proj01.z < 0.0 || proj01.z > 1.0) {
-        reason = REASON_OUTSIDE_Z;
-        return 0.0;
-    }
-
-    float current = proj01.z;
-
-    // slope-scaled bias helps acne
-    float bias = max(u_ShadowBias * (1.0 - dot(N, L)), u_ShadowBias);
-
-    vec2 texel = 1.0 / vec2(ts.xy);
-
-    // 3x3 PCF
-    float shadow = 0.0;
-    for (int x = -1; x <= 1; x++) {
-        for (int y = -1; y <= 1; y++) {
-            float pcfDepth = texture(
-                u_ShadowMapArray,
-                vec3(proj01.xy + vec2(x, y) * texel, float(cascadeIdx))
-            ).r;
-
-            shadow += (current - bias > pcfDepth) ? 1.0 : 0.0;
-        }
-    }
-    shadow *= (1.0 / 9.0);
-    return shadow;
-}
+#include "Include/Shadows.glsl"
 
 out vec4 FragColor;
 
 void main() {
     vec3 albedo = u_Color.rgb;
-    if (u_UseTexture == 1)
-        albedo *= texture(u_Texture0, v_TexCoord).rgb;
+#if defined(HAS_TEXTURE0_ARRAY)
+    albedo *= texture(u_Texture0, vec3(v_TexCoord, u_Texture0Layer)).rgb;
+#elif defined(HAS_TEXTURE0)
+    albedo *= texture(u_Texture0, v_TexCoord).rgb;
+#endif
 
     vec3 N = normalize(v_NormalWS);
     vec3 L = normalize(-u_LightDir);
 
     float ndl = max(dot(N, L), 0.0);
 
-    // Choose cascade based on view-space depth (positive forward)
-    float viewDepth = -(u_View * vec4(v_WorldPos, 1.0)).z;
-
+    float shadow = 0.0;
     int cascadeIdx = 0;
-    if (u_CascadeCount > 1 && viewDepth > u_CascadeSplits[0]) cascadeIdx = 1;
-    if (u_CascadeCount > 2 && viewDepth > u_CascadeSplits[1]) cascadeIdx = 2;
-    if (u_CascadeCount > 3 && viewDepth > u_CascadeSplits[2]) cascadeIdx = 3;
-    cascadeIdx = clamp(cascadeIdx, 0, max(u_CascadeCount - 1, 0));
+    int reason = REASON_SHADOWS_DISABLED;
+    vec3 proj01 = vec3(0.0);
 
-    float shadow = 0.0;
-int reason = REASON_OK;
-vec3 proj01 = vec3(0.0);
-
-if (u_UseShadows != 1) {
-    reason = REASON_SHADOWS_DISABLED;
-    shadow = 0.0;
-} else if (u_CascadeCount <= 0) {
-    reason = REASON_NO_CASCADES;
-    shadow = 0.0;
-} else {
+#ifdef RECEIVE_SHADOWS
+    cascadeIdx = SelectCascade(v_WorldPos);
     shadow = ShadowFactor(cascadeIdx, v_WorldPos, N, L, reason, proj01);
-}
+#endif
 
 #if DEBUG_VIEW == 1
     // Shadow factor visualization (white lit, black shadow)
@@ -172,7 +92,7 @@ if (u_UseShadows != 1) {
     return;
 #elif DEBUG_VIEW == 2
     // Cascade index visualization (darker = nearer cascade)
-    float t = (u_CascadeCount <= 1) ? 0.0 : float(cascadeIdx) / float(u_CascadeCount - 1);
+    float t = (CASCADE_COUNT <= 1) ? 0.0 : float(cascadeIdx) / float(CASCADE_COUNT - 1);
     FragColor = vec4(vec3(t), 1.0);
     return;
 #elif DEBUG_VIEW == 3
@@ -195,16 +115,21 @@ if (u_UseShadows != 1) {
     if (reason == REASON_SHADOWS_DISABLED) { FragColor = vec4(0.5,0.5,0.5,1); return; } // gray
     if (reason == REASON_NO_CASCADES)      { FragColor = vec4(0.5,0,0.5,1);   return; } // purple
 
+#ifdef RECEIVE_SHADOWS
     // OK: show shadow factor (green channel) to see it changing
     float d = texture(u_ShadowMapArray, vec3(proj01.xy, float(cascadeIdx))).r;
     FragColor = vec4(vec3(d), 1.0);
     return;
 #endif
+#endif
 
+#ifdef USE_LIGHTING
     // Normal lighting (ambient unshadowed, diffuse shadowed)
     vec3 lit = u_Ambient * u_LightColor
              + (1.0 - shadow) * ndl * u_LightColor;
-
-    vec3 color = (u_UseLighting == 1) ? (albedo * lit) : albedo;
+    vec3 color = albedo * lit;
+#else
+    vec3 color = albedo;
+#endif
     FragColor = vec4(clamp(color, 0.0, 1.0), u_Color.a);
 }
\ No newline at end of file
@@ -1,3 +1,5 @@
+#pragma keywords HAS_TEXTURE0 USE_LIGHTING
+
 #type vertex
 #version 330 core
 layout(location = 0) in vec3 a_Position;
@@ -10,12 +12,14 @@ uniform mat4 u_Model;
 out vec3 v_NormalWS;
 out vec2 v_TexCoord;
 
+invariant gl_Position; // matches the depth pre-pass (ShadowDepth.shader)
+
 void main() {
     mat3 normalMat = transpose(inverse(mat3(u_Model)));
     v_NormalWS = normalize(normalMat * a_Normal);
     v_TexCoord = a_TexCoord;
 
-    gl_Position = u_ViewProjection * u_Model * vec4(a_Position, 1.0);
+    gl_Position = u_ViewProjection * (u_Model * vec4(a_Position, 1.0));
 }
 
 #type fragment
@@ -23,11 +27,13 @@ void main() {
 in vec3 v_NormalWS;
 in vec2 v_TexCoord;
 
-uniform vec4 u_Color;
-uniform int  u_UseTexture;
+layout(std140) uniform MaterialBlock {
+    vec4 u_Color;
+};
+#ifdef HAS_TEXTURE0
 uniform sampler2D u_Texture0;
+#endif
 
-uniform int  u_UseLighting;
 uniform vec3 u_LightDir;    // direction the light points (world)
 uniform vec3 u_LightColor;
 uniform float u_Ambient;
@@ -36,17 +42,21 @@ out vec4 FragColor;
 
 void main() {
     vec3 albedo = u_Color.rgb;
-    if (u_UseTexture == 1)
-        albedo *= texture(u_Texture0, v_TexCoord).rgb;
+#ifdef HAS_TEXTURE0
+    albedo *= texture(u_Texture0, v_TexCoord).rgb;
+#endif
 
     vec3 N = normalize(v_NormalWS);
 
     // If u_LightDir is "direction light points", the incoming light is opposite:
     vec3 L = normalize(-u_LightDir);
 
+#ifdef USE_LIGHTING
     float ndl = max(dot(N, L), 0.0);
     vec3 lit = u_Ambient * u_LightColor + ndl * u_LightColor;
-
-    vec3 color = (u_UseLighting == 1) ? (albedo * lit) : albedo;
+    vec3 color = albedo * lit;
+#else
+    vec3 color = albedo;
+#endif
     FragColor = vec4(color, u_Color.a);
 }
\ No newline at end of file
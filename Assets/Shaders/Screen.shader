@@ -18,6 +18,7 @@ uniform float u_Exposure;     // e.g. 1.0
 uniform int   u_Tonemap;      // 0=none, 1=reinhard, 2=aces
 uniform float u_Vignette;     // 0..1
 uniform sampler2D  u_Scene;
+uniform vec2       u_UVScale;     // pooled render targets are larger than the viewport
 uniform usampler2D u_ID;          // R32UI picking texture
 uniform uint       u_SelectedID;  // 0 = none
 uniform vec3       u_OutlineColor;
@@ -36,7 +37,9 @@ vec3 TonemapACES(vec3 x) {
 }
 
 void main() {
-    vec3 sceneColor = texture(u_Scene, vUV).rgb;
+    // stay half a texel inside the rendered region: past it the pooled texture is unwritten
+    vec2 maxUV = u_UVScale - 0.5 / vec2(textureSize(u_Scene, 0));
+    vec3 sceneColor = texture(u_Scene, min(vUV * u_UVScale, maxUV)).rgb;
 
     // outline logic stays the same, but operate in linear space before gamma
     // ... keep your ID outline code ...
@@ -5,8 +5,12 @@ layout(location = 0) in vec3 a_Position;
 uniform mat4 u_ViewProjection; // light VP
 uniform mat4 u_Model;
 
+// Also the depth pre-pass program: the colour pass tests GL_EQUAL against it, so
+// gl_Position must come out bit-identical to the lit shaders' (world first, then VP)
+invariant gl_Position;
+
 void main() {
-    gl_Position = u_ViewProjection * u_Model * vec4(a_Position, 1.0);
+    gl_Position = u_ViewProjection * (u_Model * vec4(a_Position, 1.0));
 }
 
 #type fragment
@@ -8,10 +8,12 @@ uniform mat4 u_Model;
 
 out vec2 v_TexCoord;
 
+invariant gl_Position; // matches the depth pre-pass (ShadowDepth.shader)
+
 void main()
 {
     v_TexCoord = aTexCoord;
-    gl_Position = u_ViewProjection * u_Model * vec4(aPos, 1.0);
+    gl_Position = u_ViewProjection * (u_Model * vec4(aPos, 1.0));
 }
 
 #type fragment
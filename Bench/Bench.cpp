@@ -0,0 +1,603 @@
+#include <Engine/Core/Window.h>
+#include <Engine/Core/JobSystem.h>
+
+#include <Engine/Renderer/Renderer.h>
+#include <Engine/Renderer/PerspectiveCamera.h>
+#include <Engine/Renderer/Model.h>
+#include <Engine/Renderer/Mesh.h>
+
+#include <Engine/Scene/Scene.h>
+#include <Engine/Scene/Entity.h>
+#include <Engine/Scene/Components.h>
+#include <Engine/Scene/SceneSerializer.h>
+
+#include <Engine/Assets/AssetManager.h>
+#include <Engine/Assets/AssetRegistry.h>
+
+#include <Engine/Physics/CollisionWorld.h>
+
+#include "SceneGenerator.h"
+#include "CommandStack.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace Engine;
+using json = nlohmann::json;
+
+// Usage:
+//   Bench [--sizes 1000,10000,100000] [--max N] [--min-time ms] [--headless]
+//         [--out results.json] [--baseline baseline.json] [--threshold percent]
+//   Bench --compare baseline.json results.json [--threshold percent]
+//
+// Every benchmark runs once to warm up, then repeats until --min-time has passed
+// (at least 3, at most 1000 samples). Results are compared on the median.
+// A few correctness checks run first; any failure makes the exit code 1.
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    volatile float g_Sink = 0.0f; // keeps measured work from being optimized out
+
+    struct BenchResult {
+        std::string Name;
+        uint32_t Count = 0;       // entities / items the iteration processed
+        uint32_t Samples = 0;
+        double MedianMs = 0.0;
+        double MeanMs = 0.0;
+        double MinMs = 0.0;
+    };
+
+    struct BenchOptions {
+        std::vector<uint32_t> Sizes{ 1000, 10000, 100000 };
+        double MinTimeMs = 250.0;
+        bool Headless = false;
+        std::string OutPath = "bench_results.json";
+        std::string BaselinePath;
+        std::string ComparePath; // --compare: baseline file, BaselinePath is the current one
+        double ThresholdPct = 10.0;
+    };
+
+    template<typename Fn>
+    BenchResult Measure(const std::string& name, uint32_t count, double minTimeMs, Fn&& fn) {
+        fn(); // warm-up: caches, first-touch allocations
+
+        std::vector<double> samples;
+        double total = 0.0;
+        while ((total < minTimeMs || samples.size() < 3) && samples.size() < 1000) {
+            const auto start = Clock::now();
+            fn();
+            const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            samples.push_back(ms);
+            total += ms;
+        }
+
+        std::sort(samples.begin(), samples.end());
+
+        BenchResult r;
+        r.Name = name;
+        r.Count = count;
+        r.Samples = (uint32_t)samples.size();
+        r.MedianMs = samples[samples.size() / 2];
+        r.MeanMs = total / (double)samples.size();
+        r.MinMs = samples.front();
+
+        std::cout << std::left << std::setw(34) << name << std::right << std::setw(9) << count
+            << std::fixed << std::setprecision(4)
+            << "  median " << std::setw(11) << r.MedianMs << " ms"
+            << "  min " << std::setw(11) << r.MinMs << " ms"
+            << "  (" << r.Samples << " samples)\n";
+        return r;
+    }
+
+    std::vector<AssetHandle> LoadBenchModels() {
+        auto& assets = AssetManager::Get();
+        AssetHandle shader = assets.LoadShader("Assets/Shaders/Lit.glsl");
+        if (shader == InvalidAssetHandle)
+            return {};
+
+        std::vector<std::string> paths;
+        std::error_code ec;
+        for (auto it = std::filesystem::recursive_directory_iterator("Assets/Models", ec);
+            !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+            const std::string ext = it->path().extension().string();
+            if (ext == ".obj" || ext == ".gltf" || ext == ".glb" || ext == ".fbx")
+                paths.push_back(it->path().generic_string());
+        }
+        std::sort(paths.begin(), paths.end()); // same model order on every machine
+
+        std::vector<AssetHandle> models;
+        for (const auto& p : paths) {
+            AssetHandle h = assets.LoadModel(p, shader);
+            if (h != InvalidAssetHandle)
+                models.push_back(h);
+        }
+        return models;
+    }
+
+    // ---------------- Checks ----------------
+    // Correctness checks that run before the timings; any failure makes Bench exit 1.
+
+    bool Check(bool ok, const char* what) {
+        std::cout << "[Bench] Check " << (ok ? "passed" : "FAILED") << ": " << what << "\n";
+        return ok;
+    }
+
+    // A sphere overlapping a face from behind must be pushed back the way it came,
+    // not through the face. Uses the first model's box collider: inside the box is
+    // behind its +x face.
+    bool CheckSphereOverlap(const std::vector<AssetHandle>& models) {
+        auto model = models.empty() ? nullptr : AssetManager::Get().GetModel(models.front());
+        if (!model || model->GetSubMeshes().empty() || !model->GetSubMeshes().front().MeshPtr) {
+            std::cout << "[Bench] Check skipped: sphere overlap (no model)\n";
+            return true;
+        }
+
+        Scene scene;
+        Entity e = scene.CreateEntity("Box");
+        e.AddComponent<MeshRendererComponent>(models.front());
+
+        CollisionWorld world(scene);
+        world.SetUseTriangleColliders(false);
+
+        // the box shape spans every submesh; the first one's bounds are enough to aim at
+        Bounds b = model->GetSubMeshes().front().MeshPtr->GetBounds();
+        for (const auto& sm : model->GetSubMeshes()) {
+            if (!sm.MeshPtr) continue;
+            b.Min = glm::min(b.Min, sm.MeshPtr->GetBounds().Min);
+            b.Max = glm::max(b.Max, sm.MeshPtr->GetBounds().Max);
+        }
+        const glm::vec3 size = b.Max - b.Min;
+        const glm::vec3 mid = (b.Min + b.Max) * 0.5f;
+        const float r = 0.25f * std::min({ size.x, size.y, size.z });
+        if (r <= 1e-4f) {
+            std::cout << "[Bench] Check skipped: sphere overlap (flat model)\n";
+            return true;
+        }
+
+        const glm::vec3 behind(b.Max.x - 0.5f * r, mid.y, mid.z);
+        const glm::vec3 front(b.Max.x + 0.5f * r, mid.y, mid.z);
+
+        const glm::vec3 fromBehind = world.ResolveSphereOverlap(behind, r);
+        const glm::vec3 fromFront = world.ResolveSphereOverlap(front, r);
+
+        bool ok = true;
+        ok &= Check(fromBehind.x <= b.Max.x - r + 1e-3f, "sphere overlapping a face from behind stays behind it");
+        ok &= Check(fromFront.x >= b.Max.x + r - 1e-3f, "sphere overlapping a face from the front stays in front");
+        return ok;
+    }
+
+    // ParallelFor covers every index exactly once, and a ScheduleAfter graph
+    // (fan-out -> fan-out -> join) only runs a stage once the previous one finished.
+    bool CheckJobSystem() {
+        auto& jobs = JobSystem::Get();
+        bool ok = true;
+
+        const uint32_t count = 100000;
+        std::vector<std::atomic<uint32_t>> hits(count);
+        std::mutex threadsMutex;
+        std::set<std::thread::id> threads;
+        jobs.ParallelFor(count, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; i++)
+                hits[i].fetch_add(1, std::memory_order_relaxed);
+            std::lock_guard lock(threadsMutex);
+            threads.insert(std::this_thread::get_id());
+            }, 256);
+
+        bool once = true;
+        for (const auto& h : hits)
+            once &= h.load(std::memory_order_relaxed) == 1;
+        std::cout << "[Bench] ParallelFor ran on " << threads.size() << " of "
+            << jobs.GetWorkerCount() + 1 << " threads\n";
+        ok &= Check(once, "ParallelFor visits every index exactly once");
+
+        // stage 1 fills slices, stage 2 (after stage 1) squares each slice sum,
+        // the join (after stage 2) adds them up
+        const uint32_t slices = 64, perSlice = 1000;
+        std::vector<uint64_t> sums(slices, 0), squares(slices, 0);
+        std::atomic<uint32_t> earlyStage2{ 0 };
+        uint64_t total = 0;
+        bool joinSawAll = false;
+
+        JobCounter stage1, stage2, join;
+        for (uint32_t s = 0; s < slices; s++) {
+            jobs.Schedule([&, s]() {
+                uint64_t sum = 0;
+                for (uint32_t i = 0; i < perSlice; i++)
+                    sum += (uint64_t)s * perSlice + i;
+                sums[s] = sum;
+                }, &stage1);
+        }
+        for (uint32_t s = 0; s < slices; s++) {
+            jobs.ScheduleAfter(stage1, [&, s]() {
+                if (!stage1.IsDone())
+                    earlyStage2.fetch_add(1, std::memory_order_relaxed);
+                squares[s] = sums[s] * sums[s];
+                }, &stage2);
+        }
+        jobs.ScheduleAfter(stage2, [&]() {
+            joinSawAll = stage1.IsDone() && stage2.IsDone();
+            for (uint64_t v : squares)
+                total += v;
+            }, &join);
+        jobs.Wait(join);
+
+        uint64_t expected = 0;
+        for (uint32_t s = 0; s < slices; s++) {
+            uint64_t sum = 0;
+            for (uint32_t i = 0; i < perSlice; i++)
+                sum += (uint64_t)s * perSlice + i;
+            expected += sum * sum;
+        }
+        ok &= Check(earlyStage2.load() == 0 && joinSawAll, "ScheduleAfter waits for its dependency");
+        ok &= Check(total == expected, "ScheduleAfter fan-out/join result");
+        return ok;
+    }
+
+    // ---------------- Benchmarks (one scene size) ----------------
+
+    void RunSceneBenchmarks(uint32_t size, const std::vector<AssetHandle>& models, bool hasGL,
+        const BenchOptions& opt, std::vector<BenchResult>& out)
+    {
+        Scene scene;
+        Bench::SceneGenSettings gen;
+        gen.EntityCount = size;
+        gen.Models = models;
+        const auto stats = Bench::GenerateScene(scene, gen);
+
+        std::cout << "\n--- " << size << " entities (" << stats.Meshes << " meshes, " << stats.Lights
+            << " lights, " << stats.Warps << " warps) ---\n";
+
+        auto& reg = scene.Registry();
+
+        // TransformComponent::GetTransform
+        {
+            auto view = reg.view<TransformComponent>();
+            out.push_back(Measure("Transform.GetTransform", size, opt.MinTimeMs, [&]() {
+                float acc = 0.0f;
+                for (auto e : view)
+                    acc += view.get<TransformComponent>(e).GetTransform()[3][0];
+                g_Sink = acc;
+                }));
+        }
+
+        // Scene::FindEntityByUUID, random order
+        {
+            std::vector<UUID> ids;
+            ids.reserve(size);
+            auto view = reg.view<IDComponent>();
+            for (auto e : view)
+                ids.push_back(view.get<IDComponent>(e).ID);
+            std::shuffle(ids.begin(), ids.end(), std::mt19937(1234));
+
+            out.push_back(Measure("Scene.FindEntityByUUID", (uint32_t)ids.size(), opt.MinTimeMs, [&]() {
+                uint32_t found = 0;
+                for (UUID id : ids)
+                    found += scene.FindEntityByUUID(id) ? 1u : 0u;
+                g_Sink = (float)found;
+                }));
+        }
+
+        if (hasGL && !models.empty()) {
+            PerspectiveCamera camera(1.0472f, 16.0f / 9.0f, 0.1f, 300.0f);
+            camera.SetPosition(glm::vec3(0.0f, 2.0f, 0.0f));
+
+            // Scene::OnRender: light pick + frustum culling + Submit (nothing is drawn)
+            out.push_back(Measure("Scene.OnRender.Cull", stats.Meshes, opt.MinTimeMs, [&]() {
+                Renderer::BeginScene(camera);
+                scene.OnRender(camera);
+                g_Sink = (float)Renderer::GetDrawListSize();
+                }));
+
+            // Renderer::Submit + the EndScene sort, every submesh in scene order
+            struct Draw { std::shared_ptr<Material> Mat; std::shared_ptr<VertexArray> Vao; glm::mat4 World; };
+            std::vector<Draw> draws;
+            auto& assets = AssetManager::Get();
+            auto view = reg.view<TransformComponent, MeshRendererComponent>();
+            for (auto e : view) {
+                auto model = assets.GetModel(view.get<MeshRendererComponent>(e).Model);
+                if (!model) continue;
+                const glm::mat4 world = view.get<TransformComponent>(e).GetTransform();
+                for (const auto& sm : model->GetSubMeshes()) {
+                    if (sm.MeshPtr && sm.MaterialPtr)
+                        draws.push_back(Draw{ sm.MaterialPtr, sm.MeshPtr->GetVertexArray(), world });
+                }
+            }
+
+            out.push_back(Measure("Renderer.SubmitSort", (uint32_t)draws.size(), opt.MinTimeMs, [&]() {
+                Renderer::BeginScene(camera);
+                for (const auto& d : draws)
+                    Renderer::Submit(d.Mat, d.Vao, d.World);
+                Renderer::SortDrawList();
+                g_Sink = (float)Renderer::GetDrawListSize();
+                }));
+
+            Renderer::BeginScene(camera); // drop the list, never drawn
+        }
+
+        // SceneSerializer round trips (write + read into a second scene)
+        {
+            const auto dir = std::filesystem::temp_directory_path();
+            const std::string jsonPath = (dir / "engine3d_bench.scene").string();
+            const std::string binaryPath = (dir / "engine3d_bench.sceneb").string();
+
+            Scene loaded;
+            SceneSerializer writer(scene);
+            SceneSerializer reader(loaded);
+
+            out.push_back(Measure("SceneSerializer.Json", size, opt.MinTimeMs, [&]() {
+                writer.Serialize(jsonPath);
+                reader.Deserialize(jsonPath);
+                }));
+            out.push_back(Measure("SceneSerializer.Binary", size, opt.MinTimeMs, [&]() {
+                writer.Serialize(binaryPath);
+                reader.Deserialize(binaryPath);
+                }));
+
+            std::error_code ec;
+            std::filesystem::remove(jsonPath, ec);
+            std::filesystem::remove(SceneSerializer::GetDeltaPath(jsonPath), ec);
+            std::filesystem::remove(binaryPath, ec);
+        }
+
+        // Undo stack: one bulk transaction and a run of single-entity commands
+        {
+            std::vector<UUID> ids;
+            std::vector<EditorUndo::TransformSnapshot> before, after;
+            auto view = reg.view<IDComponent, TransformComponent>();
+            for (auto e : view) {
+                const auto& tc = view.get<TransformComponent>(e);
+                EditorUndo::TransformSnapshot s{ tc.Translation, tc.Rotation, tc.Scale };
+                ids.push_back(view.get<IDComponent>(e).ID);
+                before.push_back(s);
+                s.Translation.y += 1.0f;
+                after.push_back(s);
+            }
+
+            EditorUndo::CommandStack stack;
+            stack.SetMemoryBudget(SIZE_MAX);
+
+            out.push_back(Measure("Undo.TransactionUndoRedo", (uint32_t)ids.size(), opt.MinTimeMs, [&]() {
+                stack.Clear();
+                auto& tx = stack.BeginTransaction("Move All");
+                for (size_t i = 0; i < ids.size(); i++)
+                    tx.RecordTransform(ids[i], before[i], after[i]);
+                stack.CommitTransaction();
+                stack.Undo(scene);
+                stack.Redo(scene);
+                }));
+
+            const size_t commands = std::min<size_t>(ids.size(), 10000);
+            out.push_back(Measure("Undo.CommandsUndoRedo", (uint32_t)commands, opt.MinTimeMs, [&]() {
+                stack.Clear();
+                for (size_t i = 0; i < commands; i++) {
+                    stack.BreakMerge();
+                    stack.Commit(std::make_unique<EditorUndo::TransformCommand>(ids[i], before[i], after[i]));
+                }
+                while (stack.CanUndo()) stack.Undo(scene);
+                while (stack.CanRedo()) stack.Redo(scene);
+                }));
+        }
+    }
+
+    void RunRegistryBenchmark(uint32_t size, const BenchOptions& opt, std::vector<BenchResult>& out) {
+        // one asset per ten entities is already generous for a real project
+        const uint32_t assets = std::max(100u, size / 10);
+        const std::string path = (std::filesystem::temp_directory_path() / "engine3d_bench_registry.json").string();
+
+        AssetRegistry registry(path);
+        for (uint32_t i = 0; i < assets; i++)
+            registry.Register(AssetType::Texture2D, "Assets/Bench/Textures/tex_" + std::to_string(i) + ".png");
+
+        out.push_back(Measure("AssetRegistry.SaveLoad", assets, opt.MinTimeMs, [&]() {
+            registry.Save();
+            AssetRegistry loaded(path);
+            loaded.Load();
+            g_Sink = (float)loaded.GetAll().size();
+            }));
+
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+
+    // ---------------- JSON + compare ----------------
+
+    json ToJson(const std::vector<BenchResult>& results) {
+        json j;
+        j["version"] = 1;
+#ifdef NDEBUG
+        j["config"] = "Release";
+#else
+        j["config"] = "Debug";
+#endif
+        j["results"] = json::array();
+        for (const auto& r : results) {
+            j["results"].push_back({
+                { "name", r.Name }, { "count", r.Count }, { "samples", r.Samples },
+                { "median_ms", r.MedianMs }, { "mean_ms", r.MeanMs }, { "min_ms", r.MinMs }
+                });
+        }
+        return j;
+    }
+
+    bool ReadJson(const std::string& path, json& out) {
+        std::ifstream in(path);
+        if (!in) {
+            std::cout << "[Bench] Can't open " << path << "\n";
+            return false;
+        }
+        try {
+            in >> out;
+            return true;
+        }
+        catch (const std::exception& e) {
+            std::cout << "[Bench] Bad JSON in " << path << " (" << e.what() << ")\n";
+            return false;
+        }
+    }
+
+    // Matches results by name + count; returns how many got slower than the threshold.
+    int Compare(const json& baseline, const json& current, double thresholdPct) {
+        auto key = [](const json& r) { return r.value("name", std::string()) + "@" + std::to_string(r.value("count", 0u)); };
+
+        std::unordered_map<std::string, double> base;
+        for (const auto& r : baseline.value("results", json::array()))
+            base[key(r)] = r.value("median_ms", 0.0);
+
+        std::cout << "\n--- compare (median, threshold " << thresholdPct << "%) ---\n";
+
+        int regressions = 0;
+        for (const auto& r : current.value("results", json::array())) {
+            const std::string k = key(r);
+            const double now = r.value("median_ms", 0.0);
+
+            std::cout << std::left << std::setw(44) << k << std::right;
+            auto it = base.find(k);
+            if (it == base.end() || it->second <= 0.0) {
+                std::cout << "  new\n";
+                continue;
+            }
+
+            const double deltaPct = (now - it->second) / it->second * 100.0;
+            std::cout << std::fixed << std::setprecision(4) << std::setw(12) << it->second << " -> "
+                << std::setw(12) << now << " ms  " << std::showpos << std::setprecision(1) << deltaPct
+                << std::noshowpos << "%";
+
+            if (deltaPct > thresholdPct) {
+                std::cout << "  REGRESSION";
+                regressions++;
+            }
+            else if (deltaPct < -thresholdPct) {
+                std::cout << "  improved";
+            }
+            std::cout << "\n";
+        }
+
+        std::cout << (regressions ? "[Bench] " + std::to_string(regressions) + " regression(s)\n" : "[Bench] no regressions\n");
+        return regressions;
+    }
+
+    std::vector<uint32_t> ParseSizes(const std::string& list) {
+        std::vector<uint32_t> sizes;
+        std::stringstream ss(list);
+        for (std::string item; std::getline(ss, item, ',');) {
+            if (!item.empty())
+                sizes.push_back((uint32_t)std::stoul(item));
+        }
+        return sizes;
+    }
+
+    void PrintUsage() {
+        std::cout << "Usage:\n"
+            << "  Bench [--sizes 1000,10000,100000] [--max N] [--min-time ms] [--headless]\n"
+            << "        [--out results.json] [--baseline baseline.json] [--threshold percent]\n"
+            << "  Bench --compare baseline.json results.json [--threshold percent]\n";
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchOptions opt;
+    for (int i = 1; i < argc; i++) {
+        auto is = [&](const char* flag) { return std::strcmp(argv[i], flag) == 0; };
+        const bool hasValue = i + 1 < argc;
+        const char* arg = argv[i];
+
+        try {
+            if (is("--headless")) opt.Headless = true;
+            else if (is("--sizes") && hasValue) opt.Sizes = ParseSizes(argv[++i]);
+            else if (is("--max") && hasValue) {
+                const uint64_t maxSize = std::min<uint64_t>(std::stoull(argv[++i]), UINT32_MAX);
+                opt.Sizes.clear();
+                for (uint64_t s = 1000; s <= maxSize; s *= 10) {
+                    opt.Sizes.push_back((uint32_t)s);
+                    if (s > maxSize / 10) break; // the next step would pass maxSize
+                }
+            }
+            else if (is("--min-time") && hasValue) opt.MinTimeMs = std::stod(argv[++i]);
+            else if (is("--out") && hasValue) opt.OutPath = argv[++i];
+            else if (is("--baseline") && hasValue) opt.BaselinePath = argv[++i];
+            else if (is("--threshold") && hasValue) opt.ThresholdPct = std::stod(argv[++i]);
+            else if (is("--compare") && i + 2 < argc) {
+                opt.ComparePath = argv[++i];
+                opt.BaselinePath = argv[++i];
+            }
+            else {
+                std::cout << "[Bench] Unknown argument: " << arg << "\n";
+                PrintUsage();
+                return 2;
+            }
+        }
+        catch (const std::exception&) { // std::stoul / stod: not a number, out of range
+            std::cout << "[Bench] Bad value for " << arg << ": " << argv[i] << "\n";
+            PrintUsage();
+            return 2;
+        }
+    }
+
+    // compare two stored result files, no run
+    if (!opt.ComparePath.empty()) {
+        json baseline, current;
+        if (!ReadJson(opt.ComparePath, baseline) || !ReadJson(opt.BaselinePath, current))
+            return 2;
+        return Compare(baseline, current, opt.ThresholdPct) > 0 ? 1 : 0;
+    }
+
+    // GL is only needed for the model-backed render benchmarks
+    std::unique_ptr<Window> window;
+    try {
+        window = Window::Create({ "Engine3D - Bench", 320, 180, opt.Headless });
+        Renderer::Init();
+    }
+    catch (const std::exception& e) {
+        std::cout << "[Bench] No GL context (" << e.what() << "), skipping render benchmarks\n";
+    }
+
+    const std::vector<AssetHandle> models = window ? LoadBenchModels() : std::vector<AssetHandle>{};
+    std::cout << "[Bench] " << models.size() << " models\n";
+
+    bool checksOk = true;
+    checksOk &= CheckJobSystem();
+    checksOk &= CheckSphereOverlap(models);
+
+    std::vector<BenchResult> results;
+    for (uint32_t size : opt.Sizes) {
+        RunSceneBenchmarks(size, models, window != nullptr, opt, results);
+        RunRegistryBenchmark(size, opt, results);
+    }
+
+    const json current = ToJson(results);
+    {
+        std::ofstream out(opt.OutPath);
+        out << current.dump(2) << "\n";
+        std::cout << "\n[Bench] Wrote " << opt.OutPath << "\n";
+    }
+
+    if (!opt.BaselinePath.empty()) {
+        json baseline;
+        if (!ReadJson(opt.BaselinePath, baseline))
+            return 2;
+        if (Compare(baseline, current, opt.ThresholdPct) > 0)
+            return 1;
+    }
+    return checksOk ? 0 : 1;
+}
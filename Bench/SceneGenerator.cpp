@@ -0,0 +1,82 @@
+#include "SceneGenerator.h"
+
+#include <Engine/Scene/Scene.h>
+#include <Engine/Scene/Entity.h>
+#include <Engine/Scene/Components.h>
+
+#include <random>
+#include <string>
+#include <algorithm>
+
+namespace Bench {
+
+    SceneGenStats GenerateScene(Engine::Scene& scene, const SceneGenSettings& settings) {
+        using namespace Engine;
+
+        scene.Clear();
+
+        std::mt19937_64 rng(settings.Seed);
+        std::uniform_real_distribution<float> pos(-settings.Extent, settings.Extent);
+        std::uniform_real_distribution<float> angle(-3.1415926f, 3.1415926f);
+        std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+
+        const uint32_t total = settings.EntityCount;
+        const uint32_t lights = std::min(settings.LightCount, total);
+        const uint32_t warps = std::min(total - lights, (uint32_t)(total * std::max(0.0f, settings.WarpFraction)));
+
+        SceneGenStats stats;
+        std::string name;
+
+        for (uint32_t i = 0; i < total; i++) {
+            // seeded UUIDs keep scenes (and lookups into them) identical across runs
+            const UUID id = rng() | 1;
+
+            if (i == 0) {
+                Entity spawn = scene.CreateEntityWithUUID(id, "SpawnPoint");
+                spawn.AddComponent<SpawnPointComponent>();
+                spawn.GetComponent<TransformComponent>().Translation = glm::vec3(0.0f, 2.0f, 0.0f);
+                stats.Empty++;
+                continue;
+            }
+
+            if (i <= lights) {
+                Entity e = scene.CreateEntityWithUUID(id, "Light");
+                e.GetComponent<TransformComponent>().Rotation = glm::vec3(angle(rng) * 0.5f, angle(rng), 0.0f);
+                e.AddComponent<DirectionalLightComponent>();
+                stats.Lights++;
+                continue;
+            }
+
+            Entity e;
+            if (i <= lights + warps) {
+                // warps come in pairs pointing at each other
+                const uint32_t w = i - lights - 1;
+                name = "Warp" + std::to_string(w);
+                e = scene.CreateEntityWithUUID(id, name.c_str());
+
+                auto& warp = e.AddComponent<SceneWarpComponent>();
+                warp.TargetWarpTag = "Warp" + std::to_string(w ^ 1u);
+                warp.TriggerRadius = 1.5f;
+                stats.Warps++;
+            }
+            else {
+                e = scene.CreateEntityWithUUID(id, "Mesh");
+                if (!settings.Models.empty()) {
+                    e.AddComponent<MeshRendererComponent>(settings.Models[i % settings.Models.size()]);
+                    stats.Meshes++;
+                }
+                else {
+                    stats.Empty++;
+                }
+            }
+
+            auto& tc = e.GetComponent<TransformComponent>();
+            tc.Translation = glm::vec3(pos(rng), pos(rng), pos(rng));
+            tc.Rotation = glm::vec3(0.0f, angle(rng), 0.0f);
+            tc.Scale = glm::vec3(scale(rng));
+        }
+
+        return stats;
+    }
+
+} // namespace Bench
@@ -0,0 +1,35 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <Engine/Assets/AssetHandle.h>
+
+namespace Engine { class Scene; }
+
+namespace Bench {
+
+    // Deterministic synthetic scenes for benchmarks: a cube of entities with mixed
+    // models, a few directional lights, warps that point at each other and one spawn.
+    // The same settings + seed always produce the same scene (UUIDs included).
+    struct SceneGenSettings {
+        uint32_t EntityCount = 10000;             // total, lights / warps included
+        std::vector<Engine::AssetHandle> Models;  // round-robin; empty = transforms only
+        uint32_t LightCount = 4;
+        float WarpFraction = 0.01f;               // share of entities that are warps
+        float Extent = 500.0f;                    // half-size of the cube, meters
+        uint64_t Seed = 0x5EED;
+    };
+
+    struct SceneGenStats {
+        uint32_t Meshes = 0;
+        uint32_t Lights = 0;
+        uint32_t Warps = 0;
+        uint32_t Empty = 0;
+    };
+
+    // Clears the scene first.
+    SceneGenStats GenerateScene(Engine::Scene& scene, const SceneGenSettings& settings);
+
+} // namespace Bench
@@ -1,8 +1,10 @@
 #pragma once
 #include <memory>
 #include <vector>
+#include <deque>
 #include <string>
 #include <cmath>
+#include <chrono>
 
 #include <glm/glm.hpp>
 
@@ -10,6 +12,8 @@
 #include <Engine/Scene/Entity.h>
 #include <Engine/Scene/UUID.h>
 #include <Engine/Scene/Components.h>
+#include <Engine/Scene/EntityBlob.h>
+#include <Engine/Core/MemoryTracker.h>
 
 namespace EditorUndo {
 
@@ -52,57 +56,26 @@ namespace EditorUndo {
     }
 
     // --- Entity snapshot for Create/Delete undo ---
+    // Components are packed with the binary scene encoding (see EntityBlob.h), so a
+    // snapshot costs tens of bytes instead of a full set of component structs.
     struct EntitySnapshot {
         Engine::UUID ID{};
-        std::string Tag{ "Entity" };
-        TransformSnapshot Transform{};
-
-        bool HasMeshRenderer = false;
-        Engine::MeshRendererComponent MeshRenderer{};
-
-        bool HasDirectionalLight = false;
-        Engine::DirectionalLightComponent DirectionalLight{};
+        Engine::EntityBlob Blob;
     };
 
-    inline EntitySnapshot CaptureEntity(Engine::Entity e) {
+    inline EntitySnapshot CaptureEntity(const Engine::Scene& scene, Engine::Entity e) {
         EntitySnapshot s;
         if (!e) return s;
 
+        Engine::MemoryScope memScope(Engine::MemoryTag::Undo);
         s.ID = e.GetComponent<Engine::IDComponent>().ID;
-        s.Tag = e.GetComponent<Engine::TagComponent>().Tag;
-        s.Transform = CaptureTransform(e);
-
-        if (e.HasComponent<Engine::MeshRendererComponent>()) {
-            s.HasMeshRenderer = true;
-            s.MeshRenderer = e.GetComponent<Engine::MeshRendererComponent>();
-        }
-
-        if (e.HasComponent<Engine::DirectionalLightComponent>()) {
-            s.HasDirectionalLight = true;
-            s.DirectionalLight = e.GetComponent<Engine::DirectionalLightComponent>();
-        }
-
+        s.Blob = Engine::CaptureEntityBlob(scene, e);
         return s;
     }
 
     inline Engine::Entity RestoreEntity(Engine::Scene& scene, const EntitySnapshot& s) {
         // If already exists, return it (prevents duplicates on redo)
-        Engine::Entity existing = scene.FindEntityByUUID(s.ID);
-        if (existing) return existing;
-
-        Engine::Entity e = scene.CreateEntityWithUUID(s.ID, s.Tag.c_str());
-
-        // base comps exist already
-        e.GetComponent<Engine::TagComponent>().Tag = s.Tag;
-        ApplyTransform(e, s.Transform);
-
-        if (s.HasMeshRenderer && !e.HasComponent<Engine::MeshRendererComponent>())
-            e.AddComponent<Engine::MeshRendererComponent>(s.MeshRenderer);
-
-        if (s.HasDirectionalLight && !e.HasComponent<Engine::DirectionalLightComponent>())
-            e.AddComponent<Engine::DirectionalLightComponent>(s.DirectionalLight);
-
-        return e;
+        return Engine::RestoreEntityBlob(scene, s.Blob);
     }
 
     inline void DestroyByUUID(Engine::Scene& scene, Engine::UUID id) {
@@ -118,33 +91,125 @@ namespace EditorUndo {
         virtual void Undo(Engine::Scene& scene) = 0;
         virtual void Redo(Engine::Scene& scene) = 0;
         virtual const char* Name() const = 0;
+
+        // Approximate heap + object size; drives the history budget.
+        virtual size_t GetMemoryBytes() const = 0;
+
+        // Fold `next` (committed right after this one) into this command.
+        // Return false to keep them as separate steps.
+        virtual bool MergeWith(const ICommand& next) { (void)next; return false; }
     };
 
+    // One undo step for an operation over many entities (duplicate-many, delete
+    // selection, scatter). State is kept as columns - UUIDs, transform before/after,
+    // entity blobs - and Undo/Redo resolve and apply them in bulk: one index pass,
+    // registry range create/destroy, one insert per component type.
+    //
+    // Redo order: deletes, creates, transforms. Undo runs the reverse.
+    class TransactionCommand final : public ICommand {
+    public:
+        explicit TransactionCommand(std::string name)
+            : m_Name(std::move(name)) {
+        }
+
+        void RecordTransform(Engine::UUID id, const TransformSnapshot& before, const TransformSnapshot& after) {
+            Engine::MemoryScope memScope(Engine::MemoryTag::Undo);
+            m_TransformIDs.push_back(id);
+            m_Before.push_back(before);
+            m_After.push_back(after);
+        }
+
+        void RecordCreate(EntitySnapshot snap) {
+            Engine::MemoryScope memScope(Engine::MemoryTag::Undo);
+            m_CreatedIDs.push_back(snap.ID);
+            m_Created.push_back(std::move(snap.Blob));
+        }
+
+        void RecordDelete(EntitySnapshot snap) {
+            Engine::MemoryScope memScope(Engine::MemoryTag::Undo);
+            m_DeletedIDs.push_back(snap.ID);
+            m_Deleted.push_back(std::move(snap.Blob));
+        }
+
+        bool Empty() const { return m_TransformIDs.empty() && m_CreatedIDs.empty() && m_DeletedIDs.empty(); }
+
+        void Undo(Engine::Scene& scene) override {
+            ApplyTransforms(scene, m_Before);
+            scene.DestroyEntities(m_CreatedIDs);
+            Engine::RestoreEntityBlobs(scene, m_Deleted);
+        }
+
+        void Redo(Engine::Scene& scene) override {
+            scene.DestroyEntities(m_DeletedIDs);
+            Engine::RestoreEntityBlobs(scene, m_Created);
+            ApplyTransforms(scene, m_After);
+        }
+
+        const char* Name() const override { return m_Name.c_str(); }
+
+        size_t GetMemoryBytes() const override {
+            size_t bytes = sizeof(*this) + m_Name.capacity()
+                + m_TransformIDs.capacity() * sizeof(Engine::UUID)
+                + (m_Before.capacity() + m_After.capacity()) * sizeof(TransformSnapshot)
+                + (m_CreatedIDs.capacity() + m_DeletedIDs.capacity()) * sizeof(Engine::UUID)
+                + (m_Created.capacity() + m_Deleted.capacity()) * sizeof(Engine::EntityBlob);
+            for (const auto& blob : m_Created) bytes += blob.capacity();
+            for (const auto& blob : m_Deleted) bytes += blob.capacity();
+            return bytes;
+        }
+
+    private:
+        void ApplyTransforms(Engine::Scene& scene, const std::vector<TransformSnapshot>& column) {
+            if (m_TransformIDs.empty()) return;
+
+            auto& reg = scene.Registry();
+            const auto entities = scene.FindEntitiesByUUID(m_TransformIDs);
+            for (size_t i = 0; i < entities.size(); i++) {
+                if (entities[i] == entt::null) continue;
+
+                auto& tc = reg.get<Engine::TransformComponent>(entities[i]);
+                tc.Translation = column[i].Translation;
+                tc.Rotation = column[i].Rotation;
+                tc.Scale = column[i].Scale;
+            }
+            scene.MarkEntitiesDirty(entities);
+        }
+
+    private:
+        std::string m_Name;
+
+        std::vector<Engine::UUID> m_TransformIDs;
+        std::vector<TransformSnapshot> m_Before, m_After;
+
+        std::vector<Engine::UUID> m_CreatedIDs, m_DeletedIDs;
+        std::vector<Engine::EntityBlob> m_Created, m_Deleted;
+    };
+
+    // History is bounded by bytes, not step count: oldest steps are dropped once the
+    // budget is exceeded (the newest step is always kept). Consecutive commands that
+    // arrive within the merge window are offered to MergeWith, so dragging a slider
+    // or nudging with the gizmo leaves one step instead of dozens.
     class CommandStack {
     public:
+        using Clock = std::chrono::steady_clock;
+
         void Clear() {
+            m_Transaction.reset();
             m_Commands.clear();
             m_Index = 0;
+            m_Bytes = 0;
+            m_MergeBarrier = true;
         }
 
         // Execute: performs Redo() now, then pushes it
         void Execute(Engine::Scene& scene, std::unique_ptr<ICommand> cmd) {
-            // drop redo branch
-            if (m_Index < m_Commands.size())
-                m_Commands.erase(m_Commands.begin() + (ptrdiff_t)m_Index, m_Commands.end());
-
             cmd->Redo(scene);
-            m_Commands.emplace_back(std::move(cmd));
-            m_Index = m_Commands.size();
+            Push(std::move(cmd));
         }
 
         // Commit: push a command whose effect already happened (e.g., gizmo drag)
         void Commit(std::unique_ptr<ICommand> cmd) {
-            if (m_Index < m_Commands.size())
-                m_Commands.erase(m_Commands.begin() + (ptrdiff_t)m_Index, m_Commands.end());
-
-            m_Commands.emplace_back(std::move(cmd));
-            m_Index = m_Commands.size();
+            Push(std::move(cmd));
         }
 
         bool CanUndo() const { return m_Index > 0; }
@@ -153,18 +218,109 @@ namespace EditorUndo {
         void Undo(Engine::Scene& scene) {
             if (!CanUndo()) return;
             m_Index--;
-            m_Commands[m_Index]->Undo(scene);
+            m_Commands[m_Index].Cmd->Undo(scene);
+            m_MergeBarrier = true;
         }
 
         void Redo(Engine::Scene& scene) {
             if (!CanRedo()) return;
-            m_Commands[m_Index]->Redo(scene);
+            m_Commands[m_Index].Cmd->Redo(scene);
             m_Index++;
+            m_MergeBarrier = true;
+        }
+
+        // Transactions: record changes on the returned command while the operation
+        // runs (its effects are applied by the caller), then CommitTransaction pushes
+        // it as one step. Empty transactions are dropped.
+        TransactionCommand& BeginTransaction(std::string name) {
+            Engine::MemoryScope memScope(Engine::MemoryTag::Undo);
+            m_Transaction = std::make_unique<TransactionCommand>(std::move(name));
+            return *m_Transaction;
+        }
+
+        bool InTransaction() const { return m_Transaction != nullptr; }
+
+        void CommitTransaction() {
+            if (!m_Transaction) return;
+            if (!m_Transaction->Empty())
+                Push(std::move(m_Transaction));
+            m_Transaction.reset();
         }
 
+        void CancelTransaction() { m_Transaction.reset(); }
+
+        // Next commit always starts a new step (selection change, explicit "commit" UI, ...)
+        void BreakMerge() { m_MergeBarrier = true; }
+
+        void SetMemoryBudget(size_t bytes) { m_Budget = bytes; Trim(); }
+        size_t GetMemoryBudget() const { return m_Budget; }
+        size_t GetMemoryBytes() const { return m_Bytes; }
+
+        void SetMergeWindow(Clock::duration window) { m_MergeWindow = window; }
+
+        size_t GetCount() const { return m_Commands.size(); }
+
     private:
-        std::vector<std::unique_ptr<ICommand>> m_Commands;
+        struct Entry {
+            std::unique_ptr<ICommand> Cmd;
+            size_t Bytes = 0;
+            Clock::time_point Time;
+        };
+
+        void Push(std::unique_ptr<ICommand> cmd) {
+            Engine::MemoryScope memScope(Engine::MemoryTag::Undo);
+            // drop redo branch
+            while (m_Commands.size() > m_Index) {
+                m_Bytes -= m_Commands.back().Bytes;
+                m_Commands.pop_back();
+            }
+
+            const auto now = Clock::now();
+
+            if (!m_MergeBarrier && !m_Commands.empty()) {
+                Entry& last = m_Commands.back();
+                if (now - last.Time <= m_MergeWindow && last.Cmd->MergeWith(*cmd)) {
+                    m_Bytes -= last.Bytes;
+                    last.Bytes = last.Cmd->GetMemoryBytes();
+                    last.Time = now;
+                    m_Bytes += last.Bytes;
+                    return;
+                }
+            }
+
+            Entry entry;
+            entry.Bytes = cmd->GetMemoryBytes();
+            entry.Time = now;
+            entry.Cmd = std::move(cmd);
+
+            m_Bytes += entry.Bytes;
+            m_Commands.emplace_back(std::move(entry));
+            m_Index = m_Commands.size();
+            m_MergeBarrier = false;
+
+            Trim();
+        }
+
+        // Evicts the oldest undo entries; redo entries (at and after m_Index) are never
+        // dropped, so trimming stops at the cursor even if still over budget.
+        void Trim() {
+            while (m_Bytes > m_Budget && m_Index > 0 && m_Commands.size() > 1) {
+                m_Bytes -= m_Commands.front().Bytes;
+                m_Commands.pop_front();
+                m_Index--;
+            }
+        }
+
+    private:
+        std::deque<Entry> m_Commands;
+        std::unique_ptr<TransactionCommand> m_Transaction;
         size_t m_Index = 0; // points to next redo position
+
+        size_t m_Bytes = 0;
+        size_t m_Budget = 32ull * 1024 * 1024;
+
+        Clock::duration m_MergeWindow = std::chrono::milliseconds(750);
+        bool m_MergeBarrier = true;
     };
 
     // ---------------- Concrete commands ----------------
@@ -178,15 +334,27 @@ namespace EditorUndo {
         void Undo(Engine::Scene& scene) override {
             auto e = scene.FindEntityByUUID(m_ID);
             ApplyTransform(e, m_Before);
+            scene.MarkEntityDirty(e);
         }
 
         void Redo(Engine::Scene& scene) override {
             auto e = scene.FindEntityByUUID(m_ID);
             ApplyTransform(e, m_After);
+            scene.MarkEntityDirty(e);
         }
 
         const char* Name() const override { return "Transform"; }
 
+        size_t GetMemoryBytes() const override { return sizeof(*this); }
+
+        // Successive edits of the same entity collapse into one before -> after step
+        bool MergeWith(const ICommand& next) override {
+            const auto* t = dynamic_cast<const TransformCommand*>(&next);
+            if (!t || t->m_ID != m_ID) return false;
+            m_After = t->m_After;
+            return true;
+        }
+
     private:
         Engine::UUID m_ID{};
         TransformSnapshot m_Before{}, m_After{};
@@ -208,6 +376,8 @@ namespace EditorUndo {
 
         const char* Name() const override { return "Delete Entity"; }
 
+        size_t GetMemoryBytes() const override { return sizeof(*this) + m_Snap.Blob.capacity(); }
+
         Engine::UUID GetID() const { return m_Snap.ID; }
 
     private:
@@ -230,23 +400,63 @@ namespace EditorUndo {
 
         const char* Name() const override { return "Create Entity"; }
 
+        size_t GetMemoryBytes() const override { return sizeof(*this) + m_Snap.Blob.capacity(); }
+
         Engine::UUID GetID() const { return m_Snap.ID; }
 
     private:
         EntitySnapshot m_Snap;
     };
 
+    // Several commands recorded as one step (multi-entity edits). Undo runs in reverse.
+    class CommandGroup final : public ICommand {
+    public:
+        explicit CommandGroup(std::string name)
+            : m_Name(std::move(name)) {
+        }
+
+        void Add(std::unique_ptr<ICommand> cmd) {
+            if (cmd) m_Commands.emplace_back(std::move(cmd));
+        }
+
+        bool Empty() const { return m_Commands.empty(); }
+
+        void Undo(Engine::Scene& scene) override {
+            for (auto it = m_Commands.rbegin(); it != m_Commands.rend(); ++it)
+                (*it)->Undo(scene);
+        }
+
+        void Redo(Engine::Scene& scene) override {
+            for (auto& cmd : m_Commands)
+                cmd->Redo(scene);
+        }
+
+        const char* Name() const override { return m_Name.c_str(); }
+
+        size_t GetMemoryBytes() const override {
+            size_t bytes = sizeof(*this) + m_Name.capacity() + m_Commands.capacity() * sizeof(m_Commands[0]);
+            for (const auto& cmd : m_Commands)
+                bytes += cmd->GetMemoryBytes();
+            return bytes;
+        }
+
+    private:
+        std::string m_Name;
+        std::vector<std::unique_ptr<ICommand>> m_Commands;
+    };
+
     inline EntitySnapshot MakeDuplicateSnapshot(Engine::Scene& scene, Engine::Entity src, Engine::UUID newID) {
-        EntitySnapshot s = CaptureEntity(src);
-        s.ID = newID;
+        if (!src) return {};
 
         // tag naming
-        if (!s.Tag.empty())
-            s.Tag = s.Tag + " Copy";
-        else
-            s.Tag = "Entity Copy";
+        const std::string& tag = src.GetComponent<Engine::TagComponent>().Tag;
+        const std::string newTag = tag.empty() ? std::string("Entity Copy") : tag + " Copy";
 
+        Engine::MemoryScope memScope(Engine::MemoryTag::Undo);
+        EntitySnapshot s;
+        s.ID = newID;
+        s.Blob = Engine::RetargetEntityBlob(Engine::CaptureEntityBlob(scene, src), newID, newTag);
         return s;
     }
 
-} // namespace EditorUndo
\ No newline at end of file
+} // namespace EditorUndo
@@ -9,8 +9,13 @@
 #include <Engine/Scene/UUID.h>
 
 #include <Engine/Assets/AssetManager.h>
+#include <Engine/Core/JobSystem.h>
+#include <Engine/Core/FrameScheduler.h>
+#include <Engine/Core/MemoryTracker.h>
 
 #include <Engine/Renderer/Shader.h>
+#include <Engine/Renderer/ShaderLibrary.h>
+#include <Engine/Renderer/ShaderCache.h>
 #include <Engine/Renderer/Material.h>
 #include <Engine/Renderer/VertexArray.h>
 #include <Engine/Renderer/Buffer.h>
@@ -85,8 +90,7 @@ static float SnapFloat(float v, float step) {
 }
 
 static uint32_t FoldUUIDToPickID(Engine::UUID id) {
-    uint32_t v = (uint32_t)(id ^ (id >> 32));
-    return v == 0 ? 1u : v;
+    return Engine::Scene::PickIDFromUUID(id);
 }
 
 
@@ -255,7 +259,7 @@ struct GizmoRenderer {
 
     void Init() {
         if (Initialized) return;
-        ShaderLine = std::make_shared<Shader>("Assets/Shaders/GizmoLine.shader");
+        ShaderLine = ShaderLibrary::Get().Load("Assets/Shaders/GizmoLine.shader");
 
         glGenVertexArrays(1, &VAO);
         glBindVertexArray(VAO);
@@ -500,7 +504,183 @@ static bool LaunchSandboxExe(const std::string& extraArgs, std::string& outError
 #endif
 }
 
+// -------- Renderer stats panel --------
+// Last published Renderer::GetStats() per pass, plus rolling graphs of the totals.
+// Only frames that actually rendered the viewport publish stats. Returns true when a
+// pipeline setting changed (the viewport needs re-rendering).
+static bool DrawRendererStatsPanel(RendererPipeline& pipeline) {
+    static constexpr int HistorySize = 240;
+    struct History {
+        float DrawCalls[HistorySize] = {};
+        float TrianglesK[HistorySize] = {};
+        float ShaderBinds[HistorySize] = {};
+        float UniformUploads[HistorySize] = {};
+        int Offset = 0;
+        uint64_t LastFrame = 0;
+    };
+    static History history;
+
+    const RenderStats& stats = Renderer::GetStats();
+    const RenderStats::Counters total = stats.Total();
+
+    if (stats.Frame != history.LastFrame) {
+        history.LastFrame = stats.Frame;
+        history.DrawCalls[history.Offset] = (float)total.DrawCalls;
+        history.TrianglesK[history.Offset] = (float)total.Triangles / 1000.0f;
+        history.ShaderBinds[history.Offset] = (float)total.ShaderBinds;
+        history.UniformUploads[history.Offset] = (float)total.UniformUploads;
+        history.Offset = (history.Offset + 1) % HistorySize;
+    }
+
+    ImGui::Begin("Renderer Stats");
+
+    ImGui::Text("Frame %llu", (unsigned long long)stats.Frame);
+
+    bool changed = false;
+    bool depthPrepass = pipeline.IsDepthPrepassEnabled();
+    if (ImGui::Checkbox("Depth pre-pass", &depthPrepass)) {
+        pipeline.SetDepthPrepassEnabled(depthPrepass);
+        changed = true;
+    }
+    if (depthPrepass && stats.DepthPrepass.Frame != 0) {
+        const auto& dp = stats.DepthPrepass;
+        ImGui::SameLine();
+        ImGui::TextDisabled("(frame %llu)", (unsigned long long)dp.Frame);
+        ImGui::Text("Samples: %llu depth, %llu shaded, %llu saved (%.1f%%)",
+            (unsigned long long)dp.DepthSamples, (unsigned long long)dp.ShadedSamples,
+            (unsigned long long)dp.SavedSamples(),
+            dp.DepthSamples ? 100.0 * (double)dp.SavedSamples() / (double)dp.DepthSamples : 0.0);
+    }
+
+    if (ImGui::BeginTable("##RendererStats", RenderStats::PassCount + 2,
+        ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_SizingStretchProp)) {
+        ImGui::TableSetupColumn("");
+        for (uint32_t p = 0; p < RenderStats::PassCount; p++)
+            ImGui::TableSetupColumn(RenderStats::GetPassName((RenderStats::Pass)p));
+        ImGui::TableSetupColumn("Total");
+        ImGui::TableHeadersRow();
+
+        auto Row = [&](const char* label, auto field) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(label);
+            for (uint32_t p = 0; p < RenderStats::PassCount; p++) {
+                ImGui::TableNextColumn();
+                ImGui::Text("%llu", (unsigned long long)(stats.Passes[p].*field));
+            }
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", (unsigned long long)(total.*field));
+            };
+
+        using C = RenderStats::Counters;
+        Row("Submitted", &C::Submitted);
+        Row("Culled", &C::Culled);
+        Row("Drawn", &C::Drawn);
+        Row("Draw calls", &C::DrawCalls);
+        Row("Batches", &C::Batches);
+        Row("Triangles", &C::Triangles);
+        Row("Shader binds", &C::ShaderBinds);
+        Row("VAO binds", &C::VaoBinds);
+        Row("Texture binds", &C::TextureBinds);
+        Row("Uniforms", &C::UniformUploads);
+        Row("FB binds", &C::FramebufferBinds);
+
+        ImGui::EndTable();
+    }
+
+    ImGui::Separator();
+
+    auto Graph = [&](const char* label, const float* values) {
+        float maxValue = 1.0f;
+        for (int i = 0; i < HistorySize; i++) maxValue = std::max(maxValue, values[i]);
+
+        char overlay[64];
+        const int latest = (history.Offset + HistorySize - 1) % HistorySize;
+        std::snprintf(overlay, sizeof(overlay), "%s: %.0f", label, values[latest]);
+        ImGui::PlotLines("##graph", values, HistorySize, history.Offset, overlay, 0.0f, maxValue * 1.1f, ImVec2(-1, 48));
+        };
+
+    ImGui::PushID("DrawCalls");      Graph("Draw calls", history.DrawCalls);           ImGui::PopID();
+    ImGui::PushID("Triangles");      Graph("Triangles (k)", history.TrianglesK);       ImGui::PopID();
+    ImGui::PushID("ShaderBinds");    Graph("Shader binds", history.ShaderBinds);       ImGui::PopID();
+    ImGui::PushID("UniformUploads"); Graph("Uniform uploads", history.UniformUploads); ImGui::PopID();
+
+    ImGui::End();
+    return changed;
+}
+
+// -------- Memory panel --------
+// Heap usage per MemoryTag, estimated GPU memory per resource kind, and heap
+// allocations per frame (should sit at 0 while nothing is loading or being edited).
+static void DrawMemoryPanel() {
+    static constexpr int HistorySize = 240;
+    static float frameAllocs[HistorySize] = {};
+    static int offset = 0;
+
+    const uint64_t allocs = MemoryTracker::GetFrameAllocations();
+    frameAllocs[offset] = (float)allocs;
+    offset = (offset + 1) % HistorySize;
+
+    auto MiB = [](int64_t bytes) { return (double)bytes / (1024.0 * 1024.0); };
+
+    ImGui::Begin("Memory");
+
+    if (!MemoryTracker::IsHeapTrackingEnabled())
+        ImGui::TextDisabled("Heap tracking off (build with ENGINE_MEMORY_TRACKING)");
+
+    ImGui::Text("Last frame: %llu allocations, %.1f KiB", (unsigned long long)allocs,
+        (double)MemoryTracker::GetFrameAllocatedBytes() / 1024.0);
+
+    float maxAllocs = 1.0f;
+    for (float v : frameAllocs) maxAllocs = std::max(maxAllocs, v);
+    ImGui::PlotHistogram("##FrameAllocs", frameAllocs, HistorySize, offset, "allocations / frame", 0.0f, maxAllocs * 1.1f, ImVec2(-1, 48));
+
+    auto Table = [&](const char* id, const char* firstColumn, auto rows) {
+        if (!ImGui::BeginTable(id, 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_SizingStretchProp))
+            return;
+        ImGui::TableSetupColumn(firstColumn);
+        ImGui::TableSetupColumn("Live (MiB)");
+        ImGui::TableSetupColumn("Peak (MiB)");
+        ImGui::TableSetupColumn("Allocations");
+        ImGui::TableHeadersRow();
+
+        auto Row = [&](const char* label, const MemoryTracker::Usage& u) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(label);
+            ImGui::TableNextColumn(); ImGui::Text("%.2f", MiB(u.Bytes));
+            ImGui::TableNextColumn(); ImGui::Text("%.2f", MiB(u.PeakBytes));
+            ImGui::TableNextColumn(); ImGui::Text("%llu", (unsigned long long)u.Allocations);
+            };
+        rows(Row);
+
+        ImGui::EndTable();
+        };
+
+    ImGui::Separator();
+    ImGui::TextUnformatted("Heap");
+    Table("##Heap", "Tag", [](auto Row) {
+        for (uint32_t t = 0; t < (uint32_t)MemoryTag::Count; t++)
+            Row(MemoryTracker::GetTagName((MemoryTag)t), MemoryTracker::GetHeapUsage((MemoryTag)t));
+        Row("Total", MemoryTracker::GetHeapTotal());
+        });
+
+    ImGui::Separator();
+    ImGui::TextUnformatted("GPU (estimated)");
+    Table("##Gpu", "Kind", [](auto Row) {
+        for (uint32_t k = 0; k < (uint32_t)GpuMemoryKind::Count; k++)
+            Row(MemoryTracker::GetGpuKindName((GpuMemoryKind)k), MemoryTracker::GetGpuUsage((GpuMemoryKind)k));
+        Row("Total", MemoryTracker::GetGpuTotal());
+        });
+
+    ImGui::End();
+}
+
 int main() {
+    // cold start: main() to the first presented frame, and to the first frame with
+    // every shader linked (shaders build asynchronously, draws skip them until then)
+    const auto startupBegin = std::chrono::steady_clock::now();
+    bool firstFrameLogged = false, startupLogged = false;
+
     auto window = Window::Create({ "Engine3D Editor", 1600, 900 });
     GLFWwindow* native = (GLFWwindow*)window->GetNativeWindow();
 
@@ -526,6 +706,11 @@ int main() {
     ImGui_ImplGlfw_InitForOpenGL(native, true);
     ImGui_ImplOpenGL3_Init("#version 330");
 
+    // Redraw on demand: input (ImGui chains to the window's callbacks), scene edits and
+    // finished asset jobs. Idle, the loop sleeps in glfwWaitEventsTimeout.
+    FrameScheduler scheduler(*window);
+    window->SetEventCallback([&](Event& e) { scheduler.OnEvent(e); });
+
     // Scene + serializer
     Scene scene;
 
@@ -535,9 +720,10 @@ int main() {
     editorCam.SetTransform(glm::vec3(0.0f, 8.0f, 8.0f), -3.1415926f, -0.75f);
 
     // Grid
-    auto gridShader = std::make_shared<Shader>("Assets/Shaders/Grid.shader");
+    auto gridShader = ShaderLibrary::Get().Load("Assets/Shaders/Grid.shader");
     auto gridMat = std::make_shared<Material>(gridShader);
     gridMat->SetTwoSided(true);
+    gridMat->SetBlended(true); // u_Opacity
     auto gridVAO = CreateGridPlaneVAO(100.0f);
 
     // Gizmo renderer
@@ -554,19 +740,24 @@ int main() {
     try {
         // Use whatever shader you normally use for meshes.
         // IMPORTANT: this must exist on disk.
-        markerShader = std::make_shared<Shader>(Engine::Content::Resolve("Shaders/Marker.shader"));
+        markerShader = ShaderLibrary::Get().Load("Shaders/Marker.shader");
 
         markerLight = std::make_shared<Model>(Engine::Content::Resolve("Editor/Markers/light.glb"), markerShader);
         markerSpawn = std::make_shared<Model>(Engine::Content::Resolve("Editor/Markers/spawn.glb"), markerShader);
         markerWarp = std::make_shared<Model>(Engine::Content::Resolve("Editor/Markers/warp.glb"), markerShader);
         
+        // model materials are interned (all three markers share one), so each marker
+        // gets a recoloured copy instead of editing the shared one
         auto SetupMarkerModel = [&](const std::shared_ptr<Model>& m, const glm::vec4& color) {
             if (!m) return;
-            for (const auto& sm : m->GetSubMeshes()) {
-                if (sm.MaterialPtr) {
-                    sm.MaterialPtr->SetColor(color);
-                    sm.MaterialPtr->SetTwoSided(true);
-                }
+            for (size_t i = 0; i < m->GetSubMeshes().size(); i++) {
+                const auto& shared = m->GetSubMeshes()[i].MaterialPtr;
+                if (!shared) continue;
+
+                Material material(*shared);
+                material.SetColor(color);
+                material.SetTwoSided(true);
+                m->SetMaterial(i, Material::Intern(material));
             }
             };
 
@@ -598,6 +789,10 @@ int main() {
     glm::vec3 dragStartRotation{ 0.f };
     glm::vec3 dragStartScale{ 1.f };
 
+    // A click waiting for the next viewport render to include the picking pass
+    bool pendingPick = false;
+    float pendingPickX = 0.f, pendingPickY = 0.f;
+
     auto ClearSelection = [&]() {
         selectedUUID = 0;
         selectedPickID = 0;
@@ -624,7 +819,10 @@ int main() {
 
     auto SelectByPickID = [&](uint32_t pid) {
         if (pid == 0) { ClearSelection(); return; }
-        Entity e = scene.FindEntityByPickID(pid);
+        bool collision = false;
+        Entity e = scene.FindEntityByPickID(pid, &collision);
+        if (collision)
+            std::cout << "[Editor] Pick ID " << pid << " is shared by several entities; select it from the hierarchy\n";
         if (!e) { ClearSelection(); return; }
         selectedUUID = e.GetComponent<IDComponent>().ID;
         SyncSelection();
@@ -655,15 +853,67 @@ int main() {
     // Timing
     auto last = std::chrono::high_resolution_clock::now();
 
+    // What the viewport was last rendered with; the passes are skipped (and the last
+    // composite reused) until one of these changes.
+    struct ViewportState {
+        uint32_t Width = 0, Height = 0;
+        glm::mat4 ViewProjection{ 0.0f };
+        uint64_t SceneVersion = 0;
+        uint32_t SelectedID = 0;
+        GizmoMode Gizmo = GizmoMode::None;
+        AxisConstraint Axis = AxisConstraint::None;
+
+        bool operator==(const ViewportState&) const = default;
+    };
+    ViewportState lastViewport{};
+    bool viewportInvalid = true; // assets changed under the scene
+
+    // reused across frames so the loop doesn't allocate in steady state
+    std::vector<GizmoVertex> lightDebugVerts;
+    lightDebugVerts.reserve(256);
+
+    // shader hot reload
+    auto lastShaderCheck = std::chrono::steady_clock::now();
+    bool shadersWereBuilding = false;
+
     while (!window->ShouldClose()) {
-        glfwPollEvents();
+        const bool drawFrame = scheduler.WaitForFrame(); // polls / waits for events
+
+        if (JobSystem::Get().RunMainThreadJobs() > 0) {
+            viewportInvalid = true;
+            scheduler.RequestRedraw();
+        }
+
+        // Changed .shader files are picked up at most twice a second (the idle timeout
+        // wakes the loop that often). Builds are polled every tick; the old program
+        // keeps drawing until the new one links, so the viewport never waits on one.
+        const auto tick = std::chrono::steady_clock::now();
+        if (tick - lastShaderCheck >= std::chrono::milliseconds(500)) {
+            lastShaderCheck = tick;
+            ShaderLibrary::Get().ReloadChanged();
+            AssetManager::Get().ReloadChangedShaders();
+        }
+        const bool shadersBuilding = ShaderLibrary::Get().PollBuilds() | AssetManager::Get().PollShaderBuilds();
+        if (shadersBuilding) {
+            scheduler.RequestRedraw(); // keep ticking until they link
+        }
+        else if (shadersWereBuilding) {
+            viewportInvalid = true;
+            scheduler.RequestRedraw();
+        }
+        shadersWereBuilding = shadersBuilding;
+
+        if (!drawFrame)
+            continue;
+
+        MemoryScope memScope(MemoryTag::Editor);
 
         auto now = std::chrono::high_resolution_clock::now();
         float dt = std::chrono::duration<float>(now - last).count();
         last = now;
+        if (dt > 0.1f) dt = 0.1f; // first frame after an idle stretch
 
-        std::vector<GizmoVertex> lightDebugVerts;
-        lightDebugVerts.reserve(256);
+        lightDebugVerts.clear();
 
         UpdateWindowTitle(native, sceneMgr.GetDisplayName(), sceneMgr.IsDirty());
 
@@ -776,6 +1026,31 @@ int main() {
 
                     ImGui::EndMenu();
                 }
+
+                if (ImGui::BeginMenu("View")) {
+                    FrameScheduler::Settings fs = scheduler.GetSettings();
+                    bool changed = false;
+
+                    if (ImGui::BeginMenu("Frame Rate Cap")) {
+                        const float caps[] = { 0.0f, 30.0f, 60.0f, 120.0f };
+                        for (float cap : caps) {
+                            std::string label = (cap == 0.0f) ? "VSync" : std::to_string((int)cap) + " FPS";
+                            if (ImGui::MenuItem(label.c_str(), nullptr, fs.TargetFPS == cap)) {
+                                fs.TargetFPS = cap;
+                                changed = true;
+                            }
+                        }
+                        ImGui::EndMenu();
+                    }
+
+                    if (ImGui::MenuItem("Power Saving When Unfocused", nullptr, &fs.PowerSaving))
+                        changed = true;
+
+                    if (changed)
+                        scheduler.SetSettings(fs);
+
+                    ImGui::EndMenu();
+                }
                 ImGui::EndMenuBar();
             }
 
@@ -1125,20 +1400,24 @@ int main() {
             }
 
             if (ImGui::MenuItem("Spawn Point")) {
+                // Replacing the spawn point is one undo step: delete old + create new
+                auto group = std::make_unique<EditorUndo::CommandGroup>("Place Spawn Point");
+
                 // Enforce only one SpawnPoint (delete existing)
                 {
+                    std::vector<Engine::UUID> oldIDs;
                     auto view = scene.Registry().view<IDComponent, SpawnPointComponent>();
-                    if (view.begin() != view.end()) {
-                        // delete first existing spawn point (or all)
-                        auto enttHandle = *view.begin();
-                        Engine::UUID id = view.get<IDComponent>(enttHandle).ID;
+                    for (auto enttHandle : view)
+                        oldIDs.push_back(view.get<IDComponent>(enttHandle).ID);
 
+                    for (Engine::UUID id : oldIDs) {
                         Entity old = scene.FindEntityByUUID(id);
-                        if (old) {
-                            auto snap = EditorUndo::CaptureEntity(old);
-                            cmdStack.Execute(scene, std::make_unique<EditorUndo::DeleteEntityCommand>(snap));
-                            if (selectedUUID == id) ClearSelection();
-                        }
+                        if (!old) continue;
+
+                        auto del = std::make_unique<EditorUndo::DeleteEntityCommand>(EditorUndo::CaptureEntity(scene, old));
+                        del->Redo(scene);
+                        group->Add(std::move(del));
+                        if (selectedUUID == id) ClearSelection();
                     }
                 }
                 Entity e = scene.CreateEntity("SpawnPoint");
@@ -1148,6 +1427,9 @@ int main() {
                 tr.Translation = editorCam.GetPosition() + editorCam.GetForward() * 2.0f;
                 tr.Rotation = EulerFromForward(editorCam.GetForward()); // arrow (-Z) points camera-forward
 
+                group->Add(std::make_unique<EditorUndo::CreateEntityCommand>(EditorUndo::CaptureEntity(scene, e)));
+                cmdStack.Commit(std::move(group));
+
                 sceneMgr.MarkDirty();
             }
 
@@ -1208,7 +1490,7 @@ int main() {
             if (requestDeleteUUID != 0) {
                 Entity e = scene.FindEntityByUUID(requestDeleteUUID);
                 if (e) {
-                    auto snap = EditorUndo::CaptureEntity(e);
+                    auto snap = EditorUndo::CaptureEntity(scene, e);
                     cmdStack.Execute(scene, std::make_unique<EditorUndo::DeleteEntityCommand>(snap));
                     sceneMgr.MarkDirty();
 
@@ -1297,8 +1579,8 @@ int main() {
                 static char TagBuf[128];
                 std::snprintf(TagBuf, sizeof(TagBuf), "%s", tag.c_str());
                 if (ImGui::InputText("Tag", TagBuf, sizeof(TagBuf))) {
-                    tag = TagBuf;
-                    sceneMgr.MarkDirty();
+                    scene.SetEntityTag(selectedEntity, TagBuf);
+                    sceneMgr.MarkDirty(selectedEntity);
                 }
 
                 ImGui::Separator();
@@ -1328,7 +1610,7 @@ int main() {
                             bool selected = (s == sw.TargetScene);
                             if (ImGui::Selectable(s.c_str(), selected)) {
                                 sw.TargetScene = s;
-                                sceneMgr.MarkDirty();
+                                sceneMgr.MarkDirty(selectedEntity);
                             }
                             if (selected) ImGui::SetItemDefaultFocus();
                         }
@@ -1340,19 +1622,19 @@ int main() {
                     std::snprintf(spawnTagBuf, sizeof(spawnTagBuf), "%s", sw.TargetSpawnTag.c_str());
                     if (ImGui::InputText("To Spawn Tag", spawnTagBuf, sizeof(spawnTagBuf))) {
                         sw.TargetSpawnTag = spawnTagBuf;
-                        sceneMgr.MarkDirty();
+                        sceneMgr.MarkDirty(selectedEntity);
                     }
 
                     static char warpTagBuf[128];
                     std::snprintf(warpTagBuf, sizeof(warpTagBuf), "%s", sw.TargetWarpTag.c_str());
                     if (ImGui::InputText("To Warp Tag (Optional)", warpTagBuf, sizeof(warpTagBuf))) {
                         sw.TargetWarpTag = warpTagBuf;
-                        sceneMgr.MarkDirty();
+                        sceneMgr.MarkDirty(selectedEntity);
                     }
 
                     // Trigger radius
                     if (ImGui::DragFloat("Trigger Radius", &sw.TriggerRadius, 0.05f, 0.1f, 50.0f, "%.2f m")) {
-                        sceneMgr.MarkDirty();
+                        sceneMgr.MarkDirty(selectedEntity);
                     }
                 }
 
@@ -1367,7 +1649,7 @@ int main() {
                     auto after = EditorUndo::CaptureTransform(selectedEntity);
                     if (!EditorUndo::TransformEqual(inspectorBefore, after)) {
                         cmdStack.Commit(std::make_unique<EditorUndo::TransformCommand>(selectedUUID, inspectorBefore, after));
-                        sceneMgr.MarkDirty();
+                        sceneMgr.MarkDirty(selectedEntity);
                     }
                 }
 
@@ -1388,7 +1670,7 @@ int main() {
                     auto after = EditorUndo::CaptureTransform(selectedEntity);
                     if (!EditorUndo::TransformEqual(inspectorBefore, after)) {
                         cmdStack.Commit(std::make_unique<EditorUndo::TransformCommand>(selectedUUID, inspectorBefore, after));
-                        sceneMgr.MarkDirty();
+                        sceneMgr.MarkDirty(selectedEntity);
                     }
                 }
 
@@ -1399,7 +1681,7 @@ int main() {
                     auto after = EditorUndo::CaptureTransform(selectedEntity);
                     if (!EditorUndo::TransformEqual(inspectorBefore, after)) {
                         cmdStack.Commit(std::make_unique<EditorUndo::TransformCommand>(selectedUUID, inspectorBefore, after));
-                        sceneMgr.MarkDirty();
+                        sceneMgr.MarkDirty(selectedEntity);
                     }
                 }
 
@@ -1419,6 +1701,10 @@ int main() {
             ImGui::End();
         }
 
+        if (DrawRendererStatsPanel(pipeline))
+            viewportInvalid = true;
+        DrawMemoryPanel();
+
         // --- Viewport ---
         ImGui::Begin("Viewport");
 
@@ -1445,7 +1731,7 @@ int main() {
             if (ImGui::IsKeyPressed(ImGuiKey_Z)) axis = (axis == AxisConstraint::Z) ? AxisConstraint::None : AxisConstraint::Z;
 
             if (ImGui::IsKeyPressed(ImGuiKey_Delete) && selectedEntity) {
-                auto snap = EditorUndo::CaptureEntity(selectedEntity);
+                auto snap = EditorUndo::CaptureEntity(scene, selectedEntity);
                 cmdStack.Execute(scene, std::make_unique<EditorUndo::DeleteEntityCommand>(snap));
                 sceneMgr.MarkDirty();
                 ClearSelection();
@@ -1468,213 +1754,233 @@ int main() {
         editorCam.OnUpdate(dt);
         glfwSetInputMode(native, GLFW_CURSOR, cameraControl ? GLFW_CURSOR_DISABLED : GLFW_CURSOR_NORMAL);
 
-        // Render passes
-        pipeline.BeginPickingPass(vw, vh, editorCam.GetCamera());
-        scene.OnRenderPicking(editorCam.GetCamera(), pipeline.GetIDMaterial());
-        pipeline.EndPickingPass();
-
-        // --- Build CSM + render shadow maps (Editor) ---
-        static constexpr int CSM_CASCADES = 4;
-        static constexpr uint32_t SHADOW_SIZE = 2048;
-
-        glm::vec3 lightDir, lightColor;
-        bool hasLight = scene.GetMainDirectionalLight(lightDir, lightColor);
-        if (!hasLight) { lightDir = { 0.4f,0.8f,-0.3f }; lightColor = { 1,1,1 }; }
-
-        glm::mat4 lightMats[CSM_CASCADES];
-        float splits[CSM_CASCADES] = { 15.0f, 40.0f, 90.0f, 200.0f };
+        // held keys don't send events; keep drawing while flying or dragging
+        scheduler.SetContinuous(cameraControl || dragging || statusTimer > 0.0f);
+
+        // In-place edits (gizmo drag, inspector fields) don't bump the scene version until
+        // they're committed, so an active widget or drag always re-renders.
+        const ViewportState viewportState{ vw, vh, editorCam.GetCamera().GetViewProjection(),
+            scene.GetChangeVersion(), selectedPickID, gizmo, axis };
+        const bool renderViewport = viewportInvalid || dragging || ImGui::IsAnyItemActive()
+            || viewportState != lastViewport;
+
+        if (renderViewport) {
+            lastViewport = viewportState;
+            viewportInvalid = false;
+
+            // Render passes: declared here, run (and culled) by EndFrame. Picking only
+            // runs when a click asked for it.
+            pipeline.BeginFrame(vw, vh);
+            pipeline.AddPickingPass(editorCam.GetCamera(), [&]() {
+                scene.OnRenderPicking(editorCam.GetCamera(), pipeline.GetIDMaterial());
+                });
 
-        // clamp last split to camera far
-        const PerspectiveCamera& pc = editorCam.GetCamera();
-        splits[CSM_CASCADES - 1] = std::min(splits[CSM_CASCADES - 1], pc.GetFarClip());
+            // --- Build CSM + render shadow maps (Editor) ---
+            static constexpr int CSM_CASCADES = 4;
+            static constexpr uint32_t SHADOW_SIZE = 2048;
 
-        for (int i = 0; i < CSM_CASCADES; i++) {
-            float sliceNear = (i == 0) ? pc.GetNearClip() : splits[i - 1];
-            float sliceFar = splits[i];
+            glm::vec3 lightDir, lightColor;
+            bool hasLight = scene.GetMainDirectionalLight(lightDir, lightColor);
+            if (!hasLight) { lightDir = { 0.4f,0.8f,-0.3f }; lightColor = { 1,1,1 }; }
 
-            lightMats[i] = BuildCascadeLightMatrix(pc, lightDir, sliceNear, sliceFar, SHADOW_SIZE);
-        }
+            glm::mat4 lightMats[CSM_CASCADES];
+            float splits[CSM_CASCADES] = { 15.0f, 40.0f, 90.0f, 200.0f };
 
-        for (int i = 0; i < CSM_CASCADES; i++) {
-            pipeline.BeginShadowPass(SHADOW_SIZE, lightMats[i], (uint32_t)i, CSM_CASCADES);
-            scene.OnRenderShadow(pipeline.GetShadowDepthMaterial());
-            pipeline.EndShadowPass();
-        }
+            // clamp last split to camera far
+            const PerspectiveCamera& pc = editorCam.GetCamera();
+            splits[CSM_CASCADES - 1] = std::min(splits[CSM_CASCADES - 1], pc.GetFarClip());
 
-        // IMPORTANT: bind the result for Lit.glsl
-        Renderer::SetCSMShadowMap(pipeline.GetShadowDepthTextureArray(), lightMats, splits, CSM_CASCADES);
+            for (int i = 0; i < CSM_CASCADES; i++) {
+                float sliceNear = (i == 0) ? pc.GetNearClip() : splits[i - 1];
+                float sliceFar = splits[i];
 
-        pipeline.BeginScenePass(vw, vh, editorCam.GetCamera());
-
-        // Grid
-        gridShader->Bind();
-        gridShader->SetFloat("u_GridScale", 1.0f);
-        gridShader->SetFloat3("u_GridColor", 0.45f, 0.45f, 0.45f);
-        gridShader->SetFloat3("u_BaseColor", 0.12f, 0.12f, 0.12f);
-        gridShader->SetFloat("u_Opacity", 0.30f);
-        Renderer::Submit(gridMat, gridVAO, glm::mat4(1.0f));
-
-        scene.OnUpdate(dt);
-        scene.OnRender(editorCam.GetCamera());
+                lightMats[i] = BuildCascadeLightMatrix(pc, lightDir, sliceNear, sliceFar, SHADOW_SIZE);
+            }
 
-        pipeline.EndScenePass();
-        // ---- Editor Markers (3D models, editor-only) ----
-        if (markerShader && (markerLight || markerSpawn || markerWarp)) {
-            pipeline.BeginOverlayPass();
+            // hands the result to Lit.glsl (SetCSMShadowMap) when it runs
+            pipeline.AddShadowPass(SHADOW_SIZE, lightMats, splits, CSM_CASCADES, [&](uint32_t) {
+                scene.OnRenderShadow(pipeline.GetShadowDepthMaterial());
+                });
 
-            glEnable(GL_DEPTH_TEST);     // 3D markers should depth-test
-            glEnable(GL_BLEND);
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            pipeline.AddScenePass(editorCam.GetCamera(), [&]() {
+                // Grid
+                gridShader->Bind();
+                gridShader->SetFloat("u_GridScale", 1.0f);
+                gridShader->SetFloat3("u_GridColor", 0.45f, 0.45f, 0.45f);
+                gridShader->SetFloat3("u_BaseColor", 0.12f, 0.12f, 0.12f);
+                gridShader->SetFloat("u_Opacity", 0.30f);
+                Renderer::Submit(gridMat, gridVAO, glm::mat4(1.0f));
+
+                scene.OnUpdate(dt);
+                scene.OnRender(editorCam.GetCamera());
+                });
 
-            Renderer::BeginScene(editorCam.GetCamera());
+            pipeline.AddOverlayPass([&]() {
+                // ---- Editor Markers (3D models, editor-only) ----
+                if (markerShader && (markerLight || markerSpawn || markerWarp)) {
+                    glEnable(GL_DEPTH_TEST);     // 3D markers should depth-test
+                    glEnable(GL_BLEND);
+                    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-            auto SubmitModel = [&](const std::shared_ptr<Model>& m, const glm::mat4& xform) {
-                if (!m) return;
-                for (const auto& sm : m->GetSubMeshes()) {
-                    if (!sm.MeshPtr || !sm.MaterialPtr) continue;
-                    Renderer::Submit(sm.MaterialPtr, sm.MeshPtr->GetVertexArray(), xform, 0);
-                }
-                };
+                    Renderer::BeginScene(editorCam.GetCamera());
 
-            auto& reg = scene.Registry();
-
-            // Light marker
-            {
-                auto view = reg.view<TransformComponent, DirectionalLightComponent>();
-                view.each([&](auto, TransformComponent& tc, DirectionalLightComponent&) {
-
-                    // 1) Compute the same direction your runtime uses (from tc.Rotation)
-                    glm::vec3 dir{
-                        cosf(tc.Rotation.x) * sinf(tc.Rotation.y),
-                        sinf(tc.Rotation.x),
-                        -cosf(tc.Rotation.x) * cosf(tc.Rotation.y)
-                    };
-                    dir = glm::normalize(dir);
-
-                    // 2) Build a marker transform that points along that direction
-                    float yaw = -tc.Rotation.y;
-                    float pitch = tc.Rotation.x;
-
-                    glm::mat4 markerWorld =
-                        glm::translate(glm::mat4(1.0f), tc.Translation) *
-                        glm::rotate(glm::mat4(1.0f), yaw, glm::vec3(0, 1, 0)) *
-                        glm::rotate(glm::mat4(1.0f), pitch, glm::vec3(1, 0, 0));
-
-
-                    // 3) Apply model-axis fix (markerFix) and scale
-                    glm::mat4 xform =
-                        markerWorld *
-                        markerFix *
-                        glm::scale(glm::mat4(1.0f), glm::vec3(0.75f));
-
-                    SubmitModel(markerLight, xform);
-
-                    // 4) Debug arrow line (TRUE light direction)
-                    AddArrow(lightDebugVerts, tc.Translation, dir, glm::vec3(1, 1, 0), 3.0f, 0.5f, 0.2f);
-                    glm::mat3 R = glm::mat3(xform);
-
-// GLM matrices are column-major: R[0],R[1],R[2] are the basis vectors in world space
-glm::vec3 worldX = glm::normalize(glm::vec3(R[0]));
-glm::vec3 worldY = glm::normalize(glm::vec3(R[1]));
-glm::vec3 worldZ = glm::normalize(glm::vec3(R[2]));
-
-// draw axes from the marker origin
-AddArrow(lightDebugVerts, tc.Translation, worldX, glm::vec3(1,0,0), 2.0f, 0.3f, 0.15f); // X red
-AddArrow(lightDebugVerts, tc.Translation, worldY, glm::vec3(0,1,0), 2.0f, 0.3f, 0.15f); // Y green
-AddArrow(lightDebugVerts, tc.Translation, worldZ, glm::vec3(0,0,1), 2.0f, 0.3f, 0.15f); // Z blue
-AddArrow(lightDebugVerts, tc.Translation, dir,    glm::vec3(1,1,0), 3.0f, 0.5f, 0.2f);   // Light dir yellow
-                    });
-            }
+                    auto SubmitModel = [&](const std::shared_ptr<Model>& m, const glm::mat4& xform) {
+                        if (!m) return;
+                        for (const auto& sm : m->GetSubMeshes()) {
+                            if (!sm.MeshPtr || !sm.MaterialPtr) continue;
+                            Renderer::Submit(sm.MaterialPtr, sm.MeshPtr->GetVertexArray(), xform, 0);
+                        }
+                        };
+
+                    auto& reg = scene.Registry();
+
+                    // Light marker
+                    {
+                        auto view = reg.view<TransformComponent, DirectionalLightComponent>();
+                        view.each([&](auto, TransformComponent& tc, DirectionalLightComponent&) {
+
+                            // 1) Compute the same direction your runtime uses (from tc.Rotation)
+                            glm::vec3 dir{
+                                cosf(tc.Rotation.x) * sinf(tc.Rotation.y),
+                                sinf(tc.Rotation.x),
+                                -cosf(tc.Rotation.x) * cosf(tc.Rotation.y)
+                            };
+                            dir = glm::normalize(dir);
+
+                            // 2) Build a marker transform that points along that direction
+                            float yaw = -tc.Rotation.y;
+                            float pitch = tc.Rotation.x;
+
+                            glm::mat4 markerWorld =
+                                glm::translate(glm::mat4(1.0f), tc.Translation) *
+                                glm::rotate(glm::mat4(1.0f), yaw, glm::vec3(0, 1, 0)) *
+                                glm::rotate(glm::mat4(1.0f), pitch, glm::vec3(1, 0, 0));
+
+
+                            // 3) Apply model-axis fix (markerFix) and scale
+                            glm::mat4 xform =
+                                markerWorld *
+                                markerFix *
+                                glm::scale(glm::mat4(1.0f), glm::vec3(0.75f));
+
+                            SubmitModel(markerLight, xform);
+
+                            // 4) Debug arrow line (TRUE light direction)
+                            AddArrow(lightDebugVerts, tc.Translation, dir, glm::vec3(1, 1, 0), 3.0f, 0.5f, 0.2f);
+                            glm::mat3 R = glm::mat3(xform);
+
+        // GLM matrices are column-major: R[0],R[1],R[2] are the basis vectors in world space
+        glm::vec3 worldX = glm::normalize(glm::vec3(R[0]));
+        glm::vec3 worldY = glm::normalize(glm::vec3(R[1]));
+        glm::vec3 worldZ = glm::normalize(glm::vec3(R[2]));
+
+        // draw axes from the marker origin
+        AddArrow(lightDebugVerts, tc.Translation, worldX, glm::vec3(1,0,0), 2.0f, 0.3f, 0.15f); // X red
+        AddArrow(lightDebugVerts, tc.Translation, worldY, glm::vec3(0,1,0), 2.0f, 0.3f, 0.15f); // Y green
+        AddArrow(lightDebugVerts, tc.Translation, worldZ, glm::vec3(0,0,1), 2.0f, 0.3f, 0.15f); // Z blue
+        AddArrow(lightDebugVerts, tc.Translation, dir,    glm::vec3(1,1,0), 3.0f, 0.5f, 0.2f);   // Light dir yellow
+                            });
+                    }
 
-            // Spawn marker
-            {
-                auto view = reg.view<TransformComponent, SpawnPointComponent>();
-                view.each([&](auto, TransformComponent& tc, SpawnPointComponent&) {
-                    glm::mat4 xform =
-                        tc.GetTransform()
-                        * markerFix
-                        * glm::scale(glm::mat4(1.0f), glm::vec3(0.75f));
-                    SubmitModel(markerSpawn, xform);
-                    });
-            }
+                    // Spawn marker
+                    {
+                        auto view = reg.view<TransformComponent, SpawnPointComponent>();
+                        view.each([&](auto, TransformComponent& tc, SpawnPointComponent&) {
+                            glm::mat4 xform =
+                                tc.GetTransform()
+                                * markerFix
+                                * glm::scale(glm::mat4(1.0f), glm::vec3(0.75f));
+                            SubmitModel(markerSpawn, xform);
+                            });
+                    }
 
-            // Warp marker
-            {
-                auto view = reg.view<TransformComponent, SceneWarpComponent>();
-                view.each([&](auto, TransformComponent& tc, SceneWarpComponent&) {
-                    glm::mat4 xform =
-                        tc.GetTransform()
-                        * markerFix
-                        * glm::scale(glm::mat4(1.0f), glm::vec3(0.75f));
-                    SubmitModel(markerWarp, xform);
-                    });
-            }
+                    // Warp marker
+                    {
+                        auto view = reg.view<TransformComponent, SceneWarpComponent>();
+                        view.each([&](auto, TransformComponent& tc, SceneWarpComponent&) {
+                            glm::mat4 xform =
+                                tc.GetTransform()
+                                * markerFix
+                                * glm::scale(glm::mat4(1.0f), glm::vec3(0.75f));
+                            SubmitModel(markerWarp, xform);
+                            });
+                    }
 
-            Renderer::EndScene();
+                    Renderer::EndScene();
 
-            // Draw light debug arrows (line shader)
-            if (!lightDebugVerts.empty()) {
-                // Choose whether you want them depth-tested:
-                glEnable(GL_DEPTH_TEST);    // ON = arrows can be hidden behind geometry
-                // glDisable(GL_DEPTH_TEST); // OFF = always visible
+                    // Draw light debug arrows (line shader)
+                    if (!lightDebugVerts.empty()) {
+                        // Choose whether you want them depth-tested:
+                        glEnable(GL_DEPTH_TEST);    // ON = arrows can be hidden behind geometry
+                        // glDisable(GL_DEPTH_TEST); // OFF = always visible
 
-                glEnable(GL_BLEND);
-                glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+                        glEnable(GL_BLEND);
+                        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-                gizmoRenderer.Draw(editorCam.GetCamera(), lightDebugVerts, 1.0f);
-            }
+                        gizmoRenderer.Draw(editorCam.GetCamera(), lightDebugVerts, 1.0f);
+                    }
 
-            glDisable(GL_BLEND);
-            pipeline.EndOverlayPass();
-        }
+                    glDisable(GL_BLEND);
+                }
 
-        // Gizmo visuals
-        if (selectedEntity && gizmo != GizmoMode::None) {
-            std::vector<GizmoVertex> verts;
-            verts.reserve(2048);
+                // Gizmo visuals
+                if (selectedEntity && gizmo != GizmoMode::None) {
+                    std::vector<GizmoVertex> verts;
+                    verts.reserve(2048);
 
-            glm::vec3 p = selectedEntity.GetComponent<TransformComponent>().Translation;
-            float dist = glm::length(p - editorCam.GetPosition());
-            if (dist < 1.0f) dist = 1.0f;
-            float g = std::max(0.8f, dist * 0.15f);
+                    glm::vec3 p = selectedEntity.GetComponent<TransformComponent>().Translation;
+                    float dist = glm::length(p - editorCam.GetPosition());
+                    if (dist < 1.0f) dist = 1.0f;
+                    float g = std::max(0.8f, dist * 0.15f);
 
-            glm::vec3 colX = (axis == AxisConstraint::X) ? glm::vec3(1, 1, 0) : glm::vec3(1, 0.2f, 0.2f);
-            glm::vec3 colY = (axis == AxisConstraint::Y) ? glm::vec3(1, 1, 0) : glm::vec3(0.2f, 1, 0.2f);
-            glm::vec3 colZ = (axis == AxisConstraint::Z) ? glm::vec3(1, 1, 0) : glm::vec3(0.2f, 0.6f, 1);
+                    glm::vec3 colX = (axis == AxisConstraint::X) ? glm::vec3(1, 1, 0) : glm::vec3(1, 0.2f, 0.2f);
+                    glm::vec3 colY = (axis == AxisConstraint::Y) ? glm::vec3(1, 1, 0) : glm::vec3(0.2f, 1, 0.2f);
+                    glm::vec3 colZ = (axis == AxisConstraint::Z) ? glm::vec3(1, 1, 0) : glm::vec3(0.2f, 0.6f, 1);
 
-            if (gizmo == GizmoMode::Translate) {
-                AddArrow(verts, p, { 1,0,0 }, colX, g, g * 0.18f, g * 0.07f);
-                AddArrow(verts, p, { 0,1,0 }, colY, g, g * 0.18f, g * 0.07f);
-                AddArrow(verts, p, { 0,0,1 }, colZ, g, g * 0.18f, g * 0.07f);
-            }
-            else if (gizmo == GizmoMode::Rotate) {
-                AddCircle(verts, p, { 1,0,0 }, colX, g * 0.85f, 64);
-                AddCircle(verts, p, { 0,1,0 }, colY, g * 0.85f, 64);
-                AddCircle(verts, p, { 0,0,1 }, colZ, g * 0.85f, 64);
-            }
-            else if (gizmo == GizmoMode::Scale) {
-                AddLine(verts, p, p + glm::vec3(g, 0, 0), colX);
-                AddLine(verts, p, p + glm::vec3(0, g, 0), colY);
-                AddLine(verts, p, p + glm::vec3(0, 0, g), colZ);
+                    if (gizmo == GizmoMode::Translate) {
+                        AddArrow(verts, p, { 1,0,0 }, colX, g, g * 0.18f, g * 0.07f);
+                        AddArrow(verts, p, { 0,1,0 }, colY, g, g * 0.18f, g * 0.07f);
+                        AddArrow(verts, p, { 0,0,1 }, colZ, g, g * 0.18f, g * 0.07f);
+                    }
+                    else if (gizmo == GizmoMode::Rotate) {
+                        AddCircle(verts, p, { 1,0,0 }, colX, g * 0.85f, 64);
+                        AddCircle(verts, p, { 0,1,0 }, colY, g * 0.85f, 64);
+                        AddCircle(verts, p, { 0,0,1 }, colZ, g * 0.85f, 64);
+                    }
+                    else if (gizmo == GizmoMode::Scale) {
+                        AddLine(verts, p, p + glm::vec3(g, 0, 0), colX);
+                        AddLine(verts, p, p + glm::vec3(0, g, 0), colY);
+                        AddLine(verts, p, p + glm::vec3(0, 0, g), colZ);
+
+                        AddBox(verts, p + glm::vec3(g, 0, 0), { 0,1,0 }, { 0,0,1 }, colX, g * 0.05f);
+                        AddBox(verts, p + glm::vec3(0, g, 0), { 1,0,0 }, { 0,0,1 }, colY, g * 0.05f);
+                        AddBox(verts, p + glm::vec3(0, 0, g), { 1,0,0 }, { 0,1,0 }, colZ, g * 0.05f);
+                    }
 
-                AddBox(verts, p + glm::vec3(g, 0, 0), { 0,1,0 }, { 0,0,1 }, colX, g * 0.05f);
-                AddBox(verts, p + glm::vec3(0, g, 0), { 1,0,0 }, { 0,0,1 }, colY, g * 0.05f);
-                AddBox(verts, p + glm::vec3(0, 0, g), { 1,0,0 }, { 0,1,0 }, colZ, g * 0.05f);
-            }
+                    glDisable(GL_DEPTH_TEST);
+                    glEnable(GL_BLEND);
+                    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-            glDisable(GL_DEPTH_TEST);
-            glEnable(GL_BLEND);
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+                    gizmoRenderer.Draw(editorCam.GetCamera(), verts, 1.0f);
 
-            gizmoRenderer.Draw(editorCam.GetCamera(), verts, 1.0f);
+                    glEnable(GL_DEPTH_TEST);
+                }
+                });
 
-            glEnable(GL_DEPTH_TEST);
+            pipeline.AddComposePass();
+            pipeline.EndFrame();
+            Renderer::EndStatsFrame();
         }
 
-        pipeline.Compose();
+        if (pendingPick && pipeline.HasPickingResult()) {
+            pendingPick = false;
+            SelectByPickID(pipeline.ReadPickingID((uint32_t)pendingPickX, (uint32_t)pendingPickY));
+        }
 
+        // The composite covers the lower-left part of its (size-bucketed) texture
         ImTextureID tex = (ImTextureID)(intptr_t)pipeline.GetCompositeTexture();
-        ImGui::Image(tex, vpSize, ImVec2(0, 1), ImVec2(1, 0));
+        const glm::vec2 uvScale = pipeline.GetCompositeUVScale();
+        ImGui::Image(tex, vpSize, ImVec2(0, uvScale.y), ImVec2(uvScale.x, 0));
         // Accept model drop onto viewport -> instantiate entity
         if (ImGui::BeginDragDropTarget()) {
             if (const ImGuiPayload* p = ImGui::AcceptDragDropPayload("ASSET_MODEL_HANDLE")) {
@@ -1724,9 +2030,17 @@ AddArrow(lightDebugVerts, tc.Translation, dir,    glm::vec3(1,1,0), 3.0f, 0.5f,
                 dragStartRotation = tc.Rotation;
                 dragStartScale = tc.Scale;
             }
+            else if (pipeline.HasPickingResult()) {
+                SelectByPickID(pipeline.ReadPickingID((uint32_t)mx, (uint32_t)my));
+            }
             else {
-                uint32_t pid = pipeline.ReadPickingID((uint32_t)mx, (uint32_t)my);
-                SelectByPickID(pid);
+                // IDs are only rendered on request: pick once the next frame has them
+                pendingPick = true;
+                pendingPickX = mx;
+                pendingPickY = my;
+                pipeline.RequestPicking();
+                viewportInvalid = true;
+                scheduler.RequestRedraw();
             }
         }
 
@@ -1832,7 +2146,7 @@ AddArrow(lightDebugVerts, tc.Translation, dir,    glm::vec3(1,1,0), 3.0f, 0.5f,
 
             if (!EditorUndo::TransformEqual(before, after)) {
                 cmdStack.Commit(std::make_unique<EditorUndo::TransformCommand>(selectedUUID, before, after));
-                sceneMgr.MarkDirty();
+                sceneMgr.MarkDirty(selectedEntity);
             }
 
             dragging = false;
@@ -1855,6 +2169,23 @@ AddArrow(lightDebugVerts, tc.Translation, dir,    glm::vec3(1,1,0), 3.0f, 0.5f,
 
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
         glfwSwapBuffers(native);
+
+        if (!startupLogged) {
+            const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startupBegin).count();
+            if (!firstFrameLogged) {
+                std::cout << "[Editor] First frame " << (int)ms << " ms after start\n";
+                firstFrameLogged = true;
+            }
+            if (!shadersBuilding) {
+                const auto& sc = ShaderCache::GetStats();
+                std::cout << "[Editor] Shaders ready " << (int)ms << " ms after start (cache hits=" << sc.Hits
+                    << " misses=" << sc.Misses << ")\n";
+                startupLogged = true;
+            }
+        }
+
+        AssetManager::Get().OnFrameEnd();
+        MemoryTracker::EndFrame();
     }
 
     // Shutdown
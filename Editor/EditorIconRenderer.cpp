@@ -5,6 +5,7 @@
 #include <Engine/Scene/Scene.h>
 #include <Engine/Scene/Components.h>
 #include <Engine/Renderer/Shader.h>
+#include <Engine/Renderer/ShaderLibrary.h>
 #include <Engine/Renderer/Material.h>
 #include <Engine/Renderer/Texture2D.h>
 #include <Engine/Renderer/VertexArray.h>
@@ -47,7 +48,7 @@ void EditorIconRenderer::Init() {
     if (m_Shader) return;
 
     // Put this shader in EngineContent/Shaders/Icon.shader
-    m_Shader = std::make_shared<Shader>(Content::Resolve("Shaders/Icon.shader"));
+    m_Shader = ShaderLibrary::Get().Load("Shaders/Icon.shader");
     m_Quad = CreateUnitQuadVAO();
 }
 
@@ -94,9 +95,10 @@ void EditorIconRenderer::Draw(Scene& scene, CameraController& cam, uint32_t /*se
         auto tex = GetIcon((int)ic.Type);
         if (!tex) return;
 
-        auto mat = std::make_shared<Material>(m_Shader);
-        mat->SetTwoSided(true);
-        mat->SetTexture(0, tex);
+        Material icon(m_Shader);
+        icon.SetTwoSided(true);
+        icon.SetTexture(0, tex);
+        auto mat = Material::Intern(icon); // same instance every frame
 
         float s = ic.Size;
         glm::mat4 M(1.0f);
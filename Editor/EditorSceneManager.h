@@ -23,6 +23,9 @@ public:
     const std::string& GetCurrentPath() const { return m_CurrentPath; }
     bool IsDirty() const { return m_Dirty; }
     void MarkDirty() { m_Dirty = true; }
+    // For edits written straight into a component (inspector fields, gizmo):
+    // the scene only sees emplace/patch/destroy on its own.
+    void MarkDirty(Engine::Entity entity) { m_Dirty = true; m_Scene.MarkEntityDirty(entity); }
     void MarkClean() { m_Dirty = false; }
 
     std::string GetDisplayName() const {
@@ -41,7 +44,7 @@ public:
             if (ec) break;
             if (!it.is_regular_file()) continue;
             auto p = it.path();
-            if (p.extension() == ".scene") {
+            if (p.extension() == ".scene" || p.extension() == ".sceneb") {
                 // store as generic string with forward slashes (portable)
                 m_Scenes.push_back(p.generic_string());
             }
@@ -100,7 +103,9 @@ public:
 
         const std::string path = EnsureSceneExt(m_CurrentPath);
 
-        const bool ok = m_Serializer.Serialize(path);
+        // only the entities touched since the last save; the serializer falls back
+        // to a full write when the file on disk isn't the one it loaded
+        const bool ok = m_Serializer.SerializeDelta(path);
         if (!ok) {
             // keep dirty, keep current path (so user can retry / fix)
             m_Dirty = true;
@@ -5,6 +5,8 @@
 #include <memory>
 #include <unordered_map>
 #include <string>
+#include <vector>
+#include <cstdint>
 
 namespace Engine {
 
@@ -21,12 +23,29 @@ namespace Engine {
 
         void SaveRegistry() { m_Registry.Save(); }
         void LoadRegistry() { m_Registry.Load(); }
+        // Registry changes are batched; this writes them if there are any (also done in OnFrameEnd).
+        void FlushRegistry() { m_Registry.SaveIfDirty(); }
 
         // Import / Register + load into cache
         AssetHandle LoadShader(const std::string& path);
         AssetHandle LoadModel(const std::string& path, AssetHandle shaderHandle);
         AssetHandle LoadTexture2D(const std::string& path);
 
+        // Batch form of LoadShader + LoadModel for scene loads. Each unique path is
+        // resolved once, uncached models are imported (Assimp + texture decode) on
+        // worker threads, and the GL uploads run here on the calling thread as the
+        // imports finish. Returns one handle per request, InvalidAssetHandle on failure.
+        struct ModelLoadRequest {
+            std::string ModelPath;
+            std::string ShaderPath;
+        };
+        std::vector<AssetHandle> LoadModels(const std::vector<ModelLoadRequest>& requests);
+
+        // Run Model::PackTextures on imported models (texture array pages). On by
+        // default; applies to models loaded after the call.
+        void SetPackModelTextures(bool enabled) { m_PackModelTextures = enabled; }
+        bool GetPackModelTextures() const { return m_PackModelTextures; }
+
         // Resolve handles -> live objects
         std::shared_ptr<Shader> GetShader(AssetHandle shaderHandle);
         std::shared_ptr<Model> GetModel(AssetHandle modelHandle);
@@ -40,15 +59,61 @@ namespace Engine {
         ModelInfo GetModelInfo(AssetHandle modelHandle) const;
         std::string GetShaderPath(AssetHandle shaderHandle) const;
 
+        // --- Shader builds ---
+        // Shaders load asynchronously (Shader::CreateAsync) and draws skip them until
+        // they link. Both calls run on the GL thread.
+        // Starts a rebuild of every cached shader whose file changed; returns how many.
+        uint32_t ReloadChangedShaders();
+        // Advances pending builds and reloads; true while any is still building.
+        bool PollShaderBuilds();
+
+        // --- Residency ---
+        // Budget for resident GPU data (model buffers + textures). 0 = unlimited.
+        void SetMemoryBudget(size_t bytes) { m_MemoryBudget = bytes; }
+        size_t GetMemoryBudget() const { return m_MemoryBudget; }
+
+        // Assets untouched for this many frames become eviction candidates.
+        void SetEvictionGraceFrames(uint32_t frames) { m_EvictionGraceFrames = frames; }
+
+        // Call once per frame AFTER the frame's draw list has been flushed.
+        // Advances the frame stamp and evicts LRU assets while over budget.
+        void OnFrameEnd();
+
+        struct MemoryStats {
+            size_t ModelBytes = 0;
+            size_t TextureBytes = 0;
+            uint32_t ModelCount = 0;
+            uint32_t TextureCount = 0;
+            uint32_t ShaderCount = 0;
+            uint32_t EvictedCount = 0; // total since startup
+        };
+        const MemoryStats& GetMemoryStats() const { return m_Stats; }
+
     private:
         AssetManager();
+        ~AssetManager();
+
+        template<typename T>
+        struct CacheEntry {
+            std::shared_ptr<T> Asset;
+            size_t SizeBytes = 0;
+            uint64_t LastUsedFrame = 0;
+        };
+
+        void EvictUntilWithinBudget();
 
     private:
         AssetRegistry m_Registry;
 
-        std::unordered_map<AssetHandle, std::shared_ptr<Shader>> m_ShaderCache;
-        std::unordered_map<AssetHandle, std::shared_ptr<Model>> m_ModelCache;
-        std::unordered_map<AssetHandle, std::shared_ptr<Texture2D>> m_TextureCache;
+        std::unordered_map<AssetHandle, CacheEntry<Shader>> m_ShaderCache;
+        std::unordered_map<AssetHandle, CacheEntry<Model>> m_ModelCache;
+        std::unordered_map<AssetHandle, CacheEntry<Texture2D>> m_TextureCache;
+
+        uint64_t m_FrameIndex = 0;
+        size_t m_MemoryBudget = 512ull * 1024 * 1024;
+        uint32_t m_EvictionGraceFrames = 120;
+        bool m_PackModelTextures = true;
+        MemoryStats m_Stats;
     };
 
 } // namespace Engine
\ No newline at end of file
@@ -2,31 +2,53 @@
 #include "Engine/Assets/AssetTypes.h"     // includes AssetHandle.h
 
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <optional>
+#include <deque>
+#include <cstdint>
 
 namespace Engine {
 
+    using PathID = uint32_t;
+    constexpr PathID InvalidPathID = 0;
+
     struct AssetMetadata {
         AssetType Type = AssetType::None;
         std::string Path;         // normalized, forward slashes
         AssetHandle Shader = 0;   // used by Model assets (default shader handle)
+        PathID PathId = InvalidPathID; // interned Path
     };
 
     class AssetRegistry {
     public:
         explicit AssetRegistry(const std::string& registryPath = "Assets/Project/asset_registry.json");
 
+        // A file that fails to parse loads nothing (no partial set) and blocks Save until
+        // a later Load succeeds, so the registry on disk is never overwritten with the
+        // entries read before the error.
         bool Load();
+        bool HasLoadError() const { return m_LoadFailed; }
+
+        // Always writes (unless the last Load failed). Atomic: writes <path>.tmp then
+        // renames over the registry.
         bool Save() const;
+        // Writes only if something changed since the last Load/Save.
+        bool SaveIfDirty() const;
+        bool IsDirty() const { return m_Dirty; }
 
         // Register/import (returns existing handle if path already registered for that type)
         AssetHandle Register(AssetType type, const std::string& path, AssetHandle shader = 0);
 
         bool Exists(AssetHandle id) const;
         std::optional<AssetHandle> FindByPath(AssetType type, const std::string& path) const;
+        std::optional<AssetHandle> FindByPathID(AssetType type, PathID path) const;
         const AssetMetadata* Get(AssetHandle id) const;
 
+        // Returns InvalidPathID if the (normalized) path was never interned. Does not allocate
+        // when the path is already normalized.
+        PathID FindPathID(std::string_view path) const;
+
         bool UpdatePath(AssetHandle id, const std::string& newPath);
         bool Remove(AssetHandle id);
 
@@ -36,12 +58,21 @@ namespace Engine {
     private:
         static std::string NormalizePath(const std::string& p);
 
+        PathID InternPath(const std::string& normalized);
+        static uint64_t MakeKey(AssetType type, PathID path) { return ((uint64_t)type << 32) | path; }
+
     private:
         std::string m_RegistryPath;
         AssetHandle m_NextID = 1;
+        mutable bool m_Dirty = false;
+        bool m_LoadFailed = false;
 
         std::unordered_map<AssetHandle, AssetMetadata> m_Assets;
-        std::unordered_map<std::string, AssetHandle> m_PathToHandle; // key = type + "|" + path
+        std::unordered_map<uint64_t, AssetHandle> m_PathToHandle; // key = MakeKey(type, pathID)
+
+        // Interned paths. deque keeps strings at stable addresses so the views stay valid.
+        std::deque<std::string> m_PathStrings;                 // index = PathID - 1
+        std::unordered_map<std::string_view, PathID> m_PathIDs;
     };
 
-} // namespace Engine
\ No newline at end of file
+} // namespace Engine
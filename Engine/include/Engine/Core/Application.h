@@ -1,6 +1,8 @@
 #pragma once
 #include <memory>
 #include "Engine/Core/Window.h"
+#include "Engine/Core/FrameScheduler.h"
+#include "Engine/Core/FrameTimings.h"
 
 namespace Engine {
 
@@ -10,9 +12,14 @@ namespace Engine {
 
     class Application {
     public:
-        Application();
+        explicit Application(const WindowProps& props = { "Engine3D - Sandbox", 1280, 720 });
         void Run();
 
+        // Stop after this many drawn frames and print the frame-time summary (0 = run
+        // until closed). Meant for headless perf runs.
+        void SetFrameLimit(uint64_t frames) { m_FrameLimit = frames; }
+        const FrameTimings& GetFrameTimings() const { return m_Timings; }
+
         void OnEvent(Event& e);
 
         bool m_CaptureMouse = true;
@@ -24,7 +31,11 @@ namespace Engine {
 
     private:
         std::unique_ptr<Window> m_Window;
+        std::unique_ptr<FrameScheduler> m_Scheduler;
         bool m_Running = true;
+
+        uint64_t m_FrameLimit = 0;
+        FrameTimings m_Timings;
     };
 
 } // namespace Engine
\ No newline at end of file
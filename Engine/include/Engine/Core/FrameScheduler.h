@@ -0,0 +1,77 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+namespace Engine {
+
+    class Window;
+    class Event;
+
+    // Decides when the main loop draws.
+    //
+    // A frame is due when something asked for one (input events, scene edits, finished
+    // asset jobs, or RequestRedraw from any thread) or while the loop is continuous
+    // (camera flying, gizmo drag, game running). When nothing is due, WaitForFrame
+    // sleeps in glfwWaitEventsTimeout instead of spinning; when one is due, it paces
+    // frames to the focused / unfocused frame cap on top of vsync.
+    class FrameScheduler {
+    public:
+        struct Settings {
+            float TargetFPS = 0.0f;     // cap while focused; 0 = vsync only
+            bool PowerSaving = true;    // use UnfocusedFPS while the window isn't focused
+            float UnfocusedFPS = 10.0f; // 0 = only draw when a redraw is requested
+            float IdleTimeout = 0.5f;   // longest sleep, so per-tick housekeeping still runs
+        };
+
+        explicit FrameScheduler(Window& window);
+        ~FrameScheduler();
+
+        // wired into the JobSystem wake callback
+        FrameScheduler(const FrameScheduler&) = delete;
+        FrameScheduler& operator=(const FrameScheduler&) = delete;
+
+        void SetSettings(const Settings& settings) { m_Settings = settings; }
+        const Settings& GetSettings() const { return m_Settings; }
+
+        // Thread-safe. Draws at least the next `frames` frames; the default two let
+        // ImGui settle hover / active state after the input that caused it.
+        void RequestRedraw(uint32_t frames = 2);
+
+        // Draw every frame (still capped) until cleared.
+        void SetContinuous(bool continuous) { m_Continuous = continuous; }
+        bool IsContinuous() const { return m_Continuous; }
+
+        // Any window / input event requests a redraw; focus events also switch the cap.
+        void OnEvent(Event& e);
+        bool IsFocused() const { return m_Focused; }
+
+        // Processes window events and returns once a frame should be drawn (true), or after
+        // an idle timeout with nothing to draw (false: don't render or swap this tick).
+        bool WaitForFrame();
+
+        struct Stats {
+            uint64_t Frames = 0;
+            uint64_t IdleTicks = 0;
+        };
+        const Stats& GetStats() const { return m_Stats; }
+
+    private:
+        bool WantsFrame() const;
+        float GetFrameCap() const;
+
+    private:
+        Window& m_Window;
+        Settings m_Settings;
+        std::thread::id m_MainThread;
+
+        std::atomic<uint32_t> m_PendingFrames{ 2 }; // draw the first frames unconditionally
+        bool m_Continuous = false;
+        bool m_Focused = true;
+
+        std::chrono::steady_clock::time_point m_LastFrame{};
+        Stats m_Stats;
+    };
+
+} // namespace Engine
@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Engine {
+
+    // Collects per-frame times for fixed-length runs (headless / --frames N) and prints a
+    // one-line summary, so runs can be diffed by scripts.
+    class FrameTimings {
+    public:
+        void Reserve(size_t frames) { m_FrameMs.reserve(frames); }
+        void Add(float frameMs) { m_FrameMs.push_back(frameMs); }
+        void Clear() { m_FrameMs.clear(); }
+
+        size_t GetCount() const { return m_FrameMs.size(); }
+        float GetAverageMs() const;
+        float GetMinMs() const;
+        float GetMaxMs() const;
+
+        // Nearest-rank percentile, 0..100 (50 = median)
+        float GetPercentileMs(float percentile) const;
+
+        const std::vector<float>& GetSamples() const { return m_FrameMs; }
+
+        // "[tag] frames=N avg=.. min=.. p50=.. p95=.. p99=.. max=.. ms fps=.."
+        std::string Summary(const std::string& tag) const;
+
+    private:
+        std::vector<float> m_FrameMs;
+    };
+
+} // namespace Engine
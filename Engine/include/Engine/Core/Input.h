@@ -17,6 +17,14 @@ namespace Engine {
         static bool IsKeyDown(KeyCode key);
         static bool IsMouseButtonDown(int button);
         static void GetMousePosition(float& x, float& y);
+
+        // --- Scripted state (headless runs, replays) ---
+        // While scripted, the queries above read this state instead of the GLFW window.
+        static void SetScripted(bool scripted);
+        static bool IsScripted();
+        static void SetKeyDown(KeyCode key, bool down);
+        static void SetMouseButtonDown(int button, bool down);
+        static void SetMousePosition(float x, float y);
     };
 
     // <-- ADD THIS
@@ -0,0 +1,91 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Engine {
+
+    class Event;
+
+    // Per-frame input capture for reproducible perf runs.
+    //
+    // Each recorded frame holds the simulation dt, the polled Input state (tracked keys,
+    // mouse buttons, cursor) and the window / input events that arrived since the
+    // previous frame. Replaying feeds the same state back through Input's scripted
+    // backend and the same events through the app's event callback, so CameraController
+    // and everything driven by events walk exactly the recorded path.
+    //
+    // File (.e3ir): header, then per frame a RecordedFrame followed by its events.
+    struct InputRecording {
+        struct Frame {
+            float Dt = 0.0f;
+            float MouseX = 0.0f, MouseY = 0.0f;
+            uint16_t Keys = 0;     // bit i = RecordedKeys[i]
+            uint8_t Buttons = 0;   // bit i = mouse button i
+            uint8_t Reserved = 0;
+            uint32_t EventCount = 0;
+        };
+
+        struct RecordedEvent {
+            uint32_t Type = 0;     // EventType
+            int32_t Code = 0;      // key / button / repeat count / focus
+            float X = 0.0f, Y = 0.0f;
+        };
+
+        uint32_t Width = 0, Height = 0; // window size when recording started
+        std::vector<Frame> Frames;
+        std::vector<RecordedEvent> Events; // in frame order, Frames[i].EventCount each
+
+        bool Save(const std::string& path) const;
+        bool Load(const std::string& path);
+    };
+
+    class InputRecorder {
+    public:
+        void Begin(uint32_t width, uint32_t height);
+
+        // Call from the window event callback; events go into the next recorded frame.
+        void OnEvent(const Event& e);
+
+        // Snapshot Input state and close the frame. dt is what the simulation used.
+        void RecordFrame(float dt);
+
+        const InputRecording& GetRecording() const { return m_Recording; }
+        bool Save(const std::string& path) const { return m_Recording.Save(path); }
+
+    private:
+        InputRecording m_Recording;
+        std::vector<InputRecording::RecordedEvent> m_Pending;
+    };
+
+    class InputReplayer {
+    public:
+        using EventCallbackFn = std::function<void(Event&)>;
+
+        bool Load(const std::string& path);
+
+        // Switches Input to its scripted state; the previous mode is restored by Stop.
+        void Start();
+        void Stop();
+
+        bool IsFinished() const { return m_Next >= m_Recording.Frames.size(); }
+        size_t GetFrameIndex() const { return m_Next; }
+        size_t GetFrameCount() const { return m_Recording.Frames.size(); }
+
+        // Applies the next frame: sets Input state, dispatches its events through
+        // `callback`, and returns the recorded dt (or the fixed step when one is set).
+        float NextFrame(const EventCallbackFn& callback);
+
+        // > 0: replace the recorded dts with a constant step
+        void SetFixedTimestep(float dt) { m_FixedDt = dt; }
+
+    private:
+        InputRecording m_Recording;
+        size_t m_Next = 0;
+        size_t m_NextEvent = 0;
+        float m_FixedDt = 0.0f;
+        bool m_WasScripted = false;
+    };
+
+} // namespace Engine
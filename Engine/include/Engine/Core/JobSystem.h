@@ -0,0 +1,121 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <condition_variable>
+
+namespace Engine {
+
+    struct Job;
+
+    // Completion count for a batch of jobs. Schedule increments it, each finished job
+    // decrements it; Wait returns once it reaches zero. Jobs scheduled with ScheduleAfter
+    // are parked on the counter and released when it hits zero.
+    // Must outlive the jobs that reference it (waiting on it guarantees that).
+    class JobCounter {
+    public:
+        JobCounter() = default;
+        JobCounter(const JobCounter&) = delete;
+        JobCounter& operator=(const JobCounter&) = delete;
+
+        bool IsDone() const { return m_Pending.load(std::memory_order_acquire) == 0; }
+
+    private:
+        friend class JobSystem;
+
+        std::atomic<uint32_t> m_Pending{ 0 };
+        std::mutex m_Mutex; // guards m_Continuations and the final decrement
+        std::vector<Job*> m_Continuations;
+    };
+
+    enum class JobAffinity : uint8_t {
+        Any,        // any worker (or a thread helping in Wait)
+        // Main-thread-only, non-GL work (window, input, editor state): only RunMainThreadJobs /
+        // Wait on the main thread run it. The Sandbox owns GL on its render thread, so GL work
+        // goes through RenderCommand::RunOnRenderThread instead.
+        MainThread
+    };
+
+    // Work-stealing job system: one worker per core besides the main thread, each with a
+    // lock-free Chase-Lev deque. Owners push/pop at the bottom, idle workers steal from
+    // the top of a random victim. Threads that aren't workers (asset loader threads etc.)
+    // submit through a small locked queue.
+    //
+    // Jobs must not throw; an escaping exception is logged and swallowed so a worker
+    // can't die. Use a promise / exception_ptr to hand errors back.
+    class JobSystem {
+    public:
+        // Created on first use; the thread making that call becomes the main thread.
+        static JobSystem& Get();
+
+        ~JobSystem();
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        void Schedule(std::function<void()> job, JobCounter* counter = nullptr, JobAffinity affinity = JobAffinity::Any);
+
+        // Runs `job` once `dependency` reaches zero (immediately if it already has).
+        void ScheduleAfter(JobCounter& dependency, std::function<void()> job, JobCounter* counter = nullptr,
+            JobAffinity affinity = JobAffinity::Any);
+
+        // Blocks until the counter reaches zero, running other jobs meanwhile
+        // (including main-thread jobs when called on the main thread).
+        void Wait(JobCounter& counter);
+
+        // Calls fn(begin, end) over [0, count) split across workers and the caller.
+        // Chunks shrink as the range drains (guided scheduling), never below minChunk.
+        void ParallelFor(uint32_t count, const std::function<void(uint32_t begin, uint32_t end)>& fn, uint32_t minChunk = 64);
+
+        // Drains MainThread-affinity jobs; call once per frame from the main loop.
+        // Returns how many ran.
+        uint32_t RunMainThreadJobs();
+
+        // Called (from any thread) whenever a MainThread job is queued, so a main loop
+        // blocked waiting for events can wake up and run it. Empty to clear.
+        void SetMainThreadWakeCallback(std::function<void()> callback);
+
+        uint32_t GetWorkerCount() const { return (uint32_t)m_Threads.size(); }
+        bool IsMainThread() const { return std::this_thread::get_id() == m_MainThread; }
+
+    private:
+        class WorkDeque;
+
+        explicit JobSystem(uint32_t workerCount);
+
+        void WorkerLoop(uint32_t index);
+        void Enqueue(Job* job);
+        Job* FindJob();
+        void Execute(Job* job);
+        void Finish(JobCounter* counter);
+        void Wake();
+
+    private:
+        std::thread::id m_MainThread;
+
+        // [0] = main thread, [1..] = workers
+        std::vector<std::unique_ptr<WorkDeque>> m_Deques;
+        std::vector<std::thread> m_Threads;
+
+        // overflow + submissions from non-worker threads
+        std::mutex m_SharedMutex;
+        std::deque<Job*> m_Shared;
+        std::atomic<uint32_t> m_SharedCount{ 0 };
+
+        std::mutex m_MainMutex;
+        std::deque<Job*> m_MainJobs;
+        std::function<void()> m_MainWake; // guarded by m_MainMutex
+
+        // sleeping workers
+        std::mutex m_SleepMutex;
+        std::condition_variable m_SleepCV;
+        std::atomic<uint64_t> m_WorkEpoch{ 0 };
+        std::atomic<uint32_t> m_Sleeping{ 0 };
+        std::atomic<bool> m_Running{ true };
+    };
+
+} // namespace Engine
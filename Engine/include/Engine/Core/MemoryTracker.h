@@ -0,0 +1,90 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace Engine {
+
+    // Which subsystem a heap allocation is charged to. Set per thread with MemoryScope;
+    // anything outside a scope counts as General.
+    enum class MemoryTag : uint8_t {
+        General = 0,
+        Assets,
+        Scene,
+        Renderer,
+        Editor,
+        Undo,
+        Count
+    };
+
+    // GPU resources, estimated from format and size when they're (re)allocated.
+    enum class GpuMemoryKind : uint8_t {
+        Texture2D = 0,
+        TextureCube,
+        TextureArray,
+        VertexBuffer,
+        IndexBuffer,
+        RenderTarget,
+        ShadowMap,
+        UniformBuffer,
+        Count
+    };
+
+    // Heap tracking runs through replacements of the global operator new / delete
+    // (MemoryTracker.cpp): each block carries a small header with its size and tag, so
+    // frees are charged back to whoever allocated. Over-aligned new isn't replaced and
+    // isn't counted. The hook costs a few contended atomics per allocation on every
+    // thread, so it's opt-in: define ENGINE_MEMORY_TRACKING (the Debug configurations
+    // do). The GPU estimates work either way.
+    class MemoryTracker {
+    public:
+        struct Usage {
+            int64_t Bytes = 0;        // live right now
+            int64_t PeakBytes = 0;    // high-water mark of Bytes
+            uint64_t Allocations = 0; // since startup
+        };
+
+        static bool IsHeapTrackingEnabled();
+
+        static Usage GetHeapUsage(MemoryTag tag);
+        static Usage GetHeapTotal();
+
+        static Usage GetGpuUsage(GpuMemoryKind kind);
+        static Usage GetGpuTotal();
+
+        static void TrackGpuAlloc(GpuMemoryKind kind, size_t bytes);
+        static void TrackGpuFree(GpuMemoryKind kind, size_t bytes);
+
+        static MemoryTag GetThreadTag();
+
+        // Call once per frame from the frame loop. Closes the frame's counters: heap
+        // allocations made since the previous call, on any thread. In steady state
+        // (nothing loading, no editing) this should read 0.
+        static void EndFrame();
+        static uint64_t GetFrameAllocations() { return s_FrameAllocations; }
+        static uint64_t GetFrameAllocatedBytes() { return s_FrameBytes; }
+
+        static const char* GetTagName(MemoryTag tag);
+        static const char* GetGpuKindName(GpuMemoryKind kind);
+
+    private:
+        friend class MemoryScope;
+        static MemoryTag SetThreadTag(MemoryTag tag); // returns the previous tag
+
+        static uint64_t s_FrameAllocations;
+        static uint64_t s_FrameBytes;
+    };
+
+    // Charges heap allocations on this thread to `tag` until the scope ends. Nests.
+    class MemoryScope {
+    public:
+        explicit MemoryScope(MemoryTag tag) : m_Previous(MemoryTracker::SetThreadTag(tag)) {}
+        ~MemoryScope() { MemoryTracker::SetThreadTag(m_Previous); }
+
+        MemoryScope(const MemoryScope&) = delete;
+        MemoryScope& operator=(const MemoryScope&) = delete;
+
+    private:
+        MemoryTag m_Previous;
+    };
+
+} // namespace Engine
@@ -12,6 +12,7 @@ namespace Engine {
         std::string Title = "Engine3D";
         uint32_t Width = 1280;
         uint32_t Height = 720;
+        bool Headless = false; // offscreen EGL context, no OS window (perf runs on build agents)
     };
 
     class Window {
@@ -20,7 +21,16 @@ namespace Engine {
 
         virtual ~Window() = default;
 
-        virtual void OnUpdate() = 0;
+        virtual void OnUpdate() = 0; // PollEvents + SwapBuffers
+
+        virtual void PollEvents() = 0;
+        // Sleeps until an event arrives or the timeout (seconds) runs out.
+        virtual void WaitEvents(double timeoutSeconds) = 0;
+        virtual void SwapBuffers() = 0;
+        // Thread-safe: wakes a WaitEvents on the main thread.
+        virtual void PostEmptyEvent() = 0;
+        // Binds / releases the GL context on the calling thread (render thread hand-off).
+        virtual void SetContextCurrent(bool current) = 0;
         virtual bool ShouldClose() const = 0;
 
         virtual uint32_t GetWidth() const = 0;
@@ -0,0 +1,111 @@
+#pragma once
+#include <entt/entt.hpp>
+#include <memory>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "Engine/Assets/AssetHandle.h"
+#include "Engine/Physics/SpatialHash.h"
+
+namespace Engine {
+
+    class Scene;
+    class MeshCollider;
+
+    struct SweepHit {
+        bool Hit = false;
+        float Time = 1.0f;            // fraction of the motion before contact
+        glm::vec3 Normal{ 0.0f };     // world space, points away from the surface
+        entt::entity Entity = entt::null;
+    };
+
+    // Static collision for every MeshRendererComponent entity in a scene.
+    //
+    // Broadphase: SpatialHash over world AABBs, so a query only touches the bodies
+    // near it no matter how large the level is. Bodies cache their world and
+    // inverse-world matrices and are rebuilt only when EnTT reports a Transform or
+    // MeshRenderer change (in-place writes must call MarkDirty, like Scene::MarkEntityDirty).
+    //
+    // Narrowphase: the model's triangle BVH (MeshCollider) by default; with triangle
+    // colliders off, or for models without triangles, each submesh's local AABB is used
+    // as an oriented box. Both go through the same swept-sphere test.
+    class CollisionWorld {
+    public:
+        explicit CollisionWorld(Scene& scene);
+        ~CollisionWorld();
+
+        // registry signals capture 'this'
+        CollisionWorld(const CollisionWorld&) = delete;
+        CollisionWorld& operator=(const CollisionWorld&) = delete;
+
+        void SetUseTriangleColliders(bool enabled);
+        bool GetUseTriangleColliders() const { return m_UseTriangles; }
+
+        void SetCellSize(float size) { m_Hash.SetCellSize(size); }
+        float GetCellSize() const { return m_Hash.GetCellSize(); }
+
+        void MarkDirty(entt::entity entity);
+
+        // Applies pending body changes. Queries call this themselves.
+        void Sync();
+
+        // Moves a sphere from `from` toward `to`, stopping at and sliding along contacts.
+        // Also pushes it out of anything it starts in (e.g. geometry that moved into it).
+        glm::vec3 MoveSphere(const glm::vec3& from, const glm::vec3& to, float radius, int maxSlides = 4);
+
+        // First contact along from -> to. Shapes already overlapping the sphere at `from` are ignored.
+        SweepHit SweepSphere(const glm::vec3& from, const glm::vec3& to, float radius);
+
+        // Pushes a sphere out of every shape it overlaps, away from each triangle on the side
+        // the center is already on (triangles are two-sided, as in SweepSphere).
+        glm::vec3 ResolveSphereOverlap(const glm::vec3& center, float radius, int maxIterations = 4);
+
+        struct Stats {
+            uint32_t Bodies = 0;
+            uint32_t LargeBodies = 0;
+            uint32_t CandidateBodies = 0;    // last query
+            uint32_t CandidateTriangles = 0; // last query
+        };
+        const Stats& GetStats() const { return m_Stats; }
+
+    private:
+        struct Body {
+            entt::entity Entity = entt::null;
+            glm::mat4 World{ 1.0f };
+            glm::mat4 InvWorld{ 1.0f };
+            std::shared_ptr<const MeshCollider> Collider;
+        };
+
+        void OnBodyChanged(entt::registry& reg, entt::entity e);
+
+        void RemoveBody(entt::entity e);
+        std::shared_ptr<const MeshCollider> GetShape(AssetHandle modelHandle);
+
+        template<typename Fn>
+        void ForEachTriangle(const glm::vec3& min, const glm::vec3& max, Fn&& fn);
+
+    private:
+        Scene& m_Scene;
+
+        bool m_UseTriangles = true;
+
+        std::vector<Body> m_Bodies;
+        std::vector<uint32_t> m_FreeBodies;
+        std::unordered_map<entt::entity, uint32_t> m_BodyByEntity;
+        SpatialHash m_Hash; // world AABBs by body index
+
+        std::vector<entt::entity> m_Dirty;
+
+        // shapes by model: triangle BVH, or boxes built from submesh bounds
+        std::unordered_map<AssetHandle, std::shared_ptr<const MeshCollider>> m_Shapes;
+
+        // query scratch
+        std::vector<uint32_t> m_ScratchBodies;
+        std::vector<uint32_t> m_ScratchTriangles;
+
+        Stats m_Stats;
+    };
+
+} // namespace Engine
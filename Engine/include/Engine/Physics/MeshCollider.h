@@ -0,0 +1,51 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+namespace Engine {
+
+    // Triangle BVH over a model's positions, in model local space. Built once per model
+    // on the import thread (see ModelData::Collider) and shared by every entity using it,
+    // so it survives GPU eviction of the model itself.
+    class MeshCollider {
+    public:
+        struct Node {
+            glm::vec3 Min;
+            uint32_t LeftOrFirst; // inner: index of left child (right = left + 1); leaf: first triangle
+            glm::vec3 Max;
+            uint32_t Count;       // 0 = inner node
+        };
+
+        // `indices` is a triangle list into `positions`.
+        static std::shared_ptr<MeshCollider> Build(std::vector<glm::vec3> positions, const std::vector<uint32_t>& indices);
+
+        // Appends every triangle whose bounds overlap [min, max] (conservative).
+        void QueryTriangles(const glm::vec3& min, const glm::vec3& max, std::vector<uint32_t>& outTriangles) const;
+
+        void GetTriangle(uint32_t triangle, glm::vec3& a, glm::vec3& b, glm::vec3& c) const {
+            const uint32_t* t = &m_Indices[(size_t)triangle * 3];
+            a = m_Positions[t[0]];
+            b = m_Positions[t[1]];
+            c = m_Positions[t[2]];
+        }
+
+        uint32_t GetTriangleCount() const { return (uint32_t)(m_Indices.size() / 3); }
+        const glm::vec3& GetMin() const { return m_Nodes.empty() ? m_Empty : m_Nodes[0].Min; }
+        const glm::vec3& GetMax() const { return m_Nodes.empty() ? m_Empty : m_Nodes[0].Max; }
+
+        size_t GetMemoryBytes() const {
+            return m_Positions.capacity() * sizeof(glm::vec3) + m_Indices.capacity() * sizeof(uint32_t)
+                + m_Nodes.capacity() * sizeof(Node);
+        }
+
+    private:
+        std::vector<glm::vec3> m_Positions;
+        std::vector<uint32_t> m_Indices; // 3 per triangle, reordered so each leaf is a contiguous range
+        std::vector<Node> m_Nodes;       // m_Nodes[0] = root
+
+        static inline const glm::vec3 m_Empty{ 0.0f };
+    };
+
+} // namespace Engine
@@ -0,0 +1,70 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+namespace Engine {
+
+    // World AABB of a local box under an affine transform
+    inline void TransformAABB(const glm::mat4& m, const glm::vec3& min, const glm::vec3& max,
+        glm::vec3& outMin, glm::vec3& outMax) {
+        const glm::vec3 center = glm::vec3(m * glm::vec4((min + max) * 0.5f, 1.0f));
+        const glm::vec3 half = (max - min) * 0.5f;
+
+        glm::vec3 extent(0.0f);
+        for (int col = 0; col < 3; col++)
+            extent += glm::abs(glm::vec3(m[col])) * half[col];
+
+        outMin = center - extent;
+        outMax = center + extent;
+    }
+
+    // Uniform grid over AABBs keyed by small dense ids (the owner's slot indices).
+    // Queries touch only the cells they overlap, so their cost follows local density,
+    // not level size. Items spanning more than MaxCellsPerItem cells go to a list that
+    // every query checks instead of being smeared over the grid.
+    class SpatialHash {
+    public:
+        static constexpr int MaxCellsPerItem = 512;
+
+        explicit SpatialHash(float cellSize = 8.0f);
+
+        void SetCellSize(float size); // re-buckets everything
+        float GetCellSize() const { return m_CellSize; }
+
+        void Insert(uint32_t id, const glm::vec3& min, const glm::vec3& max);
+        void Remove(uint32_t id);
+        void Clear();
+
+        // Ids whose AABB overlaps [min, max], each once. `out` is cleared first.
+        void Query(const glm::vec3& min, const glm::vec3& max, std::vector<uint32_t>& out);
+
+        uint32_t GetCount() const { return m_Count; }
+        uint32_t GetLargeCount() const { return (uint32_t)m_Large.size(); }
+
+    private:
+        struct Item {
+            glm::vec3 Min{ 0.0f }, Max{ 0.0f };
+            int CellMin[3]{}, CellMax[3]{};
+            bool Live = false;
+            bool Large = false;
+            uint32_t Stamp = 0;
+        };
+
+        void Link(uint32_t id);
+        void Unlink(uint32_t id);
+        int CellCoord(float v) const;
+        static uint64_t CellKey(int x, int y, int z);
+
+    private:
+        float m_CellSize;
+        std::vector<Item> m_Items; // by id
+        uint32_t m_Count = 0;
+
+        std::unordered_map<uint64_t, std::vector<uint32_t>> m_Cells;
+        std::vector<uint32_t> m_Large;
+        uint32_t m_Stamp = 0;
+    };
+
+} // namespace Engine
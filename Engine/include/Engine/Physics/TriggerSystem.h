@@ -0,0 +1,103 @@
+#pragma once
+#include <entt/entt.hpp>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "Engine/Physics/SpatialHash.h"
+
+namespace Engine {
+
+    class Scene;
+
+    // Point-vs-volume triggers for one observer (the player camera).
+    //
+    // Volumes come from TriggerComponent (sphere or oriented box), or from SceneWarpComponent
+    // (sphere of TriggerRadius) when an entity has no TriggerComponent. They live in a
+    // SpatialHash and are kept current through registry signals, so Update only tests
+    // the triggers in the observer's cell.
+    //
+    // Update reports edges: Enter once when the point gets inside, Stay while it remains,
+    // Exit when it leaves. A trigger on cooldown swallows its Enter (the point still
+    // counts as inside, so it won't fire until it leaves and comes back).
+    class TriggerSystem {
+    public:
+        enum class EventType : uint8_t { Enter, Stay, Exit };
+
+        struct Event {
+            EventType Type;
+            entt::entity Trigger;
+        };
+
+        explicit TriggerSystem(Scene& scene);
+        ~TriggerSystem();
+
+        // registry signals capture 'this'
+        TriggerSystem(const TriggerSystem&) = delete;
+        TriggerSystem& operator=(const TriggerSystem&) = delete;
+
+        // Cooldown for warp triggers that have no TriggerComponent.
+        void SetWarpCooldown(float seconds) { m_WarpCooldown = seconds; }
+
+        void SetCellSize(float size) { m_Hash.SetCellSize(size); }
+
+        void MarkDirty(entt::entity entity);
+        void Sync();
+
+        // Ticks cooldowns and returns this update's events (exits first).
+        // The list stays valid until the next Update.
+        const std::vector<Event>& Update(const glm::vec3& point, float dt);
+
+        // After a teleport or scene load: triggers containing `point` count as already
+        // entered, so landing inside a warp doesn't send you straight back.
+        void ResetOccupancy(const glm::vec3& point);
+
+        struct Stats {
+            uint32_t Triggers = 0;
+            uint32_t Candidates = 0; // last update
+            uint32_t Inside = 0;
+        };
+        const Stats& GetStats() const { return m_Stats; }
+
+    private:
+        struct Trigger {
+            entt::entity Entity = entt::null;
+            bool IsBox = false;
+            glm::vec3 Center{ 0.0f };
+            float Radius = 0.0f;
+            glm::mat4 InvWorld{ 1.0f };
+            glm::vec3 HalfExtents{ 0.0f };
+            float Cooldown = 0.0f;
+
+            // runtime state, kept across shape updates
+            float CooldownLeft = 0.0f;
+            bool Inside = false;
+            uint32_t Seen = 0;
+        };
+
+        void OnTriggerChanged(entt::registry& reg, entt::entity e);
+        void RemoveTrigger(entt::entity e);
+        bool Contains(const Trigger& t, const glm::vec3& point) const;
+        static void EraseSlot(std::vector<uint32_t>& list, uint32_t slot);
+
+    private:
+        Scene& m_Scene;
+        float m_WarpCooldown = 0.75f;
+
+        std::vector<Trigger> m_Triggers;
+        std::vector<uint32_t> m_FreeSlots;
+        std::unordered_map<entt::entity, uint32_t> m_SlotByEntity;
+        SpatialHash m_Hash;
+
+        std::vector<entt::entity> m_Dirty;
+        std::vector<uint32_t> m_Inside;  // slots with Inside == true
+        std::vector<uint32_t> m_Cooling; // slots with CooldownLeft > 0
+        uint32_t m_UpdateIndex = 0;
+
+        std::vector<uint32_t> m_Candidates;
+        std::vector<Event> m_Events;
+        Stats m_Stats;
+    };
+
+} // namespace Engine
@@ -93,9 +93,11 @@ namespace Engine {
 
         void SetLayout(const BufferLayout& layout) { m_Layout = layout; }
         const BufferLayout& GetLayout() const { return m_Layout; }
+        uint32_t GetSize() const { return m_Size; }
 
     private:
         uint32_t m_RendererID = 0;
+        uint32_t m_Size = 0;
         BufferLayout m_Layout;
     };
 
@@ -112,4 +114,29 @@ namespace Engine {
         uint32_t m_Count = 0;
     };
 
+    // Fixed binding points for GL_UNIFORM_BUFFER blocks. GLSL 330 can't say
+    // layout(binding = N), so Shader binds blocks by name after every link.
+    namespace UniformBinding {
+        constexpr uint32_t Material = 0; // "MaterialBlock", see Material.h
+    }
+
+    class UniformBuffer {
+    public:
+        explicit UniformBuffer(uint32_t size);
+        ~UniformBuffer();
+
+        void SetData(const void* data, uint32_t size, uint32_t offset = 0);
+        // offset must be a multiple of GetOffsetAlignment()
+        void BindRange(uint32_t binding, uint32_t offset, uint32_t size) const;
+
+        uint32_t GetSize() const { return m_Size; }
+
+        // GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT (GL thread)
+        static uint32_t GetOffsetAlignment();
+
+    private:
+        uint32_t m_RendererID = 0;
+        uint32_t m_Size = 0;
+    };
+
 } // namespace Engine
\ No newline at end of file
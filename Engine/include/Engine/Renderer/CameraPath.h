@@ -0,0 +1,46 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace Engine {
+
+    class Scene;
+
+    // Catmull-Rom flythrough at constant speed, for perf runs that need the same
+    // camera path on every build. The camera looks a little ahead along the curve.
+    class CameraPath {
+    public:
+        void AddPoint(const glm::vec3& p) { m_Points.push_back(p); m_Dirty = true; }
+        void Clear() { m_Points.clear(); m_Dirty = true; }
+        size_t GetPointCount() const { return m_Points.size(); }
+
+        // Through the scene's SpawnPoint, then every SceneWarp ordered by tag (ties by
+        // UUID), so the path only depends on the scene file.
+        static CameraPath FromScene(Scene& scene);
+
+        void SetSpeed(float unitsPerSecond) { m_Speed = unitsPerSecond; }
+        float GetSpeed() const { return m_Speed; }
+
+        float GetLength() const;
+        float GetDuration() const { return m_Speed > 0.0f ? GetLength() / m_Speed : 0.0f; }
+
+        // Camera pose `time` seconds into the flight (clamped to the ends).
+        // False when there's no path (fewer than two distinct points).
+        bool Sample(float time, glm::vec3& position, float& yawRadians, float& pitchRadians) const;
+
+    private:
+        glm::vec3 Evaluate(size_t segment, float t) const;
+        glm::vec3 PointAtDistance(float distance) const;
+        void Build() const;
+
+    private:
+        std::vector<glm::vec3> m_Points;
+        float m_Speed = 6.0f;
+
+        // arc-length table: cumulative distance per sample, SamplesPerSegment per segment
+        static constexpr uint32_t SamplesPerSegment = 32;
+        mutable std::vector<float> m_Distances;
+        mutable bool m_Dirty = true;
+    };
+
+} // namespace Engine
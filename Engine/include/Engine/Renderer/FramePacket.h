@@ -0,0 +1,51 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Engine/Renderer/Renderer.h"
+#include "Engine/Renderer/PerspectiveCamera.h"
+
+namespace Engine {
+
+    // Everything the render thread needs for one frame, built by the simulation thread
+    // and not touched by it again until the render thread hands the slot back.
+    // Materials and GPU objects are shared, not copied: the packet only keeps them alive.
+    struct FramePacket {
+        static constexpr int MaxCascades = Renderer::MaxCascades;
+
+        uint64_t FrameIndex = 0;
+        uint32_t Width = 0, Height = 0;
+
+        PerspectiveCamera Camera{ 1.0472f, 16.0f / 9.0f, 0.1f, 100.0f };
+
+        // directional light
+        bool HasLight = false;
+        glm::vec3 LightDir{ 0.4f, 0.8f, -0.3f };
+        glm::vec3 LightColor{ 1.0f };
+
+        // CSM; CascadeCount 0 = no shadows this frame
+        uint32_t ShadowSize = 2048;
+        int CascadeCount = 0;
+        glm::mat4 LightMatrices[MaxCascades]{};
+        float CascadeSplits[MaxCascades]{};
+
+        bool DrawSkybox = true;
+
+        std::vector<DrawPacket> Draws;         // frustum-culled, sorted by key
+        std::vector<DrawPacket> ShadowCasters; // sorted by VAO, drawn with the depth material
+        uint32_t CulledDraws = 0;              // for Renderer stats, counted at extraction
+
+        // keeps the vectors' capacity for the next frame
+        void Clear() {
+            Width = Height = 0;
+            HasLight = false;
+            CascadeCount = 0;
+            DrawSkybox = true;
+            CulledDraws = 0;
+            Draws.clear();
+            ShadowCasters.clear();
+        }
+    };
+
+} // namespace Engine
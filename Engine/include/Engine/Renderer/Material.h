@@ -1,38 +1,107 @@
 #pragma once
+#include <array>
 #include <memory>
 #include <string>
-#include <unordered_map>
+#include <vector>
 #include <cstdint>
 #include <glm/glm.hpp>
 
+#include "Engine/Renderer/ShaderKeywords.h"
+
 namespace Engine {
 
     class Shader;
     class Texture2D;
+    class TextureArray;
+    class UniformBuffer;
+
+    // One material's parameters, std140. Mirrors the shaders'
+    //     layout(std140) uniform MaterialBlock { vec4 u_Color; float u_Texture0Layer; };
+    // (shaders may declare a prefix of it). Every material owns one block in a shared
+    // UBO, at GetID() * stride.
+    struct MaterialParams {
+        glm::vec4 Color{ 1.0f };
+        float Texture0Layer = 0.0f; // layer in GetTextureArray() (HAS_TEXTURE0_ARRAY)
+        float Padding[3] = {};
+    };
+    static_assert(sizeof(MaterialParams) % 16 == 0, "MaterialParams must stay std140-sized");
 
     class Material {
     public:
+        static constexpr uint32_t MaxTextureSlots = 4; // u_Texture0..3
+        using TextureSlots = std::array<std::shared_ptr<Texture2D>, MaxTextureSlots>;
+
         explicit Material(const std::shared_ptr<Shader>& shader);
-        ~Material(); // <-- add this
+        Material(const Material& other); // same settings, its own ID
+        Material& operator=(const Material&) = delete;
+        ~Material();
+
+        // The shared instance equal to `prototype`, created on first request. Models and
+        // other loaders intern, so identical submeshes share one material (one ID, one
+        // run in the sorted draw list). Interned materials are shared: don't modify
+        // them, intern a modified copy instead. Thread-safe.
+        static std::shared_ptr<Material> Intern(const Material& prototype);
 
         const std::shared_ptr<Shader>& GetShader() const { return m_Shader; }
 
-        void SetColor(const glm::vec4& color) { m_Color = color; m_HasColor = true; }
+        // Small dense integer, reused after the material is destroyed; the slot of its
+        // parameter block and part of the draw sort key.
+        uint32_t GetID() const { return m_ID; }
+
+        void SetColor(const glm::vec4& color);
         bool HasColor() const { return m_HasColor; }
-        const glm::vec4& GetColor() const { return m_Color; }
+        const glm::vec4& GetColor() const { return m_Params.Color; }
+        const MaterialParams& GetParams() const { return m_Params; }
 
         void SetTexture(uint32_t slot, const std::shared_ptr<Texture2D>& tex);
-        const std::unordered_map<uint32_t, std::shared_ptr<Texture2D>>& GetTextures() const { return m_Textures; }
+        const std::shared_ptr<Texture2D>& GetTexture(uint32_t slot) const { return m_Textures[slot]; }
+        const TextureSlots& GetTextures() const { return m_Textures; }
+
+        // Slot 0 as one layer of a texture array page instead of a Texture2D (the two
+        // replace each other). Sets HAS_TEXTURE0_ARRAY; only for shaders declaring it.
+        void SetTextureArray(const std::shared_ptr<TextureArray>& page, uint32_t layer);
+        const std::shared_ptr<TextureArray>& GetTextureArray() const { return m_TextureArray; }
+
         void SetTwoSided(bool v) { m_TwoSided = v; }
         bool IsTwoSided() const { return m_TwoSided; }
+
+        // Alpha-blended over what's behind it (explicitly, or by a translucent colour).
+        // Kept out of the depth pre-pass, which would hide everything beneath it.
+        void SetBlended(bool v) { m_Blended = v; }
+        bool IsBlended() const { return m_Blended || (m_HasColor && m_Params.Color.a < 1.0f); }
+
+        // Material half of the shader permutation (ShaderKeyword bits). HAS_TEXTURE0
+        // follows SetTexture(0, ...); RECEIVE_SHADOWS is on by default.
+        uint32_t GetPermutation() const { return m_Permutation; }
+        void SetKeyword(uint32_t keyword, bool enabled) {
+            m_Permutation = enabled ? (m_Permutation | keyword) : (m_Permutation & ~keyword);
+        }
+        void SetReceiveShadows(bool v) { SetKeyword(ShaderKeyword::ReceiveShadows, v); }
+        bool ReceivesShadows() const { return (m_Permutation & ShaderKeyword::ReceiveShadows) != 0; }
+
+        bool operator==(const Material& other) const;
+        uint64_t Hash() const;
+
+        // GL thread. Copies the parameter blocks changed since the last call into
+        // `buffer`, replacing it with a larger one when there are more materials than
+        // it holds. `stride` is the per-ID spacing (UBO offset alignment).
+        static void SyncParams(std::unique_ptr<UniformBuffer>& buffer, uint32_t stride);
+
+    private:
+        void WriteParams() const;
+
     private:
         std::shared_ptr<Shader> m_Shader;
+        uint32_t m_ID = 0;
 
+        MaterialParams m_Params;
         bool m_HasColor = false;
         bool m_TwoSided = false;
-        glm::vec4 m_Color{ 1.0f };
+        bool m_Blended = false;
+        uint32_t m_Permutation = ShaderKeyword::ReceiveShadows;
 
-        std::unordered_map<uint32_t, std::shared_ptr<Texture2D>> m_Textures;
+        TextureSlots m_Textures;
+        std::shared_ptr<TextureArray> m_TextureArray; // slot 0, layer in m_Params
     };
 
-} // namespace Engine
\ No newline at end of file
+} // namespace Engine
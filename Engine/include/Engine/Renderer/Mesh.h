@@ -31,10 +31,14 @@ namespace Engine {
 
         const Bounds& GetBounds() const { return m_Bounds; }
 
+        // Vertex + index bytes uploaded to the GPU (used for asset residency accounting)
+        size_t GetGPUMemoryBytes() const { return m_GPUMemoryBytes; }
+
     private:
         std::shared_ptr<VertexArray> m_VAO;
         std::shared_ptr<IndexBuffer> m_IB;
         Bounds m_Bounds;
+        size_t m_GPUMemoryBytes = 0;
     };
 
 } // namespace Engine
\ No newline at end of file
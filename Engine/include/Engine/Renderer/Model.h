@@ -3,24 +3,68 @@
 #include <vector>
 #include <memory>
 #include <unordered_map>
+#include <cstdint>
 
 #include "Engine/Renderer/Mesh.h"
 
-struct aiNode;
-struct aiScene;
-struct aiMesh;
-struct aiMaterial;
-
 namespace Engine {
 
     class Shader;
     class Texture2D;
+    class TextureArray;
     class Material;
+    class MeshCollider;
+
+    // CPU side of a model: what Assimp + stb produce, no GL objects.
+    // Model::Import builds it and is safe to run on worker threads; the
+    // Model(ModelData&&, shader) constructor does the GL upload and must run on the GL thread.
+    struct ModelData {
+        struct TextureData {
+            std::string Name;
+            std::vector<uint8_t> RGBA;
+            int Width = 0, Height = 0;
+
+            // set by Model::PackTextures; -1 = uploaded as its own Texture2D
+            int32_t Page = -1;
+            uint32_t Layer = 0;
+        };
+
+        // a GL_TEXTURE_2D_ARRAY of same-size textures
+        struct TexturePageData {
+            int Width = 0, Height = 0;
+            uint32_t Layers = 0;
+        };
+
+        struct SubMeshData {
+            std::vector<Vertex> Vertices;
+            std::vector<uint32_t> Indices;
+            int32_t Texture = -1; // index into Textures, -1 = untextured
+        };
+
+        std::string SourcePath;
+        std::vector<SubMeshData> SubMeshes;
+        std::vector<TextureData> Textures; // one per unique texture reference
+        std::vector<TexturePageData> TexturePages; // empty unless packed
+
+        // triangle BVH over all submeshes (built on the import thread)
+        std::shared_ptr<MeshCollider> Collider;
+    };
 
     class Model {
     public:
         // Pass the shader you want model materials to use
         Model(const std::string& path, const std::shared_ptr<Shader>& defaultShader);
+        Model(ModelData&& data, const std::shared_ptr<Shader>& defaultShader);
+
+        // File -> CPU data. Throws std::runtime_error if Assimp can't read the file.
+        static ModelData Import(const std::string& path);
+
+        // Optional import step (CPU, any thread): assigns textures that share a size
+        // (all decode to RGBA8) to texture array pages, so their submeshes' materials
+        // bind one texture and differ only by the layer in their parameter block.
+        // Upload uses the pages when the model's shader declares HAS_TEXTURE0_ARRAY and
+        // falls back to one Texture2D each otherwise.
+        static void PackTextures(ModelData& data);
 
         struct SubMesh {
             std::shared_ptr<Mesh> MeshPtr;
@@ -28,23 +72,30 @@ namespace Engine {
         };
 
         const std::vector<SubMesh>& GetSubMeshes() const { return m_SubMeshes; }
+
+        // Submesh materials are interned (shared with identical ones in other models);
+        // to change one, intern a modified copy and set it here.
+        void SetMaterial(size_t subMesh, const std::shared_ptr<Material>& material);
+
+        // CPU-side collision geometry; null if the model has no triangles
+        const std::shared_ptr<const MeshCollider>& GetCollider() const { return m_Collider; }
+
+        // Sum of mesh buffers + textures owned by this model
+        size_t GetGPUMemoryBytes() const;
         std::string m_SourcePath;
 
     private:
-        void LoadModel(const std::string& path);
-        void ProcessNode(aiNode* node, const aiScene* scene);
-        SubMesh ProcessMesh(aiMesh* mesh, const aiScene* scene);
-
-        std::shared_ptr<Texture2D> LoadTextureFromMaterial(aiMaterial* mat, const aiScene* scene);
+        void Upload(ModelData&& data);
 
     private:
         std::vector<SubMesh> m_SubMeshes;
-        std::string m_Directory;
+        std::shared_ptr<const MeshCollider> m_Collider;
 
         std::shared_ptr<Shader> m_DefaultShader;
 
         // Cache textures by absolute path so duplicates arent reloaded
         std::unordered_map<std::string, std::shared_ptr<Texture2D>> m_TextureCache;
+        std::vector<std::shared_ptr<TextureArray>> m_TexturePages;
     };
 
 } // namespace Engine
\ No newline at end of file
@@ -1,8 +1,11 @@
 #pragma once
 #include <cstdint>
+#include <functional>
 
 namespace Engine {
 
+    class RenderThread;
+
     class RenderCommand {
     public:
         static void Init();
@@ -10,6 +13,18 @@ namespace Engine {
         static void SetClearColor(float r, float g, float b, float a);
         static void Clear();
         static void DrawIndexed(uint32_t indexCount);
+
+        // --- GL thread routing ---
+        // With a RenderThread installed the context lives there, so everything that
+        // creates or deletes GL objects goes through these. Without one (Editor,
+        // Application) both just run the function on the caller.
+        static void SetRenderThread(RenderThread* thread);
+
+        // Blocks until fn has run on the GL thread (resource creation, readbacks).
+        static void RunOnRenderThread(const std::function<void()>& fn);
+
+        // Fire and forget (glDelete* from destructors, which can run on any thread).
+        static void ReleaseOnRenderThread(std::function<void()> fn);
     };
 
 } // namespace Engine
\ No newline at end of file
@@ -0,0 +1,169 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Engine {
+
+    enum class RenderTargetFormat : uint8_t {
+        RGBA8 = 0,
+        R32UI,          // picking IDs
+        Depth24Stencil8
+    };
+
+    struct RenderTargetDesc {
+        uint32_t Width = 0, Height = 0;
+        RenderTargetFormat Format = RenderTargetFormat::RGBA8;
+    };
+
+    // Render target textures shared by RenderGraph executions, bucketed by format and
+    // by size rounded up to SizeGranularity: a viewport being dragged keeps landing in
+    // the same bucket instead of reallocating every frame. Passes render into the
+    // lower-left Width x Height and sample with GetUVScale. A texture nobody acquired
+    // for GraceFrames executions is freed. GL thread only.
+    class RenderTargetPool {
+    public:
+        static constexpr uint32_t SizeGranularity = 128;
+        static constexpr uint32_t GraceFrames = 4;
+
+        RenderTargetPool() = default;
+        RenderTargetPool(const RenderTargetPool&) = delete;
+        RenderTargetPool& operator=(const RenderTargetPool&) = delete;
+        ~RenderTargetPool();
+
+        static uint32_t BucketSize(uint32_t size);
+
+        // A free texture from desc's bucket, allocated if the bucket has none.
+        uint32_t Acquire(const RenderTargetDesc& desc);
+        void Release(uint32_t texture);
+
+        // FBO with these attachments (either may be 0), cached until one is freed.
+        uint32_t GetFramebuffer(uint32_t color, uint32_t depth);
+
+        // Once per frame, after the last Release: ages and frees idle textures.
+        void EndFrame();
+
+        uint32_t GetTextureCount() const { return (uint32_t)m_Entries.size(); }
+
+    private:
+        struct Entry {
+            uint32_t Texture = 0;
+            RenderTargetDesc Bucket; // allocated size
+            bool InUse = false;
+            uint64_t LastUsedFrame = 0;
+        };
+
+        void Destroy(const Entry& entry);
+
+    private:
+        std::vector<Entry> m_Entries;
+        std::unordered_map<uint64_t, uint32_t> m_Framebuffers; // color << 32 | depth -> FBO
+        uint64_t m_Frame = 0;
+    };
+
+    // One frame's passes, declared up front. Each pass names the resources it creates,
+    // reads and writes; Execute culls passes whose writes nothing reads (unless they
+    // have side effects or write an exported resource), gives every transient target
+    // a pooled texture for its first..last live use, and runs the live passes in
+    // declaration order. Targets whose lifetimes don't overlap share a texture.
+    //
+    // Declaration order is the execution order, so a pass may only read what an
+    // earlier pass wrote (or an import). GL tracks render-to-texture hazards itself;
+    // there are no explicit barriers to place.
+    class RenderGraph {
+    public:
+        using Resource = uint32_t;
+        static constexpr Resource None = ~0u;
+
+        class Builder {
+        public:
+            // New transient render target, written by this pass.
+            Resource Create(const std::string& name, const RenderTargetDesc& desc);
+            Resource Read(Resource resource);
+            Resource Write(Resource resource);
+            // Never culled (draws to the default framebuffer, reads back, ...).
+            void SetSideEffect();
+
+        private:
+            friend class RenderGraph;
+            Builder(RenderGraph& graph, uint32_t pass) : m_Graph(graph), m_Pass(pass) {}
+
+            RenderGraph& m_Graph;
+            uint32_t m_Pass;
+        };
+
+        class Context {
+        public:
+            uint32_t GetTexture(Resource resource) const { return m_Graph.GetTexture(resource); }
+            const RenderTargetDesc& GetDesc(Resource resource) const { return m_Graph.GetDesc(resource); }
+
+            // Binds an FBO with these attachments (either may be None) and sets the
+            // viewport to the target's Width x Height.
+            void BindRenderTarget(Resource color, Resource depth) const;
+
+        private:
+            friend class RenderGraph;
+            explicit Context(RenderGraph& graph) : m_Graph(graph) {}
+
+            RenderGraph& m_Graph;
+        };
+
+        using SetupFn = std::function<void(Builder&)>;
+        using ExecuteFn = std::function<void(const Context&)>;
+
+        explicit RenderGraph(RenderTargetPool& pool) : m_Pool(pool) {}
+        ~RenderGraph();
+
+        // Drops the previous frame's passes and releases its exported targets.
+        void Reset();
+
+        // A texture owned elsewhere (never pooled).
+        Resource Import(const std::string& name, uint32_t texture, const RenderTargetDesc& desc = {});
+        // Setup runs now; execute runs in Execute if the pass survives culling.
+        void AddPass(const std::string& name, const SetupFn& setup, ExecuteFn execute);
+        // Keeps the resource (and the passes producing it) alive past Execute, until Reset.
+        void Export(Resource resource);
+
+        void Execute();
+
+        // Valid for imports, exports after Execute, and transients inside their lifetime
+        uint32_t GetTexture(Resource resource) const;
+        const RenderTargetDesc& GetDesc(Resource resource) const { return m_Resources[resource].Desc; }
+        // Fraction of the pooled texture covered by the target's Width x Height
+        void GetUVScale(Resource resource, float& u, float& v) const;
+
+        bool WasExecuted(const std::string& passName) const;
+        uint32_t GetCulledPassCount() const { return m_CulledPasses; }
+
+    private:
+        struct ResourceNode {
+            std::string Name;
+            RenderTargetDesc Desc;
+            uint32_t Texture = 0;
+            bool Imported = false;
+            bool Exported = false;
+            bool Written = false; // by a pass declared so far
+            uint32_t FirstUse = ~0u, LastUse = 0;
+        };
+
+        struct PassNode {
+            std::string Name;
+            std::vector<Resource> Reads, Writes;
+            bool SideEffect = false;
+            bool Live = false;
+            ExecuteFn Execute;
+        };
+
+        void Use(uint32_t pass, Resource resource);
+
+    private:
+        RenderTargetPool& m_Pool;
+        std::vector<ResourceNode> m_Resources;
+        std::vector<PassNode> m_Passes;
+        std::vector<uint32_t> m_Held; // exported textures, released by Reset
+        uint32_t m_CulledPasses = 0;
+    };
+
+} // namespace Engine
@@ -0,0 +1,81 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
+#include "Engine/Renderer/FramePacket.h"
+
+namespace Engine {
+
+    class Window;
+
+    // Owns the GL context on a dedicated thread and draws extracted frames.
+    //
+    // The simulation thread fills a FramePacket (BeginFrame), hands it over (SubmitFrame)
+    // and goes on to build the next one in the other slot while this thread submits the
+    // first, so the two stages overlap by one frame. BeginFrame only blocks when the
+    // render thread is a full frame behind.
+    //
+    // Everything else that needs the context (resource creation, glDelete* from
+    // destructors) is queued through RenderCommand::RunOnRenderThread /
+    // ReleaseOnRenderThread, in the same FIFO as the frames, so GL calls stay ordered.
+    class RenderThread {
+    public:
+        using RenderFn = std::function<void(const FramePacket&)>;
+
+        // Takes the context away from the calling thread; create it after all startup GL
+        // work. The destructor drains the queue and makes the context current here again.
+        RenderThread(Window& window, RenderFn render);
+        ~RenderThread();
+
+        RenderThread(const RenderThread&) = delete;
+        RenderThread& operator=(const RenderThread&) = delete;
+
+        // Packet to fill for the next frame (cleared). Waits while it's still being drawn.
+        FramePacket& BeginFrame();
+        // Queues the packet from BeginFrame for render + swap and flips to the other slot.
+        void SubmitFrame();
+
+        // Runs fn on the render thread and waits; exceptions are rethrown here.
+        // Runs inline when called from the render thread itself.
+        void Execute(const std::function<void()>& fn);
+        // Queues fn and returns.
+        void Enqueue(std::function<void()> fn);
+
+        bool IsRenderThread() const;
+
+        struct Stats {
+            uint64_t FramesSubmitted = 0;
+            uint64_t FramesRendered = 0;
+            float RenderMs = 0.0f;    // last frame: render callback + swap
+            float WaitMs = 0.0f;      // last BeginFrame: time the simulation thread stalled
+        };
+        Stats GetStats() const;
+
+    private:
+        void ThreadLoop();
+        void RenderSlot(uint32_t index);
+
+    private:
+        Window& m_Window;
+        RenderFn m_Render;
+
+        FramePacket m_Packets[2];
+        bool m_InFlight[2] = { false, false }; // guarded by m_Mutex
+        uint32_t m_WriteIndex = 0;             // simulation thread only
+        uint64_t m_FrameIndex = 0;
+
+        mutable std::mutex m_Mutex;
+        std::condition_variable m_QueueCV;
+        std::condition_variable m_SlotCV;
+        std::deque<std::function<void()>> m_Queue;
+        bool m_Stopping = false;
+        Stats m_Stats;
+
+        std::thread m_Thread;
+    };
+
+} // namespace Engine
@@ -12,6 +12,55 @@ namespace Engine {
     class Material;
     class TextureCube;
 
+    // One draw: what Submit records and what a FramePacket carries to the render thread.
+    struct DrawPacket {
+        uint64_t SortKey = 0;
+        std::shared_ptr<Material> MaterialPtr;
+        std::shared_ptr<VertexArray> VaoPtr;
+        glm::mat4 Model{ 1.0f };
+        uint32_t EntityID = 0;
+    };
+
+    // Per-frame renderer counters, split by the pass the work happened in.
+    struct RenderStats {
+        enum Pass : uint32_t { Shadow = 0, Prepass, Scene, Picking, Other, PassCount };
+
+        struct Counters {
+            uint32_t Submitted = 0;        // packets that reached a draw list
+            uint32_t Culled = 0;           // rejected by frustum culling before submit
+            uint32_t Drawn = 0;            // packets DrawSorted issued
+            uint32_t DrawCalls = 0;        // every glDraw* (skybox, fullscreen, overlays too)
+            uint32_t Batches = 0;          // runs of drawn packets sharing shader + VAO
+            uint64_t Triangles = 0;
+            uint32_t ShaderBinds = 0;
+            uint32_t VaoBinds = 0;
+            uint32_t TextureBinds = 0;
+            uint32_t UniformUploads = 0;
+            uint32_t FramebufferBinds = 0;
+
+            Counters& operator+=(const Counters& o);
+        };
+
+        // Depth pre-pass occlusion queries (GL_SAMPLES_PASSED). DepthSamples passed the
+        // pre-pass depth test: what shading the list in submission order would have cost.
+        // ShadedSamples passed GL_EQUAL in the colour pass: what was actually shaded.
+        // Read without stalling, so they come from an earlier frame.
+        struct DepthPrepassResult {
+            uint64_t Frame = 0; // frame the queries were issued in; 0 = none resolved
+            uint64_t DepthSamples = 0;
+            uint64_t ShadedSamples = 0;
+
+            uint64_t SavedSamples() const { return DepthSamples > ShadedSamples ? DepthSamples - ShadedSamples : 0; }
+        };
+
+        uint64_t Frame = 0; // increments with every EndStatsFrame
+        Counters Passes[PassCount];
+        DepthPrepassResult DepthPrepass; // only while the pre-pass is on
+
+        Counters Total() const;
+        static const char* GetPassName(Pass pass);
+    };
+
     class Renderer {
     public:
         static void Init();
@@ -29,7 +78,36 @@ namespace Engine {
             const glm::mat4& model,
             uint32_t entityID);
 
-        static void EndScene();
+        static void EndScene(); // SortDrawList + DrawScene
+
+        // EndScene's sort step on its own (benchmarks time it without issuing draws)
+        static void SortDrawList();
+        static size_t GetDrawListSize() { return s_DrawList.size(); }
+
+        // shader:16 | permutation:6 | material ID:18 | VAO:24, so sorted lists bind each
+        // program variant, material (textures + parameter block) and mesh once per run.
+        // Fields are truncated to their width; that only costs sort quality.
+        static uint64_t MakeSortKey(const Material& material, const VertexArray& vao);
+
+        // Draws an already sorted list with the current scene state (between BeginScene
+        // and EndScene, or instead of them). overrideMaterial replaces every packet's
+        // material, e.g. the depth-only material for shadow casters.
+        static void DrawSorted(const std::vector<DrawPacket>& draws,
+            const std::shared_ptr<Material>& overrideMaterial = nullptr);
+
+        // An already sorted scene list: its opaque draws (behind the depth pre-pass when
+        // one is set), the skybox queued by SubmitSkybox, then its blended draws
+        // (Material::IsBlended). EndScene's draw step.
+        static void DrawScene(const std::vector<DrawPacket>& draws);
+
+        // --- Depth pre-pass ---
+        // While set, DrawScene first draws the list with depthMaterial and colour writes
+        // off, then shades it with GL_EQUAL and depth writes off, so each covered pixel
+        // runs the lit fragment shader once. Blended draws (Material::IsBlended) and
+        // draws whose program is still compiling skip the pre-pass and follow with
+        // GL_LEQUAL. Scene vertex shaders must compute gl_Position exactly like
+        // depthMaterial's (invariant, same expression). nullptr = off.
+        static void SetDepthPrepass(const std::shared_ptr<Material>& depthMaterial);
 
         // --- Lighting (simple global directional light for now) ---
         static void SetDirectionalLight(const glm::vec3& dir, const glm::vec3& color);
@@ -59,24 +137,37 @@ namespace Engine {
 
         // Skybox
         static void SetSkybox(const std::shared_ptr<TextureCube>& sky);
-        static void DrawSkybox(const PerspectiveCamera& camera);
+        // Drawn by DrawScene between the opaque and blended draws: covered pixels fail
+        // the depth test early, and blended surfaces still show the sky behind them.
+        // Cleared by BeginScene.
+        static void SubmitSkybox(const PerspectiveCamera& camera);
+        static void DrawSkybox(const PerspectiveCamera& camera); // right away
 
         static glm::mat4 s_View;
 
-    private:
-        struct DrawCommand {
-            uint64_t SortKey = 0;
-            std::shared_ptr<Material> MaterialPtr;
-            std::shared_ptr<VertexArray> VaoPtr;
-            glm::mat4 Model{ 1.0f };
-            uint32_t EntityID = 0;
-        };
+        // --- Stats ---
+        // Counted on the thread that issues GL (the render thread when there is one).
+        // RendererPipeline switches the pass; anything outside a pass counts as Other.
+        // EndStatsFrame publishes the frame's counters to GetStats and starts over.
+        static const RenderStats& GetStats() { return s_LastStats; }
+        static void EndStatsFrame();
+        static void SetStatsPass(RenderStats::Pass pass) { s_StatsPass = pass; }
+        static RenderStats::Pass GetStatsPass() { return s_StatsPass; }
+        static RenderStats::Counters& CurrentStats() { return s_Stats.Passes[s_StatsPass]; }
 
-        static void Flush();
+    private:
+        // DrawSorted over the packets whose (*mask)[i] == keep (all when mask is null)
+        static void DrawSortedFiltered(const std::vector<DrawPacket>& draws, const std::shared_ptr<Material>& overrideMaterial,
+            const std::vector<uint8_t>* mask, uint8_t keep);
 
     private:
         static glm::mat4 s_ViewProjection;
-        static std::vector<DrawCommand> s_DrawList;
+        static std::vector<DrawPacket> s_DrawList;
+        static std::shared_ptr<Material> s_DepthPrepassMaterial;
+
+        static RenderStats s_Stats;
+        static RenderStats s_LastStats;
+        static RenderStats::Pass s_StatsPass;
     };
 
 } // namespace Engine
\ No newline at end of file
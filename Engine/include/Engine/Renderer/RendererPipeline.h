@@ -1,44 +1,98 @@
 #pragma once
 #include <memory>
 #include <cstdint>
+#include <chrono>
+#include <functional>
 #include <glm/glm.hpp>
 
+#include "Engine/Renderer/RenderGraph.h"
+
 namespace Engine {
 
-    class Framebuffer;
     class Shader;
     class VertexArray;
     class PerspectiveCamera;
     class Material;
+    struct FramePacket;
 
     class RendererPipeline {
     public:
         RendererPipeline();
         ~RendererPipeline();
 
-        // --- Scene pass (renders into offscreen scene framebuffer) ---
-        void BeginScenePass(uint32_t width, uint32_t height, const PerspectiveCamera& camera);
-        void EndScenePass();
-
-        // --- Picking pass ---
-        void BeginPickingPass(uint32_t width, uint32_t height, const PerspectiveCamera& camera);
-        void EndPickingPass();
-        uint32_t ReadPickingID(uint32_t mouseX, uint32_t mouseY) const; // mouse coords top-left origin
+        // --- Frame graph ---
+        // A frame is declared between BeginFrame and EndFrame and runs in EndFrame: the
+        // RenderGraph culls passes nothing reads, takes the viewport-sized targets from
+        // a pool (shared between passes whose lifetimes don't overlap) and runs the rest
+        // in the order added. Draw callbacks run inside EndFrame. GL thread.
+        void BeginFrame(uint32_t width, uint32_t height);
+        void EndFrame();
+
+        // Cascades into the shadow map array; drawCascade(i) submits casters (with
+        // GetShadowDepthMaterial) between BeginScene(lightMatrices[i]) and EndScene.
+        // Hands the result to Lit via Renderer::SetCSMShadowMap.
+        void AddShadowPass(uint32_t shadowSize, const glm::mat4* lightMatrices, const float* cascadeSplits,
+            uint32_t cascadeCount, std::function<void(uint32_t cascade)> drawCascade);
+
+        // Clears the scene target and calls draw between BeginScene(camera) and EndScene.
+        // draw submits, or draws a sorted list itself with Renderer::DrawScene.
+        void AddScenePass(const PerspectiveCamera& camera, std::function<void()> draw);
+
+        // Scene passes lay depth down first with the shadow-depth material and shade with
+        // GL_EQUAL (see Renderer::SetDepthPrepass). Pays off when the lit shader is the
+        // bottleneck and opaque surfaces overlap; RenderStats::DepthPrepass reports the
+        // samples it kept from being shaded. Off by default.
+        void SetDepthPrepassEnabled(bool enabled) { m_DepthPrepassEnabled = enabled; }
+        bool IsDepthPrepassEnabled() const { return m_DepthPrepassEnabled; }
+        // Draws on the scene pass's colour + depth; no clear, no BeginScene. This and
+        // the compose / present passes need AddScenePass earlier in the frame.
+        void AddOverlayPass(std::function<void()> draw);
+
+        // Entity IDs (GetIDMaterial) for ReadPickingID. Only runs in frames after a
+        // RequestPicking; otherwise the graph culls it.
+        void AddPickingPass(const PerspectiveCamera& camera, std::function<void()> draw);
+        void RequestPicking() { m_PickingRequested = true; }
+        // The last executed frame rendered picking; its IDs stay readable until the next BeginFrame.
+        bool HasPickingResult() const { return m_PickingTarget != RenderGraph::None; }
+        uint32_t ReadPickingID(uint32_t mouseX, uint32_t mouseY); // mouse coords top-left origin
         std::shared_ptr<Material> GetIDMaterial() const { return m_IDMaterial; }
 
-        // --- Composition (Scene + ID outline into a color texture for UI) ---
-        void Compose();                          // writes into Composite framebuffer
-        uint32_t GetCompositeTexture() const;    // show this in ImGui viewport
+        // Tonemapped scene into a texture for the ImGui viewport, kept until the next BeginFrame.
+        void AddComposePass();
+        uint32_t GetCompositeTexture() const;
+        // Pooled targets are rounded up in size; the composite covers [0, scale] in UV.
+        glm::vec2 GetCompositeUVScale() const;
+
+        // Tonemapped scene to the default framebuffer.
+        void AddPresentPass();
+
+        // Whole frame from an extracted packet: shadow cascades, scene pass, present.
+        // This is what a RenderThread runs; it only reads the packet.
+        void RenderFramePacket(const FramePacket& packet);
 
-        // Optional fullscreen present (Sandbox can still use it)
-        void PresentToScreen();
+        const RenderGraph& GetGraph() const { return m_Graph; }
+
+        // --- Per-pass timings (RenderFramePacket only, off by default) ---
+        // Cpu = time spent issuing the pass, Gpu = GL_TIME_ELAPSED. Queries are read
+        // QueryLatency frames later so they never stall, which makes the published set
+        // belong to an older frame: check FrameIndex.
+        enum class Pass : uint32_t { Shadow = 0, Scene, Present, Count };
+        static constexpr uint32_t PassCount = (uint32_t)Pass::Count;
+        static const char* GetPassName(Pass pass);
+
+        struct PassTimings {
+            uint64_t FrameIndex = 0; // FramePacket::FrameIndex; 0 = nothing resolved yet
+            float CpuMs[PassCount] = {};
+            float GpuMs[PassCount] = {};
+        };
+
+        void SetPassTimingEnabled(bool enabled) { m_PassTimingEnabled = enabled; }
+        const PassTimings& GetPassTimings() const { return m_PassTimings; }
 
         // --- Selection outline input (used by Screen.shader) ---
         void SetSelectedID(uint32_t id) { m_SelectedID = id; }
         uint32_t GetSelectedID() const { return m_SelectedID; }
 
-        void BeginOverlayPass(); // binds scene framebuffer, no clear
-        void EndOverlayPass();   // currently no-op
         float m_Exposure = 1.0f;
         int   m_Tonemap = 2;     // ACES default
         float m_Vignette = 0.0f;
@@ -46,42 +100,47 @@ namespace Engine {
         // --- Shadows (CSM) ---
         static constexpr uint32_t MaxCascades = 4;
 
-        void BeginShadowPass(uint32_t shadowSize,
-            const glm::mat4& lightViewProj,
-            uint32_t cascadeIndex,
-            uint32_t cascadeCount = MaxCascades);
-        void EndShadowPass();
-
         uint32_t GetShadowDepthTextureArray() const { return m_ShadowDepthTexArray; }
         uint32_t GetShadowCascadeCount() const { return m_ShadowCascadeCount; }
         std::shared_ptr<Material> GetShadowDepthMaterial() const { return m_ShadowDepthMaterial; }
 
     private:
-        void EnsureSceneResources(uint32_t width, uint32_t height);
-        void EnsurePickingResources(uint32_t width, uint32_t height);
-        void EnsureCompositeResources(uint32_t width, uint32_t height);
-        void DrawFullscreen(); // draws Screen.shader using Scene + ID
+        void DrawFullscreen(uint32_t sceneTexture, float uvScaleX, float uvScaleY); // Screen.shader
         void EnsureShadowResources(uint32_t shadowSize);
+        void EnsureShadowDepthMaterial();
+        bool BeginShadowCascade(const glm::mat4& lightViewProj, uint32_t cascadeIndex);
+        void EndShadowCascade();
 
+        void BeginPassTimer(Pass pass);
+        void EndPassTimer(Pass pass);
+        void ResolvePassTimers(); // publishes the oldest slot before it gets reused
 
     private:
-        // Scene
-        std::unique_ptr<Framebuffer> m_SceneFB;
+        // Viewport-sized targets live in the pool; the shadow array is fixed-size and
+        // imported into each frame's graph.
+        RenderTargetPool m_TargetPool;
+        RenderGraph m_Graph{ m_TargetPool };
+
+        uint32_t m_Width = 0, m_Height = 0;
+
+        // this frame's graph resources (RenderGraph::None when not declared)
+        RenderGraph::Resource m_ShadowMap = RenderGraph::None;
+        RenderGraph::Resource m_SceneColor = RenderGraph::None;
+        RenderGraph::Resource m_SceneDepth = RenderGraph::None;
+        RenderGraph::Resource m_PickingTarget = RenderGraph::None;
+        RenderGraph::Resource m_PickingDepth = RenderGraph::None;
+        RenderGraph::Resource m_CompositeTarget = RenderGraph::None;
+
         std::shared_ptr<Shader> m_ScreenShader;
         std::shared_ptr<VertexArray> m_ScreenQuadVAO;
 
         // Picking
-        std::unique_ptr<Framebuffer> m_IDFB;
         std::shared_ptr<Shader> m_IDShader;
         std::shared_ptr<Material> m_IDMaterial;
+        bool m_PickingRequested = false;
 
-        // Composite (for ImGui viewport)
-        std::unique_ptr<Framebuffer> m_CompositeFB;
-
-        uint32_t m_Width = 0, m_Height = 0;
-        bool m_ScenePassActive = false;
-        bool m_PickingPassActive = false;
         uint32_t m_SelectedID = 0;
+        bool m_DepthPrepassEnabled = false;
 
         uint32_t m_ShadowSize = 2048;
         uint32_t m_ShadowCascadeCount = MaxCascades;
@@ -92,10 +151,18 @@ namespace Engine {
         std::shared_ptr<Shader>   m_ShadowDepthShader;
         std::shared_ptr<Material> m_ShadowDepthMaterial;
 
-        bool m_ShadowPassActive = false;
-
         uint32_t m_ShadowAllocSize = 0;
         uint32_t m_ShadowAllocCascades = 0;
+
+        // Pass timers: QueryLatency frames of GL_TIME_ELAPSED queries in a ring
+        static constexpr uint32_t QueryLatency = 3;
+        bool m_PassTimingEnabled = false;
+        uint32_t m_TimerQueries[QueryLatency][PassCount] = {};
+        uint32_t m_TimerIssued[QueryLatency] = {}; // bit per pass
+        PassTimings m_TimerPending[QueryLatency];
+        uint32_t m_TimerSlot = 0;
+        std::chrono::steady_clock::time_point m_PassStart;
+        PassTimings m_PassTimings;
     };
 
 } // namespace Engine
\ No newline at end of file
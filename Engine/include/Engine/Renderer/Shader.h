@@ -1,12 +1,18 @@
 #pragma once
+#include <atomic>
+#include <filesystem>
+#include <memory>
 #include <string>
 #include <cstdint>
+#include <unordered_map>
+#include <vector>
 
 namespace Engine {
 
     class Shader {
     public:
-        // From file (our #type format)
+        // From file (our #type format, with #include "relative/path" and
+        // #pragma keywords, see ShaderKeywords.h); blocks until the program is linked
         explicit Shader(const std::string& filepath);
 
         void SetUInt(const std::string& name, uint32_t value) const;
@@ -14,32 +20,107 @@ namespace Engine {
         // From source strings (keep for quick tests)
         Shader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc);
 
+        // Issues the compiles and the link and returns without waiting for them. With
+        // KHR_parallel_shader_compile the driver builds in the background and IsReady
+        // polls; without it the build finishes the first time IsReady or Bind asks.
+        // Compile / link errors are logged and leave the shader failed (never ready)
+        // instead of throwing. GL thread only.
+        static std::shared_ptr<Shader> CreateAsync(const std::string& filepath);
+
         ~Shader();
 
         const std::string& GetName() const { return m_Name; }
-        uint32_t GetRendererID() const { return m_RendererID; }
+        uint32_t GetRendererID() const { return m_RendererID.load(std::memory_order_relaxed); }
+
+        // GL thread. True once the program is linked; never blocks. Renderers skip draws
+        // with shaders that aren't ready. Also swaps in a finished hot reload.
+        bool IsReady();
+        bool HasFailed() const { return m_State == State::Failed; }
+        bool IsBuilding() const; // this program or any of its variants
+
+        // GL thread. Starts rebuilding from the source file when it changed on disk; the
+        // current program keeps drawing until the new one links, and stays if it fails.
+        // Variants rebuild with it.
+        bool ReloadIfChanged();
+
+        // ShaderKeyword bits this file declared; 0 for shaders without variants.
+        uint32_t GetKeywords() const { return m_Source.Keywords; }
 
+        // GL thread. The program compiled for `permutation` (bits the shader didn't
+        // declare are ignored; no bits is this shader itself). Variants are built
+        // asynchronously on first use and cached; poll IsReady before drawing.
+        Shader& GetVariant(uint32_t permutation);
+
+        // Binding a shader that is still building waits for it.
         void Bind() const;
 
+        // Declares "MaterialBlock" (bound to UniformBinding::Material at link). Shaders
+        // without it still get u_Color as a plain uniform.
+        bool HasMaterialBlock() const { return m_HasMaterialBlock; }
+
         void SetMat4(const std::string& name, const float* value4x4) const;
         void SetFloat4(const std::string& name, float x, float y, float z, float w) const;
 
         void SetInt(const std::string& name, int value) const;
 
+        void SetFloat2(const std::string& name, float x, float y) const;
         void SetFloat3(const std::string& name, float x, float y, float z) const;
 
         void SetFloat(const std::string& name, float value) const;
 
     private:
-        uint32_t CompileStage(uint32_t type, const std::string& src);
+        Shader() = default; // CreateAsync, variants
+
+        // one in-flight compile + link; Program == 0 means none
+        struct Build {
+            uint32_t Program = 0;
+            uint32_t VertexStage = 0, FragmentStage = 0; // 0 when loaded from ShaderCache
+            uint64_t CacheKey = 0;
+        };
+
+        enum class State : uint8_t { Ready, Pending, Failed };
+
+        static Build BeginBuild(const std::string& vertexSrc, const std::string& fragmentSrc);
+        static bool IsBuildComplete(const Build& build);
+        // linked program, or 0 after logging the errors; releases the stages either way
+        static uint32_t FinishBuild(Build& build, const std::string& name);
+
         uint32_t CreateProgram(const std::string& vertexSrc, const std::string& fragmentSrc);
+        void FinishPending() const;
+        // installs a linked program: block bindings and the u_TextureN sampler units
+        // are set once here instead of per draw
+        void SetProgram(uint32_t program) const;
+
+        struct Source {
+            std::string Vertex, Fragment; // #includes expanded, no keyword #defines yet
+            uint32_t Keywords = 0;
+            std::vector<std::string> Includes; // every file pulled in, for hot reload
+        };
+
+        static std::string ReadFile(const std::string& filepath);
+        static Source ParseShaderFile(const std::string& filepath);
+        static std::string ExpandIncludes(const std::string& source, const std::string& filepath,
+            std::vector<std::string>& stack, std::vector<std::string>& outIncludes);
+        // #defines for the permutation's keywords, right after the #version line
+        static std::string InjectDefines(const std::string& stage, uint32_t keywords, uint32_t permutation);
 
-        std::string ReadFile(const std::string& filepath);
-        void ParseShaderFile(const std::string& source, std::string& outVertex, std::string& outFragment);
+        Build BeginVariantBuild(uint32_t permutation) const;
+        std::filesystem::file_time_type GetSourceTime() const; // newest of the file and its includes
 
     private:
-        uint32_t m_RendererID = 0;
+        mutable std::atomic<uint32_t> m_RendererID{ 0 };
         std::string m_Name;
+
+        mutable State m_State = State::Ready;
+        mutable bool m_HasMaterialBlock = false;
+        mutable Build m_Pending; // initial async build
+        Build m_Reload;          // hot reload, swapped in by IsReady
+
+        std::string m_FilePath;  // empty for shaders built from strings
+        std::filesystem::file_time_type m_FileTime{};
+
+        Source m_Source;         // parsed file; variants and reloads build from it
+        std::unordered_map<uint32_t, std::unique_ptr<Shader>> m_Variants;
     };
 
-} // namespace Engine
\ No newline at end of file
+} // namespace Engine
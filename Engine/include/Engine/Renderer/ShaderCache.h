@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+namespace Engine {
+
+    // On-disk cache of linked GL program binaries (GL_ARB_get_program_binary), so
+    // launches after the first skip GLSL compile + link. Entries are keyed by a hash of
+    // the stage sources and the GL vendor / renderer / version strings: a source edit
+    // or a driver update just misses and rebuilds. Shader uses it transparently; a
+    // binary the driver rejects is deleted and the program recompiled from source.
+    //
+    // Everything except the settings must run on the GL thread.
+    class ShaderCache {
+    public:
+        struct Stats {
+            uint32_t Hits = 0;
+            uint32_t Misses = 0;
+            uint32_t Rejected = 0; // binary on disk, driver refused it
+            uint32_t Stored = 0;
+        };
+
+        // Default "Cache/Shaders", relative to the working directory like Assets/.
+        static void SetDirectory(const std::string& directory) { s_Directory = directory; }
+        static const std::string& GetDirectory() { return s_Directory; }
+
+        static void SetEnabled(bool enabled) { s_Enabled = enabled; }
+        static bool IsEnabled() { return s_Enabled; }
+
+        // Enabled and the driver exposes at least one binary format.
+        static bool IsAvailable();
+
+        static uint64_t MakeKey(const std::string& vertexSrc, const std::string& fragmentSrc);
+
+        // Linked program from the cache, or 0 on a miss / rejected binary.
+        static uint32_t Load(uint64_t key);
+
+        // Call before glLinkProgram on programs that will be stored.
+        static void PrepareForLink(uint32_t program);
+        static void Store(uint64_t key, uint32_t program);
+
+        static const Stats& GetStats() { return s_Stats; }
+
+    private:
+        static std::string GetPath(uint64_t key);
+
+        static std::string s_Directory;
+        static bool s_Enabled;
+        static Stats s_Stats;
+    };
+
+} // namespace Engine
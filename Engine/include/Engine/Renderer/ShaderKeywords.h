@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+
+namespace Engine {
+
+    // Compile-time shader features. A shader file opts in with
+    //     #pragma keywords HAS_TEXTURE0 USE_LIGHTING RECEIVE_SHADOWS CASCADE_COUNT
+    // and each variant is compiled with the matching #defines injected after #version.
+    // A permutation is a bitmask of these; Material stores its part (HAS_TEXTURE0,
+    // HAS_TEXTURE0_ARRAY, RECEIVE_SHADOWS) and the renderer adds the per-frame part
+    // (lighting, cascades).
+    namespace ShaderKeyword {
+
+        constexpr uint32_t HasTexture0    = 1u << 0; // HAS_TEXTURE0
+        constexpr uint32_t UseLighting    = 1u << 1; // USE_LIGHTING
+        constexpr uint32_t ReceiveShadows = 1u << 2; // RECEIVE_SHADOWS
+
+        // CASCADE_COUNT=N, stored as N - 1 so the field can't encode 0 cascades
+        constexpr uint32_t CascadeShift = 3;
+        constexpr uint32_t CascadeMask  = 3u << CascadeShift;
+        constexpr uint32_t MaxCascades  = 4;
+
+        // u_Texture0 is a sampler2DArray, sampled at MaterialParams::Texture0Layer
+        constexpr uint32_t HasTexture0Array = 1u << 5; // HAS_TEXTURE0_ARRAY
+
+        constexpr uint32_t CascadeCount(uint32_t count) {
+            return ((count > 0 ? count - 1 : 0) << CascadeShift) & CascadeMask;
+        }
+
+        constexpr uint32_t GetCascadeCount(uint32_t permutation) {
+            return ((permutation & CascadeMask) >> CascadeShift) + 1;
+        }
+
+        // every bit above; Renderer::MakeSortKey keeps this many
+        constexpr uint32_t All = HasTexture0 | UseLighting | ReceiveShadows | CascadeMask | HasTexture0Array;
+
+    } // namespace ShaderKeyword
+
+} // namespace Engine
@@ -1,20 +1,35 @@
 #pragma once
 #include <unordered_map>
 #include <memory>
+#include <mutex>
 #include <string>
 
 namespace Engine {
 
     class Shader;
 
+    // Engine-wide shaders that aren't assets (skybox, screen, ID, shadow depth, editor
+    // gizmos / icons). Load returns the existing program for a path that was already
+    // loaded, so each file is compiled once however many systems ask for it.
+    // Programs are created on the calling thread, which must own the GL context, and
+    // build asynchronously (see Shader::CreateAsync).
     class ShaderLibrary {
     public:
+        static ShaderLibrary& Get();
+
         void Add(const std::shared_ptr<Shader>& shader);
         std::shared_ptr<Shader> Load(const std::string& filepath);
         std::shared_ptr<Shader> Get(const std::string& name) const;
+        bool Exists(const std::string& name) const;
+
+        // GL thread. Starts a rebuild of every shader whose file changed; returns how many.
+        uint32_t ReloadChanged();
+        // GL thread. Advances pending builds and reloads; true while any is still building.
+        bool PollBuilds();
 
     private:
+        mutable std::mutex m_Mutex;
         std::unordered_map<std::string, std::shared_ptr<Shader>> m_Shaders;
     };
 
-} // namespace Engine
\ No newline at end of file
+} // namespace Engine
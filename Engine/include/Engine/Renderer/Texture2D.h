@@ -20,6 +20,9 @@ namespace Engine {
         uint32_t GetWidth() const { return m_Width; }
         uint32_t GetHeight() const { return m_Height; }
 
+        // RGBA8 base level + full mip chain (~4/3 of the base level)
+        size_t GetGPUMemoryBytes() const { return ((size_t)m_Width * m_Height * 4 * 4) / 3; }
+
     private:
         Texture2D() = default; // used by CreateFromMemory/CreateFromRGBA8
         void UploadRGBA8(const uint8_t* rgbaPixels, int width, int height);
@@ -0,0 +1,36 @@
+#pragma once
+#include <string>
+#include <cstdint>
+
+namespace Engine {
+
+    // GL_TEXTURE_2D_ARRAY of same-size RGBA8 layers. Model import packs a model's
+    // equally sized textures into these pages so materials that only differ by
+    // albedo share one texture binding (layer index in MaterialParams).
+    class TextureArray {
+    public:
+        // Allocates all layers (contents undefined until SetLayerRGBA8). GL thread.
+        TextureArray(const std::string& debugName, uint32_t width, uint32_t height, uint32_t layers);
+        ~TextureArray();
+
+        void SetLayerRGBA8(uint32_t layer, const uint8_t* rgbaPixels);
+        // After the last SetLayerRGBA8
+        void GenerateMipmaps();
+
+        void Bind(uint32_t slot = 0) const;
+        uint32_t GetRendererID() const { return m_RendererID; }
+
+        uint32_t GetWidth() const { return m_Width; }
+        uint32_t GetHeight() const { return m_Height; }
+        uint32_t GetLayerCount() const { return m_Layers; }
+
+        // RGBA8 layers + full mip chains
+        size_t GetGPUMemoryBytes() const { return ((size_t)m_Width * m_Height * 4 * m_Layers * 4) / 3; }
+
+    private:
+        uint32_t m_RendererID = 0;
+        uint32_t m_Width = 0, m_Height = 0, m_Layers = 0;
+        std::string m_DebugName;
+    };
+
+} // namespace Engine
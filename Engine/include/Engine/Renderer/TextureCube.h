@@ -14,8 +14,12 @@ namespace Engine {
         void Bind(uint32_t slot = 0) const;
         uint32_t GetRendererID() const { return m_RendererID; }
 
+        // faces as uploaded, no mips
+        size_t GetGPUMemoryBytes() const { return m_GPUMemoryBytes; }
+
     private:
         uint32_t m_RendererID = 0;
+        size_t m_GPUMemoryBytes = 0;
     };
 
 } // namespace Engine
\ No newline at end of file
@@ -68,4 +68,15 @@ namespace Engine {
     
     };
 
+    // Runtime trigger volume (not serialized yet). SceneWarp entities without one get
+    // a sphere of TriggerRadius from the TriggerSystem.
+    struct TriggerComponent {
+        enum class ShapeType : uint8_t { Sphere, Box };
+
+        ShapeType Shape = ShapeType::Sphere;
+        float Radius = 1.0f;                  // sphere, meters, centered on Translation
+        glm::vec3 HalfExtents{ 0.5f };        // box, local space (rotated and scaled by the transform)
+        float Cooldown = 0.0f;                // seconds after an Enter before the next Enter can fire
+    };
+
 } // namespace Engine
\ No newline at end of file
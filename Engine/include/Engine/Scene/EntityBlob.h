@@ -0,0 +1,35 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <cstdint>
+
+#include "Engine/Scene/Entity.h"
+#include "Engine/Scene/UUID.h"
+
+namespace Engine {
+
+    class Scene;
+
+    // One entity packed into bytes with the .sceneb component encoding (raw UUID and
+    // TransformComponent, packed light/warp, a small local string table). Asset references
+    // stay as handles, so a blob is only meaningful within the running project.
+    // Meant for undo history and copies: a plain entity is ~70 bytes.
+    using EntityBlob = std::vector<uint8_t>;
+
+    EntityBlob CaptureEntityBlob(const Scene& scene, Entity entity);
+
+    // Recreates the entity with its original UUID. If that UUID is already live, the
+    // existing entity is returned untouched (redo after a partial undo can't duplicate).
+    Entity RestoreEntityBlob(Scene& scene, const EntityBlob& blob);
+
+    // Bulk form: creates all missing entities with one registry range call and inserts
+    // each component type as one column. Result is parallel to `blobs` (existing entity
+    // for live UUIDs, entt::null for blobs that fail to decode).
+    std::vector<entt::entity> RestoreEntityBlobs(Scene& scene, const std::vector<EntityBlob>& blobs);
+
+    UUID GetEntityBlobID(const EntityBlob& blob);
+
+    // Same components under a new identity (duplicate / paste).
+    EntityBlob RetargetEntityBlob(const EntityBlob& blob, UUID newID, const std::string& newTag);
+
+} // namespace Engine
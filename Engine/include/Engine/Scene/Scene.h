@@ -3,6 +3,11 @@
 #include <string>
 #include <memory>
 #include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <deque>
+#include <vector>
+#include <string_view>
 #include "Engine/Scene/Entity.h"
 #include "Engine/Scene/UUID.h"
 
@@ -12,12 +17,15 @@ namespace Engine {
 
     class PerspectiveCamera;
     class Material; // <-- ADD
+    struct FramePacket;
 
     class Scene {
     public:
-        Scene() = default;
+        Scene();
 
-        Entity FindEntityByPickID(uint32_t pickID);
+        // component signals capture 'this'
+        Scene(const Scene&) = delete;
+        Scene& operator=(const Scene&) = delete;
 
         entt::registry& Registry() { return m_Registry; }
         const entt::registry& Registry() const { return m_Registry; }
@@ -27,10 +35,27 @@ namespace Engine {
         Entity DuplicateEntity(Entity src);
         void DestroyEntity(Entity entity);
 
+        // Bulk forms for multi-entity edits: one index pass and one registry range call.
+        // Unknown UUIDs resolve to entt::null / are skipped.
+        std::vector<entt::entity> FindEntitiesByUUID(const std::vector<UUID>& ids) const;
+        void DestroyEntities(const std::vector<UUID>& ids);
+
         void Clear();
 
+        // --- Lookups (hash indices kept current through IDComponent/TagComponent signals) ---
         Entity FindEntityByUUID(UUID id);
+
+        // Tags aren't unique: this returns one of them, GetEntitiesWithTag returns all.
         Entity FindEntityByTag(const std::string& tag);
+        const std::vector<entt::entity>& GetEntitiesWithTag(const std::string& tag) const;
+
+        // Pick IDs are a 32-bit fold of the 64-bit UUID, so two entities can share one.
+        // A shared ID returns a null Entity (never an arbitrary one) and sets outCollision.
+        Entity FindEntityByPickID(uint32_t pickID, bool* outCollision = nullptr);
+        static uint32_t PickIDFromUUID(UUID id);
+
+        // Tag edits must come through here (registry.patch) to keep the tag index right.
+        void SetEntityTag(Entity entity, const std::string& tag);
 
         void OnUpdate(float dt);
         void OnRender(const PerspectiveCamera& camera);
@@ -39,10 +64,70 @@ namespace Engine {
             const std::shared_ptr<Material>& idMaterial);
         
         void OnRenderShadow(const std::shared_ptr<Material>& shadowDepthMat);
+
+        // Render-thread path: fills packet.Draws (culled against packet.Camera, sorted),
+        // packet.ShadowCasters and the light. Cascades / viewport are the caller's.
+        void ExtractFramePacket(FramePacket& packet);
         bool GetMainDirectionalLight(glm::vec3& outDir, glm::vec3& outColor);
 
+        // --- Change tracking (incremental saves) ---
+        // emplace/patch/remove/destroy are picked up through EnTT signals.
+        // Code that writes a component in place (ImGui fields, gizmo) must call
+        // MarkEntityDirty, because entt can't see those writes.
+        void MarkEntityDirty(Entity entity);
+        void MarkEntitiesDirty(const std::vector<entt::entity>& entities);
+        void SetChangeTrackingEnabled(bool enabled) { m_TrackChanges = enabled; }
+        bool IsChangeTrackingEnabled() const { return m_TrackChanges; }
+
+        bool HasTrackedChanges() const { return !m_DirtyEntities.empty() || !m_DestroyedEntities.empty(); }
+        const std::unordered_map<UUID, entt::entity>& GetDirtyEntities() const { return m_DirtyEntities; }
+        const std::unordered_set<UUID>& GetDestroyedEntities() const { return m_DestroyedEntities; }
+        void ClearTrackedChanges();
+
+        // Bumped by every change the tracking above sees (and by Clear), whether or not
+        // tracking is enabled. Views compare it to skip redrawing an unchanged scene.
+        uint64_t GetChangeVersion() const { return m_ChangeVersion; }
+
+    private:
+        template<typename... Components>
+        void ConnectChangeSignals();
+        void OnComponentChanged(entt::registry& reg, entt::entity e);
+        void OnEntityDestroyed(entt::registry& reg, entt::entity e);
+
+        void OnIDConstruct(entt::registry& reg, entt::entity e);
+        void OnIDDestroy(entt::registry& reg, entt::entity e);
+        void OnTagConstruct(entt::registry& reg, entt::entity e);
+        void OnTagUpdate(entt::registry& reg, entt::entity e);
+        void OnTagDestroy(entt::registry& reg, entt::entity e);
+
+        uint32_t InternTag(const std::string& tag);
+        void IndexTag(entt::entity e, uint32_t tagID);
+        void UnindexTag(entt::entity e);
+        void ResetIndices();
+
     private:
         entt::registry m_Registry;
+
+        bool m_TrackChanges = true;
+        uint64_t m_ChangeVersion = 0;
+        std::unordered_map<UUID, entt::entity> m_DirtyEntities; // changed or created since last save
+        std::unordered_set<UUID> m_DestroyedEntities;           // removed since last save
+
+        // --- Lookup indices ---
+        bool m_IndexingSuspended = false; // Clear() drops the indices wholesale
+
+        std::unordered_map<UUID, entt::entity> m_EntityByUUID;
+        std::unordered_map<uint32_t, entt::entity> m_EntityByPickID;
+        std::unordered_map<uint32_t, std::vector<entt::entity>> m_PickIDCollisions; // rare; all sharers
+
+        struct TagSlot {
+            uint32_t TagID = UINT32_MAX; // UINT32_MAX = not indexed
+            uint32_t Index = 0;          // position in m_EntitiesByTag[TagID]
+        };
+        std::deque<std::string> m_TagNames;                   // interned; stable for string_view keys
+        std::unordered_map<std::string_view, uint32_t> m_TagIDs;
+        std::vector<std::vector<entt::entity>> m_EntitiesByTag;
+        std::vector<TagSlot> m_TagSlots;                      // by entity index
     };
 
 } // namespace Engine
\ No newline at end of file
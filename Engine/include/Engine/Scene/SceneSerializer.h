@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include <cstdint>
 
 namespace Engine {
 
@@ -9,11 +10,42 @@ namespace Engine {
     public:
         explicit SceneSerializer(Scene& scene);
 
+        // Picks the format from the extension: ".sceneb" = binary, anything else = JSON.
         bool Serialize(const std::string& filepath);
         bool Deserialize(const std::string& filepath);
 
+        // Incremental save for JSON scenes: appends only the entities the Scene tracked
+        // as changed since the last load/save to "<filepath>.delta" (one JSON line per
+        // record) and leaves the base file alone. Deserialize replays the journal.
+        // Falls back to a full Serialize when the file on disk isn't the one this
+        // serializer last loaded/wrote, and compacts (full rewrite, journal removed)
+        // once the journal grows past a quarter of the base file.
+        bool SerializeDelta(const std::string& filepath);
+        static std::string GetDeltaPath(const std::string& filepath);
+
+        // Binary chunked format (.sceneb): header, string table, asset-ref table and one
+        // packed column per component type. Loaded through a memory map and bulk-inserted
+        // into EnTT storage. JSON stays the source format for diffs.
+        bool SerializeBinary(const std::string& filepath);
+        bool DeserializeBinary(const std::string& filepath);
+
+        static bool IsBinaryScenePath(const std::string& filepath);
+
+        // Offline converters; they don't touch the AssetManager or any live scene.
+        static bool ConvertJsonToBinary(const std::string& jsonPath, const std::string& binaryPath);
+        static bool ConvertBinaryToJson(const std::string& binaryPath, const std::string& jsonPath);
+
+    private:
+        bool SerializeJson(const std::string& filepath);
+        void SetBaseFile(const std::string& filepath, uint64_t revision);
+
     private:
         Scene& m_Scene;
+
+        // base file the delta journal applies to (JSON only)
+        std::string m_BasePath;
+        uint64_t m_BaseRevision = 0;
+        uintmax_t m_BaseSize = 0;
     };
 
-} // namespace Engine
\ No newline at end of file
+} // namespace Engine
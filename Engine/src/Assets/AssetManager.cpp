@@ -4,11 +4,17 @@
 #include "Engine/Renderer/Shader.h"
 #include "Engine/Renderer/Model.h"
 #include "Engine/Renderer/Texture2D.h"
+#include "Engine/Renderer/RenderCommand.h"
 
 #include "Engine/Core/Content.h"
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Core/MemoryTracker.h"
 
 #include <iostream>
 #include <filesystem>
+#include <algorithm>
+#include <vector>
+#include <exception>
 
 namespace Engine {
 
@@ -22,7 +28,12 @@ namespace Engine {
         m_Registry.Load();
     }
 
+    AssetManager::~AssetManager() {
+        m_Registry.SaveIfDirty();
+    }
+
     AssetHandle AssetManager::LoadShader(const std::string& path) {
+        MemoryScope memScope(MemoryTag::Assets);
         std::string resolved = Content::Resolve(path);
         if (!Content::Exists(resolved)) {
             std::cout << "[AssetManager] Shader file missing: " << resolved << "\n";
@@ -31,25 +42,28 @@ namespace Engine {
 
         // Register first ONLY after file exists
         AssetHandle id = m_Registry.Register(AssetType::Shader, resolved);
-        m_Registry.Save();
 
-        if (auto it = m_ShaderCache.find(id); it != m_ShaderCache.end())
+        if (auto it = m_ShaderCache.find(id); it != m_ShaderCache.end()) {
+            it->second.LastUsedFrame = m_FrameIndex;
             return id;
+        }
 
         try {
-            auto shader = std::make_shared<Shader>(resolved);
-            m_ShaderCache[id] = shader;
+            std::shared_ptr<Shader> shader;
+            RenderCommand::RunOnRenderThread([&]() { shader = Shader::CreateAsync(resolved); });
+            m_ShaderCache[id] = { shader, 0, m_FrameIndex };
+            m_Stats.ShaderCount++;
             return id;
         }
         catch (const std::exception& e) {
             std::cout << "[AssetManager] Shader load failed: " << resolved << " (" << e.what() << ")\n";
             m_Registry.Remove(id);
-            m_Registry.Save();
             return InvalidAssetHandle;
         }
     }
     
     AssetHandle AssetManager::LoadModel(const std::string& path, AssetHandle shaderHandle) {
+        MemoryScope memScope(MemoryTag::Assets);
         auto shader = GetShader(shaderHandle);
         if (!shader) {
             std::cout << "[AssetManager] Missing shader handle for model: " << path << "\n";
@@ -63,25 +77,144 @@ namespace Engine {
         }
 
         AssetHandle id = m_Registry.Register(AssetType::Model, resolved, shaderHandle);
-        m_Registry.Save();
 
-        if (auto it = m_ModelCache.find(id); it != m_ModelCache.end())
+        if (auto it = m_ModelCache.find(id); it != m_ModelCache.end()) {
+            it->second.LastUsedFrame = m_FrameIndex;
             return id;
+        }
 
         try {
-            auto model = std::make_shared<Model>(resolved, shader);
-            m_ModelCache[id] = model;
+            // import here, only the upload needs the GL thread
+            ModelData data = Model::Import(resolved);
+            if (m_PackModelTextures) Model::PackTextures(data);
+            std::shared_ptr<Model> model;
+            RenderCommand::RunOnRenderThread([&]() { model = std::make_shared<Model>(std::move(data), shader); });
+            size_t bytes = model->GetGPUMemoryBytes();
+            m_ModelCache[id] = { model, bytes, m_FrameIndex };
+            m_Stats.ModelBytes += bytes;
+            m_Stats.ModelCount++;
             return id;
         }
         catch (const std::exception& e) {
             std::cout << "[AssetManager] Model load failed: " << resolved << " (" << e.what() << ")\n";
             m_Registry.Remove(id);
-            m_Registry.Save();
             return InvalidAssetHandle;
         }
     }
 
+    std::vector<AssetHandle> AssetManager::LoadModels(const std::vector<ModelLoadRequest>& requests) {
+        MemoryScope memScope(MemoryTag::Assets);
+        std::vector<AssetHandle> result(requests.size(), InvalidAssetHandle);
+
+        // --- Resolve (main thread: registry + shader compile) ---
+        std::unordered_map<std::string, AssetHandle> shaderByPath;
+        std::unordered_map<std::string, std::string> resolvedModelPath;
+
+        struct PendingModel {
+            AssetHandle Handle;
+            std::string Path;
+            std::shared_ptr<Shader> ShaderPtr;
+            std::vector<size_t> Requests;
+        };
+        std::vector<PendingModel> pending;
+        std::unordered_map<AssetHandle, size_t> pendingIndex;
+
+        for (size_t i = 0; i < requests.size(); i++) {
+            const auto& req = requests[i];
+
+            auto sit = shaderByPath.find(req.ShaderPath);
+            if (sit == shaderByPath.end())
+                sit = shaderByPath.emplace(req.ShaderPath, LoadShader(req.ShaderPath)).first;
+
+            auto shader = GetShader(sit->second);
+            if (!shader) {
+                std::cout << "[AssetManager] Missing shader handle for model: " << req.ModelPath << "\n";
+                continue;
+            }
+
+            auto mit = resolvedModelPath.find(req.ModelPath);
+            if (mit == resolvedModelPath.end()) {
+                std::string resolved = Content::Resolve(req.ModelPath);
+                if (!Content::Exists(resolved)) {
+                    std::cout << "[AssetManager] Model file missing: " << resolved << "\n";
+                    resolved.clear();
+                }
+                mit = resolvedModelPath.emplace(req.ModelPath, std::move(resolved)).first;
+            }
+            if (mit->second.empty())
+                continue;
+
+            AssetHandle id = m_Registry.Register(AssetType::Model, mit->second, sit->second);
+
+            if (auto it = m_ModelCache.find(id); it != m_ModelCache.end()) {
+                it->second.LastUsedFrame = m_FrameIndex;
+                result[i] = id;
+                continue;
+            }
+
+            auto [pit, inserted] = pendingIndex.emplace(id, pending.size());
+            if (inserted)
+                pending.push_back({ id, mit->second, shader, {} });
+            pending[pit->second].Requests.push_back(i);
+        }
+
+        if (pending.empty())
+            return result;
+
+        // --- Import (job workers: file I/O, Assimp, image decode) ---
+        auto& jobs = JobSystem::Get();
+        std::vector<ModelData> imported(pending.size());
+        std::vector<std::exception_ptr> errors(pending.size());
+        std::unique_ptr<JobCounter[]> done(new JobCounter[pending.size()]);
+
+        for (size_t j = 0; j < pending.size(); j++) {
+            jobs.Schedule([&, j]() {
+                MemoryScope memScope(MemoryTag::Assets);
+                try {
+                    imported[j] = Model::Import(pending[j].Path);
+                    if (m_PackModelTextures) Model::PackTextures(imported[j]);
+                }
+                catch (...) {
+                    errors[j] = std::current_exception();
+                }
+                }, &done[j]);
+        }
+
+        // --- Upload (GL thread, in request order, overlapping the remaining imports) ---
+        for (size_t j = 0; j < pending.size(); j++) {
+            auto& pm = pending[j];
+            try {
+                // helps with the remaining imports while this one finishes
+                jobs.Wait(done[j]);
+                if (errors[j])
+                    std::rethrow_exception(errors[j]);
+
+                std::shared_ptr<Model> model;
+                RenderCommand::RunOnRenderThread([&]() { model = std::make_shared<Model>(std::move(imported[j]), pm.ShaderPtr); });
+                size_t bytes = model->GetGPUMemoryBytes();
+                m_ModelCache[pm.Handle] = { model, bytes, m_FrameIndex };
+                m_Stats.ModelBytes += bytes;
+                m_Stats.ModelCount++;
+
+                for (size_t r : pm.Requests)
+                    result[r] = pm.Handle;
+            }
+            catch (const std::exception& e) {
+                std::cout << "[AssetManager] Model load failed: " << pm.Path << " (" << e.what() << ")\n";
+                m_Registry.Remove(pm.Handle);
+            }
+            catch (...) {
+                // never leave with imports still running
+                std::cout << "[AssetManager] Model load threw: " << pm.Path << "\n";
+                m_Registry.Remove(pm.Handle);
+            }
+        }
+
+        return result;
+    }
+
     AssetHandle AssetManager::LoadTexture2D(const std::string& path) {
+        MemoryScope memScope(MemoryTag::Assets);
         std::string resolved = Content::Resolve(path);
         if (!Content::Exists(resolved)) {
             std::cout << "[AssetManager] Texture file missing: " << resolved << "\n";
@@ -89,20 +222,24 @@ namespace Engine {
         }
 
         AssetHandle id = m_Registry.Register(AssetType::Texture2D, resolved);
-        m_Registry.Save();
 
-        if (auto it = m_TextureCache.find(id); it != m_TextureCache.end())
+        if (auto it = m_TextureCache.find(id); it != m_TextureCache.end()) {
+            it->second.LastUsedFrame = m_FrameIndex;
             return id;
+        }
 
         try {
-            auto tex = std::make_shared<Texture2D>(resolved);
-            m_TextureCache[id] = tex;
+            std::shared_ptr<Texture2D> tex;
+            RenderCommand::RunOnRenderThread([&]() { tex = std::make_shared<Texture2D>(resolved); });
+            size_t bytes = tex->GetGPUMemoryBytes();
+            m_TextureCache[id] = { tex, bytes, m_FrameIndex };
+            m_Stats.TextureBytes += bytes;
+            m_Stats.TextureCount++;
             return id;
         }
         catch (const std::exception& e) {
             std::cout << "[AssetManager] Texture load failed: " << resolved << " (" << e.what() << ")\n";
             m_Registry.Remove(id);
-            m_Registry.Save();
             return InvalidAssetHandle;
         }
     }
@@ -110,29 +247,33 @@ namespace Engine {
     std::shared_ptr<Shader> AssetManager::GetShader(AssetHandle shaderHandle) {
         if (shaderHandle == InvalidAssetHandle) return nullptr;
 
-        if (auto it = m_ShaderCache.find(shaderHandle); it != m_ShaderCache.end())
-            return it->second;
+        if (auto it = m_ShaderCache.find(shaderHandle); it != m_ShaderCache.end()) {
+            it->second.LastUsedFrame = m_FrameIndex;
+            return it->second.Asset;
+        }
 
+        // cache miss: (re)load
+        MemoryScope memScope(MemoryTag::Assets);
         const AssetMetadata* meta = m_Registry.Get(shaderHandle);
         if (!meta || meta->Type != AssetType::Shader) return nullptr;
 
         if (!std::filesystem::exists(meta->Path)) {
             std::cout << "[AssetManager] Shader missing on disk, removing: " << meta->Path << "\n";
             m_Registry.Remove(shaderHandle);
-            m_Registry.Save();
             return nullptr;
         }
 
         try {
-            auto shader = std::make_shared<Shader>(meta->Path);
-            m_ShaderCache[shaderHandle] = shader;
+            std::shared_ptr<Shader> shader;
+            RenderCommand::RunOnRenderThread([&]() { shader = Shader::CreateAsync(meta->Path); });
+            m_ShaderCache[shaderHandle] = { shader, 0, m_FrameIndex };
+            m_Stats.ShaderCount++;
             return shader;
         }
         catch (const std::exception& e) {
             std::cout << "[AssetManager] Shader load failed, removing registry entry: " << meta->Path
                 << " (" << e.what() << ")\n";
             m_Registry.Remove(shaderHandle);
-            m_Registry.Save();
             return nullptr;
         }
     }
@@ -140,9 +281,13 @@ namespace Engine {
     // --- GetModel ---
     std::shared_ptr<Model> AssetManager::GetModel(AssetHandle modelHandle) {
         if (modelHandle == InvalidAssetHandle) return nullptr;
-        if (auto it = m_ModelCache.find(modelHandle); it != m_ModelCache.end())
-            return it->second;
+        if (auto it = m_ModelCache.find(modelHandle); it != m_ModelCache.end()) {
+            it->second.LastUsedFrame = m_FrameIndex;
+            return it->second.Asset;
+        }
 
+        // cache miss: (re)load
+        MemoryScope memScope(MemoryTag::Assets);
         const AssetMetadata* meta = m_Registry.Get(modelHandle);
         if (!meta || meta->Type != AssetType::Model) return nullptr;
 
@@ -158,8 +303,15 @@ namespace Engine {
         }
 
         try {
-            auto model = std::make_shared<Model>(meta->Path, shader);
-            m_ModelCache[modelHandle] = model;
+            // Either first use or reload after eviction
+            ModelData data = Model::Import(meta->Path);
+            if (m_PackModelTextures) Model::PackTextures(data);
+            std::shared_ptr<Model> model;
+            RenderCommand::RunOnRenderThread([&]() { model = std::make_shared<Model>(std::move(data), shader); });
+            size_t bytes = model->GetGPUMemoryBytes();
+            m_ModelCache[modelHandle] = { model, bytes, m_FrameIndex };
+            m_Stats.ModelBytes += bytes;
+            m_Stats.ModelCount++;
             return model;
         }
         catch (...) {
@@ -173,29 +325,35 @@ namespace Engine {
     std::shared_ptr<Texture2D> AssetManager::GetTexture2D(AssetHandle texHandle) {
         if (texHandle == InvalidAssetHandle) return nullptr;
 
-        if (auto it = m_TextureCache.find(texHandle); it != m_TextureCache.end())
-            return it->second;
+        if (auto it = m_TextureCache.find(texHandle); it != m_TextureCache.end()) {
+            it->second.LastUsedFrame = m_FrameIndex;
+            return it->second.Asset;
+        }
 
+        // cache miss: (re)load
+        MemoryScope memScope(MemoryTag::Assets);
         const AssetMetadata* meta = m_Registry.Get(texHandle);
         if (!meta || meta->Type != AssetType::Texture2D) return nullptr;
 
         if (!std::filesystem::exists(meta->Path)) {
             std::cout << "[AssetManager] Texture missing on disk, removing: " << meta->Path << "\n";
             m_Registry.Remove(texHandle);
-            m_Registry.Save();
             return nullptr;
         }
 
         try {
-            auto tex = std::make_shared<Texture2D>(meta->Path);
-            m_TextureCache[texHandle] = tex;
+            std::shared_ptr<Texture2D> tex;
+            RenderCommand::RunOnRenderThread([&]() { tex = std::make_shared<Texture2D>(meta->Path); });
+            size_t bytes = tex->GetGPUMemoryBytes();
+            m_TextureCache[texHandle] = { tex, bytes, m_FrameIndex };
+            m_Stats.TextureBytes += bytes;
+            m_Stats.TextureCount++;
             return tex;
         }
         catch (const std::exception& e) {
             std::cout << "[AssetManager] Texture load failed, removing registry entry: " << meta->Path
                 << " (" << e.what() << ")\n";
             m_Registry.Remove(texHandle);
-            m_Registry.Save();
             return nullptr;
         }
     }
@@ -215,4 +373,109 @@ namespace Engine {
         return meta->Path;
     }
 
+    // ---------------- Residency ----------------
+
+    uint32_t AssetManager::ReloadChangedShaders() {
+        uint32_t started = 0;
+        for (auto& [handle, entry] : m_ShaderCache)
+            if (entry.Asset->ReloadIfChanged())
+                started++;
+        return started;
+    }
+
+    bool AssetManager::PollShaderBuilds() {
+        bool building = false;
+        for (auto& [handle, entry] : m_ShaderCache) {
+            entry.Asset->IsReady();
+            building |= entry.Asset->IsBuilding();
+        }
+        return building;
+    }
+
+    void AssetManager::OnFrameEnd() {
+        m_FrameIndex++;
+
+        // Registry edits from this frame's loads go out in one write
+        m_Registry.SaveIfDirty();
+
+        if (m_MemoryBudget == 0)
+            return;
+
+        if (m_Stats.ModelBytes + m_Stats.TextureBytes > m_MemoryBudget)
+            EvictUntilWithinBudget();
+    }
+
+    void AssetManager::EvictUntilWithinBudget() {
+        // Only assets held by nothing but the cache are safe to drop:
+        // use_count() == 1 means no scene, material or queued DrawCommand still owns them
+        // (the draw list holds its own shared_ptrs, so anything in flight keeps use_count > 1).
+        struct Candidate {
+            AssetType Type;
+            AssetHandle Handle;
+            uint64_t LastUsedFrame;
+            size_t SizeBytes;
+        };
+
+        std::vector<Candidate> candidates;
+        candidates.reserve(m_ModelCache.size() + m_TextureCache.size());
+
+        auto isStale = [&](uint64_t lastUsed) {
+            return lastUsed + m_EvictionGraceFrames <= m_FrameIndex;
+            };
+
+        for (const auto& [id, e] : m_ModelCache)
+            if (e.Asset.use_count() == 1 && isStale(e.LastUsedFrame))
+                candidates.push_back({ AssetType::Model, id, e.LastUsedFrame, e.SizeBytes });
+
+        for (const auto& [id, e] : m_TextureCache)
+            if (e.Asset.use_count() == 1 && isStale(e.LastUsedFrame))
+                candidates.push_back({ AssetType::Texture2D, id, e.LastUsedFrame, e.SizeBytes });
+
+        if (candidates.empty())
+            return;
+
+        // Least recently used first
+        std::sort(candidates.begin(), candidates.end(),
+            [](const Candidate& a, const Candidate& b) { return a.LastUsedFrame < b.LastUsedFrame; });
+
+        uint32_t evicted = 0;
+        for (const auto& c : candidates) {
+            if (m_Stats.ModelBytes + m_Stats.TextureBytes <= m_MemoryBudget)
+                break;
+
+            if (c.Type == AssetType::Model) {
+                m_ModelCache.erase(c.Handle);
+                m_Stats.ModelBytes -= c.SizeBytes;
+                m_Stats.ModelCount--;
+            }
+            else {
+                m_TextureCache.erase(c.Handle);
+                m_Stats.TextureBytes -= c.SizeBytes;
+                m_Stats.TextureCount--;
+            }
+
+            evicted++;
+            if (const AssetMetadata* meta = m_Registry.Get(c.Handle))
+                std::cout << "[AssetManager] Evicted " << AssetTypeToString(c.Type) << ": " << meta->Path
+                << " (" << (c.SizeBytes / 1024) << " KB)\n";
+        }
+
+        if (evicted == 0)
+            return;
+
+        // Models just released may have been the last owners of their shader.
+        for (auto it = m_ShaderCache.begin(); it != m_ShaderCache.end(); ) {
+            if (it->second.Asset.use_count() == 1 && isStale(it->second.LastUsedFrame)) {
+                it = m_ShaderCache.erase(it);
+                m_Stats.ShaderCount--;
+                evicted++;
+            }
+            else {
+                ++it;
+            }
+        }
+
+        m_Stats.EvictedCount += evicted;
+    }
+
 } // namespace Engine
\ No newline at end of file
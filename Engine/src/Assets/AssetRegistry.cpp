@@ -2,19 +2,23 @@
 #include "Engine/Assets/AssetRegistry.h"
 
 #include <fstream>
-#include <sstream>
 #include <filesystem>
 #include <iostream>
-#include <cctype>
+#include <charconv>
+#include <vector>
+#include <algorithm>
 
 namespace Engine {
 
     static std::string ReadAllText(const std::string& path) {
-        std::ifstream in(path, std::ios::in | std::ios::binary);
+        std::ifstream in(path, std::ios::in | std::ios::binary | std::ios::ate);
         if (!in) return {};
-        std::ostringstream ss;
-        ss << in.rdbuf();
-        return ss.str();
+
+        std::string txt;
+        txt.resize((size_t)in.tellg());
+        in.seekg(0);
+        in.read(txt.data(), (std::streamsize)txt.size());
+        return txt;
     }
 
     static void EnsureParentDir(const std::string& filePath) {
@@ -24,42 +28,125 @@ namespace Engine {
             std::filesystem::create_directories(parent, ec);
     }
 
-    static bool ExtractUInt(const std::string& src, const std::string& key, uint32_t& out) {
-        // finds: "key": 123
-        auto pos = src.find("\"" + key + "\"");
-        if (pos == std::string::npos) return false;
-        pos = src.find(':', pos);
-        if (pos == std::string::npos) return false;
-        pos++;
+    // Paths we write are already normalized; only pay for lexically_normal when something looks off.
+    static bool LooksNormalized(std::string_view p) {
+        if (p.empty()) return false;
+        if (p.find('\\') != std::string_view::npos) return false;
+        if (p.find("//") != std::string_view::npos) return false;
+        if (p.find("./") != std::string_view::npos) return false;
+        if (p.back() == '/' || p.back() == '.') return false;
+        return true;
+    }
 
-        while (pos < src.size() && (src[pos] == ' ' || src[pos] == '\t')) pos++;
+    static void WriteEscaped(std::ostream& out, const std::string& s) {
+        for (char c : s) {
+            if (c == '"' || c == '\\') out << '\\';
+            out << c;
+        }
+    }
 
-        size_t end = pos;
-        while (end < src.size() && isdigit((unsigned char)src[end])) end++;
+    // ---------------------------------------------------------------------
+    // Single-pass reader for the registry file:
+    //   { "nextID": N, "assets": [ { "id": 1, "type": "Model", "path": "...", "shader": 2 }, ... ] }
+    // Unknown keys are skipped, so newer files still load.
+    // ---------------------------------------------------------------------
+    class RegistryReader {
+    public:
+        RegistryReader(const char* begin, const char* end) : m_P(begin), m_End(end) {}
+
+        void SkipWS() {
+            while (m_P < m_End && (*m_P == ' ' || *m_P == '\t' || *m_P == '\n' || *m_P == '\r')) m_P++;
+        }
 
-        if (end == pos) return false;
-        out = (uint32_t)std::stoul(src.substr(pos, end - pos));
-        return true;
-    }
+        bool Peek(char c) { SkipWS(); return m_P < m_End && *m_P == c; }
+
+        bool Consume(char c) {
+            if (!Peek(c)) return false;
+            m_P++;
+            return true;
+        }
 
-    static bool ExtractString(const std::string& src, const std::string& key, std::string& out) {
-        // finds: "key": "value"
-        auto pos = src.find("\"" + key + "\"");
-        if (pos == std::string::npos) return false;
-        pos = src.find(':', pos);
-        if (pos == std::string::npos) return false;
-        pos++;
+        // Returns a view into the source when there are no escapes, otherwise into scratch.
+        bool ReadString(std::string_view& out, std::string& scratch) {
+            if (!Consume('"')) return false;
 
-        while (pos < src.size() && (src[pos] == ' ' || src[pos] == '\t')) pos++;
-        if (pos >= src.size() || src[pos] != '"') return false;
-        pos++;
+            const char* start = m_P;
+            while (m_P < m_End && *m_P != '"' && *m_P != '\\') m_P++;
+            if (m_P >= m_End) return false;
 
-        auto end = src.find('"', pos);
-        if (end == std::string::npos) return false;
+            if (*m_P == '"') {
+                out = std::string_view(start, (size_t)(m_P - start));
+                m_P++;
+                return true;
+            }
 
-        out = src.substr(pos, end - pos);
-        return true;
-    }
+            scratch.assign(start, m_P);
+            while (m_P < m_End && *m_P != '"') {
+                if (*m_P == '\\' && m_P + 1 < m_End) {
+                    m_P++;
+                    switch (*m_P) {
+                    case 'n': scratch += '\n'; break;
+                    case 't': scratch += '\t'; break;
+                    default:  scratch += *m_P; break;
+                    }
+                }
+                else {
+                    scratch += *m_P;
+                }
+                m_P++;
+            }
+            if (m_P >= m_End) return false;
+            m_P++;
+            out = scratch;
+            return true;
+        }
+
+        bool ReadUInt(uint64_t& out) {
+            SkipWS();
+            auto res = std::from_chars(m_P, m_End, out);
+            if (res.ec != std::errc()) return false;
+            m_P = res.ptr;
+            return true;
+        }
+
+        bool SkipValue() {
+            SkipWS();
+            if (m_P >= m_End) return false;
+
+            if (*m_P == '"') {
+                std::string_view sv;
+                std::string scratch;
+                return ReadString(sv, scratch);
+            }
+
+            if (*m_P == '{' || *m_P == '[') {
+                int depth = 0;
+                while (m_P < m_End) {
+                    char c = *m_P;
+                    if (c == '"') {
+                        std::string_view sv;
+                        std::string scratch;
+                        if (!ReadString(sv, scratch)) return false;
+                        continue;
+                    }
+                    if (c == '{' || c == '[') depth++;
+                    else if (c == '}' || c == ']') {
+                        if (--depth == 0) { m_P++; return true; }
+                    }
+                    m_P++;
+                }
+                return false;
+            }
+
+            // number / true / false / null
+            while (m_P < m_End && *m_P != ',' && *m_P != '}' && *m_P != ']') m_P++;
+            return true;
+        }
+
+    private:
+        const char* m_P;
+        const char* m_End;
+    };
 
     AssetRegistry::AssetRegistry(const std::string& registryPath)
         : m_RegistryPath(registryPath) {
@@ -71,106 +158,223 @@ namespace Engine {
         return fp.generic_string(); // forward slashes
     }
 
+    PathID AssetRegistry::InternPath(const std::string& normalized) {
+        if (auto it = m_PathIDs.find(std::string_view(normalized)); it != m_PathIDs.end())
+            return it->second;
+
+        m_PathStrings.push_back(normalized);
+        PathID id = (PathID)m_PathStrings.size();
+        m_PathIDs.emplace(std::string_view(m_PathStrings.back()), id);
+        return id;
+    }
+
+    PathID AssetRegistry::FindPathID(std::string_view path) const {
+        if (auto it = m_PathIDs.find(path); it != m_PathIDs.end())
+            return it->second;
+
+        if (LooksNormalized(path))
+            return InvalidPathID;
+
+        // slow path: caller handed us a non-normalized path
+        std::string norm = NormalizePath(std::string(path));
+        if (auto it = m_PathIDs.find(std::string_view(norm)); it != m_PathIDs.end())
+            return it->second;
+        return InvalidPathID;
+    }
+
     bool AssetRegistry::Load() {
         m_Assets.clear();
         m_PathToHandle.clear();
+        m_PathIDs.clear();
+        m_PathStrings.clear();
         m_NextID = 1;
+        m_Dirty = false;
+        m_LoadFailed = false;
 
         std::string txt = ReadAllText(m_RegistryPath);
         if (txt.empty())
             return false;
 
-        // nextID
-        uint32_t next = 1;
-        if (ExtractUInt(txt, "nextID", next))
-            m_NextID = (next == 0 ? 1 : next);
-
-        // parse objects inside "assets": [ ... ]
-        auto assetsPos = txt.find("\"assets\"");
-        if (assetsPos == std::string::npos)
-            return true;
-
-        auto arrayStart = txt.find('[', assetsPos);
-        auto arrayEnd = txt.find(']', assetsPos);
-        if (arrayStart == std::string::npos || arrayEnd == std::string::npos || arrayEnd <= arrayStart)
-            return true;
-
-        size_t pos = arrayStart;
-        while (true) {
-            auto objStart = txt.find('{', pos);
-            if (objStart == std::string::npos || objStart > arrayEnd) break;
-
-            auto objEnd = txt.find('}', objStart);
-            if (objEnd == std::string::npos || objEnd > arrayEnd) break;
-
-            std::string obj = txt.substr(objStart, (objEnd - objStart) + 1);
-
-            uint32_t id = 0;
-            std::string typeStr, pathStr;
-            uint32_t shader = 0;
+        // Rough upper bound so the maps don't rehash while loading big registries
+        size_t estimate = (size_t)std::count(txt.begin(), txt.end(), '{');
+        m_Assets.reserve(estimate);
+        m_PathToHandle.reserve(estimate);
+        m_PathIDs.reserve(estimate);
+
+        RegistryReader r(txt.data(), txt.data() + txt.size());
+        std::string keyScratch, valScratch;
+        size_t entry = 0; // index in "assets" of the object being read
+
+        auto fail = [&](const char* what) {
+            std::cout << "[AssetRegistry] Parse error (" << what << ") in " << m_RegistryPath
+                << " at asset entry " << entry << "; nothing loaded, saving disabled until the file is fixed\n";
+            m_Assets.clear();
+            m_PathToHandle.clear();
+            m_PathIDs.clear();
+            m_PathStrings.clear();
+            m_NextID = 1;
+            m_LoadFailed = true;
+            return false;
+            };
 
-            if (ExtractUInt(obj, "id", id) &&
-                ExtractString(obj, "type", typeStr) &&
-                ExtractString(obj, "path", pathStr))
-            {
-                AssetMetadata meta;
-                meta.Type = AssetTypeFromString(typeStr);
-                meta.Path = NormalizePath(pathStr);
+        if (!r.Consume('{')) return fail("expected '{'");
 
-                uint32_t sh = 0;
-                if (ExtractUInt(obj, "shader", sh))
-                    meta.Shader = sh;
+        while (!r.Peek('}')) {
+            std::string_view key;
+            if (!r.ReadString(key, keyScratch) || !r.Consume(':')) return fail("key");
 
-                if (id != 0 && meta.Type != AssetType::None && !meta.Path.empty()) {
-                    m_Assets[id] = meta;
-                    std::string key = std::string(AssetTypeToString(meta.Type)) + "|" + meta.Path;
-                    m_PathToHandle[key] = id;
+            if (key == "nextID") {
+                uint64_t next = 1;
+                if (!r.ReadUInt(next)) return fail("nextID");
+                m_NextID = (next == 0 ? 1 : next);
+            }
+            else if (key == "assets") {
+                if (!r.Consume('[')) return fail("expected '['");
+
+                while (!r.Peek(']')) {
+                    if (!r.Consume('{')) return fail("expected asset object");
+
+                    uint64_t id = 0, shader = 0;
+                    AssetType type = AssetType::None;
+                    std::string path;
+
+                    while (!r.Peek('}')) {
+                        std::string_view field;
+                        if (!r.ReadString(field, keyScratch) || !r.Consume(':')) return fail("asset key");
+
+                        if (field == "id") {
+                            if (!r.ReadUInt(id)) return fail("id");
+                        }
+                        else if (field == "shader") {
+                            if (!r.ReadUInt(shader)) return fail("shader");
+                        }
+                        else if (field == "type") {
+                            std::string_view v;
+                            if (!r.ReadString(v, valScratch)) return fail("type");
+                            type = AssetTypeFromString(std::string(v));
+                        }
+                        else if (field == "path") {
+                            std::string_view v;
+                            if (!r.ReadString(v, valScratch)) return fail("path");
+                            path = LooksNormalized(v) ? std::string(v) : NormalizePath(std::string(v));
+                        }
+                        else if (!r.SkipValue()) {
+                            return fail("value");
+                        }
+
+                        r.Consume(',');
+                    }
+                    r.Consume('}');
+                    entry++;
+
+                    if (id != 0 && type != AssetType::None && !path.empty()) {
+                        AssetMetadata meta;
+                        meta.Type = type;
+                        meta.Shader = (type == AssetType::Model) ? shader : 0;
+                        meta.PathId = InternPath(path);
+                        meta.Path = std::move(path);
+
+                        m_PathToHandle[MakeKey(type, meta.PathId)] = id;
+                        m_Assets[id] = std::move(meta);
+
+                        if (id >= m_NextID) m_NextID = id + 1;
+                    }
+
+                    r.Consume(',');
                 }
+                r.Consume(']');
+            }
+            else if (!r.SkipValue()) {
+                return fail("value");
             }
 
-            pos = objEnd + 1;
+            r.Consume(',');
         }
 
         return true;
     }
 
     bool AssetRegistry::Save() const {
+        if (m_LoadFailed) {
+            std::cout << "[AssetRegistry] Not saving: " << m_RegistryPath << " failed to load and would be overwritten\n";
+            return false;
+        }
         EnsureParentDir(m_RegistryPath);
 
-        std::ofstream out(m_RegistryPath, std::ios::out | std::ios::trunc);
-        if (!out) return false;
+        // Stable order keeps the file diff-friendly
+        std::vector<AssetHandle> ids;
+        ids.reserve(m_Assets.size());
+        for (const auto& [id, meta] : m_Assets) ids.push_back(id);
+        std::sort(ids.begin(), ids.end());
+
+        const std::string tmpPath = m_RegistryPath + ".tmp";
+        {
+            std::ofstream out(tmpPath, std::ios::out | std::ios::trunc | std::ios::binary);
+            if (!out) return false;
 
-        out << "{\n";
-        out << "  \"nextID\": " << m_NextID << ",\n";
-        out << "  \"assets\": [\n";
+            out << "{\n";
+            out << "  \"nextID\": " << m_NextID << ",\n";
+            out << "  \"assets\": [\n";
 
-        bool first = true;
-        for (const auto& [id, meta] : m_Assets) {
-            if (!first) out << ",\n";
-            first = false;
+            bool first = true;
+            for (AssetHandle id : ids) {
+                const AssetMetadata& meta = m_Assets.at(id);
 
-            out << "    { \"id\": " << id
-                << ", \"type\": \"" << AssetTypeToString(meta.Type)
-                << "\", \"path\": \"" << meta.Path << "\"";
+                if (!first) out << ",\n";
+                first = false;
 
-            if (meta.Type == AssetType::Model && meta.Shader != 0)
-                out << ", \"shader\": " << meta.Shader;
+                out << "    { \"id\": " << id
+                    << ", \"type\": \"" << AssetTypeToString(meta.Type)
+                    << "\", \"path\": \"";
+                WriteEscaped(out, meta.Path);
+                out << "\"";
 
-            out << " }";
+                if (meta.Type == AssetType::Model && meta.Shader != 0)
+                    out << ", \"shader\": " << meta.Shader;
+
+                out << " }";
+            }
+
+            out << "\n  ]\n";
+            out << "}\n";
+
+            out.flush();
+            if (!out) {
+                std::cout << "[AssetRegistry] Write failed: " << tmpPath << "\n";
+                return false;
+            }
+        }
+
+        // Replace the old file in one step so a crash never leaves a half-written registry
+        std::error_code ec;
+        std::filesystem::rename(tmpPath, m_RegistryPath, ec);
+        if (ec) {
+            std::cout << "[AssetRegistry] Rename failed: " << tmpPath << " -> " << m_RegistryPath
+                << " (" << ec.message() << ")\n";
+            return false;
         }
 
-        out << "\n  ]\n";
-        out << "}\n";
+        m_Dirty = false;
         return true;
     }
 
+    bool AssetRegistry::SaveIfDirty() const {
+        if (!m_Dirty) return true;
+        return Save();
+    }
+
     bool AssetRegistry::Exists(AssetHandle id) const {
         return m_Assets.find(id) != m_Assets.end();
     }
 
     std::optional<AssetHandle> AssetRegistry::FindByPath(AssetType type, const std::string& path) const {
-        std::string key = std::string(AssetTypeToString(type)) + "|" + NormalizePath(path);
-        auto it = m_PathToHandle.find(key);
+        PathID pid = FindPathID(path);
+        if (pid == InvalidPathID) return std::nullopt;
+        return FindByPathID(type, pid);
+    }
+
+    std::optional<AssetHandle> AssetRegistry::FindByPathID(AssetType type, PathID path) const {
+        auto it = m_PathToHandle.find(MakeKey(type, path));
         if (it == m_PathToHandle.end()) return std::nullopt;
         return it->second;
     }
@@ -182,15 +386,21 @@ namespace Engine {
     }
 
     AssetHandle AssetRegistry::Register(AssetType type, const std::string& path, AssetHandle shader) {
-        std::string norm = NormalizePath(path);
-        std::string key = std::string(AssetTypeToString(type)) + "|" + norm;
-
-        if (auto it = m_PathToHandle.find(key); it != m_PathToHandle.end()) {
-            AssetHandle existing = it->second;
-            auto& meta = m_Assets[existing];
-            if (type == AssetType::Model && shader != 0)
-                meta.Shader = shader;
-            return existing;
+        // Fast path: already-known path, no allocation
+        PathID pid = FindPathID(path);
+        if (pid != InvalidPathID) {
+            if (auto it = m_PathToHandle.find(MakeKey(type, pid)); it != m_PathToHandle.end()) {
+                AssetHandle existing = it->second;
+                auto& meta = m_Assets[existing];
+                if (type == AssetType::Model && shader != 0 && meta.Shader != shader) {
+                    meta.Shader = shader;
+                    m_Dirty = true;
+                }
+                return existing;
+            }
+        }
+        else {
+            pid = InternPath(NormalizePath(path));
         }
 
         AssetHandle id = m_NextID++;
@@ -198,11 +408,13 @@ namespace Engine {
 
         AssetMetadata meta;
         meta.Type = type;
-        meta.Path = norm;
+        meta.Path = m_PathStrings[pid - 1];
+        meta.PathId = pid;
         meta.Shader = (type == AssetType::Model) ? shader : 0;
 
-        m_Assets[id] = meta;
-        m_PathToHandle[key] = id;
+        m_Assets[id] = std::move(meta);
+        m_PathToHandle[MakeKey(type, pid)] = id;
+        m_Dirty = true;
         return id;
     }
 
@@ -210,13 +422,17 @@ namespace Engine {
         auto it = m_Assets.find(id);
         if (it == m_Assets.end()) return false;
 
-        std::string oldKey = std::string(AssetTypeToString(it->second.Type)) + "|" + it->second.Path;
-        m_PathToHandle.erase(oldKey);
+        m_PathToHandle.erase(MakeKey(it->second.Type, it->second.PathId));
+
+        PathID pid = FindPathID(newPath);
+        if (pid == InvalidPathID)
+            pid = InternPath(NormalizePath(newPath));
 
-        it->second.Path = NormalizePath(newPath);
+        it->second.Path = m_PathStrings[pid - 1];
+        it->second.PathId = pid;
 
-        std::string newKey = std::string(AssetTypeToString(it->second.Type)) + "|" + it->second.Path;
-        m_PathToHandle[newKey] = id;
+        m_PathToHandle[MakeKey(it->second.Type, pid)] = id;
+        m_Dirty = true;
         return true;
     }
 
@@ -224,10 +440,11 @@ namespace Engine {
         auto it = m_Assets.find(id);
         if (it == m_Assets.end()) return false;
 
-        std::string key = std::string(AssetTypeToString(it->second.Type)) + "|" + it->second.Path;
-        m_PathToHandle.erase(key);
+        // The interned path stays; it's tiny and may be re-registered later.
+        m_PathToHandle.erase(MakeKey(it->second.Type, it->second.PathId));
         m_Assets.erase(it);
+        m_Dirty = true;
         return true;
     }
 
-} // namespace Engine
\ No newline at end of file
+} // namespace Engine
@@ -18,6 +18,10 @@
 
 #include "Engine/Renderer/TextureCube.h"
 
+#include "Engine/Assets/AssetManager.h"
+#include "Engine/Core/JobSystem.h"
+#include "Engine/Core/MemoryTracker.h"
+
 #include <GLFW/glfw3.h>
 
 #include <chrono>
@@ -26,10 +30,14 @@
 
 namespace Engine {
 
-    Application::Application() {
-        m_Window = Window::Create({ "Engine3D - Sandbox", 1280, 720 });
+    Application::Application(const WindowProps& props) {
+        m_Window = Window::Create(props);
         m_Window->SetEventCallback([this](Event& e) { this->OnEvent(e); });
 
+        // game loop: draw every frame while focused, sleep in the event wait otherwise
+        m_Scheduler = std::make_unique<FrameScheduler>(*m_Window);
+        m_Scheduler->SetContinuous(true);
+
         Renderer::Init();
 
         m_CaptureMouse = true;
@@ -37,6 +45,8 @@ namespace Engine {
     }
 
     void Application::OnEvent(Event& e) {
+        m_Scheduler->OnEvent(e);
+
         EventDispatcher dispatcher(e);
         dispatcher.Dispatch<WindowCloseEvent>([this](WindowCloseEvent&) { m_Running = false; return true; });
         dispatcher.Dispatch<WindowResizeEvent>([this](WindowResizeEvent&) { return false; });
@@ -112,17 +122,22 @@ namespace Engine {
             }
         }
 
+        if (m_FrameLimit > 0)
+            m_Timings.Reserve((size_t)m_FrameLimit);
+
         auto last = std::chrono::high_resolution_clock::now();
 
         while (m_Running && !m_Window->ShouldClose()) {
+            // polls events; blocks while unfocused / minimized instead of spinning
+            const bool drawFrame = m_Scheduler->WaitForFrame();
+            JobSystem::Get().RunMainThreadJobs();
+
             auto now = std::chrono::high_resolution_clock::now();
             float dt = std::chrono::duration<float>(now - last).count();
             last = now;
 
-            if (!m_HasFocus) {
-                m_Window->OnUpdate();
+            if (!drawFrame || !m_HasFocus)
                 continue;
-            }
 
             if (dt > 0.1f) dt = 0.1f;
 
@@ -131,18 +146,31 @@ namespace Engine {
 
             uint32_t w = m_Window->GetWidth();
             uint32_t h = m_Window->GetHeight();
-            if (w == 0 || h == 0) {
-                m_Window->OnUpdate();
+            if (w == 0 || h == 0)
                 continue;
-            }
 
-            pipeline.BeginScenePass(w, h, camCtrl.GetCamera());
-            scene.OnUpdate(dt);
-            scene.OnRender(camCtrl.GetCamera()); // submits only + pushes light inside Scene
-            pipeline.EndScenePass();
-            pipeline.PresentToScreen();
-
-            m_Window->OnUpdate();
+            pipeline.BeginFrame(w, h);
+            pipeline.AddScenePass(camCtrl.GetCamera(), [&]() {
+                scene.OnUpdate(dt);
+                scene.OnRender(camCtrl.GetCamera()); // submits only + pushes light inside Scene
+                });
+            pipeline.AddPresentPass();
+            pipeline.EndFrame();
+
+            m_Window->SwapBuffers();
+            Renderer::EndStatsFrame();
+
+            AssetManager::Get().OnFrameEnd();
+            MemoryTracker::EndFrame();
+
+            if (m_FrameLimit > 0) {
+                // frame work only: update, render, swap (not the scheduler's wait)
+                m_Timings.Add(std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - now).count());
+                if (m_Timings.GetCount() >= m_FrameLimit) {
+                    std::cout << m_Timings.Summary("Application") << "\n";
+                    m_Running = false;
+                }
+            }
         }
     }
 
@@ -0,0 +1,87 @@
+#include "pch.h"
+#include "Engine/Core/FrameScheduler.h"
+
+#include "Engine/Core/Window.h"
+#include "Engine/Core/JobSystem.h"
+
+#include "Engine/Events/Event.h"
+#include "Engine/Events/WindowFocusEvent.h"
+
+namespace Engine {
+
+    FrameScheduler::FrameScheduler(Window& window)
+        : m_Window(window), m_MainThread(std::this_thread::get_id()) {
+        // a finished background load queues its GL upload; wake up and draw it
+        JobSystem::Get().SetMainThreadWakeCallback([this]() { RequestRedraw(); });
+    }
+
+    FrameScheduler::~FrameScheduler() {
+        JobSystem::Get().SetMainThreadWakeCallback({});
+    }
+
+    void FrameScheduler::RequestRedraw(uint32_t frames) {
+        uint32_t pending = m_PendingFrames.load(std::memory_order_relaxed);
+        while (pending < frames && !m_PendingFrames.compare_exchange_weak(pending, frames, std::memory_order_relaxed)) {}
+
+        if (std::this_thread::get_id() != m_MainThread)
+            m_Window.PostEmptyEvent();
+    }
+
+    void FrameScheduler::OnEvent(Event& e) {
+        if (e.GetEventType() == EventType::WindowFocus)
+            m_Focused = static_cast<WindowFocusEvent&>(e).IsFocused();
+
+        RequestRedraw();
+    }
+
+    float FrameScheduler::GetFrameCap() const {
+        if (!m_Focused && m_Settings.PowerSaving)
+            return m_Settings.UnfocusedFPS;
+        return m_Settings.TargetFPS;
+    }
+
+    bool FrameScheduler::WantsFrame() const {
+        // minimized: nothing to draw into, and no vsync to block on
+        if (m_Window.GetWidth() == 0 || m_Window.GetHeight() == 0)
+            return false;
+
+        if (m_PendingFrames.load(std::memory_order_relaxed) > 0)
+            return true;
+
+        if (!m_Continuous)
+            return false;
+
+        return m_Focused || !m_Settings.PowerSaving || m_Settings.UnfocusedFPS > 0.0f;
+    }
+
+    bool FrameScheduler::WaitForFrame() {
+        using Clock = std::chrono::steady_clock;
+
+        if (WantsFrame()) {
+            m_Window.PollEvents();
+        }
+        else {
+            m_Window.WaitEvents(m_Settings.IdleTimeout);
+            if (!WantsFrame()) {
+                m_Stats.IdleTicks++;
+                return false;
+            }
+        }
+
+        // pace to the cap; keep handling events while we wait
+        const float cap = GetFrameCap();
+        if (cap > 0.0f) {
+            const auto due = m_LastFrame + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / cap));
+            for (auto now = Clock::now(); now < due; now = Clock::now())
+                m_Window.WaitEvents(std::chrono::duration<double>(due - now).count());
+        }
+        m_LastFrame = Clock::now();
+
+        uint32_t pending = m_PendingFrames.load(std::memory_order_relaxed);
+        while (pending > 0 && !m_PendingFrames.compare_exchange_weak(pending, pending - 1, std::memory_order_relaxed)) {}
+
+        m_Stats.Frames++;
+        return true;
+    }
+
+} // namespace Engine
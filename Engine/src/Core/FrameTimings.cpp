@@ -0,0 +1,49 @@
+#include "pch.h"
+#include "Engine/Core/FrameTimings.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <sstream>
+#include <iomanip>
+
+namespace Engine {
+
+    float FrameTimings::GetAverageMs() const {
+        if (m_FrameMs.empty()) return 0.0f;
+        return (float)(std::accumulate(m_FrameMs.begin(), m_FrameMs.end(), 0.0) / (double)m_FrameMs.size());
+    }
+
+    float FrameTimings::GetMinMs() const {
+        return m_FrameMs.empty() ? 0.0f : *std::min_element(m_FrameMs.begin(), m_FrameMs.end());
+    }
+
+    float FrameTimings::GetMaxMs() const {
+        return m_FrameMs.empty() ? 0.0f : *std::max_element(m_FrameMs.begin(), m_FrameMs.end());
+    }
+
+    float FrameTimings::GetPercentileMs(float percentile) const {
+        if (m_FrameMs.empty()) return 0.0f;
+
+        std::vector<float> sorted = m_FrameMs;
+        const double rank = std::ceil(std::clamp(percentile, 0.0f, 100.0f) / 100.0 * (double)sorted.size());
+        const size_t index = (size_t)std::max(rank, 1.0) - 1;
+
+        std::nth_element(sorted.begin(), sorted.begin() + (ptrdiff_t)index, sorted.end());
+        return sorted[index];
+    }
+
+    std::string FrameTimings::Summary(const std::string& tag) const {
+        const float avg = GetAverageMs();
+
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(3)
+            << "[" << tag << "] frames=" << m_FrameMs.size()
+            << " avg=" << avg << " min=" << GetMinMs()
+            << " p50=" << GetPercentileMs(50.0f) << " p95=" << GetPercentileMs(95.0f) << " p99=" << GetPercentileMs(99.0f)
+            << " max=" << GetMaxMs() << " ms"
+            << " fps=" << std::setprecision(1) << (avg > 0.0f ? 1000.0f / avg : 0.0f);
+        return out.str();
+    }
+
+} // namespace Engine
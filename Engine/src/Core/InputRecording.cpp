@@ -0,0 +1,263 @@
+#include "pch.h"
+#include "Engine/Core/InputRecording.h"
+
+#include "Engine/Core/Input.h"
+#include "Engine/Events/Event.h"
+#include "Engine/Events/ApplicationEvent.h"
+#include "Engine/Events/WindowFocusEvent.h"
+#include "Engine/Events/KeyEvent.h"
+#include "Engine/Events/MouseEvent.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <type_traits>
+
+namespace Engine {
+
+    namespace {
+
+        constexpr char     kMagic[4] = { 'E', '3', 'I', 'R' };
+        constexpr uint32_t kVersion = 1;
+        constexpr uint32_t kMouseButtons = 8;
+
+        // the keys game code polls through Input::IsKeyDown
+        constexpr KeyCode kRecordedKeys[] = {
+            KeyCode::W, KeyCode::A, KeyCode::S, KeyCode::D,
+            KeyCode::Q, KeyCode::E, KeyCode::LeftShift, KeyCode::Escape
+        };
+
+        struct FileHeader {
+            char Magic[4];
+            uint32_t Version;
+            uint32_t FrameCount;
+            uint32_t EventCount;
+            uint32_t Width;
+            uint32_t Height;
+        };
+
+        static_assert(std::is_trivially_copyable_v<InputRecording::Frame> && sizeof(InputRecording::Frame) == 20,
+            "InputRecording::Frame is written as raw bytes");
+        static_assert(std::is_trivially_copyable_v<InputRecording::RecordedEvent> && sizeof(InputRecording::RecordedEvent) == 16,
+            "InputRecording::RecordedEvent is written as raw bytes");
+
+        bool Encode(const Event& e, InputRecording::RecordedEvent& out) {
+            out = {};
+            out.Type = (uint32_t)e.GetEventType();
+
+            switch (e.GetEventType()) {
+            case EventType::WindowClose:
+                return true;
+            case EventType::WindowResize: {
+                const auto& ev = static_cast<const WindowResizeEvent&>(e);
+                out.X = (float)ev.GetWidth();
+                out.Y = (float)ev.GetHeight();
+                return true;
+            }
+            case EventType::WindowFocus:
+                out.Code = static_cast<const WindowFocusEvent&>(e).IsFocused() ? 1 : 0;
+                return true;
+            case EventType::KeyPressed: {
+                const auto& ev = static_cast<const KeyPressedEvent&>(e);
+                out.Code = ev.GetKeyCode();
+                out.X = (float)ev.GetRepeatCount();
+                return true;
+            }
+            case EventType::KeyReleased:
+            case EventType::KeyTyped:
+                out.Code = static_cast<const KeyEvent&>(e).GetKeyCode();
+                return true;
+            case EventType::MouseButtonPressed:
+            case EventType::MouseButtonReleased:
+                out.Code = static_cast<const MouseButtonEvent&>(e).GetMouseButton();
+                return true;
+            case EventType::MouseMoved: {
+                const auto& ev = static_cast<const MouseMovedEvent&>(e);
+                out.X = ev.GetX();
+                out.Y = ev.GetY();
+                return true;
+            }
+            case EventType::MouseScrolled: {
+                const auto& ev = static_cast<const MouseScrolledEvent&>(e);
+                out.X = ev.GetXOffset();
+                out.Y = ev.GetYOffset();
+                return true;
+            }
+            default:
+                return false;
+            }
+        }
+
+        template<typename T>
+        void Dispatch(T&& e, const InputReplayer::EventCallbackFn& callback) {
+            callback(e);
+        }
+
+        void Decode(const InputRecording::RecordedEvent& r, const InputReplayer::EventCallbackFn& callback) {
+            switch ((EventType)r.Type) {
+            case EventType::WindowClose:         Dispatch(WindowCloseEvent(), callback); break;
+            case EventType::WindowResize:        Dispatch(WindowResizeEvent((uint32_t)r.X, (uint32_t)r.Y), callback); break;
+            case EventType::WindowFocus:         Dispatch(WindowFocusEvent(r.Code != 0), callback); break;
+            case EventType::KeyPressed:          Dispatch(KeyPressedEvent(r.Code, (int)r.X), callback); break;
+            case EventType::KeyReleased:         Dispatch(KeyReleasedEvent(r.Code), callback); break;
+            case EventType::KeyTyped:            Dispatch(KeyTypedEvent(r.Code), callback); break;
+            case EventType::MouseButtonPressed:  Dispatch(MouseButtonPressedEvent(r.Code), callback); break;
+            case EventType::MouseButtonReleased: Dispatch(MouseButtonReleasedEvent(r.Code), callback); break;
+            case EventType::MouseMoved:          Dispatch(MouseMovedEvent(r.X, r.Y), callback); break;
+            case EventType::MouseScrolled:       Dispatch(MouseScrolledEvent(r.X, r.Y), callback); break;
+            default: break;
+            }
+        }
+
+    } // namespace
+
+    // ---------------- InputRecording ----------------
+
+    bool InputRecording::Save(const std::string& path) const {
+        std::ofstream out(path, std::ios::out | std::ios::trunc | std::ios::binary);
+        if (!out) {
+            std::cout << "[InputRecording] Can't write " << path << "\n";
+            return false;
+        }
+
+        FileHeader header{};
+        std::memcpy(header.Magic, kMagic, sizeof(kMagic));
+        header.Version = kVersion;
+        header.FrameCount = (uint32_t)Frames.size();
+        header.EventCount = (uint32_t)Events.size();
+        header.Width = Width;
+        header.Height = Height;
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        size_t nextEvent = 0;
+        for (const auto& frame : Frames) {
+            out.write(reinterpret_cast<const char*>(&frame), sizeof(frame));
+            out.write(reinterpret_cast<const char*>(Events.data() + nextEvent), (std::streamsize)(frame.EventCount * sizeof(RecordedEvent)));
+            nextEvent += frame.EventCount;
+        }
+
+        if (!out) {
+            std::cout << "[InputRecording] Write failed: " << path << "\n";
+            return false;
+        }
+        std::cout << "[InputRecording] Saved " << Frames.size() << " frames, " << Events.size() << " events to " << path << "\n";
+        return true;
+    }
+
+    bool InputRecording::Load(const std::string& path) {
+        Frames.clear();
+        Events.clear();
+
+        std::ifstream in(path, std::ios::in | std::ios::binary);
+        if (!in) {
+            std::cout << "[InputRecording] Can't open " << path << "\n";
+            return false;
+        }
+
+        FileHeader header{};
+        in.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!in || std::memcmp(header.Magic, kMagic, sizeof(kMagic)) != 0 || header.Version != kVersion) {
+            std::cout << "[InputRecording] Not an input recording (or wrong version): " << path << "\n";
+            return false;
+        }
+
+        Width = header.Width;
+        Height = header.Height;
+        Frames.resize(header.FrameCount);
+        Events.resize(header.EventCount);
+
+        size_t nextEvent = 0;
+        for (auto& frame : Frames) {
+            in.read(reinterpret_cast<char*>(&frame), sizeof(frame));
+            if (!in || frame.EventCount > Events.size() - nextEvent)
+                break;
+            in.read(reinterpret_cast<char*>(Events.data() + nextEvent), (std::streamsize)(frame.EventCount * sizeof(RecordedEvent)));
+            nextEvent += frame.EventCount;
+        }
+
+        if (!in || nextEvent != Events.size()) {
+            std::cout << "[InputRecording] Truncated or corrupt: " << path << "\n";
+            Frames.clear();
+            Events.clear();
+            return false;
+        }
+        return true;
+    }
+
+    // ---------------- InputRecorder ----------------
+
+    void InputRecorder::Begin(uint32_t width, uint32_t height) {
+        m_Recording = {};
+        m_Recording.Width = width;
+        m_Recording.Height = height;
+        m_Pending.clear();
+    }
+
+    void InputRecorder::OnEvent(const Event& e) {
+        InputRecording::RecordedEvent r;
+        if (Encode(e, r))
+            m_Pending.push_back(r);
+    }
+
+    void InputRecorder::RecordFrame(float dt) {
+        InputRecording::Frame frame;
+        frame.Dt = dt;
+        Input::GetMousePosition(frame.MouseX, frame.MouseY);
+
+        for (uint32_t i = 0; i < std::size(kRecordedKeys); i++) {
+            if (Input::IsKeyDown(kRecordedKeys[i]))
+                frame.Keys |= (uint16_t)(1u << i);
+        }
+        for (uint32_t b = 0; b < kMouseButtons; b++) {
+            if (Input::IsMouseButtonDown((int)b))
+                frame.Buttons |= (uint8_t)(1u << b);
+        }
+
+        frame.EventCount = (uint32_t)m_Pending.size();
+        m_Recording.Frames.push_back(frame);
+        m_Recording.Events.insert(m_Recording.Events.end(), m_Pending.begin(), m_Pending.end());
+        m_Pending.clear();
+    }
+
+    // ---------------- InputReplayer ----------------
+
+    bool InputReplayer::Load(const std::string& path) {
+        m_Next = m_NextEvent = 0;
+        if (!m_Recording.Load(path))
+            return false;
+
+        std::cout << "[InputReplay] " << m_Recording.Frames.size() << " frames from " << path
+            << " (recorded at " << m_Recording.Width << "x" << m_Recording.Height << ")\n";
+        return true;
+    }
+
+    void InputReplayer::Start() {
+        m_WasScripted = Input::IsScripted();
+        Input::SetScripted(true);
+        m_Next = m_NextEvent = 0;
+    }
+
+    void InputReplayer::Stop() {
+        Input::SetScripted(m_WasScripted);
+    }
+
+    float InputReplayer::NextFrame(const EventCallbackFn& callback) {
+        if (IsFinished())
+            return 0.0f;
+
+        const auto& frame = m_Recording.Frames[m_Next++];
+
+        // state first: handlers (e.g. a focus event resetting the camera) poll Input
+        Input::SetMousePosition(frame.MouseX, frame.MouseY);
+        for (uint32_t i = 0; i < std::size(kRecordedKeys); i++)
+            Input::SetKeyDown(kRecordedKeys[i], (frame.Keys >> i) & 1u);
+        for (uint32_t b = 0; b < kMouseButtons; b++)
+            Input::SetMouseButtonDown((int)b, (frame.Buttons >> b) & 1u);
+
+        for (uint32_t i = 0; i < frame.EventCount; i++)
+            Decode(m_Recording.Events[m_NextEvent++], callback);
+
+        return m_FixedDt > 0.0f ? m_FixedDt : frame.Dt;
+    }
+
+} // namespace Engine
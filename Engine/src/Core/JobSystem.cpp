@@ -0,0 +1,370 @@
+#include "pch.h"
+#include "Engine/Core/JobSystem.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace Engine {
+
+    struct Job {
+        std::function<void()> Fn;
+        JobCounter* Counter = nullptr;
+        JobAffinity Affinity = JobAffinity::Any;
+    };
+
+    // Chase-Lev work-stealing deque (Le et al., "Correct and Efficient Work-Stealing for
+    // Weak Memory Models"). Fixed capacity: a full Push fails and the caller falls back
+    // to the shared queue, so the buffer never has to grow under a concurrent steal.
+    class JobSystem::WorkDeque {
+    public:
+        static constexpr int64_t Capacity = 4096; // power of two
+
+        bool Push(Job* job) {
+            const int64_t b = m_Bottom.load(std::memory_order_relaxed);
+            const int64_t t = m_Top.load(std::memory_order_acquire);
+            if (b - t >= Capacity)
+                return false;
+
+            m_Buffer[b & (Capacity - 1)].store(job, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            m_Bottom.store(b + 1, std::memory_order_relaxed);
+            return true;
+        }
+
+        // owner only
+        Job* Pop() {
+            const int64_t b = m_Bottom.load(std::memory_order_relaxed) - 1;
+            m_Bottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t t = m_Top.load(std::memory_order_relaxed);
+
+            if (t > b) {
+                m_Bottom.store(b + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            Job* job = m_Buffer[b & (Capacity - 1)].load(std::memory_order_relaxed);
+            if (t == b) {
+                // last item: race the thieves for it
+                if (!m_Top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    job = nullptr;
+                m_Bottom.store(b + 1, std::memory_order_relaxed);
+            }
+            return job;
+        }
+
+        // any thread
+        Job* Steal() {
+            int64_t t = m_Top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const int64_t b = m_Bottom.load(std::memory_order_acquire);
+            if (t >= b)
+                return nullptr;
+
+            Job* job = m_Buffer[t & (Capacity - 1)].load(std::memory_order_relaxed);
+            if (!m_Top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                return nullptr; // lost to another thief or the owner
+            return job;
+        }
+
+    private:
+        alignas(64) std::atomic<int64_t> m_Top{ 0 };
+        alignas(64) std::atomic<int64_t> m_Bottom{ 0 };
+        alignas(64) std::atomic<Job*> m_Buffer[Capacity]{};
+    };
+
+    namespace {
+        // deque owned by the calling thread, -1 for threads outside the system
+        thread_local int t_DequeIndex = -1;
+        thread_local const JobSystem* t_Owner = nullptr;
+        thread_local uint32_t t_StealSeed = 0x9E3779B9u;
+
+        uint32_t NextRandom() {
+            uint32_t x = t_StealSeed;
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            t_StealSeed = x;
+            return x;
+        }
+    }
+
+    JobSystem& JobSystem::Get() {
+        // one worker per core; the main thread takes the remaining one (it helps in Wait)
+        static JobSystem s_Instance(std::max(1u, std::thread::hardware_concurrency()) - 1);
+        return s_Instance;
+    }
+
+    JobSystem::JobSystem(uint32_t workerCount)
+        : m_MainThread(std::this_thread::get_id()) {
+        workerCount = std::max(1u, workerCount);
+
+        m_Deques.reserve(workerCount + 1);
+        for (uint32_t i = 0; i <= workerCount; i++)
+            m_Deques.push_back(std::make_unique<WorkDeque>());
+
+        t_DequeIndex = 0;
+        t_Owner = this;
+
+        m_Threads.reserve(workerCount);
+        for (uint32_t i = 1; i <= workerCount; i++)
+            m_Threads.emplace_back(&JobSystem::WorkerLoop, this, i);
+
+        std::cout << "[JobSystem] " << workerCount << " workers\n";
+    }
+
+    JobSystem::~JobSystem() {
+        m_Running.store(false, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock(m_SleepMutex);
+            m_WorkEpoch.fetch_add(1);
+        }
+        m_SleepCV.notify_all();
+
+        for (auto& t : m_Threads)
+            t.join();
+
+        // whatever never ran (counters are owned by callers that have gone away)
+        for (auto& d : m_Deques)
+            while (Job* job = d->Steal()) delete job;
+        for (Job* job : m_Shared) delete job;
+        for (Job* job : m_MainJobs) delete job;
+    }
+
+    void JobSystem::Schedule(std::function<void()> job, JobCounter* counter, JobAffinity affinity) {
+        if (counter)
+            counter->m_Pending.fetch_add(1, std::memory_order_relaxed);
+
+        Enqueue(new Job{ std::move(job), counter, affinity });
+    }
+
+    void JobSystem::ScheduleAfter(JobCounter& dependency, std::function<void()> job, JobCounter* counter, JobAffinity affinity) {
+        if (counter)
+            counter->m_Pending.fetch_add(1, std::memory_order_relaxed);
+
+        Job* j = new Job{ std::move(job), counter, affinity };
+        {
+            // Finish drops the count to zero under this lock, so the check can't race it
+            std::lock_guard<std::mutex> lock(dependency.m_Mutex);
+            if (dependency.m_Pending.load(std::memory_order_acquire) != 0) {
+                dependency.m_Continuations.push_back(j);
+                return;
+            }
+        }
+        Enqueue(j);
+    }
+
+    void JobSystem::Enqueue(Job* job) {
+        if (job->Affinity == JobAffinity::MainThread) {
+            std::lock_guard<std::mutex> lock(m_MainMutex);
+            m_MainJobs.push_back(job);
+            if (m_MainWake)
+                m_MainWake();
+            return; // workers can't take it, no point waking them
+        }
+
+        if (t_Owner != this || t_DequeIndex < 0 || !m_Deques[t_DequeIndex]->Push(job)) {
+            std::lock_guard<std::mutex> lock(m_SharedMutex);
+            m_Shared.push_back(job);
+            m_SharedCount.fetch_add(1, std::memory_order_release);
+        }
+
+        Wake();
+    }
+
+    void JobSystem::Wake() {
+        // pairs with the epoch check in WorkerLoop: either the sleeper sees the new
+        // epoch before it waits, or we see it counted in m_Sleeping and notify
+        m_WorkEpoch.fetch_add(1);
+        if (m_Sleeping.load() > 0) {
+            { std::lock_guard<std::mutex> lock(m_SleepMutex); }
+            m_SleepCV.notify_one();
+        }
+    }
+
+    Job* JobSystem::FindJob() {
+        const int self = (t_Owner == this) ? t_DequeIndex : -1;
+
+        if (self >= 0) {
+            if (Job* job = m_Deques[self]->Pop())
+                return job;
+        }
+
+        if (IsMainThread()) {
+            std::lock_guard<std::mutex> lock(m_MainMutex);
+            if (!m_MainJobs.empty()) {
+                Job* job = m_MainJobs.front();
+                m_MainJobs.pop_front();
+                return job;
+            }
+        }
+
+        if (m_SharedCount.load(std::memory_order_acquire) > 0) {
+            std::lock_guard<std::mutex> lock(m_SharedMutex);
+            if (!m_Shared.empty()) {
+                Job* job = m_Shared.front();
+                m_Shared.pop_front();
+                m_SharedCount.fetch_sub(1, std::memory_order_relaxed);
+                return job;
+            }
+        }
+
+        const uint32_t count = (uint32_t)m_Deques.size();
+        const uint32_t start = NextRandom() % count;
+        for (uint32_t i = 0; i < count; i++) {
+            const uint32_t victim = (start + i) % count;
+            if ((int)victim == self) continue;
+            if (Job* job = m_Deques[victim]->Steal())
+                return job;
+        }
+        return nullptr;
+    }
+
+    void JobSystem::Execute(Job* job) {
+        try {
+            job->Fn();
+        }
+        catch (const std::exception& e) {
+            std::cout << "[JobSystem] Job threw: " << e.what() << "\n";
+        }
+        catch (...) {
+            std::cout << "[JobSystem] Job threw an unknown exception\n";
+        }
+
+        JobCounter* counter = job->Counter;
+        delete job;
+        if (counter)
+            Finish(counter);
+    }
+
+    void JobSystem::Finish(JobCounter* counter) {
+        std::vector<Job*> released;
+        {
+            std::lock_guard<std::mutex> lock(counter->m_Mutex);
+            if (counter->m_Pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                released.swap(counter->m_Continuations);
+        }
+        // the counter may be gone from here on
+
+        for (Job* job : released)
+            Enqueue(job);
+    }
+
+    void JobSystem::Wait(JobCounter& counter) {
+        uint32_t idle = 0;
+        while (counter.m_Pending.load(std::memory_order_acquire) != 0) {
+            if (Job* job = FindJob()) {
+                Execute(job);
+                idle = 0;
+                continue;
+            }
+
+            // nothing to help with: the remaining jobs are running elsewhere
+            if (++idle < 64)
+                std::this_thread::yield();
+            else
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+
+        // the last Finish may still hold the lock; don't let the caller destroy it under it
+        std::lock_guard<std::mutex> lock(counter.m_Mutex);
+    }
+
+    void JobSystem::ParallelFor(uint32_t count, const std::function<void(uint32_t, uint32_t)>& fn, uint32_t minChunk) {
+        if (count == 0)
+            return;
+
+        minChunk = std::max(1u, minChunk);
+        const uint32_t threads = GetWorkerCount() + 1;
+        const uint32_t maxChunks = (count + minChunk - 1) / minChunk;
+        if (maxChunks <= 1) {
+            fn(0, count);
+            return;
+        }
+
+        // Threads claim [begin, end) from a shared cursor; chunks start large and shrink
+        // toward minChunk, so uneven work still balances without per-item overhead.
+        std::atomic<uint32_t> next{ 0 };
+        auto run = [&]() {
+            uint32_t begin = next.load(std::memory_order_relaxed);
+            for (;;) {
+                uint32_t end;
+                do {
+                    if (begin >= count)
+                        return;
+                    const uint32_t remaining = count - begin;
+                    const uint32_t chunk = std::max(minChunk, remaining / (threads * 2));
+                    end = begin + std::min(chunk, remaining);
+                } while (!next.compare_exchange_weak(begin, end, std::memory_order_relaxed));
+
+                fn(begin, end);
+                begin = next.load(std::memory_order_relaxed);
+            }
+            };
+
+        JobCounter counter;
+        const uint32_t helpers = std::min(threads, maxChunks) - 1;
+        for (uint32_t i = 0; i < helpers; i++)
+            Schedule(run, &counter);
+
+        try {
+            run();
+        }
+        catch (...) {
+            // helpers reference this frame; stop handing out work and let them drain
+            next.store(count, std::memory_order_relaxed);
+            Wait(counter);
+            throw;
+        }
+        Wait(counter);
+    }
+
+    uint32_t JobSystem::RunMainThreadJobs() {
+        if (!IsMainThread())
+            return 0;
+
+        // only what's queued now; jobs queued by these run next frame
+        std::deque<Job*> jobs;
+        {
+            std::lock_guard<std::mutex> lock(m_MainMutex);
+            jobs.swap(m_MainJobs);
+        }
+        for (Job* job : jobs)
+            Execute(job);
+        return (uint32_t)jobs.size();
+    }
+
+    void JobSystem::SetMainThreadWakeCallback(std::function<void()> callback) {
+        std::lock_guard<std::mutex> lock(m_MainMutex);
+        m_MainWake = std::move(callback);
+    }
+
+    void JobSystem::WorkerLoop(uint32_t index) {
+        t_DequeIndex = (int)index;
+        t_Owner = this;
+        t_StealSeed ^= index * 0x85EBCA6Bu;
+
+        while (m_Running.load(std::memory_order_acquire)) {
+            const uint64_t epoch = m_WorkEpoch.load();
+
+            Job* job = FindJob();
+            for (int spin = 0; !job && spin < 32; spin++) {
+                std::this_thread::yield();
+                job = FindJob();
+            }
+            if (job) {
+                Execute(job);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m_SleepMutex);
+            m_Sleeping.fetch_add(1);
+            m_SleepCV.wait(lock, [&] {
+                return m_WorkEpoch.load() != epoch || !m_Running.load(std::memory_order_acquire);
+                });
+            m_Sleeping.fetch_sub(1);
+        }
+    }
+
+} // namespace Engine
@@ -0,0 +1,195 @@
+#include "pch.h"
+#include "Engine/Core/MemoryTracker.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace Engine {
+
+    namespace {
+
+        // Constant-initialised: operator new can run before any dynamic initialiser.
+        struct Counter {
+            std::atomic<int64_t> Bytes{ 0 };
+            std::atomic<int64_t> PeakBytes{ 0 };
+            std::atomic<uint64_t> Allocations{ 0 };
+
+            void Add(int64_t bytes) {
+                Allocations.fetch_add(1, std::memory_order_relaxed);
+                const int64_t now = Bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+                int64_t peak = PeakBytes.load(std::memory_order_relaxed);
+                while (now > peak && !PeakBytes.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {}
+            }
+
+            void Remove(int64_t bytes) {
+                Bytes.fetch_sub(bytes, std::memory_order_relaxed);
+            }
+
+            MemoryTracker::Usage Read() const {
+                MemoryTracker::Usage u;
+                u.Bytes = Bytes.load(std::memory_order_relaxed);
+                u.PeakBytes = PeakBytes.load(std::memory_order_relaxed);
+                u.Allocations = Allocations.load(std::memory_order_relaxed);
+                return u;
+            }
+        };
+
+        Counter s_Heap[(size_t)MemoryTag::Count];
+        Counter s_HeapTotal;
+        Counter s_Gpu[(size_t)GpuMemoryKind::Count];
+        Counter s_GpuTotal;
+
+        // running totals EndFrame diffs against
+        std::atomic<uint64_t> s_AllocCount{ 0 };
+        std::atomic<uint64_t> s_AllocBytes{ 0 };
+        uint64_t s_FrameStartCount = 0;
+        uint64_t s_FrameStartBytes = 0;
+
+        thread_local MemoryTag t_Tag = MemoryTag::General;
+
+    } // namespace
+
+    uint64_t MemoryTracker::s_FrameAllocations = 0;
+    uint64_t MemoryTracker::s_FrameBytes = 0;
+
+    bool MemoryTracker::IsHeapTrackingEnabled() {
+#ifdef ENGINE_MEMORY_TRACKING
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    MemoryTracker::Usage MemoryTracker::GetHeapUsage(MemoryTag tag) { return s_Heap[(size_t)tag].Read(); }
+    MemoryTracker::Usage MemoryTracker::GetHeapTotal() { return s_HeapTotal.Read(); }
+    MemoryTracker::Usage MemoryTracker::GetGpuUsage(GpuMemoryKind kind) { return s_Gpu[(size_t)kind].Read(); }
+    MemoryTracker::Usage MemoryTracker::GetGpuTotal() { return s_GpuTotal.Read(); }
+
+    void MemoryTracker::TrackGpuAlloc(GpuMemoryKind kind, size_t bytes) {
+        s_Gpu[(size_t)kind].Add((int64_t)bytes);
+        s_GpuTotal.Add((int64_t)bytes);
+    }
+
+    void MemoryTracker::TrackGpuFree(GpuMemoryKind kind, size_t bytes) {
+        s_Gpu[(size_t)kind].Remove((int64_t)bytes);
+        s_GpuTotal.Remove((int64_t)bytes);
+    }
+
+    MemoryTag MemoryTracker::GetThreadTag() { return t_Tag; }
+
+    MemoryTag MemoryTracker::SetThreadTag(MemoryTag tag) {
+        MemoryTag previous = t_Tag;
+        t_Tag = tag;
+        return previous;
+    }
+
+    void MemoryTracker::EndFrame() {
+        const uint64_t count = s_AllocCount.load(std::memory_order_relaxed);
+        const uint64_t bytes = s_AllocBytes.load(std::memory_order_relaxed);
+        s_FrameAllocations = count - s_FrameStartCount;
+        s_FrameBytes = bytes - s_FrameStartBytes;
+        s_FrameStartCount = count;
+        s_FrameStartBytes = bytes;
+    }
+
+    const char* MemoryTracker::GetTagName(MemoryTag tag) {
+        switch (tag) {
+        case MemoryTag::General:  return "General";
+        case MemoryTag::Assets:   return "Assets";
+        case MemoryTag::Scene:    return "Scene";
+        case MemoryTag::Renderer: return "Renderer";
+        case MemoryTag::Editor:   return "Editor";
+        case MemoryTag::Undo:     return "Undo";
+        default:                  return "?";
+        }
+    }
+
+    const char* MemoryTracker::GetGpuKindName(GpuMemoryKind kind) {
+        switch (kind) {
+        case GpuMemoryKind::Texture2D:    return "Texture2D";
+        case GpuMemoryKind::TextureCube:  return "TextureCube";
+        case GpuMemoryKind::TextureArray: return "TextureArray";
+        case GpuMemoryKind::VertexBuffer: return "VertexBuffer";
+        case GpuMemoryKind::IndexBuffer:  return "IndexBuffer";
+        case GpuMemoryKind::RenderTarget: return "RenderTarget";
+        case GpuMemoryKind::ShadowMap:    return "ShadowMap";
+        case GpuMemoryKind::UniformBuffer: return "UniformBuffer";
+        default:                          return "?";
+        }
+    }
+
+} // namespace Engine
+
+#ifdef ENGINE_MEMORY_TRACKING
+
+namespace {
+
+    // 16 bytes keeps the default new alignment for the block that follows
+    struct alignas(16) BlockHeader {
+        uint64_t Size;
+        Engine::MemoryTag Tag;
+    };
+    static_assert(sizeof(BlockHeader) == 16, "BlockHeader must preserve malloc alignment");
+
+    void* TrackedAlloc(std::size_t size) noexcept {
+        auto* header = static_cast<BlockHeader*>(std::malloc(size + sizeof(BlockHeader)));
+        if (!header)
+            return nullptr;
+
+        header->Size = size;
+        header->Tag = Engine::t_Tag;
+
+        Engine::s_Heap[(size_t)header->Tag].Add((int64_t)size);
+        Engine::s_HeapTotal.Add((int64_t)size);
+        Engine::s_AllocCount.fetch_add(1, std::memory_order_relaxed);
+        Engine::s_AllocBytes.fetch_add(size, std::memory_order_relaxed);
+        return header + 1;
+    }
+
+    void TrackedFree(void* p) noexcept {
+        if (!p)
+            return;
+
+        auto* header = static_cast<BlockHeader*>(p) - 1;
+        Engine::s_Heap[(size_t)header->Tag].Remove((int64_t)header->Size);
+        Engine::s_HeapTotal.Remove((int64_t)header->Size);
+        std::free(header);
+    }
+
+    void* TrackedNew(std::size_t size) {
+        if (size == 0)
+            size = 1;
+        for (;;) {
+            if (void* p = TrackedAlloc(size))
+                return p;
+            std::new_handler handler = std::get_new_handler();
+            if (!handler)
+                throw std::bad_alloc();
+            handler();
+        }
+    }
+
+} // namespace
+
+void* operator new(std::size_t size) { return TrackedNew(size); }
+void* operator new[](std::size_t size) { return TrackedNew(size); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try { return TrackedNew(size); }
+    catch (...) { return nullptr; }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try { return TrackedNew(size); }
+    catch (...) { return nullptr; }
+}
+
+void operator delete(void* p) noexcept { TrackedFree(p); }
+void operator delete[](void* p) noexcept { TrackedFree(p); }
+void operator delete(void* p, std::size_t) noexcept { TrackedFree(p); }
+void operator delete[](void* p, std::size_t) noexcept { TrackedFree(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { TrackedFree(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { TrackedFree(p); }
+
+#endif // ENGINE_MEMORY_TRACKING
@@ -3,10 +3,19 @@
 
 #include <GLFW/glfw3.h>
 
+#include <bitset>
+
 namespace Engine {
 
     static GLFWwindow* s_Window = nullptr;
 
+    static struct ScriptedInput {
+        bool Enabled = false;
+        std::bitset<GLFW_KEY_LAST + 1> Keys;
+        std::bitset<GLFW_MOUSE_BUTTON_LAST + 1> Buttons;
+        float MouseX = 0.0f, MouseY = 0.0f;
+    } s_Scripted;
+
     void SetNativeGLFWWindow(GLFWwindow* w) {
         s_Window = w;
     }
@@ -18,6 +27,9 @@ namespace Engine {
     }
 
     bool Input::IsKeyDown(KeyCode key) {
+        if (s_Scripted.Enabled)
+            return (int)key >= 0 && (int)key <= GLFW_KEY_LAST && s_Scripted.Keys[(size_t)key];
+
         GLFWwindow* w = GetGLFWWindow();
         if (!w) return false;
         int state = glfwGetKey(w, (int)key);
@@ -25,12 +37,21 @@ namespace Engine {
     }
 
     bool Input::IsMouseButtonDown(int button) {
+        if (s_Scripted.Enabled)
+            return button >= 0 && button <= GLFW_MOUSE_BUTTON_LAST && s_Scripted.Buttons[(size_t)button];
+
         GLFWwindow* w = GetGLFWWindow();
         if (!w) return false;
         return glfwGetMouseButton(w, button) == GLFW_PRESS;
     }
 
     void Input::GetMousePosition(float& x, float& y) {
+        if (s_Scripted.Enabled) {
+            x = s_Scripted.MouseX;
+            y = s_Scripted.MouseY;
+            return;
+        }
+
         GLFWwindow* w = GetGLFWWindow();
         if (!w) { x = y = 0.0f; return; }
         double dx, dy;
@@ -39,4 +60,28 @@ namespace Engine {
         y = (float)dy;
     }
 
+    void Input::SetScripted(bool scripted) {
+        s_Scripted = {};
+        s_Scripted.Enabled = scripted;
+    }
+
+    bool Input::IsScripted() {
+        return s_Scripted.Enabled;
+    }
+
+    void Input::SetKeyDown(KeyCode key, bool down) {
+        if ((int)key >= 0 && (int)key <= GLFW_KEY_LAST)
+            s_Scripted.Keys[(size_t)key] = down;
+    }
+
+    void Input::SetMouseButtonDown(int button, bool down) {
+        if (button >= 0 && button <= GLFW_MOUSE_BUTTON_LAST)
+            s_Scripted.Buttons[(size_t)button] = down;
+    }
+
+    void Input::SetMousePosition(float x, float y) {
+        s_Scripted.MouseX = x;
+        s_Scripted.MouseY = y;
+    }
+
 } // namespace Engine
\ No newline at end of file
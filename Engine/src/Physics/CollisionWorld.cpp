@@ -0,0 +1,424 @@
+#include "pch.h"
+#include "Engine/Physics/CollisionWorld.h"
+#include "Engine/Physics/MeshCollider.h"
+
+#include "Engine/Scene/Scene.h"
+#include "Engine/Scene/Components.h"
+#include "Engine/Assets/AssetManager.h"
+#include "Engine/Renderer/Model.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace Engine {
+
+    namespace {
+
+        constexpr float Skin = 0.002f; // gap kept from surfaces to prevent jitter
+
+        // Ericson, Real-Time Collision Detection 5.1.5
+        glm::vec3 ClosestPointOnTriangle(const glm::vec3& p, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c) {
+            const glm::vec3 ab = b - a, ac = c - a, ap = p - a;
+            const float d1 = glm::dot(ab, ap), d2 = glm::dot(ac, ap);
+            if (d1 <= 0.0f && d2 <= 0.0f) return a;
+
+            const glm::vec3 bp = p - b;
+            const float d3 = glm::dot(ab, bp), d4 = glm::dot(ac, bp);
+            if (d3 >= 0.0f && d4 <= d3) return b;
+
+            const float vc = d1 * d4 - d3 * d2;
+            if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+                return a + ab * (d1 / (d1 - d3));
+
+            const glm::vec3 cp = p - c;
+            const float d5 = glm::dot(ab, cp), d6 = glm::dot(ac, cp);
+            if (d6 >= 0.0f && d5 <= d6) return c;
+
+            const float vb = d5 * d2 - d1 * d6;
+            if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+                return a + ac * (d2 / (d2 - d6));
+
+            const float va = d3 * d6 - d5 * d4;
+            if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+                return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+
+            const float denom = 1.0f / (va + vb + vc);
+            return a + ab * (vb * denom) + ac * (vc * denom);
+        }
+
+        // Smallest root of a t^2 + b t + c = 0 in [0, maxT]
+        bool LowestRoot(float a, float b, float c, float maxT, float& outT) {
+            if (std::fabs(a) < 1e-12f) return false;
+
+            const float disc = b * b - 4.0f * a * c;
+            if (disc < 0.0f) return false;
+
+            const float sq = std::sqrt(disc);
+            float r1 = (-b - sq) / (2.0f * a);
+            float r2 = (-b + sq) / (2.0f * a);
+            if (r1 > r2) std::swap(r1, r2);
+
+            if (r1 >= 0.0f && r1 <= maxT) { outT = r1; return true; }
+            if (r2 >= 0.0f && r2 <= maxT) { outT = r2; return true; }
+            return false;
+        }
+
+        // Swept sphere vs double-sided triangle (face, then edges, then vertices).
+        // Updates ioT / outNormal when a contact earlier than ioT is found.
+        bool SweepSphereTriangle(const glm::vec3& c0, const glm::vec3& d, float r,
+            const glm::vec3& a, const glm::vec3& b, const glm::vec3& c,
+            float& ioT, glm::vec3& outNormal) {
+            glm::vec3 n = glm::cross(b - a, c - a);
+            const float nLen = glm::length(n);
+            if (nLen < 1e-12f) return false;
+            n /= nLen;
+
+            float s0 = glm::dot(c0 - a, n);
+            if (s0 < 0.0f) { n = -n; s0 = -s0; }
+
+            // already touching: that's the overlap resolver's job
+            const glm::vec3 closest0 = ClosestPointOnTriangle(c0, a, b, c);
+            const glm::vec3 toCenter0 = c0 - closest0;
+            if (glm::dot(toCenter0, toCenter0) < r * r)
+                return false;
+
+            const float approach = glm::dot(d, n);
+
+            // face interior
+            if (approach < 0.0f) {
+                const float t = (r - s0) / approach;
+                if (t >= 0.0f && t <= ioT) {
+                    const glm::vec3 p = c0 + d * t - n * r;
+                    if (glm::dot(glm::cross(b - a, p - a), n) >= 0.0f &&
+                        glm::dot(glm::cross(c - b, p - b), n) >= 0.0f &&
+                        glm::dot(glm::cross(a - c, p - c), n) >= 0.0f) {
+                        ioT = t;
+                        outNormal = n;
+                        return true;
+                    }
+                }
+            }
+
+            bool hit = false;
+            float tBest = ioT;
+            glm::vec3 contact(0.0f);
+            const float dd = glm::dot(d, d);
+
+            // vertices
+            for (const glm::vec3* v : { &a, &b, &c }) {
+                const glm::vec3 m = c0 - *v;
+                float t;
+                if (LowestRoot(dd, 2.0f * glm::dot(d, m), glm::dot(m, m) - r * r, tBest, t)) {
+                    tBest = t;
+                    contact = *v;
+                    hit = true;
+                }
+            }
+
+            // edges: distance from the moving center to the edge line == r, then clamp to the segment
+            const glm::vec3* edges[3][2] = { { &a, &b }, { &b, &c }, { &c, &a } };
+            for (const auto& edge : edges) {
+                const glm::vec3& p = *edge[0];
+                const glm::vec3 e = *edge[1] - p;
+                const glm::vec3 btv = p - c0;
+
+                const float ee = glm::dot(e, e);
+                const float ed = glm::dot(e, d);
+                const float eb = glm::dot(e, btv);
+
+                float t;
+                if (!LowestRoot(ee * dd - ed * ed,
+                    -2.0f * ee * glm::dot(d, btv) + 2.0f * ed * eb,
+                    ee * glm::dot(btv, btv) - eb * eb - r * r * ee,
+                    tBest, t))
+                    continue;
+
+                const float f = (ed * t - eb) / ee;
+                if (f < 0.0f || f > 1.0f) continue;
+
+                tBest = t;
+                contact = p + e * f;
+                hit = true;
+            }
+
+            if (!hit) return false;
+
+            const glm::vec3 away = (c0 + d * tBest) - contact;
+            const float len = glm::length(away);
+            ioT = tBest;
+            outNormal = len > 1e-8f ? away / len : n;
+            return true;
+        }
+
+        // Two triangles per face of each submesh box
+        std::shared_ptr<MeshCollider> BuildBoxShape(const Model& model) {
+            std::vector<glm::vec3> positions;
+            std::vector<uint32_t> indices;
+
+            static constexpr uint32_t Faces[12][3] = {
+                { 0, 1, 3 }, { 0, 3, 2 }, { 4, 6, 7 }, { 4, 7, 5 }, // -x, +x
+                { 0, 4, 5 }, { 0, 5, 1 }, { 2, 3, 7 }, { 2, 7, 6 }, // -y, +y
+                { 0, 2, 6 }, { 0, 6, 4 }, { 1, 5, 7 }, { 1, 7, 3 }, // -z, +z
+            };
+
+            for (const auto& sm : model.GetSubMeshes()) {
+                if (!sm.MeshPtr) continue;
+                const Bounds& b = sm.MeshPtr->GetBounds();
+
+                const uint32_t base = (uint32_t)positions.size();
+                for (uint32_t i = 0; i < 8; i++) {
+                    positions.emplace_back(
+                        (i & 4) ? b.Max.x : b.Min.x,
+                        (i & 2) ? b.Max.y : b.Min.y,
+                        (i & 1) ? b.Max.z : b.Min.z);
+                }
+                for (const auto& f : Faces) {
+                    indices.push_back(base + f[0]);
+                    indices.push_back(base + f[1]);
+                    indices.push_back(base + f[2]);
+                }
+            }
+
+            if (indices.empty()) return nullptr;
+            return MeshCollider::Build(std::move(positions), indices);
+        }
+
+    } // namespace
+
+    CollisionWorld::CollisionWorld(Scene& scene)
+        : m_Scene(scene) {
+        auto& reg = m_Scene.Registry();
+        reg.on_construct<TransformComponent>().connect<&CollisionWorld::OnBodyChanged>(*this);
+        reg.on_update<TransformComponent>().connect<&CollisionWorld::OnBodyChanged>(*this);
+        reg.on_destroy<TransformComponent>().connect<&CollisionWorld::OnBodyChanged>(*this);
+        reg.on_construct<MeshRendererComponent>().connect<&CollisionWorld::OnBodyChanged>(*this);
+        reg.on_update<MeshRendererComponent>().connect<&CollisionWorld::OnBodyChanged>(*this);
+        reg.on_destroy<MeshRendererComponent>().connect<&CollisionWorld::OnBodyChanged>(*this);
+
+        // pick up whatever is already in the scene
+        for (auto e : reg.view<TransformComponent, MeshRendererComponent>())
+            m_Dirty.push_back(e);
+    }
+
+    CollisionWorld::~CollisionWorld() {
+        auto& reg = m_Scene.Registry();
+        reg.on_construct<TransformComponent>().disconnect(*this);
+        reg.on_update<TransformComponent>().disconnect(*this);
+        reg.on_destroy<TransformComponent>().disconnect(*this);
+        reg.on_construct<MeshRendererComponent>().disconnect(*this);
+        reg.on_update<MeshRendererComponent>().disconnect(*this);
+        reg.on_destroy<MeshRendererComponent>().disconnect(*this);
+    }
+
+    void CollisionWorld::OnBodyChanged(entt::registry& /*reg*/, entt::entity e) {
+        // the component may still be attached (on_destroy); Sync looks again later
+        m_Dirty.push_back(e);
+    }
+
+    void CollisionWorld::MarkDirty(entt::entity entity) {
+        if (entity != entt::null)
+            m_Dirty.push_back(entity);
+    }
+
+    void CollisionWorld::SetUseTriangleColliders(bool enabled) {
+        if (m_UseTriangles == enabled) return;
+        m_UseTriangles = enabled;
+
+        m_Shapes.clear();
+        for (const auto& [entity, index] : m_BodyByEntity) {
+            (void)index;
+            m_Dirty.push_back(entity);
+        }
+    }
+
+    std::shared_ptr<const MeshCollider> CollisionWorld::GetShape(AssetHandle modelHandle) {
+        if (auto it = m_Shapes.find(modelHandle); it != m_Shapes.end())
+            return it->second;
+
+        // cached per model, so a body survives the model being evicted from the GPU
+        auto model = AssetManager::Get().GetModel(modelHandle);
+        if (!model) return nullptr;
+
+        std::shared_ptr<const MeshCollider> shape;
+        if (m_UseTriangles)
+            shape = model->GetCollider();
+        if (!shape || shape->GetTriangleCount() == 0)
+            shape = BuildBoxShape(*model);
+
+        m_Shapes[modelHandle] = shape;
+        return shape;
+    }
+
+    void CollisionWorld::RemoveBody(entt::entity e) {
+        auto it = m_BodyByEntity.find(e);
+        if (it == m_BodyByEntity.end()) return;
+
+        m_Hash.Remove(it->second);
+        m_Bodies[it->second] = {};
+        m_FreeBodies.push_back(it->second);
+        m_BodyByEntity.erase(it);
+    }
+
+    void CollisionWorld::Sync() {
+        if (m_Dirty.empty()) return;
+
+        std::sort(m_Dirty.begin(), m_Dirty.end());
+        m_Dirty.erase(std::unique(m_Dirty.begin(), m_Dirty.end()), m_Dirty.end());
+
+        auto& reg = m_Scene.Registry();
+        for (entt::entity e : m_Dirty) {
+            RemoveBody(e);
+
+            if (!reg.valid(e) || !reg.all_of<TransformComponent, MeshRendererComponent>(e))
+                continue;
+
+            const auto& mrc = reg.get<MeshRendererComponent>(e);
+            if (mrc.Model == InvalidAssetHandle) continue;
+
+            auto shape = GetShape(mrc.Model);
+            if (!shape) continue;
+
+            uint32_t index;
+            if (!m_FreeBodies.empty()) {
+                index = m_FreeBodies.back();
+                m_FreeBodies.pop_back();
+            }
+            else {
+                index = (uint32_t)m_Bodies.size();
+                m_Bodies.emplace_back();
+            }
+
+            Body& body = m_Bodies[index];
+            body.Entity = e;
+            body.World = reg.get<TransformComponent>(e).GetTransform();
+            body.InvWorld = glm::inverse(body.World);
+            body.Collider = std::move(shape);
+
+            glm::vec3 min, max;
+            TransformAABB(body.World, body.Collider->GetMin(), body.Collider->GetMax(), min, max);
+
+            m_BodyByEntity[e] = index;
+            m_Hash.Insert(index, min, max);
+        }
+        m_Dirty.clear();
+
+        m_Stats.Bodies = m_Hash.GetCount();
+        m_Stats.LargeBodies = m_Hash.GetLargeCount();
+    }
+
+    template<typename Fn>
+    void CollisionWorld::ForEachTriangle(const glm::vec3& min, const glm::vec3& max, Fn&& fn) {
+        m_Hash.Query(min, max, m_ScratchBodies);
+        m_Stats.CandidateBodies = (uint32_t)m_ScratchBodies.size();
+
+        uint32_t triangles = 0;
+        for (uint32_t index : m_ScratchBodies) {
+            const Body& body = m_Bodies[index];
+
+            // query the BVH in local space with a conservative box, test in world space
+            glm::vec3 lmin, lmax;
+            TransformAABB(body.InvWorld, min, max, lmin, lmax);
+
+            m_ScratchTriangles.clear();
+            body.Collider->QueryTriangles(lmin, lmax, m_ScratchTriangles);
+            triangles += (uint32_t)m_ScratchTriangles.size();
+
+            for (uint32_t t : m_ScratchTriangles) {
+                glm::vec3 a, b, c;
+                body.Collider->GetTriangle(t, a, b, c);
+                fn(body,
+                    glm::vec3(body.World * glm::vec4(a, 1.0f)),
+                    glm::vec3(body.World * glm::vec4(b, 1.0f)),
+                    glm::vec3(body.World * glm::vec4(c, 1.0f)));
+            }
+        }
+
+        m_Stats.CandidateTriangles = triangles;
+    }
+
+    SweepHit CollisionWorld::SweepSphere(const glm::vec3& from, const glm::vec3& to, float radius) {
+        Sync();
+
+        SweepHit hit;
+        const glm::vec3 d = to - from;
+        if (glm::dot(d, d) < 1e-12f) return hit;
+
+        const glm::vec3 qmin = glm::min(from, to) - glm::vec3(radius + Skin);
+        const glm::vec3 qmax = glm::max(from, to) + glm::vec3(radius + Skin);
+
+        ForEachTriangle(qmin, qmax, [&](const Body& body, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c) {
+            if (SweepSphereTriangle(from, d, radius, a, b, c, hit.Time, hit.Normal)) {
+                hit.Hit = true;
+                hit.Entity = body.Entity;
+            }
+            });
+
+        return hit;
+    }
+
+    glm::vec3 CollisionWorld::ResolveSphereOverlap(const glm::vec3& center, float radius, int maxIterations) {
+        Sync();
+
+        glm::vec3 p = center;
+        for (int iter = 0; iter < maxIterations; iter++) {
+            bool anyHit = false;
+
+            const glm::vec3 qmin = p - glm::vec3(radius + Skin);
+            const glm::vec3 qmax = p + glm::vec3(radius + Skin);
+
+            ForEachTriangle(qmin, qmax, [&](const Body&, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c) {
+                const glm::vec3 q = ClosestPointOnTriangle(p, a, b, c);
+                const glm::vec3 v = p - q;
+                const float d2 = glm::dot(v, v);
+                if (d2 >= radius * radius) return;
+
+                glm::vec3 n = glm::cross(b - a, c - a);
+                const float nLen = glm::length(n);
+                if (nLen < 1e-12f) return;
+                n /= nLen;
+
+                // Separate along closest point -> center, so the sphere stays on the side it
+                // is already on. Triangles are two-sided like the sweep: pushing to the front
+                // would carry a sphere that touched a wall or floor from behind straight through it.
+                const float d = std::sqrt(d2);
+                const glm::vec3 dir = d > 1e-5f ? v / d : (glm::dot(p - a, n) < 0.0f ? -n : n);
+                p += dir * (radius + Skin - d);
+                anyHit = true;
+                });
+
+            if (!anyHit)
+                break;
+        }
+
+        return p;
+    }
+
+    glm::vec3 CollisionWorld::MoveSphere(const glm::vec3& from, const glm::vec3& to, float radius, int maxSlides) {
+        glm::vec3 p = ResolveSphereOverlap(from, radius);
+        glm::vec3 delta = to - from;
+
+        for (int i = 0; i < maxSlides; i++) {
+            const float len2 = glm::dot(delta, delta);
+            if (len2 < 1e-12f) break;
+
+            const SweepHit hit = SweepSphere(p, p + delta, radius);
+            if (!hit.Hit) {
+                p += delta;
+                break;
+            }
+
+            // stop just short of the contact, then slide the rest along the surface
+            const float len = std::sqrt(len2);
+            const float travel = std::max(0.0f, len * hit.Time - Skin);
+            p += delta * (travel / len);
+
+            glm::vec3 rest = delta * (1.0f - hit.Time);
+            rest -= hit.Normal * glm::dot(rest, hit.Normal);
+            delta = rest;
+        }
+
+        return ResolveSphereOverlap(p, radius);
+    }
+
+} // namespace Engine
@@ -0,0 +1,128 @@
+#include "pch.h"
+#include "Engine/Physics/MeshCollider.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <numeric>
+
+namespace Engine {
+
+    namespace {
+
+        constexpr uint32_t MaxLeafTriangles = 4;
+
+        struct BuildTask {
+            uint32_t Node;
+            uint32_t First;
+            uint32_t Count;
+        };
+
+    } // namespace
+
+    std::shared_ptr<MeshCollider> MeshCollider::Build(std::vector<glm::vec3> positions, const std::vector<uint32_t>& indices) {
+        auto collider = std::make_shared<MeshCollider>();
+        const uint32_t triCount = (uint32_t)(indices.size() / 3);
+        if (triCount == 0 || positions.empty())
+            return collider;
+
+        std::vector<glm::vec3> centroids(triCount), triMin(triCount), triMax(triCount);
+        for (uint32_t i = 0; i < triCount; i++) {
+            const glm::vec3& a = positions[indices[i * 3 + 0]];
+            const glm::vec3& b = positions[indices[i * 3 + 1]];
+            const glm::vec3& c = positions[indices[i * 3 + 2]];
+            triMin[i] = glm::min(a, glm::min(b, c));
+            triMax[i] = glm::max(a, glm::max(b, c));
+            centroids[i] = (a + b + c) * (1.0f / 3.0f);
+        }
+
+        std::vector<uint32_t> order(triCount);
+        std::iota(order.begin(), order.end(), 0u);
+
+        auto& nodes = collider->m_Nodes;
+        nodes.reserve((size_t)triCount * 2 / MaxLeafTriangles + 1);
+        nodes.push_back({});
+
+        // median split on the longest centroid axis; explicit stack, no recursion
+        std::vector<BuildTask> stack{ { 0, 0, triCount } };
+        while (!stack.empty()) {
+            const BuildTask task = stack.back();
+            stack.pop_back();
+
+            glm::vec3 bmin(FLT_MAX), bmax(-FLT_MAX), cmin(FLT_MAX), cmax(-FLT_MAX);
+            for (uint32_t i = task.First; i < task.First + task.Count; i++) {
+                const uint32_t t = order[i];
+                bmin = glm::min(bmin, triMin[t]);
+                bmax = glm::max(bmax, triMax[t]);
+                cmin = glm::min(cmin, centroids[t]);
+                cmax = glm::max(cmax, centroids[t]);
+            }
+
+            Node& node = nodes[task.Node];
+            node.Min = bmin;
+            node.Max = bmax;
+
+            const glm::vec3 extent = cmax - cmin;
+            const int axis = (extent.x >= extent.y && extent.x >= extent.z) ? 0 : (extent.y >= extent.z ? 1 : 2);
+
+            if (task.Count <= MaxLeafTriangles || extent[axis] <= 1e-6f) {
+                node.LeftOrFirst = task.First;
+                node.Count = task.Count;
+                continue;
+            }
+
+            const uint32_t half = task.Count / 2;
+            auto first = order.begin() + task.First;
+            std::nth_element(first, first + half, first + task.Count,
+                [&](uint32_t l, uint32_t r) { return centroids[l][axis] < centroids[r][axis]; });
+
+            const uint32_t left = (uint32_t)nodes.size();
+            node.LeftOrFirst = left;
+            node.Count = 0;
+            nodes.push_back({});
+            nodes.push_back({});
+
+            stack.push_back({ left, task.First, half });
+            stack.push_back({ left + 1, task.First + half, task.Count - half });
+        }
+        nodes.shrink_to_fit();
+
+        auto& sorted = collider->m_Indices;
+        sorted.resize((size_t)triCount * 3);
+        for (uint32_t i = 0; i < triCount; i++) {
+            sorted[i * 3 + 0] = indices[order[i] * 3 + 0];
+            sorted[i * 3 + 1] = indices[order[i] * 3 + 1];
+            sorted[i * 3 + 2] = indices[order[i] * 3 + 2];
+        }
+
+        collider->m_Positions = std::move(positions);
+        collider->m_Positions.shrink_to_fit();
+        return collider;
+    }
+
+    void MeshCollider::QueryTriangles(const glm::vec3& min, const glm::vec3& max, std::vector<uint32_t>& outTriangles) const {
+        if (m_Nodes.empty()) return;
+
+        uint32_t stack[64];
+        uint32_t top = 0;
+        stack[top++] = 0;
+
+        while (top > 0) {
+            const Node& node = m_Nodes[stack[--top]];
+            if (node.Max.x < min.x || node.Min.x > max.x ||
+                node.Max.y < min.y || node.Min.y > max.y ||
+                node.Max.z < min.z || node.Min.z > max.z)
+                continue;
+
+            if (node.Count > 0) {
+                for (uint32_t i = 0; i < node.Count; i++)
+                    outTriangles.push_back(node.LeftOrFirst + i);
+                continue;
+            }
+
+            // median splits keep depth at ~log2(n / 4), so 64 entries can't overflow
+            stack[top++] = node.LeftOrFirst;
+            stack[top++] = node.LeftOrFirst + 1;
+        }
+    }
+
+} // namespace Engine
@@ -0,0 +1,150 @@
+#include "pch.h"
+#include "Engine/Physics/SpatialHash.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Engine {
+
+    SpatialHash::SpatialHash(float cellSize)
+        : m_CellSize(std::max(0.25f, cellSize)) {
+    }
+
+    void SpatialHash::SetCellSize(float size) {
+        m_CellSize = std::max(0.25f, size);
+
+        m_Cells.clear();
+        m_Large.clear();
+        for (uint32_t id = 0; id < (uint32_t)m_Items.size(); id++) {
+            if (m_Items[id].Live)
+                Link(id);
+        }
+    }
+
+    int SpatialHash::CellCoord(float v) const {
+        return (int)std::floor(v / m_CellSize);
+    }
+
+    uint64_t SpatialHash::CellKey(int x, int y, int z) {
+        // 21 bits per axis
+        const uint64_t mask = (1ull << 21) - 1;
+        return ((uint64_t)(uint32_t)x & mask)
+            | (((uint64_t)(uint32_t)y & mask) << 21)
+            | (((uint64_t)(uint32_t)z & mask) << 42);
+    }
+
+    void SpatialHash::Insert(uint32_t id, const glm::vec3& min, const glm::vec3& max) {
+        if (id >= m_Items.size())
+            m_Items.resize((size_t)id + 1);
+
+        Item& item = m_Items[id];
+        if (item.Live)
+            Unlink(id);
+        else
+            m_Count++;
+
+        item.Min = min;
+        item.Max = max;
+        item.Live = true;
+        Link(id);
+    }
+
+    void SpatialHash::Remove(uint32_t id) {
+        if (id >= m_Items.size() || !m_Items[id].Live) return;
+
+        Unlink(id);
+        m_Items[id].Live = false;
+        m_Count--;
+    }
+
+    void SpatialHash::Clear() {
+        m_Items.clear();
+        m_Cells.clear();
+        m_Large.clear();
+        m_Count = 0;
+    }
+
+    void SpatialHash::Link(uint32_t id) {
+        Item& item = m_Items[id];
+        for (int i = 0; i < 3; i++) {
+            item.CellMin[i] = CellCoord(item.Min[i]);
+            item.CellMax[i] = CellCoord(item.Max[i]);
+        }
+
+        const int64_t cells = (int64_t)(item.CellMax[0] - item.CellMin[0] + 1)
+            * (item.CellMax[1] - item.CellMin[1] + 1)
+            * (item.CellMax[2] - item.CellMin[2] + 1);
+        item.Large = cells > MaxCellsPerItem;
+
+        if (item.Large) {
+            m_Large.push_back(id);
+            return;
+        }
+
+        for (int z = item.CellMin[2]; z <= item.CellMax[2]; z++)
+            for (int y = item.CellMin[1]; y <= item.CellMax[1]; y++)
+                for (int x = item.CellMin[0]; x <= item.CellMax[0]; x++)
+                    m_Cells[CellKey(x, y, z)].push_back(id);
+    }
+
+    void SpatialHash::Unlink(uint32_t id) {
+        const Item& item = m_Items[id];
+        auto eraseFrom = [id](std::vector<uint32_t>& list) {
+            auto it = std::find(list.begin(), list.end(), id);
+            if (it == list.end()) return;
+            *it = list.back();
+            list.pop_back();
+            };
+
+        if (item.Large) {
+            eraseFrom(m_Large);
+            return;
+        }
+
+        for (int z = item.CellMin[2]; z <= item.CellMax[2]; z++)
+            for (int y = item.CellMin[1]; y <= item.CellMax[1]; y++)
+                for (int x = item.CellMin[0]; x <= item.CellMax[0]; x++) {
+                    auto it = m_Cells.find(CellKey(x, y, z));
+                    if (it == m_Cells.end()) continue;
+                    eraseFrom(it->second);
+                    if (it->second.empty()) m_Cells.erase(it);
+                }
+    }
+
+    void SpatialHash::Query(const glm::vec3& min, const glm::vec3& max, std::vector<uint32_t>& out) {
+        out.clear();
+        if (m_Count == 0) return;
+
+        if (++m_Stamp == 0) {
+            for (auto& item : m_Items) item.Stamp = 0;
+            m_Stamp = 1;
+        }
+
+        auto consider = [&](uint32_t id) {
+            Item& item = m_Items[id];
+            if (item.Stamp == m_Stamp) return;
+            item.Stamp = m_Stamp;
+
+            if (item.Max.x < min.x || item.Min.x > max.x ||
+                item.Max.y < min.y || item.Min.y > max.y ||
+                item.Max.z < min.z || item.Min.z > max.z)
+                return;
+            out.push_back(id);
+            };
+
+        for (uint32_t id : m_Large)
+            consider(id);
+
+        const int x0 = CellCoord(min.x), y0 = CellCoord(min.y), z0 = CellCoord(min.z);
+        const int x1 = CellCoord(max.x), y1 = CellCoord(max.y), z1 = CellCoord(max.z);
+        for (int z = z0; z <= z1; z++)
+            for (int y = y0; y <= y1; y++)
+                for (int x = x0; x <= x1; x++) {
+                    auto it = m_Cells.find(CellKey(x, y, z));
+                    if (it == m_Cells.end()) continue;
+                    for (uint32_t id : it->second)
+                        consider(id);
+                }
+    }
+
+} // namespace Engine
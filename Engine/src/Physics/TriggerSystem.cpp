@@ -0,0 +1,241 @@
+#include "pch.h"
+#include "Engine/Physics/TriggerSystem.h"
+
+#include "Engine/Scene/Scene.h"
+#include "Engine/Scene/Components.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Engine {
+
+    TriggerSystem::TriggerSystem(Scene& scene)
+        : m_Scene(scene) {
+        auto& reg = m_Scene.Registry();
+        reg.on_construct<TransformComponent>().connect<&TriggerSystem::OnTriggerChanged>(*this);
+        reg.on_update<TransformComponent>().connect<&TriggerSystem::OnTriggerChanged>(*this);
+        reg.on_destroy<TransformComponent>().connect<&TriggerSystem::OnTriggerChanged>(*this);
+        reg.on_construct<TriggerComponent>().connect<&TriggerSystem::OnTriggerChanged>(*this);
+        reg.on_update<TriggerComponent>().connect<&TriggerSystem::OnTriggerChanged>(*this);
+        reg.on_destroy<TriggerComponent>().connect<&TriggerSystem::OnTriggerChanged>(*this);
+        reg.on_construct<SceneWarpComponent>().connect<&TriggerSystem::OnTriggerChanged>(*this);
+        reg.on_update<SceneWarpComponent>().connect<&TriggerSystem::OnTriggerChanged>(*this);
+        reg.on_destroy<SceneWarpComponent>().connect<&TriggerSystem::OnTriggerChanged>(*this);
+
+        for (auto e : reg.view<TransformComponent, TriggerComponent>())
+            m_Dirty.push_back(e);
+        for (auto e : reg.view<TransformComponent, SceneWarpComponent>())
+            m_Dirty.push_back(e);
+    }
+
+    TriggerSystem::~TriggerSystem() {
+        auto& reg = m_Scene.Registry();
+        reg.on_construct<TransformComponent>().disconnect(*this);
+        reg.on_update<TransformComponent>().disconnect(*this);
+        reg.on_destroy<TransformComponent>().disconnect(*this);
+        reg.on_construct<TriggerComponent>().disconnect(*this);
+        reg.on_update<TriggerComponent>().disconnect(*this);
+        reg.on_destroy<TriggerComponent>().disconnect(*this);
+        reg.on_construct<SceneWarpComponent>().disconnect(*this);
+        reg.on_update<SceneWarpComponent>().disconnect(*this);
+        reg.on_destroy<SceneWarpComponent>().disconnect(*this);
+    }
+
+    void TriggerSystem::OnTriggerChanged(entt::registry& /*reg*/, entt::entity e) {
+        // components may still be attached (on_destroy); Sync looks again later
+        m_Dirty.push_back(e);
+    }
+
+    void TriggerSystem::MarkDirty(entt::entity entity) {
+        if (entity != entt::null)
+            m_Dirty.push_back(entity);
+    }
+
+    void TriggerSystem::EraseSlot(std::vector<uint32_t>& list, uint32_t slot) {
+        auto it = std::find(list.begin(), list.end(), slot);
+        if (it == list.end()) return;
+        *it = list.back();
+        list.pop_back();
+    }
+
+    void TriggerSystem::RemoveTrigger(entt::entity e) {
+        auto it = m_SlotByEntity.find(e);
+        if (it == m_SlotByEntity.end()) return;
+
+        // no Exit for a trigger that no longer exists
+        const uint32_t slot = it->second;
+        if (m_Triggers[slot].Inside) EraseSlot(m_Inside, slot);
+        if (m_Triggers[slot].CooldownLeft > 0.0f) EraseSlot(m_Cooling, slot);
+
+        m_Hash.Remove(slot);
+        m_Triggers[slot] = {};
+        m_FreeSlots.push_back(slot);
+        m_SlotByEntity.erase(it);
+    }
+
+    void TriggerSystem::Sync() {
+        if (m_Dirty.empty()) return;
+
+        std::sort(m_Dirty.begin(), m_Dirty.end());
+        m_Dirty.erase(std::unique(m_Dirty.begin(), m_Dirty.end()), m_Dirty.end());
+
+        auto& reg = m_Scene.Registry();
+        for (entt::entity e : m_Dirty) {
+            const bool valid = reg.valid(e) && reg.all_of<TransformComponent>(e);
+            const auto* trigger = valid ? reg.try_get<TriggerComponent>(e) : nullptr;
+            const auto* warp = valid ? reg.try_get<SceneWarpComponent>(e) : nullptr;
+
+            if (!trigger && !warp) {
+                RemoveTrigger(e);
+                continue;
+            }
+
+            // reuse the slot so Inside / cooldown survive a moved or resized trigger
+            uint32_t slot;
+            if (auto it = m_SlotByEntity.find(e); it != m_SlotByEntity.end()) {
+                slot = it->second;
+            }
+            else if (!m_FreeSlots.empty()) {
+                slot = m_FreeSlots.back();
+                m_FreeSlots.pop_back();
+                m_SlotByEntity[e] = slot;
+            }
+            else {
+                slot = (uint32_t)m_Triggers.size();
+                m_Triggers.emplace_back();
+                m_SlotByEntity[e] = slot;
+            }
+
+            Trigger& t = m_Triggers[slot];
+            t.Entity = e;
+
+            const auto& tc = reg.get<TransformComponent>(e);
+            glm::vec3 min, max;
+
+            if (trigger && trigger->Shape == TriggerComponent::ShapeType::Box) {
+                const glm::mat4 world = tc.GetTransform();
+                t.IsBox = true;
+                t.InvWorld = glm::inverse(world);
+                t.HalfExtents = glm::abs(trigger->HalfExtents);
+                TransformAABB(world, -t.HalfExtents, t.HalfExtents, min, max);
+            }
+            else {
+                // same 5 cm floor the old warp loop used
+                t.IsBox = false;
+                t.Center = tc.Translation;
+                t.Radius = std::max(0.05f, trigger ? trigger->Radius : warp->TriggerRadius);
+                min = t.Center - glm::vec3(t.Radius);
+                max = t.Center + glm::vec3(t.Radius);
+            }
+
+            t.Cooldown = trigger ? std::max(0.0f, trigger->Cooldown) : m_WarpCooldown;
+            m_Hash.Insert(slot, min, max);
+        }
+        m_Dirty.clear();
+
+        m_Stats.Triggers = m_Hash.GetCount();
+    }
+
+    bool TriggerSystem::Contains(const Trigger& t, const glm::vec3& point) const {
+        if (!t.IsBox) {
+            const glm::vec3 d = point - t.Center;
+            return glm::dot(d, d) <= t.Radius * t.Radius;
+        }
+
+        const glm::vec3 local = glm::vec3(t.InvWorld * glm::vec4(point, 1.0f));
+        return std::fabs(local.x) <= t.HalfExtents.x
+            && std::fabs(local.y) <= t.HalfExtents.y
+            && std::fabs(local.z) <= t.HalfExtents.z;
+    }
+
+    const std::vector<TriggerSystem::Event>& TriggerSystem::Update(const glm::vec3& point, float dt) {
+        Sync();
+        m_Events.clear();
+
+        // only triggers that actually fired are ticking
+        for (size_t i = 0; i < m_Cooling.size();) {
+            Trigger& t = m_Triggers[m_Cooling[i]];
+            t.CooldownLeft -= dt;
+            if (t.CooldownLeft <= 0.0f) {
+                t.CooldownLeft = 0.0f;
+                m_Cooling[i] = m_Cooling.back();
+                m_Cooling.pop_back();
+            }
+            else {
+                i++;
+            }
+        }
+
+        if (++m_UpdateIndex == 0) {
+            for (auto& t : m_Triggers) t.Seen = 0;
+            m_UpdateIndex = 1;
+        }
+
+        m_Hash.Query(point, point, m_Candidates);
+        m_Stats.Candidates = (uint32_t)m_Candidates.size();
+
+        for (uint32_t slot : m_Candidates) {
+            if (Contains(m_Triggers[slot], point))
+                m_Triggers[slot].Seen = m_UpdateIndex;
+        }
+
+        // exits
+        for (size_t i = 0; i < m_Inside.size();) {
+            Trigger& t = m_Triggers[m_Inside[i]];
+            if (t.Seen != m_UpdateIndex) {
+                t.Inside = false;
+                m_Events.push_back({ EventType::Exit, t.Entity });
+                m_Inside[i] = m_Inside.back();
+                m_Inside.pop_back();
+            }
+            else {
+                i++;
+            }
+        }
+
+        // enters / stays
+        for (uint32_t slot : m_Candidates) {
+            Trigger& t = m_Triggers[slot];
+            if (t.Seen != m_UpdateIndex) continue;
+
+            if (t.Inside) {
+                m_Events.push_back({ EventType::Stay, t.Entity });
+                continue;
+            }
+
+            t.Inside = true;
+            m_Inside.push_back(slot);
+
+            if (t.CooldownLeft > 0.0f) continue;
+
+            m_Events.push_back({ EventType::Enter, t.Entity });
+            if (t.Cooldown > 0.0f) {
+                t.CooldownLeft = t.Cooldown;
+                m_Cooling.push_back(slot);
+            }
+        }
+
+        m_Stats.Inside = (uint32_t)m_Inside.size();
+        return m_Events;
+    }
+
+    void TriggerSystem::ResetOccupancy(const glm::vec3& point) {
+        Sync();
+
+        for (uint32_t slot : m_Inside)
+            m_Triggers[slot].Inside = false;
+        m_Inside.clear();
+
+        m_Hash.Query(point, point, m_Candidates);
+        for (uint32_t slot : m_Candidates) {
+            Trigger& t = m_Triggers[slot];
+            if (!Contains(t, point)) continue;
+
+            t.Inside = true;
+            m_Inside.push_back(slot);
+        }
+
+        m_Stats.Inside = (uint32_t)m_Inside.size();
+    }
+
+} // namespace Engine
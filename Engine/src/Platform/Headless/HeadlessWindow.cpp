@@ -0,0 +1,168 @@
+#include "pch.h"
+#include "HeadlessWindow.h"
+
+#include "Engine/Core/Input.h"
+#include "../../Renderer/GLExtensions.h"
+
+#include <glad/glad.h>
+
+#ifdef ENGINE_HEADLESS_EGL
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+#include <chrono>
+
+namespace Engine {
+
+    HeadlessWindow::HeadlessWindow(const WindowProps& props) { Init(props); }
+    HeadlessWindow::~HeadlessWindow() { Shutdown(); }
+
+#ifdef ENGINE_HEADLESS_EGL
+
+    static EGLDisplay GetHeadlessDisplay() {
+        // Mesa's surfaceless platform needs neither a display server nor a GPU (llvmpipe)
+        auto getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+        if (getPlatformDisplay) {
+            EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+            if (display != EGL_NO_DISPLAY)
+                return display;
+        }
+        return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+
+    void HeadlessWindow::Init(const WindowProps& props) {
+        m_Width = props.Width;
+        m_Height = props.Height;
+
+        EGLDisplay display = GetHeadlessDisplay();
+        EGLint major = 0, minor = 0;
+        if (display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor))
+            throw std::runtime_error("Failed to initialize EGL");
+        m_Display = display;
+
+        // the destructor never runs when the constructor throws: tear down whatever
+        // was created so far (Shutdown skips the null handles) before reporting
+        auto fail = [&](const char* what) {
+            Shutdown();
+            throw std::runtime_error(what);
+            };
+
+        if (!eglBindAPI(EGL_OPENGL_API))
+            fail("EGL has no desktop OpenGL");
+
+        EGLint configAttribs[] = {
+            EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+            EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+            EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8, EGL_ALPHA_SIZE, 8,
+            EGL_DEPTH_SIZE, 24, EGL_STENCIL_SIZE, 8,
+            EGL_NONE
+        };
+
+        EGLConfig config = nullptr;
+        EGLint count = 0;
+        eglChooseConfig(display, configAttribs, &config, 1, &count);
+
+        const bool pbuffer = count > 0;
+        if (!pbuffer) {
+            // no pbuffer configs: render-to-FBO only (EGL_KHR_surfaceless_context)
+            configAttribs[1] = 0;
+            eglChooseConfig(display, configAttribs, &config, 1, &count);
+            if (count == 0)
+                fail("No EGL config for OpenGL");
+        }
+
+        const EGLint contextAttribs[] = {
+            EGL_CONTEXT_MAJOR_VERSION, 3,
+            EGL_CONTEXT_MINOR_VERSION, 3,
+            EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+            EGL_NONE
+        };
+        EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttribs);
+        if (context == EGL_NO_CONTEXT)
+            fail("Failed to create EGL OpenGL 3.3 context");
+        m_Context = context;
+
+        EGLSurface surface = EGL_NO_SURFACE;
+        if (pbuffer) {
+            const EGLint surfaceAttribs[] = { EGL_WIDTH, (EGLint)m_Width, EGL_HEIGHT, (EGLint)m_Height, EGL_NONE };
+            surface = eglCreatePbufferSurface(display, config, surfaceAttribs);
+            if (surface == EGL_NO_SURFACE)
+                fail("Failed to create EGL pbuffer");
+        }
+        m_Surface = surface;
+
+        if (!eglMakeCurrent(display, surface, surface, context))
+            fail("Failed to make EGL context current");
+
+        if (!gladLoadGLLoader((GLADloadproc)eglGetProcAddress))
+            fail("Failed to initialize glad");
+        GLExtensions::Load((GLADloadproc)eglGetProcAddress);
+
+        Input::SetScripted(true);
+
+        std::cout << "[HeadlessWindow] EGL " << major << "." << minor
+            << (pbuffer ? " pbuffer " : " surfaceless ") << m_Width << "x" << m_Height << "\n";
+        std::cout << "OpenGL Vendor:   " << glGetString(GL_VENDOR) << "\n";
+        std::cout << "OpenGL Renderer: " << glGetString(GL_RENDERER) << "\n";
+        std::cout << "OpenGL Version:  " << glGetString(GL_VERSION) << "\n";
+    }
+
+    void HeadlessWindow::Shutdown() {
+        if (!m_Display) return;
+
+        eglMakeCurrent(m_Display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if (m_Surface) eglDestroySurface(m_Display, m_Surface);
+        if (m_Context) eglDestroyContext(m_Display, m_Context);
+        eglTerminate(m_Display);
+
+        m_Display = m_Surface = m_Context = nullptr;
+    }
+
+    void HeadlessWindow::SwapBuffers() {
+        if (m_Surface)
+            eglSwapBuffers(m_Display, m_Surface);
+        else
+            glFlush();
+    }
+
+    void HeadlessWindow::SetContextCurrent(bool current) {
+        if (current)
+            eglMakeCurrent(m_Display, m_Surface, m_Surface, m_Context);
+        else
+            eglMakeCurrent(m_Display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    }
+
+#else
+
+    void HeadlessWindow::Init(const WindowProps& /*props*/) {
+        throw std::runtime_error("Headless rendering needs an EGL build (msbuild /p:EngineHeadlessEGL=true, see EngineCommon.props)");
+    }
+
+    void HeadlessWindow::Shutdown() {}
+    void HeadlessWindow::SwapBuffers() {}
+    void HeadlessWindow::SetContextCurrent(bool /*current*/) {}
+
+#endif
+
+    void HeadlessWindow::OnUpdate() {
+        PollEvents();
+        SwapBuffers();
+    }
+
+    void HeadlessWindow::WaitEvents(double timeoutSeconds) {
+        std::unique_lock<std::mutex> lock(m_WakeMutex);
+        if (timeoutSeconds > 0.0)
+            m_WakeCV.wait_for(lock, std::chrono::duration<double>(timeoutSeconds), [&] { return m_Woken; });
+        m_Woken = false;
+    }
+
+    void HeadlessWindow::PostEmptyEvent() {
+        {
+            std::lock_guard<std::mutex> lock(m_WakeMutex);
+            m_Woken = true;
+        }
+        m_WakeCV.notify_one();
+    }
+
+} // namespace Engine
@@ -0,0 +1,61 @@
+#pragma once
+#include "Engine/Core/Window.h"
+
+#include <mutex>
+#include <condition_variable>
+
+namespace Engine {
+
+    // Window without a display: an EGL pbuffer (or surfaceless) OpenGL 3.3 core context,
+    // so perf runs work on build agents with Mesa llvmpipe and no X / Wayland.
+    // RendererPipeline draws into its own render targets as usual; the present pass lands
+    // in the pbuffer. There's no OS input, so Input switches to its scripted state.
+    //
+    // Needs an EGL build (ENGINE_HEADLESS_EGL + libEGL, switched on by the EngineHeadlessEGL
+    // property in EngineCommon.props); otherwise construction throws.
+    class HeadlessWindow final : public Window {
+    public:
+        explicit HeadlessWindow(const WindowProps& props);
+        ~HeadlessWindow() override;
+
+        void OnUpdate() override;
+
+        void PollEvents() override {}
+        void WaitEvents(double timeoutSeconds) override;
+        void SwapBuffers() override;
+        void PostEmptyEvent() override;
+        void SetContextCurrent(bool current) override;
+        bool ShouldClose() const override { return false; }
+
+        uint32_t GetWidth() const override { return m_Width; }
+        uint32_t GetHeight() const override { return m_Height; }
+
+        void SetEventCallback(const EventCallbackFn& callback) override { m_EventCallback = callback; }
+
+        void* GetNativeWindow() const override { return nullptr; }
+
+        void SetCursorMode(bool /*enabled*/) override {}
+        bool IsFocused() const override { return true; }
+
+    private:
+        void Init(const WindowProps& props);
+        void Shutdown();
+
+    private:
+        // EGLDisplay / EGLSurface / EGLContext, kept opaque so EGL stays out of this header
+        void* m_Display = nullptr;
+        void* m_Surface = nullptr; // null when only a surfaceless context was available
+        void* m_Context = nullptr;
+
+        EventCallbackFn m_EventCallback;
+
+        uint32_t m_Width = 0;
+        uint32_t m_Height = 0;
+
+        // WaitEvents has nothing to wait for but still honours PostEmptyEvent
+        std::mutex m_WakeMutex;
+        std::condition_variable m_WakeCV;
+        bool m_Woken = false;
+    };
+
+} // namespace Engine
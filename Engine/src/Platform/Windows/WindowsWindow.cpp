@@ -1,5 +1,7 @@
 #include "pch.h"
 #include "WindowsWindow.h"
+#include "../Headless/HeadlessWindow.h"
+#include "../../Renderer/GLExtensions.h"
 
 #ifndef GLFW_INCLUDE_NONE
 #define GLFW_INCLUDE_NONE
@@ -22,6 +24,8 @@ namespace Engine {
     }
 
     std::unique_ptr<Window> Window::Create(const WindowProps& props) {
+        if (props.Headless)
+            return std::make_unique<HeadlessWindow>(props);
         return std::make_unique<WindowsWindow>(props);
     }
 
@@ -57,6 +61,7 @@ namespace Engine {
 
         if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
             throw std::runtime_error("Failed to initialize glad");
+        GLExtensions::Load((GLADloadproc)glfwGetProcAddress);
 
         glfwSetWindowUserPointer(m_Window, this);
 
@@ -161,10 +166,33 @@ namespace Engine {
     }
 
     void WindowsWindow::OnUpdate() {
+        PollEvents();
+        SwapBuffers();
+    }
+
+    void WindowsWindow::PollEvents() {
         glfwPollEvents();
+    }
+
+    void WindowsWindow::WaitEvents(double timeoutSeconds) {
+        if (timeoutSeconds > 0.0)
+            glfwWaitEventsTimeout(timeoutSeconds);
+        else
+            glfwPollEvents();
+    }
+
+    void WindowsWindow::SwapBuffers() {
         glfwSwapBuffers(m_Window);
     }
 
+    void WindowsWindow::PostEmptyEvent() {
+        glfwPostEmptyEvent();
+    }
+
+    void WindowsWindow::SetContextCurrent(bool current) {
+        glfwMakeContextCurrent(current ? m_Window : nullptr);
+    }
+
     bool WindowsWindow::ShouldClose() const {
         return glfwWindowShouldClose(m_Window) != 0;
     }
@@ -11,6 +11,12 @@ namespace Engine {
         ~WindowsWindow() override;
 
         void OnUpdate() override;
+
+        void PollEvents() override;
+        void WaitEvents(double timeoutSeconds) override;
+        void SwapBuffers() override;
+        void PostEmptyEvent() override;
+        void SetContextCurrent(bool current) override;
         bool ShouldClose() const override;
 
         uint32_t GetWidth() const override { return m_Width; }
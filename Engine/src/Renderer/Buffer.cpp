@@ -1,18 +1,23 @@
 #include "pch.h"
 #include "Engine/Renderer/Buffer.h"
+#include "Engine/Renderer/RenderCommand.h"
+#include "Engine/Core/MemoryTracker.h"
 
 #include <glad/glad.h>
 
 namespace Engine {
 
-    VertexBuffer::VertexBuffer(const void* data, uint32_t size) {
+    VertexBuffer::VertexBuffer(const void* data, uint32_t size)
+        : m_Size(size) {
         glGenBuffers(1, &m_RendererID);
         glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
         glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW);
+        MemoryTracker::TrackGpuAlloc(GpuMemoryKind::VertexBuffer, m_Size);
     }
 
     VertexBuffer::~VertexBuffer() {
-        glDeleteBuffers(1, &m_RendererID);
+        MemoryTracker::TrackGpuFree(GpuMemoryKind::VertexBuffer, m_Size);
+        RenderCommand::ReleaseOnRenderThread([id = m_RendererID]() { glDeleteBuffers(1, &id); });
     }
 
     void VertexBuffer::Bind() const {
@@ -24,14 +29,49 @@ namespace Engine {
         glGenBuffers(1, &m_RendererID);
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
         glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(uint32_t), indices, GL_STATIC_DRAW);
+        MemoryTracker::TrackGpuAlloc(GpuMemoryKind::IndexBuffer, (size_t)m_Count * sizeof(uint32_t));
     }
 
     IndexBuffer::~IndexBuffer() {
-        glDeleteBuffers(1, &m_RendererID);
+        MemoryTracker::TrackGpuFree(GpuMemoryKind::IndexBuffer, (size_t)m_Count * sizeof(uint32_t));
+        RenderCommand::ReleaseOnRenderThread([id = m_RendererID]() { glDeleteBuffers(1, &id); });
     }
 
     void IndexBuffer::Bind() const {
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
     }
 
+    UniformBuffer::UniformBuffer(uint32_t size)
+        : m_Size(size) {
+        glGenBuffers(1, &m_RendererID);
+        glBindBuffer(GL_UNIFORM_BUFFER, m_RendererID);
+        glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        MemoryTracker::TrackGpuAlloc(GpuMemoryKind::UniformBuffer, m_Size);
+    }
+
+    UniformBuffer::~UniformBuffer() {
+        MemoryTracker::TrackGpuFree(GpuMemoryKind::UniformBuffer, m_Size);
+        RenderCommand::ReleaseOnRenderThread([id = m_RendererID]() { glDeleteBuffers(1, &id); });
+    }
+
+    void UniformBuffer::SetData(const void* data, uint32_t size, uint32_t offset) {
+        glBindBuffer(GL_UNIFORM_BUFFER, m_RendererID);
+        glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+
+    void UniformBuffer::BindRange(uint32_t binding, uint32_t offset, uint32_t size) const {
+        glBindBufferRange(GL_UNIFORM_BUFFER, binding, m_RendererID, offset, size);
+    }
+
+    uint32_t UniformBuffer::GetOffsetAlignment() {
+        static const uint32_t alignment = [] {
+            GLint value = 0;
+            glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &value);
+            return value > 0 ? (uint32_t)value : 256u;
+        }();
+        return alignment;
+    }
+
 } // namespace Engine
\ No newline at end of file
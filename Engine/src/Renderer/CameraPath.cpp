@@ -0,0 +1,131 @@
+#include "pch.h"
+#include "Engine/Renderer/CameraPath.h"
+
+#include "Engine/Scene/Scene.h"
+#include "Engine/Scene/Components.h"
+
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
+namespace Engine {
+
+    CameraPath CameraPath::FromScene(Scene& scene) {
+        auto& reg = scene.Registry();
+        CameraPath path;
+
+        // start: the spawn point the Sandbox would use ("SpawnPoint" tag, else the first)
+        {
+            auto view = reg.view<TagComponent, TransformComponent, SpawnPointComponent>();
+            entt::entity chosen = entt::null;
+            for (auto e : view) {
+                if (view.get<TagComponent>(e).Tag == "SpawnPoint") { chosen = e; break; }
+                if (chosen == entt::null) chosen = e;
+            }
+            if (chosen != entt::null)
+                path.AddPoint(view.get<TransformComponent>(chosen).Translation);
+        }
+
+        // then the warps, in an order that doesn't depend on registry layout
+        struct WarpPoint { std::string Tag; UUID ID; glm::vec3 Position; };
+        std::vector<WarpPoint> warps;
+
+        auto view = reg.view<IDComponent, TagComponent, TransformComponent, SceneWarpComponent>();
+        for (auto e : view) {
+            warps.push_back({ view.get<TagComponent>(e).Tag, view.get<IDComponent>(e).ID,
+                view.get<TransformComponent>(e).Translation });
+        }
+        std::sort(warps.begin(), warps.end(), [](const WarpPoint& a, const WarpPoint& b) {
+            return std::tie(a.Tag, a.ID) < std::tie(b.Tag, b.ID);
+            });
+
+        for (const auto& w : warps)
+            path.AddPoint(w.Position);
+
+        return path;
+    }
+
+    glm::vec3 CameraPath::Evaluate(size_t segment, float t) const {
+        // ends are duplicated so the curve starts and stops on the first / last point
+        const size_t last = m_Points.size() - 1;
+        const glm::vec3& p0 = m_Points[segment == 0 ? 0 : segment - 1];
+        const glm::vec3& p1 = m_Points[segment];
+        const glm::vec3& p2 = m_Points[std::min(segment + 1, last)];
+        const glm::vec3& p3 = m_Points[std::min(segment + 2, last)];
+
+        const float t2 = t * t;
+        const float t3 = t2 * t;
+        return 0.5f * ((2.0f * p1)
+            + (-p0 + p2) * t
+            + (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * t2
+            + (-p0 + 3.0f * p1 - 3.0f * p2 + p3) * t3);
+    }
+
+    void CameraPath::Build() const {
+        m_Dirty = false;
+        m_Distances.clear();
+        if (m_Points.size() < 2) return;
+
+        const size_t segments = m_Points.size() - 1;
+        m_Distances.reserve(segments * SamplesPerSegment + 1);
+
+        float total = 0.0f;
+        glm::vec3 prev = m_Points[0];
+        m_Distances.push_back(0.0f);
+
+        for (size_t s = 0; s < segments; s++) {
+            for (uint32_t i = 1; i <= SamplesPerSegment; i++) {
+                const glm::vec3 p = Evaluate(s, (float)i / (float)SamplesPerSegment);
+                total += glm::length(p - prev);
+                m_Distances.push_back(total);
+                prev = p;
+            }
+        }
+    }
+
+    float CameraPath::GetLength() const {
+        if (m_Dirty) Build();
+        return m_Distances.empty() ? 0.0f : m_Distances.back();
+    }
+
+    glm::vec3 CameraPath::PointAtDistance(float distance) const {
+        // first sample at or past `distance`, then lerp the curve parameter inside that step
+        auto it = std::lower_bound(m_Distances.begin(), m_Distances.end(), distance);
+        size_t i = (size_t)std::distance(m_Distances.begin(), it);
+        if (i == 0) return m_Points.front();
+        if (i >= m_Distances.size()) return m_Points.back();
+
+        const float d0 = m_Distances[i - 1];
+        const float d1 = m_Distances[i];
+        const float frac = d1 > d0 ? (distance - d0) / (d1 - d0) : 0.0f;
+
+        const size_t step = i - 1;
+        const size_t segment = step / SamplesPerSegment;
+        const float t = ((float)(step % SamplesPerSegment) + frac) / (float)SamplesPerSegment;
+        return Evaluate(segment, t);
+    }
+
+    bool CameraPath::Sample(float time, glm::vec3& position, float& yawRadians, float& pitchRadians) const {
+        const float length = GetLength();
+        if (length <= 1e-4f || m_Speed <= 0.0f)
+            return false;
+
+        const float distance = std::clamp(time * m_Speed, 0.0f, length);
+        position = PointAtDistance(distance);
+
+        // look ahead; near the end, look along the final stretch instead
+        const float lookAhead = std::max(1.0f, m_Speed * 0.5f);
+        glm::vec3 dir = PointAtDistance(std::min(distance + lookAhead, length)) - position;
+        if (glm::dot(dir, dir) < 1e-8f)
+            dir = position - PointAtDistance(std::max(distance - lookAhead, 0.0f));
+        if (glm::dot(dir, dir) < 1e-8f)
+            dir = glm::vec3(0.0f, 0.0f, -1.0f);
+        dir = glm::normalize(dir);
+
+        // inverse of CameraController's forward: (cos p * sin y, sin p, -cos p * cos y)
+        yawRadians = std::atan2(dir.x, -dir.z);
+        pitchRadians = std::asin(std::clamp(dir.y, -1.0f, 1.0f));
+        return true;
+    }
+
+} // namespace Engine
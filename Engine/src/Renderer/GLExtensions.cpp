@@ -0,0 +1,61 @@
+#include "pch.h"
+#include "GLExtensions.h"
+
+#include <cstring>
+
+namespace Engine::GLExtensions {
+
+    bool HasProgramBinary = false;
+    PFNGetProgramBinary GetProgramBinary = nullptr;
+    PFNProgramBinary ProgramBinary = nullptr;
+    PFNProgramParameteri ProgramParameteri = nullptr;
+    bool HasParallelShaderCompile = false;
+
+    bool IsSupported(const char* extension) {
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        for (GLint i = 0; i < count; i++) {
+            const char* name = (const char*)glGetStringi(GL_EXTENSIONS, (GLuint)i);
+            if (name && std::strcmp(name, extension) == 0)
+                return true;
+        }
+        return false;
+    }
+
+    static bool HasVersion(int major, int minor) {
+        GLint maj = 0, min = 0;
+        glGetIntegerv(GL_MAJOR_VERSION, &maj);
+        glGetIntegerv(GL_MINOR_VERSION, &min);
+        return maj > major || (maj == major && min >= minor);
+    }
+
+    void Load(GLADloadproc load) {
+        if (HasVersion(4, 1) || IsSupported("GL_ARB_get_program_binary")) {
+            GetProgramBinary = (PFNGetProgramBinary)load("glGetProgramBinary");
+            ProgramBinary = (PFNProgramBinary)load("glProgramBinary");
+            ProgramParameteri = (PFNProgramParameteri)load("glProgramParameteri");
+
+            GLint formats = 0;
+            if (GetProgramBinary && ProgramBinary && ProgramParameteri)
+                glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+            HasProgramBinary = formats > 0;
+        }
+        if (!HasProgramBinary) {
+            GetProgramBinary = nullptr;
+            ProgramBinary = nullptr;
+            ProgramParameteri = nullptr;
+        }
+
+        // same enums either way; only the thread-count entry point is suffixed
+        PFNMaxShaderCompilerThreads maxThreads = nullptr;
+        if (IsSupported("GL_KHR_parallel_shader_compile"))
+            maxThreads = (PFNMaxShaderCompilerThreads)load("glMaxShaderCompilerThreadsKHR");
+        else if (IsSupported("GL_ARB_parallel_shader_compile"))
+            maxThreads = (PFNMaxShaderCompilerThreads)load("glMaxShaderCompilerThreadsARB");
+
+        HasParallelShaderCompile = maxThreads != nullptr;
+        if (maxThreads)
+            maxThreads(0xFFFFFFFFu); // implementation-chosen
+    }
+
+} // namespace Engine::GLExtensions
@@ -0,0 +1,44 @@
+#pragma once
+#include <glad/glad.h>
+
+// glad is generated for GL 3.3 core without extensions. The few newer entry points
+// the renderer can use when the driver has them are loaded here, after glad.
+
+// GL_ARB_get_program_binary (core in 4.1)
+#ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#define GL_PROGRAM_BINARY_LENGTH           0x8741
+#define GL_NUM_PROGRAM_BINARY_FORMATS      0x87FE
+#define GL_PROGRAM_BINARY_FORMATS          0x87FF
+#endif
+
+// GL_KHR_parallel_shader_compile / GL_ARB_parallel_shader_compile
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#define GL_COMPLETION_STATUS_KHR           0x91B1
+#endif
+
+namespace Engine::GLExtensions {
+
+    using PFNGetProgramBinary = void (APIENTRYP)(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary);
+    using PFNProgramBinary = void (APIENTRYP)(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length);
+    using PFNProgramParameteri = void (APIENTRYP)(GLuint program, GLenum pname, GLint value);
+    using PFNMaxShaderCompilerThreads = void (APIENTRYP)(GLuint count);
+
+    // True when the extension (or core version) is present and the driver reports at
+    // least one binary format; the pointers below are null otherwise.
+    extern bool HasProgramBinary;
+    extern PFNGetProgramBinary GetProgramBinary;
+    extern PFNProgramBinary ProgramBinary;
+    extern PFNProgramParameteri ProgramParameteri;
+
+    // True when GL_COMPLETION_STATUS_KHR can be queried on shaders and programs.
+    // Load already asked the driver for as many compiler threads as it likes.
+    extern bool HasParallelShaderCompile;
+
+    // Call on the GL thread right after gladLoadGLLoader, with the same loader.
+    void Load(GLADloadproc load);
+
+    bool IsSupported(const char* extension);
+
+} // namespace Engine::GLExtensions
@@ -1,19 +1,215 @@
 #include "pch.h"
 #include "Engine/Renderer/Material.h"
 
+#include "Engine/Renderer/Buffer.h"
 #include "Engine/Renderer/Shader.h"
 #include "Engine/Renderer/Texture2D.h"
+#include "Engine/Renderer/TextureArray.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
 
 namespace Engine {
 
+    namespace {
+
+        // CPU copy of every material's parameter block, indexed by material ID
+        struct ParamTable {
+            std::mutex Mutex;
+            std::vector<MaterialParams> Blocks;
+            std::vector<uint32_t> FreeIDs;
+            uint32_t DirtyBegin = UINT_MAX, DirtyEnd = 0;
+
+            void MarkDirty(uint32_t id) {
+                DirtyBegin = std::min(DirtyBegin, id);
+                DirtyEnd = std::max(DirtyEnd, id + 1);
+            }
+        };
+
+        struct InternTable {
+            std::mutex Mutex;
+            std::unordered_multimap<uint64_t, std::weak_ptr<Material>> Materials;
+        };
+
+        // Never destroyed: materials owned by other statics (asset caches) are released
+        // after function-local statics constructed later than them.
+        ParamTable& GetParamTable() {
+            static ParamTable* s_Table = new ParamTable();
+            return *s_Table;
+        }
+
+        InternTable& GetInternTable() {
+            static InternTable* s_Table = new InternTable();
+            return *s_Table;
+        }
+
+        uint64_t HashCombine(uint64_t h, uint64_t v) {
+            return h ^ (v + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2));
+        }
+
+        uint32_t AllocateID(const MaterialParams& params) {
+            auto& table = GetParamTable();
+            std::lock_guard<std::mutex> lock(table.Mutex);
+
+            uint32_t id;
+            if (!table.FreeIDs.empty()) {
+                id = table.FreeIDs.back();
+                table.FreeIDs.pop_back();
+                table.Blocks[id] = params;
+            }
+            else {
+                id = (uint32_t)table.Blocks.size();
+                table.Blocks.push_back(params);
+            }
+            table.MarkDirty(id);
+            return id;
+        }
+
+    } // namespace
+
     Material::Material(const std::shared_ptr<Shader>& shader)
         : m_Shader(shader) {
+        m_ID = AllocateID(m_Params);
     }
 
-    Material::~Material() = default; // <-- important
+    Material::Material(const Material& other)
+        : m_Shader(other.m_Shader),
+        m_Params(other.m_Params),
+        m_HasColor(other.m_HasColor),
+        m_TwoSided(other.m_TwoSided),
+        m_Blended(other.m_Blended),
+        m_Permutation(other.m_Permutation),
+        m_Textures(other.m_Textures),
+        m_TextureArray(other.m_TextureArray) {
+        m_ID = AllocateID(m_Params);
+    }
+
+    Material::~Material() {
+        auto& table = GetParamTable();
+        std::lock_guard<std::mutex> lock(table.Mutex);
+        table.FreeIDs.push_back(m_ID);
+    }
+
+    std::shared_ptr<Material> Material::Intern(const Material& prototype) {
+        const uint64_t hash = prototype.Hash();
+
+        auto& table = GetInternTable();
+        std::lock_guard<std::mutex> lock(table.Mutex);
+
+        auto [begin, end] = table.Materials.equal_range(hash);
+        for (auto it = begin; it != end;) {
+            if (auto material = it->second.lock()) {
+                if (*material == prototype)
+                    return material;
+                ++it;
+            }
+            else {
+                it = table.Materials.erase(it); // released since; drop the entry
+            }
+        }
+
+        auto material = std::make_shared<Material>(prototype);
+        table.Materials.emplace(hash, material);
+        return material;
+    }
+
+    void Material::WriteParams() const {
+        auto& table = GetParamTable();
+        std::lock_guard<std::mutex> lock(table.Mutex);
+        table.Blocks[m_ID] = m_Params;
+        table.MarkDirty(m_ID);
+    }
+
+    void Material::SetColor(const glm::vec4& color) {
+        m_Params.Color = color;
+        m_HasColor = true;
+        WriteParams();
+    }
 
     void Material::SetTexture(uint32_t slot, const std::shared_ptr<Texture2D>& tex) {
+        if (slot >= MaxTextureSlots) {
+            std::cout << "[Material] Texture slot " << slot << " out of range (max " << MaxTextureSlots - 1 << ")\n";
+            return;
+        }
         m_Textures[slot] = tex;
+        if (slot == 0) {
+            SetKeyword(ShaderKeyword::HasTexture0, tex != nullptr);
+            if (tex && m_TextureArray)
+                SetTextureArray(nullptr, 0);
+        }
+    }
+
+    void Material::SetTextureArray(const std::shared_ptr<TextureArray>& page, uint32_t layer) {
+        if (page && m_Textures[0])
+            SetTexture(0, nullptr);
+
+        m_TextureArray = page;
+        SetKeyword(ShaderKeyword::HasTexture0Array, page != nullptr);
+
+        m_Params.Texture0Layer = page ? (float)layer : 0.0f;
+        WriteParams();
+    }
+
+    bool Material::operator==(const Material& other) const {
+        return m_Shader == other.m_Shader
+            && std::memcmp(&m_Params, &other.m_Params, sizeof(MaterialParams)) == 0
+            && m_HasColor == other.m_HasColor
+            && m_TwoSided == other.m_TwoSided
+            && m_Blended == other.m_Blended
+            && m_Permutation == other.m_Permutation
+            && m_Textures == other.m_Textures
+            && m_TextureArray == other.m_TextureArray;
+    }
+
+    uint64_t Material::Hash() const {
+        uint64_t h = std::hash<const void*>()(m_Shader.get());
+        for (const auto& tex : m_Textures)
+            h = HashCombine(h, std::hash<const void*>()(tex.get()));
+        h = HashCombine(h, std::hash<const void*>()(m_TextureArray.get()));
+
+        uint32_t words[sizeof(MaterialParams) / 4];
+        std::memcpy(words, &m_Params, sizeof(words));
+        for (uint32_t w : words)
+            h = HashCombine(h, w);
+
+        h = HashCombine(h, (uint64_t)m_Permutation << 3 | (uint64_t)m_Blended << 2 | (uint64_t)m_TwoSided << 1 | (uint64_t)m_HasColor);
+        return h;
+    }
+
+    void Material::SyncParams(std::unique_ptr<UniformBuffer>& buffer, uint32_t stride) {
+        auto& table = GetParamTable();
+        std::lock_guard<std::mutex> lock(table.Mutex);
+
+        const uint32_t count = (uint32_t)table.Blocks.size();
+        if (count == 0)
+            return;
+
+        if (!buffer || buffer->GetSize() < count * stride) {
+            uint32_t capacity = 64;
+            while (capacity < count) capacity *= 2;
+            buffer = std::make_unique<UniformBuffer>(capacity * stride);
+            table.DirtyBegin = 0;
+            table.DirtyEnd = count;
+        }
+
+        if (table.DirtyBegin >= table.DirtyEnd)
+            return;
+
+        // blocks are packed on the CPU; spread the changed range out to the UBO stride
+        static std::vector<uint8_t> staging; // GL thread only
+        const uint32_t first = table.DirtyBegin;
+        const uint32_t n = table.DirtyEnd - table.DirtyBegin;
+        staging.assign((size_t)n * stride, 0);
+        for (uint32_t i = 0; i < n; i++)
+            std::memcpy(staging.data() + (size_t)i * stride, &table.Blocks[first + i], sizeof(MaterialParams));
+
+        buffer->SetData(staging.data(), n * stride, first * stride);
+
+        table.DirtyBegin = UINT_MAX;
+        table.DirtyEnd = 0;
     }
 
-} // namespace Engine
\ No newline at end of file
+} // namespace Engine
@@ -25,6 +25,8 @@ namespace Engine {
         m_IB = std::make_shared<IndexBuffer>(indices.data(), (uint32_t)indices.size());
         m_VAO->SetIndexBuffer(m_IB);
 
+        m_GPUMemoryBytes = vertices.size() * sizeof(Vertex) + indices.size() * sizeof(uint32_t);
+
         {
             glm::vec3 mn(FLT_MAX), mx(-FLT_MAX);
 
@@ -4,11 +4,17 @@
 #include "Engine/Renderer/Shader.h"
 #include "Engine/Renderer/Material.h"
 #include "Engine/Renderer/Texture2D.h"
+#include "Engine/Renderer/TextureArray.h"
+#include "Engine/Renderer/ShaderKeywords.h"
+#include "Engine/Physics/MeshCollider.h"
 
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 
+#include <stb_image.h>
+
+#include <algorithm>
 #include <filesystem>
 #include <iostream>
 #include <vector>
@@ -22,12 +28,151 @@ namespace Engine {
         return p.lexically_normal().string();
     }
 
-    Model::Model(const std::string& path, const std::shared_ptr<Shader>& defaultShader)
-        : m_DefaultShader(defaultShader) {
-        LoadModel(path);
-    }
+    // ---------------- Import (CPU only, any thread) ----------------
+    //
+    // Nothing in here may touch GL. Assimp::Importer is per call and stb's flip
+    // flag is set per thread, so several imports can run at once.
+
+    namespace {
+
+        struct ImportContext {
+            const aiScene* Scene = nullptr;
+            std::string Directory;
+            ModelData* Data = nullptr;
+            std::unordered_map<std::string, int32_t> TextureIndex; // texName -> Data->Textures
+        };
+
+        bool DecodeImage(const stbi_uc* bytes, size_t sizeBytes, const std::string& path,
+            ModelData::TextureData& out) {
+            stbi_set_flip_vertically_on_load_thread(1);
+
+            int w = 0, h = 0, channels = 0;
+            stbi_uc* data = bytes
+                ? stbi_load_from_memory(bytes, (int)sizeBytes, &w, &h, &channels, 4)
+                : stbi_load(path.c_str(), &w, &h, &channels, 4);
+            if (!data)
+                return false;
+
+            out.Width = w;
+            out.Height = h;
+            out.RGBA.assign(data, data + (size_t)w * (size_t)h * 4);
+            stbi_image_free(data);
+            return true;
+        }
+
+        // Loads baseColor/diffuse only for now (slot 0).
+        int32_t ImportTexture(ImportContext& ctx, aiMaterial* mat) {
+            auto tryType = [&](aiTextureType type) -> std::string {
+                if (!mat || mat->GetTextureCount(type) == 0) return {};
+                aiString str;
+                if (mat->GetTexture(type, 0, &str) != AI_SUCCESS) return {};
+                return str.C_Str();
+                };
+
+            // glTF
+            std::string texName = tryType(aiTextureType_BASE_COLOR);
+            // other formats
+            if (texName.empty())
+                texName = tryType(aiTextureType_DIFFUSE);
+
+            if (texName.empty())
+                return -1;
+
+            if (auto it = ctx.TextureIndex.find(texName); it != ctx.TextureIndex.end())
+                return it->second;
+
+            ModelData::TextureData tex;
+            tex.Name = texName;
+            bool ok = false;
+
+            // ---- Embedded texture (GLB often uses this) ----
+            if (const aiTexture* embedded = ctx.Scene->GetEmbeddedTexture(texName.c_str())) {
+                if (embedded->mHeight == 0) {
+                    // Compressed image data (PNG/JPG)
+                    ok = DecodeImage(reinterpret_cast<const stbi_uc*>(embedded->pcData),
+                        (size_t)embedded->mWidth, texName, tex);
+                    if (ok) std::cout << "[Model] Loaded embedded texture: " << texName << "\n";
+                }
+                else {
+                    // Uncompressed (rare): aiTexel array (RGBA)
+                    const int w = (int)embedded->mWidth;
+                    const int h = (int)embedded->mHeight;
+                    tex.Width = w;
+                    tex.Height = h;
+                    tex.RGBA.resize((size_t)w * (size_t)h * 4);
+                    for (int i = 0; i < w * h; i++) {
+                        tex.RGBA[i * 4 + 0] = embedded->pcData[i].r;
+                        tex.RGBA[i * 4 + 1] = embedded->pcData[i].g;
+                        tex.RGBA[i * 4 + 2] = embedded->pcData[i].b;
+                        tex.RGBA[i * 4 + 3] = embedded->pcData[i].a;
+                    }
+                    ok = true;
+                    std::cout << "[Model] Loaded embedded RGBA texture: " << texName << "\n";
+                }
+
+                if (!ok)
+                    std::cout << "[Model] Failed to decode embedded texture: " << texName << "\n";
+            }
+            else {
+                // ---- External texture (gltf+pngs, obj+mtl, etc.) ----
+                const std::string fullPath = JoinPathFS(ctx.Directory, texName);
+                ok = DecodeImage(nullptr, 0, fullPath, tex);
+                if (ok) std::cout << "[Model] Loaded texture: " << fullPath << "\n";
+                else    std::cout << "[Model] Texture load failed: " << fullPath << " (" << stbi_failure_reason() << ")\n";
+            }
+
+            // remember failures too, so a missing file isn't probed once per submesh
+            const int32_t index = ok ? (int32_t)ctx.Data->Textures.size() : -1;
+            if (ok) ctx.Data->Textures.push_back(std::move(tex));
+            ctx.TextureIndex[texName] = index;
+            return index;
+        }
 
-    void Model::LoadModel(const std::string& path) {
+        void ImportMesh(ImportContext& ctx, aiMesh* mesh) {
+            ModelData::SubMeshData sm;
+            sm.Vertices.reserve(mesh->mNumVertices);
+
+            for (unsigned i = 0; i < mesh->mNumVertices; i++) {
+                Vertex v{};
+                v.Position = { mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z };
+
+                if (mesh->HasNormals())
+                    v.Normal = { mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z };
+                else
+                    v.Normal = { 0.0f, 1.0f, 0.0f };
+
+                if (mesh->mTextureCoords[0])
+                    v.TexCoord = { mesh->mTextureCoords[0][i].x, mesh->mTextureCoords[0][i].y };
+                else
+                    v.TexCoord = { 0.0f, 0.0f };
+
+                sm.Vertices.push_back(v);
+            }
+
+            sm.Indices.reserve((size_t)mesh->mNumFaces * 3);
+            for (unsigned i = 0; i < mesh->mNumFaces; i++) {
+                const aiFace& face = mesh->mFaces[i];
+                for (unsigned j = 0; j < face.mNumIndices; j++)
+                    sm.Indices.push_back(face.mIndices[j]);
+            }
+
+            if (mesh->mMaterialIndex < ctx.Scene->mNumMaterials)
+                sm.Texture = ImportTexture(ctx, ctx.Scene->mMaterials[mesh->mMaterialIndex]);
+
+            ctx.Data->SubMeshes.push_back(std::move(sm));
+        }
+
+        void ImportNode(ImportContext& ctx, aiNode* node) {
+            for (unsigned i = 0; i < node->mNumMeshes; i++)
+                ImportMesh(ctx, ctx.Scene->mMeshes[node->mMeshes[i]]);
+
+            for (unsigned i = 0; i < node->mNumChildren; i++)
+                ImportNode(ctx, node->mChildren[i]);
+        }
+
+    } // namespace
+
+    ModelData Model::Import(const std::string& path) {
         Assimp::Importer importer;
 
         // You can optionally add aiProcess_FlipUVs if textures appear upside-down for some assets.
@@ -44,148 +189,172 @@ namespace Engine {
             throw std::runtime_error(std::string("Assimp failed: ") + importer.GetErrorString());
         }
 
+        ModelData data;
+        data.SourcePath = path;
+
+        ImportContext ctx;
+        ctx.Scene = scene;
         auto slash = path.find_last_of("/\\");
-        m_Directory = (slash == std::string::npos) ? "" : path.substr(0, slash);
-        m_SourcePath = path; // NEW: keep for cache keys
+        ctx.Directory = (slash == std::string::npos) ? "" : path.substr(0, slash);
+        ctx.Data = &data;
 
-        m_SubMeshes.clear();
-        m_TextureCache.clear();
-        ProcessNode(scene->mRootNode, scene);
+        ImportNode(ctx, scene->mRootNode);
 
-        std::cout << "[Model] Loaded: " << path << " submeshes=" << m_SubMeshes.size() << "\n";
-    }
+        // collision geometry: positions of every submesh in one triangle list
+        {
+            size_t vertexCount = 0, indexCount = 0;
+            for (const auto& sm : data.SubMeshes) {
+                vertexCount += sm.Vertices.size();
+                indexCount += sm.Indices.size();
+            }
+
+            std::vector<glm::vec3> positions;
+            std::vector<uint32_t> indices;
+            positions.reserve(vertexCount);
+            indices.reserve(indexCount);
+            for (const auto& sm : data.SubMeshes) {
+                const uint32_t base = (uint32_t)positions.size();
+                for (const auto& v : sm.Vertices)
+                    positions.push_back(v.Position);
+                for (uint32_t i : sm.Indices)
+                    indices.push_back(base + i);
+            }
 
-    void Model::ProcessNode(aiNode* node, const aiScene* scene) {
-        for (unsigned i = 0; i < node->mNumMeshes; i++) {
-            aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
-            m_SubMeshes.push_back(ProcessMesh(mesh, scene));
+            if (!indices.empty())
+                data.Collider = MeshCollider::Build(std::move(positions), indices);
         }
 
-        for (unsigned i = 0; i < node->mNumChildren; i++)
-            ProcessNode(node->mChildren[i], scene);
+        return data;
     }
 
-    // Loads baseColor/diffuse only for now (slot 0).
-    std::shared_ptr<Texture2D> Model::LoadTextureFromMaterial(aiMaterial* mat, const aiScene* scene) {
-        auto tryType = [&](aiTextureType type) -> std::string {
-            if (!mat || mat->GetTextureCount(type) == 0) return {};
-            aiString str;
-            if (mat->GetTexture(type, 0, &str) != AI_SUCCESS) return {};
-            return str.C_Str();
-            };
-
-        // glTF
-        std::string texName = tryType(aiTextureType_BASE_COLOR);
-        // other formats
-        if (texName.empty())
-            texName = tryType(aiTextureType_DIFFUSE);
-
-        if (texName.empty())
-            return nullptr;
-
-        // Cache key
-        std::string cacheKey = m_SourcePath + "|" + texName;
-        if (auto it = m_TextureCache.find(cacheKey); it != m_TextureCache.end())
-            return it->second;
-
-        // ---- Embedded texture (GLB often uses this) ----
-        if (scene) {
-            if (const aiTexture* embedded = scene->GetEmbeddedTexture(texName.c_str())) {
-                // Compressed image data (PNG/JPG) if mHeight == 0
-                if (embedded->mHeight == 0) {
-                    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(embedded->pcData);
-                    size_t sizeBytes = (size_t)embedded->mWidth;
-
-                    Texture2D* raw = Texture2D::CreateFromMemory(texName, bytes, sizeBytes);
-                    auto tex = std::shared_ptr<Texture2D>(raw);
-
-                    m_TextureCache[cacheKey] = tex;
-                    std::cout << "[Model] Loaded embedded texture: " << texName << "\n";
-                    return tex;
-                }
-
-                // Uncompressed (rare): aiTexel array (RGBA)
-                {
-                    int w = (int)embedded->mWidth;
-                    int h = (int)embedded->mHeight;
+    void Model::PackTextures(ModelData& data) {
+        // GL 3.3 guarantees 256 array layers
+        constexpr uint32_t MaxLayersPerPage = 256;
+
+        data.TexturePages.clear();
+        for (auto& td : data.Textures)
+            td.Page = -1;
+
+        // textures grouped by size, in first-seen order
+        std::vector<std::vector<size_t>> groups;
+        for (size_t i = 0; i < data.Textures.size(); i++) {
+            const auto& td = data.Textures[i];
+            auto it = std::find_if(groups.begin(), groups.end(), [&](const std::vector<size_t>& g) {
+                const auto& first = data.Textures[g.front()];
+                return first.Width == td.Width && first.Height == td.Height;
+                });
+            if (it == groups.end()) groups.push_back({ i });
+            else                    it->push_back(i);
+        }
 
-                    std::vector<uint8_t> rgba;
-                    rgba.resize((size_t)w * (size_t)h * 4);
+        for (const auto& group : groups) {
+            if (group.size() < 2)
+                continue; // nothing to share a binding with
 
-                    for (int i = 0; i < w * h; i++) {
-                        rgba[i * 4 + 0] = embedded->pcData[i].r;
-                        rgba[i * 4 + 1] = embedded->pcData[i].g;
-                        rgba[i * 4 + 2] = embedded->pcData[i].b;
-                        rgba[i * 4 + 3] = embedded->pcData[i].a;
-                    }
+            for (size_t start = 0; start < group.size(); start += MaxLayersPerPage) {
+                const uint32_t layers = (uint32_t)std::min<size_t>(MaxLayersPerPage, group.size() - start);
+                const int32_t page = (int32_t)data.TexturePages.size();
 
-                    Texture2D* raw = Texture2D::CreateFromRGBA8(texName, rgba.data(), w, h);
-                    auto tex = std::shared_ptr<Texture2D>(raw);
+                const auto& first = data.Textures[group[start]];
+                data.TexturePages.push_back({ first.Width, first.Height, layers });
 
-                    m_TextureCache[cacheKey] = tex;
-                    std::cout << "[Model] Loaded embedded RGBA texture: " << texName << "\n";
-                    return tex;
+                for (uint32_t layer = 0; layer < layers; layer++) {
+                    auto& td = data.Textures[group[start + layer]];
+                    td.Page = page;
+                    td.Layer = layer;
                 }
             }
         }
+    }
 
-        // ---- External texture (gltf+pngs, obj+mtl, etc.) ----
-        std::string fullPath = JoinPathFS(m_Directory, texName);
+    // ---------------- Upload (GL thread) ----------------
 
-        try {
-            auto tex = std::make_shared<Texture2D>(fullPath);
-            m_TextureCache[cacheKey] = tex;
-            std::cout << "[Model] Loaded texture: " << fullPath << "\n";
-            return tex;
-        }
-        catch (const std::exception& e) {
-            std::cout << "[Model] Texture load failed: " << fullPath << " (" << e.what() << ")\n";
-            return nullptr;
-        }
+    Model::Model(const std::string& path, const std::shared_ptr<Shader>& defaultShader)
+        : m_DefaultShader(defaultShader) {
+        Upload(Import(path));
     }
 
-    Model::SubMesh Model::ProcessMesh(aiMesh* mesh, const aiScene* scene) {
-        std::vector<Vertex> vertices;
-        std::vector<uint32_t> indices;
-
-        vertices.reserve(mesh->mNumVertices);
+    Model::Model(ModelData&& data, const std::shared_ptr<Shader>& defaultShader)
+        : m_DefaultShader(defaultShader) {
+        Upload(std::move(data));
+    }
 
-        for (unsigned i = 0; i < mesh->mNumVertices; i++) {
-            Vertex v{};
-            v.Position = { mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z };
+    void Model::Upload(ModelData&& data) {
+        m_SourcePath = data.SourcePath; // NEW: keep for cache keys
 
-            if (mesh->HasNormals())
-                v.Normal = { mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z };
-            else
-                v.Normal = { 0.0f, 1.0f, 0.0f };
+        m_SubMeshes.clear();
+        m_TextureCache.clear();
+        m_TexturePages.clear();
+        m_Collider = std::move(data.Collider);
+
+        // pages need a shader that samples u_Texture0 as an array
+        const bool usePages = !data.TexturePages.empty() && m_DefaultShader
+            && (m_DefaultShader->GetKeywords() & ShaderKeyword::HasTexture0Array);
+        if (usePages) {
+            for (size_t i = 0; i < data.TexturePages.size(); i++) {
+                const auto& pd = data.TexturePages[i];
+                m_TexturePages.push_back(std::make_shared<TextureArray>(m_SourcePath + "|page" + std::to_string(i),
+                    (uint32_t)pd.Width, (uint32_t)pd.Height, pd.Layers));
+            }
+        }
 
-            if (mesh->mTextureCoords[0])
-                v.TexCoord = { mesh->mTextureCoords[0][i].x, mesh->mTextureCoords[0][i].y };
-            else
-                v.TexCoord = { 0.0f, 0.0f };
+        std::vector<std::shared_ptr<Texture2D>> textures(data.Textures.size());
+        for (size_t i = 0; i < data.Textures.size(); i++) {
+            auto& td = data.Textures[i];
+            if (usePages && td.Page >= 0) {
+                m_TexturePages[(size_t)td.Page]->SetLayerRGBA8(td.Layer, td.RGBA.data());
+            }
+            else {
+                auto tex = std::shared_ptr<Texture2D>(Texture2D::CreateFromRGBA8(td.Name, td.RGBA.data(), td.Width, td.Height));
+                m_TextureCache[m_SourcePath + "|" + td.Name] = tex;
+                textures[i] = std::move(tex);
+            }
 
-            vertices.push_back(v);
+            // pixels live on the GPU now
+            td.RGBA.clear();
+            td.RGBA.shrink_to_fit();
         }
+        for (auto& page : m_TexturePages)
+            page->GenerateMipmaps();
+
+        // submeshes that only differ in geometry share one interned material
+        m_SubMeshes.reserve(data.SubMeshes.size());
+        for (auto& sm : data.SubMeshes) {
+            auto meshObj = std::make_shared<Mesh>(sm.Vertices, sm.Indices);
+
+            Material material(m_DefaultShader);
+            material.SetColor({ 1, 1, 1, 1 });
+            if (sm.Texture >= 0) {
+                const auto& td = data.Textures[(size_t)sm.Texture];
+                if (usePages && td.Page >= 0)
+                    material.SetTextureArray(m_TexturePages[(size_t)td.Page], td.Layer);
+                else
+                    material.SetTexture(0, textures[(size_t)sm.Texture]);
+            }
 
-        for (unsigned i = 0; i < mesh->mNumFaces; i++) {
-            const aiFace& face = mesh->mFaces[i];
-            for (unsigned j = 0; j < face.mNumIndices; j++)
-                indices.push_back(face.mIndices[j]);
+            m_SubMeshes.push_back({ meshObj, Material::Intern(material) });
         }
 
-        auto meshObj = std::make_shared<Mesh>(vertices, indices);
-
-        auto matObj = std::make_shared<Material>(m_DefaultShader);
-        matObj->SetColor({ 1, 1, 1, 1 });
+        std::cout << "[Model] Loaded: " << m_SourcePath << " submeshes=" << m_SubMeshes.size();
+        if (!m_TexturePages.empty())
+            std::cout << " texture pages=" << m_TexturePages.size();
+        std::cout << "\n";
+    }
 
-        if (scene && mesh->mMaterialIndex < scene->mNumMaterials) {
-            aiMaterial* aiMat = scene->mMaterials[mesh->mMaterialIndex];
-            auto tex0 = LoadTextureFromMaterial(aiMat, scene);
-            if (tex0)
-                matObj->SetTexture(0, tex0);
-        }
+    void Model::SetMaterial(size_t subMesh, const std::shared_ptr<Material>& material) {
+        if (subMesh < m_SubMeshes.size())
+            m_SubMeshes[subMesh].MaterialPtr = material;
+    }
 
-        return { meshObj, matObj };
+    size_t Model::GetGPUMemoryBytes() const {
+        size_t bytes = 0;
+        for (const auto& sm : m_SubMeshes)
+            if (sm.MeshPtr) bytes += sm.MeshPtr->GetGPUMemoryBytes();
+        for (const auto& [key, tex] : m_TextureCache)
+            if (tex) bytes += tex->GetGPUMemoryBytes();
+        for (const auto& page : m_TexturePages)
+            bytes += page->GetGPUMemoryBytes();
+        return bytes;
     }
 
-} // namespace Engine
\ No newline at end of file
+} // namespace Engine
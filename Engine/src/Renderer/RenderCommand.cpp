@@ -1,10 +1,17 @@
 #include "pch.h"
 #include "Engine/Renderer/RenderCommand.h"
+#include "Engine/Renderer/RenderThread.h"
+#include "Engine/Renderer/Renderer.h"
+#include "Engine/Core/MemoryTracker.h"
+
+#include <atomic>
 
 #include <glad/glad.h>
 
 namespace Engine {
 
+    static std::atomic<RenderThread*> s_RenderThread{ nullptr };
+
     void RenderCommand::Init() {
         glEnable(GL_DEPTH_TEST);
         glDepthFunc(GL_LESS);
@@ -35,6 +42,33 @@ namespace Engine {
 
     void RenderCommand::DrawIndexed(uint32_t indexCount) {
         glDrawElements(GL_TRIANGLES, (int)indexCount, GL_UNSIGNED_INT, nullptr);
+
+        auto& stats = Renderer::CurrentStats();
+        stats.DrawCalls++;
+        stats.Triangles += indexCount / 3;
+    }
+
+    void RenderCommand::SetRenderThread(RenderThread* thread) {
+        s_RenderThread.store(thread, std::memory_order_release);
+    }
+
+    void RenderCommand::RunOnRenderThread(const std::function<void()>& fn) {
+        RenderThread* thread = s_RenderThread.load(std::memory_order_acquire);
+        if (thread) {
+            // charge what fn allocates to the caller's subsystem, not the render thread's
+            const MemoryTag tag = MemoryTracker::GetThreadTag();
+            thread->Execute([&fn, tag]() { MemoryScope scope(tag); fn(); });
+        }
+        else
+            fn();
+    }
+
+    void RenderCommand::ReleaseOnRenderThread(std::function<void()> fn) {
+        RenderThread* thread = s_RenderThread.load(std::memory_order_acquire);
+        if (thread && !thread->IsRenderThread())
+            thread->Enqueue(std::move(fn));
+        else
+            fn();
     }
 
 } // namespace Engine
\ No newline at end of file
@@ -0,0 +1,320 @@
+#include "pch.h"
+#include "Engine/Renderer/RenderGraph.h"
+#include "Engine/Renderer/RenderCommand.h"
+#include "Engine/Renderer/Renderer.h"
+#include "Engine/Core/MemoryTracker.h"
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Engine {
+
+    // every format is 4 bytes per texel
+    static size_t TargetBytes(const RenderTargetDesc& desc) {
+        return (size_t)desc.Width * desc.Height * 4;
+    }
+
+    // ---------------- RenderTargetPool ----------------
+
+    RenderTargetPool::~RenderTargetPool() {
+        for (const auto& entry : m_Entries)
+            Destroy(entry);
+
+        std::vector<uint32_t> fbos;
+        for (const auto& [key, fbo] : m_Framebuffers)
+            fbos.push_back(fbo);
+        if (!fbos.empty()) {
+            RenderCommand::ReleaseOnRenderThread([fbos = std::move(fbos)]() {
+                glDeleteFramebuffers((GLsizei)fbos.size(), fbos.data());
+                });
+        }
+    }
+
+    uint32_t RenderTargetPool::BucketSize(uint32_t size) {
+        return std::max(1u, (size + SizeGranularity - 1) / SizeGranularity) * SizeGranularity;
+    }
+
+    uint32_t RenderTargetPool::Acquire(const RenderTargetDesc& desc) {
+        const RenderTargetDesc bucket{ BucketSize(desc.Width), BucketSize(desc.Height), desc.Format };
+
+        for (auto& entry : m_Entries) {
+            if (entry.InUse || entry.Bucket.Format != bucket.Format
+                || entry.Bucket.Width != bucket.Width || entry.Bucket.Height != bucket.Height)
+                continue;
+            entry.InUse = true;
+            entry.LastUsedFrame = m_Frame;
+            return entry.Texture;
+        }
+
+        Entry entry;
+        entry.Bucket = bucket;
+        entry.InUse = true;
+        entry.LastUsedFrame = m_Frame;
+
+        glGenTextures(1, &entry.Texture);
+        glBindTexture(GL_TEXTURE_2D, entry.Texture);
+
+        const GLsizei w = (GLsizei)bucket.Width, h = (GLsizei)bucket.Height;
+        switch (bucket.Format) {
+        case RenderTargetFormat::RGBA8:
+            // only the lower-left Width x Height is rendered and it's read back 1:1;
+            // linear filtering would blend in the unwritten texels past its edge
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            break;
+        case RenderTargetFormat::R32UI:
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_R32UI, w, h, 0, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            break;
+        case RenderTargetFormat::Depth24Stencil8:
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH24_STENCIL8, w, h, 0, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, nullptr);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            break;
+        }
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        MemoryTracker::TrackGpuAlloc(GpuMemoryKind::RenderTarget, TargetBytes(bucket));
+        m_Entries.push_back(entry);
+        return entry.Texture;
+    }
+
+    void RenderTargetPool::Release(uint32_t texture) {
+        for (auto& entry : m_Entries) {
+            if (entry.Texture == texture) {
+                entry.InUse = false;
+                return;
+            }
+        }
+    }
+
+    uint32_t RenderTargetPool::GetFramebuffer(uint32_t color, uint32_t depth) {
+        const uint64_t key = (uint64_t)color << 32 | depth;
+        if (auto it = m_Framebuffers.find(key); it != m_Framebuffers.end())
+            return it->second;
+
+        GLuint fbo = 0;
+        glGenFramebuffers(1, &fbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+
+        if (color) {
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, color, 0);
+            GLenum drawBuffers[1] = { GL_COLOR_ATTACHMENT0 };
+            glDrawBuffers(1, drawBuffers);
+        }
+        else {
+            glDrawBuffer(GL_NONE);
+            glReadBuffer(GL_NONE);
+        }
+        if (depth)
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, depth, 0);
+
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+            throw std::runtime_error("Render target framebuffer incomplete");
+
+        m_Framebuffers.emplace(key, fbo);
+        return fbo;
+    }
+
+    void RenderTargetPool::EndFrame() {
+        m_Frame++;
+
+        for (size_t i = 0; i < m_Entries.size();) {
+            const Entry& entry = m_Entries[i];
+            if (entry.InUse || m_Frame - entry.LastUsedFrame <= GraceFrames) {
+                i++;
+                continue;
+            }
+            Destroy(entry);
+            m_Entries[i] = m_Entries.back();
+            m_Entries.pop_back();
+        }
+    }
+
+    void RenderTargetPool::Destroy(const Entry& entry) {
+        MemoryTracker::TrackGpuFree(GpuMemoryKind::RenderTarget, TargetBytes(entry.Bucket));
+
+        // FBOs that attach it go with it
+        std::vector<uint32_t> fbos;
+        for (auto it = m_Framebuffers.begin(); it != m_Framebuffers.end();) {
+            const uint32_t color = (uint32_t)(it->first >> 32), depth = (uint32_t)it->first;
+            if (color == entry.Texture || depth == entry.Texture) {
+                fbos.push_back(it->second);
+                it = m_Framebuffers.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+
+        RenderCommand::ReleaseOnRenderThread([tex = entry.Texture, fbos = std::move(fbos)]() {
+            if (!fbos.empty()) glDeleteFramebuffers((GLsizei)fbos.size(), fbos.data());
+            glDeleteTextures(1, &tex);
+            });
+    }
+
+    // ---------------- RenderGraph ----------------
+
+    RenderGraph::~RenderGraph() {
+        for (uint32_t texture : m_Held)
+            m_Pool.Release(texture);
+    }
+
+    void RenderGraph::Reset() {
+        for (uint32_t texture : m_Held)
+            m_Pool.Release(texture);
+        m_Held.clear();
+
+        m_Resources.clear();
+        m_Passes.clear();
+        m_CulledPasses = 0;
+    }
+
+    RenderGraph::Resource RenderGraph::Import(const std::string& name, uint32_t texture, const RenderTargetDesc& desc) {
+        ResourceNode node;
+        node.Name = name;
+        node.Desc = desc;
+        node.Texture = texture;
+        node.Imported = true;
+        node.Written = true;
+        m_Resources.push_back(std::move(node));
+        return (Resource)m_Resources.size() - 1;
+    }
+
+    void RenderGraph::AddPass(const std::string& name, const SetupFn& setup, ExecuteFn execute) {
+        PassNode pass;
+        pass.Name = name;
+        pass.Execute = std::move(execute);
+        m_Passes.push_back(std::move(pass));
+
+        Builder builder(*this, (uint32_t)m_Passes.size() - 1);
+        setup(builder);
+    }
+
+    void RenderGraph::Export(Resource resource) {
+        m_Resources[resource].Exported = true;
+    }
+
+    RenderGraph::Resource RenderGraph::Builder::Create(const std::string& name, const RenderTargetDesc& desc) {
+        ResourceNode node;
+        node.Name = name;
+        node.Desc = desc;
+        m_Graph.m_Resources.push_back(std::move(node));
+        return Write((Resource)m_Graph.m_Resources.size() - 1);
+    }
+
+    RenderGraph::Resource RenderGraph::Builder::Read(Resource resource) {
+        auto& node = m_Graph.m_Resources[resource];
+        auto& pass = m_Graph.m_Passes[m_Pass];
+        if (!node.Written)
+            throw std::runtime_error("RenderGraph: pass '" + pass.Name + "' reads '" + node.Name + "' before any pass writes it");
+
+        pass.Reads.push_back(resource);
+        return resource;
+    }
+
+    RenderGraph::Resource RenderGraph::Builder::Write(Resource resource) {
+        m_Graph.m_Resources[resource].Written = true;
+        m_Graph.m_Passes[m_Pass].Writes.push_back(resource);
+        return resource;
+    }
+
+    void RenderGraph::Builder::SetSideEffect() {
+        m_Graph.m_Passes[m_Pass].SideEffect = true;
+    }
+
+    void RenderGraph::Use(uint32_t pass, Resource resource) {
+        auto& node = m_Resources[resource];
+        node.FirstUse = std::min(node.FirstUse, pass);
+        node.LastUse = std::max(node.LastUse, pass);
+    }
+
+    void RenderGraph::Execute() {
+        // --- Cull: walk back from exports and side effects ---
+        std::vector<bool> needed(m_Resources.size(), false);
+        for (size_t r = 0; r < m_Resources.size(); r++)
+            needed[r] = m_Resources[r].Exported;
+
+        for (size_t i = m_Passes.size(); i-- > 0;) {
+            auto& pass = m_Passes[i];
+            pass.Live = pass.SideEffect
+                || std::any_of(pass.Writes.begin(), pass.Writes.end(), [&](Resource r) { return needed[r]; });
+            if (!pass.Live) {
+                m_CulledPasses++;
+                continue;
+            }
+            for (Resource r : pass.Reads)
+                needed[r] = true;
+        }
+
+        // --- Lifetimes over the live passes ---
+        for (uint32_t i = 0; i < (uint32_t)m_Passes.size(); i++) {
+            if (!m_Passes[i].Live) continue;
+            for (Resource r : m_Passes[i].Reads)  Use(i, r);
+            for (Resource r : m_Passes[i].Writes) Use(i, r);
+        }
+
+        // --- Run: acquire at first use, release after last (exports are held) ---
+        Context context(*this);
+        for (uint32_t i = 0; i < (uint32_t)m_Passes.size(); i++) {
+            auto& pass = m_Passes[i];
+            if (!pass.Live) continue;
+
+            for (auto& node : m_Resources)
+                if (!node.Imported && node.FirstUse == i)
+                    node.Texture = m_Pool.Acquire(node.Desc);
+
+            pass.Execute(context);
+
+            for (auto& node : m_Resources) {
+                if (node.Imported || node.LastUse != i || !node.Texture) continue;
+                if (node.Exported) {
+                    m_Held.push_back(node.Texture);
+                }
+                else {
+                    m_Pool.Release(node.Texture);
+                    node.Texture = 0;
+                }
+            }
+        }
+
+        m_Pool.EndFrame();
+    }
+
+    uint32_t RenderGraph::GetTexture(Resource resource) const {
+        return resource < m_Resources.size() ? m_Resources[resource].Texture : 0;
+    }
+
+    void RenderGraph::GetUVScale(Resource resource, float& u, float& v) const {
+        const auto& node = m_Resources[resource];
+        if (node.Imported) {
+            u = v = 1.0f;
+            return;
+        }
+        u = (float)node.Desc.Width / (float)RenderTargetPool::BucketSize(node.Desc.Width);
+        v = (float)node.Desc.Height / (float)RenderTargetPool::BucketSize(node.Desc.Height);
+    }
+
+    bool RenderGraph::WasExecuted(const std::string& passName) const {
+        return std::any_of(m_Passes.begin(), m_Passes.end(),
+            [&](const PassNode& pass) { return pass.Live && pass.Name == passName; });
+    }
+
+    void RenderGraph::Context::BindRenderTarget(Resource color, Resource depth) const {
+        const uint32_t colorTex = color != None ? m_Graph.GetTexture(color) : 0;
+        const uint32_t depthTex = depth != None ? m_Graph.GetTexture(depth) : 0;
+
+        glBindFramebuffer(GL_FRAMEBUFFER, m_Graph.m_Pool.GetFramebuffer(colorTex, depthTex));
+        Renderer::CurrentStats().FramebufferBinds++;
+
+        const RenderTargetDesc& desc = m_Graph.GetDesc(color != None ? color : depth);
+        RenderCommand::SetViewport(0, 0, desc.Width, desc.Height);
+    }
+
+} // namespace Engine
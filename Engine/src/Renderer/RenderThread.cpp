@@ -0,0 +1,157 @@
+#include "pch.h"
+#include "Engine/Renderer/RenderThread.h"
+
+#include "Engine/Core/Window.h"
+#include "Engine/Renderer/RenderCommand.h"
+
+#include <chrono>
+#include <future>
+#include <iostream>
+
+namespace Engine {
+
+    namespace {
+        thread_local const RenderThread* t_Current = nullptr;
+
+        float MillisecondsSince(std::chrono::steady_clock::time_point start) {
+            return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+    }
+
+    RenderThread::RenderThread(Window& window, RenderFn render)
+        : m_Window(window), m_Render(std::move(render)) {
+        // a context can only be current on one thread at a time
+        m_Window.SetContextCurrent(false);
+        m_Thread = std::thread(&RenderThread::ThreadLoop, this);
+
+        RenderCommand::SetRenderThread(this);
+    }
+
+    RenderThread::~RenderThread() {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Stopping = true;
+        }
+        m_QueueCV.notify_one();
+        m_Thread.join();
+
+        RenderCommand::SetRenderThread(nullptr);
+        m_Window.SetContextCurrent(true);
+
+        // releases that raced the shutdown; the packets' own refs go when we're destroyed
+        std::deque<std::function<void()>> leftover;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            leftover.swap(m_Queue);
+        }
+        for (auto& fn : leftover)
+            fn();
+    }
+
+    bool RenderThread::IsRenderThread() const {
+        return t_Current == this;
+    }
+
+    FramePacket& RenderThread::BeginFrame() {
+        const auto start = std::chrono::steady_clock::now();
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_SlotCV.wait(lock, [&] { return !m_InFlight[m_WriteIndex]; });
+            m_Stats.WaitMs = MillisecondsSince(start);
+        }
+
+        // outside the lock: dropping the last ref to a mesh queues its glDelete
+        FramePacket& packet = m_Packets[m_WriteIndex];
+        packet.Clear();
+        packet.FrameIndex = ++m_FrameIndex;
+        return packet;
+    }
+
+    void RenderThread::SubmitFrame() {
+        const uint32_t index = m_WriteIndex;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_InFlight[index] = true;
+            m_Queue.push_back([this, index]() { RenderSlot(index); });
+            m_Stats.FramesSubmitted++;
+        }
+        m_QueueCV.notify_one();
+
+        m_WriteIndex ^= 1;
+    }
+
+    void RenderThread::RenderSlot(uint32_t index) {
+        const auto start = std::chrono::steady_clock::now();
+        try {
+            m_Render(m_Packets[index]);
+        }
+        catch (const std::exception& e) {
+            std::cout << "[RenderThread] Frame threw: " << e.what() << "\n";
+        }
+        m_Window.SwapBuffers();
+
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_InFlight[index] = false;
+            m_Stats.FramesRendered++;
+            m_Stats.RenderMs = MillisecondsSince(start);
+        }
+        m_SlotCV.notify_one();
+    }
+
+    void RenderThread::Execute(const std::function<void()>& fn) {
+        if (IsRenderThread()) {
+            fn();
+            return;
+        }
+
+        // we block until it has run, so the task can live on this stack
+        std::packaged_task<void()> task(fn);
+        std::future<void> result = task.get_future();
+        Enqueue([&task]() { task(); });
+        result.get();
+    }
+
+    void RenderThread::Enqueue(std::function<void()> fn) {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Queue.push_back(std::move(fn));
+        }
+        m_QueueCV.notify_one();
+    }
+
+    RenderThread::Stats RenderThread::GetStats() const {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_Stats;
+    }
+
+    void RenderThread::ThreadLoop() {
+        t_Current = this;
+        m_Window.SetContextCurrent(true);
+
+        std::deque<std::function<void()>> batch;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                m_QueueCV.wait(lock, [&] { return !m_Queue.empty() || m_Stopping; });
+                if (m_Queue.empty())
+                    break; // stopping and drained
+                batch.swap(m_Queue);
+            }
+
+            for (auto& fn : batch) {
+                try {
+                    fn();
+                }
+                catch (const std::exception& e) {
+                    std::cout << "[RenderThread] Command threw: " << e.what() << "\n";
+                }
+            }
+            batch.clear();
+        }
+
+        m_Window.SetContextCurrent(false);
+        t_Current = nullptr;
+    }
+
+} // namespace Engine
@@ -3,15 +3,19 @@
 
 #include "Engine/Renderer/RenderCommand.h"
 #include "Engine/Renderer/Shader.h"
+#include "Engine/Renderer/ShaderLibrary.h"
 #include "Engine/Renderer/VertexArray.h"
 #include "Engine/Renderer/Buffer.h"
 #include "Engine/Renderer/PerspectiveCamera.h"
 #include "Engine/Renderer/Texture2D.h"
+#include "Engine/Renderer/TextureArray.h"
 #include "Engine/Renderer/Material.h"
 
 #include "Engine/Renderer/TextureCube.h"
+#include "Engine/Core/MemoryTracker.h"
 
 #include <algorithm>
+#include <array>
 #include <glm/gtc/type_ptr.hpp>
 
 #include <glad/glad.h>
@@ -19,6 +23,24 @@
 static std::shared_ptr<Engine::Shader> s_SkyboxShader;
 static std::shared_ptr<Engine::VertexArray> s_SkyboxVAO;
 static std::shared_ptr<Engine::TextureCube> s_SkyboxTex;
+static glm::mat4 s_SkyboxViewProjection{ 1.0f }; // queued by SubmitSkybox
+static bool s_SkyboxQueued = false;
+
+// every material's parameter block, at Material::GetID() * s_MaterialParamStride
+static std::unique_ptr<Engine::UniformBuffer> s_MaterialParams;
+static uint32_t s_MaterialParamStride = 0;
+
+// Depth pre-pass sample counts: a GL_SAMPLES_PASSED pair (pre-pass, colour pass) per
+// DrawScene in a small ring, read once the GPU has them so the CPU never waits
+struct PrepassQuerySlot {
+    GLuint Queries[2] = {};
+    uint64_t Frame = 0;
+    bool Pending = false;
+};
+static constexpr uint32_t PrepassQueryLatency = 3;
+static PrepassQuerySlot s_PrepassQueries[PrepassQueryLatency];
+static uint32_t s_PrepassQuerySlot = 0;
+static Engine::RenderStats::DepthPrepassResult s_PrepassResult;
 
 static std::shared_ptr<Engine::VertexArray> CreateSkyboxCubeVAO() {
     // 36 verts cube, positions only
@@ -42,7 +64,8 @@ static std::shared_ptr<Engine::VertexArray> CreateSkyboxCubeVAO() {
 namespace Engine {
 
     glm::mat4 Renderer::s_ViewProjection{ 1.0f };
-    std::vector<Renderer::DrawCommand> Renderer::s_DrawList;
+    std::vector<DrawPacket> Renderer::s_DrawList;
+    std::shared_ptr<Material> Renderer::s_DepthPrepassMaterial;
 
     bool Renderer::s_HasDirLight = false;
     glm::vec3 Renderer::s_DirLightDir = glm::vec3(0.4f, 0.8f, -0.3f);
@@ -57,6 +80,49 @@ namespace Engine {
         glm::mat4(1.0f), glm::mat4(1.0f), glm::mat4(1.0f), glm::mat4(1.0f)
     };
 
+    RenderStats Renderer::s_Stats;
+    RenderStats Renderer::s_LastStats;
+    RenderStats::Pass Renderer::s_StatsPass = RenderStats::Other;
+
+    RenderStats::Counters& RenderStats::Counters::operator+=(const Counters& o) {
+        Submitted += o.Submitted;
+        Culled += o.Culled;
+        Drawn += o.Drawn;
+        DrawCalls += o.DrawCalls;
+        Batches += o.Batches;
+        Triangles += o.Triangles;
+        ShaderBinds += o.ShaderBinds;
+        VaoBinds += o.VaoBinds;
+        TextureBinds += o.TextureBinds;
+        UniformUploads += o.UniformUploads;
+        FramebufferBinds += o.FramebufferBinds;
+        return *this;
+    }
+
+    RenderStats::Counters RenderStats::Total() const {
+        Counters total;
+        for (const auto& p : Passes)
+            total += p;
+        return total;
+    }
+
+    const char* RenderStats::GetPassName(Pass pass) {
+        switch (pass) {
+        case Shadow:       return "Shadow";
+        case Prepass:      return "Prepass";
+        case Scene:        return "Scene";
+        case Picking:      return "Picking";
+        case Other:        return "Other";
+        default:           return "?";
+        }
+    }
+
+    void Renderer::EndStatsFrame() {
+        s_Stats.Frame = s_LastStats.Frame + 1;
+        s_LastStats = s_Stats;
+        s_Stats = {};
+    }
+
 
     void Renderer::Init() {
         RenderCommand::Init();
@@ -66,66 +132,117 @@ namespace Engine {
         s_ViewProjection = camera.GetViewProjection();
         s_View = camera.GetView();
         s_DrawList.clear();
-        
+        s_SkyboxQueued = false;
     }
 
     void Renderer::EndScene() {
+        SortDrawList();
+        DrawScene(s_DrawList);
+    }
+
+    void Renderer::SortDrawList() {
         std::sort(s_DrawList.begin(), s_DrawList.end(),
-            [](const DrawCommand& a, const DrawCommand& b) { return a.SortKey < b.SortKey; });
-        Flush();
+            [](const DrawPacket& a, const DrawPacket& b) { return a.SortKey < b.SortKey; });
     }
 
-    void Renderer::Flush() {
-        for (const auto& cmd : s_DrawList) {
-            auto& mat = cmd.MaterialPtr;
-            if (!mat) continue;
-            auto& shader = mat->GetShader();
-            if (!shader) continue;
+    uint64_t Renderer::MakeSortKey(const Material& material, const VertexArray& vao) {
+        // the variant's own program ID isn't known off the GL thread; the base program
+        // plus the material's keyword bits sorts the same way
+        const auto& shader = material.GetShader();
+        const uint64_t program = shader ? shader->GetRendererID() : 0;
+        const uint64_t permutation = material.GetPermutation() & ShaderKeyword::All;
+        return ((program & 0xFFFF) << 48) | (permutation << 42)
+            | (uint64_t(material.GetID() & 0x3FFFF) << 24) | uint64_t(vao.GetRendererID() & 0xFFFFFF);
+    }
+
+    // The program variant a material draws with this frame: its keywords plus the
+    // frame's lighting / shadow ones
+    static uint32_t FramePermutation(const Material& material) {
+        const bool shadows = Renderer::s_HasShadows && Renderer::s_CascadeCount > 0;
+        uint32_t permutation = material.GetPermutation()
+            | (Renderer::s_HasDirLight ? ShaderKeyword::UseLighting : 0)
+            | (shadows ? ShaderKeyword::CascadeCount((uint32_t)Renderer::s_CascadeCount) : 0);
+        if (!shadows) permutation &= ~ShaderKeyword::ReceiveShadows;
+        return permutation;
+    }
+
+    void Renderer::DrawSorted(const std::vector<DrawPacket>& draws, const std::shared_ptr<Material>& overrideMaterial) {
+        DrawSortedFiltered(draws, overrideMaterial, nullptr, 0);
+    }
+
+    void Renderer::DrawSortedFiltered(const std::vector<DrawPacket>& draws, const std::shared_ptr<Material>& overrideMaterial,
+        const std::vector<uint8_t>* mask, uint8_t keep) {
+        auto& stats = CurrentStats();
+        uint64_t lastBatch = ~0ull;
+
+        if (s_MaterialParamStride == 0) {
+            const uint32_t align = UniformBuffer::GetOffsetAlignment();
+            s_MaterialParamStride = (uint32_t)((sizeof(MaterialParams) + align - 1) / align * align);
+        }
+        Material::SyncParams(s_MaterialParams, s_MaterialParamStride);
+
+        // consecutive draws of one material (the sort groups them) skip its binds
+        const Material* lastMaterial = nullptr;
+        std::array<const void*, Material::MaxTextureSlots> boundTextures{}; // Texture2D or TextureArray
+
+        for (size_t i = 0; i < draws.size(); i++) {
+            const auto& cmd = draws[i];
+            if (mask && (*mask)[i] != keep) continue;
+
+            auto& mat = overrideMaterial ? overrideMaterial : cmd.MaterialPtr;
+            if (!mat || !mat->GetShader()) continue;
+
+            const uint32_t permutation = FramePermutation(*mat);
+
+            Shader* shader = &mat->GetShader()->GetVariant(permutation);
+            if (!shader->IsReady()) continue; // skipped until it links
 
             shader->Bind();
             shader->SetMat4("u_ViewProjection", glm::value_ptr(s_ViewProjection));
             shader->SetMat4("u_Model", glm::value_ptr(cmd.Model));
             shader->SetUInt("u_EntityID", cmd.EntityID);
 
-            shader->SetInt("u_UseLighting", s_HasDirLight ? 1 : 0);
             shader->SetFloat3("u_LightDir", s_DirLightDir.x, s_DirLightDir.y, s_DirLightDir.z);
             shader->SetFloat3("u_LightColor", s_DirLightColor.x, s_DirLightColor.y, s_DirLightColor.z);
             shader->SetFloat("u_Ambient", 0.07f); // Set Light Level
             shader->SetMat4("u_View", glm::value_ptr(s_View));
 
-            // Default: no texture
-            int useTexture0 = 0;
-
-            // Bind textures (slot -> u_Texture{slot})
-            for (const auto& kv : mat->GetTextures()) {
-                uint32_t slot = kv.first;
-                const auto& tex = kv.second;
-                if (!tex) continue;
-
-                tex->Bind(slot);
-                shader->SetInt("u_Texture" + std::to_string(slot), (int)slot);
-
-                if (slot == 0) useTexture0 = 1;
+            // Textures sit in fixed slots (the shader's u_TextureN samplers were pointed at
+            // them at link) and parameters in the material's UBO block
+            if (mat.get() != lastMaterial) {
+                // materials packed into one page differ only by layer: no rebind
+                if (const auto& page = mat->GetTextureArray(); page && page.get() != boundTextures[0]) {
+                    page->Bind(0);
+                    boundTextures[0] = page.get();
+                }
+                for (uint32_t slot = 0; slot < Material::MaxTextureSlots; slot++) {
+                    const auto& tex = mat->GetTexture(slot);
+                    if (tex && tex.get() != boundTextures[slot]) {
+                        tex->Bind(slot);
+                        boundTextures[slot] = tex.get();
+                    }
+                }
+                if (s_MaterialParams)
+                    s_MaterialParams->BindRange(UniformBinding::Material,
+                        mat->GetID() * s_MaterialParamStride, (uint32_t)sizeof(MaterialParams));
+                lastMaterial = mat.get();
             }
 
-            // Tell shader whether to sample texture0
-            shader->SetInt("u_UseTexture", useTexture0);
-
-            if (mat->HasColor()) {
+            if (!shader->HasMaterialBlock()) {
                 const auto& c = mat->GetColor();
                 shader->SetFloat4("u_Color", c.r, c.g, c.b, c.a);
             }
-            else {
-                shader->SetFloat4("u_Color", 1.f, 1.f, 1.f, 1.f);
-            }
 
+            if (!cmd.VaoPtr) continue;
             cmd.VaoPtr->Bind();
             auto count = cmd.VaoPtr->GetIndexBuffer()->GetCount();
             if (count == 0) continue;
 
-            // Two Sided Drawing
+            // Two Sided Drawing (the packet's own material decides, so an override such
+            // as the depth pre-pass covers the same faces the real draw will)
+            const bool twoSided = cmd.MaterialPtr ? cmd.MaterialPtr->IsTwoSided() : mat->IsTwoSided();
             bool restoreCull = false;
-            if (mat->IsTwoSided() && glIsEnabled(GL_CULL_FACE)) {
+            if (twoSided && glIsEnabled(GL_CULL_FACE)) {
                 glDisable(GL_CULL_FACE);
                 restoreCull = true;
             }
@@ -133,11 +250,7 @@ namespace Engine {
             // ---- Shadows (bind to a high slot to avoid colliding with material textures) ----
             constexpr uint32_t ShadowSlot = 15;
 
-            shader->SetInt("u_UseShadows", s_HasShadows ? 1 : 0);
-
-            if (s_HasShadows) {
-                shader->SetInt("u_CascadeCount", s_CascadeCount);
-
+            if (permutation & ShaderKeyword::ReceiveShadows) {
                 for (int i = 0; i < s_CascadeCount; i++) {
                     shader->SetMat4("u_LightSpaceMatrices[" + std::to_string(i) + "]",
                         glm::value_ptr(s_LightMatrices[i]));
@@ -146,6 +259,7 @@ namespace Engine {
 
                 glActiveTexture(GL_TEXTURE0 + ShadowSlot);
                 glBindTexture(GL_TEXTURE_2D_ARRAY, s_ShadowMapArrayTex);
+                stats.TextureBinds++;
                 shader->SetInt("u_ShadowMapArray", (int)ShadowSlot);
 
                 shader->SetFloat("u_ShadowBias", 0.0015f);
@@ -153,6 +267,13 @@ namespace Engine {
 
             RenderCommand::DrawIndexed(count);
 
+            stats.Drawn++;
+            const uint64_t batch = (uint64_t(shader->GetRendererID()) << 32) | cmd.VaoPtr->GetRendererID();
+            if (batch != lastBatch) {
+                stats.Batches++;
+                lastBatch = batch;
+            }
+
             if (restoreCull)
                 glEnable(GL_CULL_FACE);
         }
@@ -160,53 +281,10 @@ namespace Engine {
 
     }
 
-    void Renderer::Submit(const std::shared_ptr<Material>& material,
-        const std::shared_ptr<VertexArray>& vao,
-        const glm::mat4& model) {
-        if (!material || !vao) return;
-        if (!material->GetShader()) return;
-        Submit(material, vao, model, 0);
-    }
-
-    void Renderer::Submit(const std::shared_ptr<Material>& material,
-        const std::shared_ptr<VertexArray>& vao,
-        const glm::mat4& model,
-        uint32_t entityID) {
-        uint64_t key = (uint64_t(material->GetShader()->GetRendererID()) << 32) |
-            uint64_t(vao->GetRendererID());
-        if (!material || !vao) return;
-        if (!material->GetShader()) return;
-
-        DrawCommand cmd;
-        cmd.SortKey = key;
-        cmd.MaterialPtr = material;
-        cmd.VaoPtr = vao;
-        cmd.Model = model;
-        cmd.EntityID = entityID;
-
-        s_DrawList.push_back(std::move(cmd));
-    }
-
-    void Renderer::SetDirectionalLight(const glm::vec3& dir, const glm::vec3& color) {
-        s_HasDirLight = true;
-        s_DirLightDir = glm::normalize(dir);
-        s_DirLightColor = color;
-    }
-
-    void Renderer::ClearLights() {
-        s_HasDirLight = false;
-        s_DirLightDir = glm::vec3(0.4f, 0.8f, -0.3f);
-        s_DirLightColor = glm::vec3(1.0f);
-    }
-
-    void Engine::Renderer::SetSkybox(const std::shared_ptr<TextureCube>& sky) {
-        s_SkyboxTex = sky;
-        if (!s_SkyboxShader) s_SkyboxShader = std::make_shared<Shader>("Assets/Shaders/Skybox.shader");
-        if (!s_SkyboxVAO)    s_SkyboxVAO = CreateSkyboxCubeVAO();
-    }
-
-    void Renderer::DrawSkybox(const PerspectiveCamera& camera) {
+    // vp = projection * rotation-only view
+    static void DrawSkyboxVP(const glm::mat4& vp) {
         if (!s_SkyboxTex || !s_SkyboxShader || !s_SkyboxVAO) return;
+        if (!s_SkyboxShader->IsReady()) return;
 
         // Cache uniform location once per program
         static GLuint cachedProgram = 0;
@@ -237,10 +315,6 @@ namespace Engine {
 
         s_SkyboxShader->Bind();
 
-        // Remove translation from view matrix
-        glm::mat4 view = glm::mat4(glm::mat3(camera.GetView()));
-        glm::mat4 vp = camera.GetProjection() * view;
-
         // Set matrix (your Shader::SetMat4 already no-ops if loc == -1)
         s_SkyboxShader->SetMat4("u_ViewProjectionNoTranslate", glm::value_ptr(vp));
 
@@ -249,6 +323,8 @@ namespace Engine {
 
         s_SkyboxVAO->Bind();
         glDrawArrays(GL_TRIANGLES, 0, 36);
+        Renderer::CurrentStats().DrawCalls++;
+        Renderer::CurrentStats().Triangles += 12;
 
         // Restore states
         glDepthMask(oldDepthMask);
@@ -256,9 +332,166 @@ namespace Engine {
         if (cullWasEnabled) glEnable(GL_CULL_FACE);
     }
 
+    // Newest finished query pair -> s_PrepassResult. Slot `reuse` is about to be
+    // issued again, so it's read even if that means waiting (it's the oldest).
+    static void ResolvePrepassQueries(uint32_t reuse) {
+        for (uint32_t i = 0; i < PrepassQueryLatency; i++) {
+            auto& slot = s_PrepassQueries[i];
+            if (!slot.Pending) continue;
+
+            // queries finish in order: the colour pass one covers both
+            GLuint available = GL_TRUE;
+            if (i != reuse)
+                glGetQueryObjectuiv(slot.Queries[1], GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available) continue;
+
+            GLuint64 depthSamples = 0, shadedSamples = 0;
+            glGetQueryObjectui64v(slot.Queries[0], GL_QUERY_RESULT, &depthSamples);
+            glGetQueryObjectui64v(slot.Queries[1], GL_QUERY_RESULT, &shadedSamples);
+            slot.Pending = false;
+
+            if (slot.Frame >= s_PrepassResult.Frame)
+                s_PrepassResult = { slot.Frame, depthSamples, shadedSamples };
+        }
+    }
+
+    void Renderer::DrawScene(const std::vector<DrawPacket>& draws) {
+        const bool prepass = s_DepthPrepassMaterial && !draws.empty()
+            && s_DepthPrepassMaterial->GetShader() && s_DepthPrepassMaterial->GetShader()->IsReady();
+
+        // Opaque draws go first, then the sky, then blended ones over both. With the
+        // pre-pass, "opaque" also means the colour-pass program is ready: an unready
+        // draw would leave depth with nothing shaded on it, and a blended one would
+        // hide everything beneath it.
+        static std::vector<uint8_t> opaque; // GL thread only
+        opaque.resize(draws.size());
+        bool anyDeferred = false;
+        for (size_t i = 0; i < draws.size(); i++) {
+            const Material* mat = draws[i].MaterialPtr.get();
+            const bool blended = mat && mat->IsBlended();
+            opaque[i] = prepass
+                ? mat && mat->GetShader() && draws[i].VaoPtr && !blended
+                    && mat->GetShader()->GetVariant(FramePermutation(*mat)).IsReady()
+                : !blended;
+            anyDeferred |= !opaque[i];
+        }
+
+        if (prepass) {
+            auto& slot = s_PrepassQueries[s_PrepassQuerySlot];
+            if (slot.Queries[0] == 0)
+                glGenQueries(2, slot.Queries);
+            ResolvePrepassQueries(s_PrepassQuerySlot);
+
+            // depth only, through the cheap depth material
+            const RenderStats::Pass pass = s_StatsPass;
+            SetStatsPass(RenderStats::Prepass);
+            glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+            glDepthMask(GL_TRUE);
+            glDepthFunc(GL_LESS);
+
+            glBeginQuery(GL_SAMPLES_PASSED, slot.Queries[0]);
+            DrawSortedFiltered(draws, s_DepthPrepassMaterial, &opaque, 1);
+            glEndQuery(GL_SAMPLES_PASSED);
+
+            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+            SetStatsPass(pass);
+
+            // only the nearest surface matches; the rest fail before the fragment shader
+            glDepthMask(GL_FALSE);
+            glDepthFunc(GL_EQUAL);
+
+            glBeginQuery(GL_SAMPLES_PASSED, slot.Queries[1]);
+            DrawSortedFiltered(draws, nullptr, &opaque, 1);
+            glEndQuery(GL_SAMPLES_PASSED);
+
+            glDepthMask(GL_TRUE);
+            glDepthFunc(GL_LESS);
+
+            slot.Frame = s_LastStats.Frame + 1; // the frame s_Stats is counting
+            slot.Pending = true;
+            s_PrepassQuerySlot = (s_PrepassQuerySlot + 1) % PrepassQueryLatency;
+            s_Stats.DepthPrepass = s_PrepassResult;
+        }
+        else {
+            DrawSortedFiltered(draws, nullptr, &opaque, 1);
+        }
+
+        if (s_SkyboxQueued) {
+            DrawSkyboxVP(s_SkyboxViewProjection);
+            s_SkyboxQueued = false;
+        }
+
+        // blended (and, with the pre-pass, still compiling) draws over the finished depth
+        if (anyDeferred) {
+            if (prepass) glDepthFunc(GL_LEQUAL);
+            DrawSortedFiltered(draws, nullptr, &opaque, 0);
+            glDepthFunc(GL_LESS);
+        }
+    }
+
+    void Renderer::SetDepthPrepass(const std::shared_ptr<Material>& depthMaterial) {
+        s_DepthPrepassMaterial = depthMaterial;
+    }
+
+    void Renderer::Submit(const std::shared_ptr<Material>& material,
+        const std::shared_ptr<VertexArray>& vao,
+        const glm::mat4& model) {
+        if (!material || !vao) return;
+        if (!material->GetShader()) return;
+        Submit(material, vao, model, 0);
+    }
+
+    void Renderer::Submit(const std::shared_ptr<Material>& material,
+        const std::shared_ptr<VertexArray>& vao,
+        const glm::mat4& model,
+        uint32_t entityID) {
+        if (!material || !vao) return;
+        if (!material->GetShader()) return;
+
+        DrawPacket cmd;
+        cmd.SortKey = MakeSortKey(*material, *vao);
+        cmd.MaterialPtr = material;
+        cmd.VaoPtr = vao;
+        cmd.Model = model;
+        cmd.EntityID = entityID;
+
+        MemoryScope memScope(MemoryTag::Renderer); // draw list growth
+        s_DrawList.push_back(std::move(cmd));
+        CurrentStats().Submitted++;
+    }
+
+    void Renderer::SetDirectionalLight(const glm::vec3& dir, const glm::vec3& color) {
+        s_HasDirLight = true;
+        s_DirLightDir = glm::normalize(dir);
+        s_DirLightColor = color;
+    }
+
+    void Renderer::ClearLights() {
+        s_HasDirLight = false;
+        s_DirLightDir = glm::vec3(0.4f, 0.8f, -0.3f);
+        s_DirLightColor = glm::vec3(1.0f);
+    }
+
+    void Engine::Renderer::SetSkybox(const std::shared_ptr<TextureCube>& sky) {
+        s_SkyboxTex = sky;
+        if (!s_SkyboxShader) s_SkyboxShader = ShaderLibrary::Get().Load("Assets/Shaders/Skybox.shader");
+        if (!s_SkyboxVAO)    s_SkyboxVAO = CreateSkyboxCubeVAO();
+    }
+
+    void Renderer::SubmitSkybox(const PerspectiveCamera& camera) {
+        s_SkyboxViewProjection = camera.GetProjection() * glm::mat4(glm::mat3(camera.GetView()));
+        s_SkyboxQueued = true;
+    }
+
+    void Renderer::DrawSkybox(const PerspectiveCamera& camera) {
+        // Remove translation from view matrix
+        DrawSkyboxVP(camera.GetProjection() * glm::mat4(glm::mat3(camera.GetView())));
+    }
+
     void Renderer::BeginScene(const glm::mat4& viewProjection) {
         s_ViewProjection = viewProjection;
         s_DrawList.clear();
+        s_SkyboxQueued = false;
     }
 
     void Renderer::SetCSMShadowMap(uint32_t depthTexArray,
@@ -1,161 +1,367 @@
 #include "pch.h"
 #include "Engine/Renderer/RendererPipeline.h"
 
-#include "Engine/Renderer/Framebuffer.h"
 #include "Engine/Renderer/RenderCommand.h"
 #include "Engine/Renderer/Renderer.h"
 #include "Engine/Renderer/ScreenQuad.h"
 #include "Engine/Renderer/Shader.h"
+#include "Engine/Renderer/ShaderLibrary.h"
 #include "Engine/Renderer/VertexArray.h"
 #include "Engine/Renderer/PerspectiveCamera.h"
 #include "Engine/Renderer/Material.h"
+#include "Engine/Renderer/FramePacket.h"
+#include "Engine/Core/MemoryTracker.h"
 
 #include <glad/glad.h>
 
+#include <vector>
+
 namespace Engine {
 
-    RendererPipeline::~RendererPipeline() = default;
+    // DEPTH_COMPONENT24 is stored as 4 bytes per texel
+    static size_t ShadowArrayBytes(uint32_t size, uint32_t layers) {
+        return (size_t)size * size * layers * 4;
+    }
+
+    RendererPipeline::~RendererPipeline() {
+        if (m_ShadowDepthTexArray) {
+            MemoryTracker::TrackGpuFree(GpuMemoryKind::ShadowMap, ShadowArrayBytes(m_ShadowAllocSize, m_ShadowAllocCascades));
+            RenderCommand::ReleaseOnRenderThread([tex = m_ShadowDepthTexArray, fbo = m_ShadowFBO]() {
+                glDeleteTextures(1, &tex);
+                if (fbo) glDeleteFramebuffers(1, &fbo);
+                });
+        }
+
+        if (m_TimerQueries[0][0] == 0) return;
+
+        std::vector<uint32_t> queries(&m_TimerQueries[0][0], &m_TimerQueries[0][0] + QueryLatency * PassCount);
+        RenderCommand::ReleaseOnRenderThread([queries = std::move(queries)]() {
+            glDeleteQueries((GLsizei)queries.size(), queries.data());
+            });
+    }
 
     RendererPipeline::RendererPipeline() {
         m_ScreenQuadVAO = ScreenQuad::GetVAO();
     }
 
-    void RendererPipeline::EnsureSceneResources(uint32_t width, uint32_t height) {
+    // ---------------- Frame graph ----------------
+
+    void RendererPipeline::BeginFrame(uint32_t width, uint32_t height) {
         m_Width = width;
         m_Height = height;
 
-        if (!m_SceneFB)
-            m_SceneFB = std::make_unique<Framebuffer>(FramebufferSpec{ width, height, FramebufferColorFormat::RGBA8 });
-        else
-            m_SceneFB->Resize(width, height);
+        // releases last frame's composite / picking targets back to the pool
+        m_Graph.Reset();
+        m_ShadowMap = m_SceneColor = m_SceneDepth = RenderGraph::None;
+        m_PickingTarget = m_PickingDepth = m_CompositeTarget = RenderGraph::None;
 
         if (!m_ScreenShader)
-            m_ScreenShader = std::make_shared<Shader>("Assets/Shaders/Screen.shader");
+            m_ScreenShader = ShaderLibrary::Get().Load("Assets/Shaders/Screen.shader");
     }
 
-    void RendererPipeline::EnsurePickingResources(uint32_t width, uint32_t height) {
-        m_Width = width;
-        m_Height = height;
+    void RendererPipeline::EndFrame() {
+        MemoryScope memScope(MemoryTag::Renderer);
+
+        if (m_PickingTarget != RenderGraph::None && m_PickingRequested)
+            m_Graph.Export(m_PickingTarget);
+
+        m_Graph.Execute();
 
-        if (!m_IDFB)
-            m_IDFB = std::make_unique<Framebuffer>(FramebufferSpec{ width, height, FramebufferColorFormat::R32UI });
+        // a culled pass's targets never got textures
+        if (m_PickingTarget != RenderGraph::None && !m_Graph.GetTexture(m_PickingTarget))
+            m_PickingTarget = RenderGraph::None;
         else
-            m_IDFB->Resize(width, height);
+            m_PickingRequested = false;
+    }
+
+    void RendererPipeline::AddShadowPass(uint32_t shadowSize, const glm::mat4* lightMatrices, const float* cascadeSplits,
+        uint32_t cascadeCount, std::function<void(uint32_t cascade)> drawCascade) {
+        m_ShadowCascadeCount = std::min<uint32_t>(cascadeCount, MaxCascades);
+        EnsureShadowResources(shadowSize);
+        if (m_ShadowCascadeCount == 0)
+            return;
 
+        m_ShadowMap = m_Graph.Import("ShadowMap", m_ShadowDepthTexArray, { m_ShadowSize, m_ShadowSize, RenderTargetFormat::Depth24Stencil8 });
+
+        std::vector<glm::mat4> matrices(lightMatrices, lightMatrices + m_ShadowCascadeCount);
+        std::vector<float> splits(cascadeSplits, cascadeSplits + m_ShadowCascadeCount);
+
+        m_Graph.AddPass("Shadow",
+            [&](RenderGraph::Builder& builder) { builder.Write(m_ShadowMap); },
+            [this, matrices = std::move(matrices), splits = std::move(splits), draw = std::move(drawCascade)](const RenderGraph::Context&) {
+                BeginPassTimer(Pass::Shadow);
+                for (uint32_t i = 0; i < m_ShadowCascadeCount; i++) {
+                    if (!BeginShadowCascade(matrices[i], i)) continue;
+                    draw(i);
+                    EndShadowCascade();
+                }
+                Renderer::SetCSMShadowMap(m_ShadowDepthTexArray, matrices.data(), splits.data(), (int)m_ShadowCascadeCount);
+                EndPassTimer(Pass::Shadow);
+            });
+    }
+
+    void RendererPipeline::AddScenePass(const PerspectiveCamera& camera, std::function<void()> draw) {
+        const RenderTargetDesc color{ m_Width, m_Height, RenderTargetFormat::RGBA8 };
+        const RenderTargetDesc depth{ m_Width, m_Height, RenderTargetFormat::Depth24Stencil8 };
+
+        m_Graph.AddPass("Scene",
+            [&](RenderGraph::Builder& builder) {
+                m_SceneColor = builder.Create("SceneColor", color);
+                m_SceneDepth = builder.Create("SceneDepth", depth);
+                if (m_ShadowMap != RenderGraph::None)
+                    builder.Read(m_ShadowMap);
+            },
+            [this, camera, draw = std::move(draw)](const RenderGraph::Context& ctx) {
+                BeginPassTimer(Pass::Scene);
+                Renderer::SetStatsPass(RenderStats::Scene);
+                if (m_ShadowMap == RenderGraph::None)
+                    Renderer::ClearShadowMap();
+
+                ctx.BindRenderTarget(m_SceneColor, m_SceneDepth);
+                RenderCommand::SetClearColor(0.08f, 0.10f, 0.12f, 1.0f);
+                RenderCommand::Clear();
+
+                if (m_DepthPrepassEnabled)
+                    EnsureShadowDepthMaterial();
+                Renderer::SetDepthPrepass(m_DepthPrepassEnabled ? m_ShadowDepthMaterial : nullptr);
+
+                Renderer::BeginScene(camera);
+                draw();
+                Renderer::EndScene();
+                Renderer::SetDepthPrepass(nullptr); // overlays draw normally
+
+                Renderer::SetStatsPass(RenderStats::Other);
+                EndPassTimer(Pass::Scene);
+            });
+    }
+
+    void RendererPipeline::AddOverlayPass(std::function<void()> draw) {
+        if (m_SceneColor == RenderGraph::None) return; // needs AddScenePass first
+        m_Graph.AddPass("Overlay",
+            [&](RenderGraph::Builder& builder) {
+                builder.Write(builder.Read(m_SceneColor));
+                builder.Write(builder.Read(m_SceneDepth));
+            },
+            [this, draw = std::move(draw)](const RenderGraph::Context& ctx) {
+                ctx.BindRenderTarget(m_SceneColor, m_SceneDepth);
+                draw();
+            });
+    }
+
+    void RendererPipeline::AddPickingPass(const PerspectiveCamera& camera, std::function<void()> draw) {
         if (!m_IDShader) {
-            m_IDShader = std::make_shared<Shader>("Assets/Shaders/ID.shader");
+            m_IDShader = ShaderLibrary::Get().Load("Assets/Shaders/ID.shader");
             m_IDMaterial = std::make_shared<Material>(m_IDShader);
             m_IDMaterial->SetColor({ 1,1,1,1 });
         }
+
+        const RenderTargetDesc ids{ m_Width, m_Height, RenderTargetFormat::R32UI };
+        const RenderTargetDesc depth{ m_Width, m_Height, RenderTargetFormat::Depth24Stencil8 };
+
+        m_Graph.AddPass("Picking",
+            [&](RenderGraph::Builder& builder) {
+                m_PickingTarget = builder.Create("PickingIDs", ids);
+                m_PickingDepth = builder.Create("PickingDepth", depth);
+            },
+            [this, camera, draw = std::move(draw)](const RenderGraph::Context& ctx) {
+                Renderer::SetStatsPass(RenderStats::Picking);
+                ctx.BindRenderTarget(m_PickingTarget, m_PickingDepth);
+
+                const GLuint none = 0;
+                glClear(GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+                glClearBufferuiv(GL_COLOR, 0, &none);
+
+                Renderer::BeginScene(camera);
+                draw();
+                Renderer::EndScene();
+                Renderer::SetStatsPass(RenderStats::Other);
+            });
     }
 
-    void RendererPipeline::EnsureCompositeResources(uint32_t width, uint32_t height) {
-        m_Width = width;
-        m_Height = height;
+    uint32_t RendererPipeline::ReadPickingID(uint32_t mouseX, uint32_t mouseY) {
+        if (!HasPickingResult()) return 0;
+        if (mouseX >= m_Width || mouseY >= m_Height) return 0;
 
-        if (!m_CompositeFB)
-            m_CompositeFB = std::make_unique<Framebuffer>(FramebufferSpec{ width, height, FramebufferColorFormat::RGBA8 });
-        else
-            m_CompositeFB->Resize(width, height);
+        glBindFramebuffer(GL_FRAMEBUFFER, m_TargetPool.GetFramebuffer(m_Graph.GetTexture(m_PickingTarget), 0));
+        Renderer::CurrentStats().FramebufferBinds++;
+        glReadBuffer(GL_COLOR_ATTACHMENT0);
+
+        uint32_t x = mouseX;
+        uint32_t y = (m_Height - 1) - mouseY; // top-left -> bottom-left
+        uint32_t pixel = 0;
+        glReadPixels((int)x, (int)y, 1, 1, GL_RED_INTEGER, GL_UNSIGNED_INT, &pixel);
+        return pixel;
     }
 
-    // ---------------- Scene pass ----------------
+    // ---------------- Compose + Present ----------------
 
-    void RendererPipeline::BeginScenePass(uint32_t width, uint32_t height, const PerspectiveCamera& camera) {
-        EnsureSceneResources(width, height);
+    void RendererPipeline::AddComposePass() {
+        if (m_SceneColor == RenderGraph::None) return;
+        const RenderTargetDesc color{ m_Width, m_Height, RenderTargetFormat::RGBA8 };
+
+        m_Graph.AddPass("Compose",
+            [&](RenderGraph::Builder& builder) {
+                builder.Read(m_SceneColor);
+                m_CompositeTarget = builder.Create("Composite", color);
+            },
+            [this](const RenderGraph::Context& ctx) {
+                ctx.BindRenderTarget(m_CompositeTarget, RenderGraph::None);
+                RenderCommand::SetClearColor(0.f, 0.f, 0.f, 1.f);
+                RenderCommand::Clear();
+
+                if (!m_ScreenShader->IsReady()) return; // still compiling
+
+                float u, v;
+                m_Graph.GetUVScale(m_SceneColor, u, v);
+                glDisable(GL_DEPTH_TEST);
+                DrawFullscreen(ctx.GetTexture(m_SceneColor), u, v);
+                glEnable(GL_DEPTH_TEST);
+            });
+        m_Graph.Export(m_CompositeTarget);
+    }
 
-        m_SceneFB->Bind();
-        RenderCommand::SetViewport(0, 0, width, height);
-        RenderCommand::SetClearColor(0.08f, 0.10f, 0.12f, 1.0f);
-        RenderCommand::Clear();
+    uint32_t RendererPipeline::GetCompositeTexture() const {
+        return m_CompositeTarget != RenderGraph::None ? m_Graph.GetTexture(m_CompositeTarget) : 0;
+    }
 
-        Renderer::BeginScene(camera);
-        m_ScenePassActive = true;
+    glm::vec2 RendererPipeline::GetCompositeUVScale() const {
+        if (m_CompositeTarget == RenderGraph::None) return glm::vec2(1.0f);
+        glm::vec2 scale;
+        m_Graph.GetUVScale(m_CompositeTarget, scale.x, scale.y);
+        return scale;
     }
 
-    void RendererPipeline::EndScenePass() {
-        if (!m_ScenePassActive) return;
-        Renderer::EndScene();
-        m_ScenePassActive = false;
+    void RendererPipeline::AddPresentPass() {
+        if (m_SceneColor == RenderGraph::None) return;
+        m_Graph.AddPass("Present",
+            [&](RenderGraph::Builder& builder) {
+                builder.Read(m_SceneColor);
+                builder.SetSideEffect(); // the default framebuffer isn't a graph resource
+            },
+            [this](const RenderGraph::Context& ctx) {
+                BeginPassTimer(Pass::Present);
+                glBindFramebuffer(GL_FRAMEBUFFER, 0);
+                Renderer::CurrentStats().FramebufferBinds++;
+                RenderCommand::SetViewport(0, 0, m_Width, m_Height);
+                RenderCommand::SetClearColor(0.f, 0.f, 0.f, 1.f);
+                RenderCommand::Clear();
+
+                if (m_ScreenShader->IsReady()) { // else still compiling
+                    float u, v;
+                    m_Graph.GetUVScale(m_SceneColor, u, v);
+                    glDisable(GL_DEPTH_TEST);
+                    DrawFullscreen(ctx.GetTexture(m_SceneColor), u, v);
+                    glEnable(GL_DEPTH_TEST);
+                }
+                EndPassTimer(Pass::Present);
+            });
     }
 
-    // ---------------- Picking pass ----------------
+    // ---------------- Frame packet ----------------
 
-    void RendererPipeline::BeginPickingPass(uint32_t width, uint32_t height, const PerspectiveCamera& camera) {
-        EnsurePickingResources(width, height);
+    void RendererPipeline::RenderFramePacket(const FramePacket& packet) {
+        MemoryScope memScope(MemoryTag::Renderer);
+        if (packet.Width == 0 || packet.Height == 0) return;
 
-        m_IDFB->Bind();
-        RenderCommand::SetViewport(0, 0, width, height);
+        if (m_PassTimingEnabled) {
+            ResolvePassTimers();
+            m_TimerPending[m_TimerSlot] = {};
+            m_TimerPending[m_TimerSlot].FrameIndex = packet.FrameIndex;
+        }
 
-        m_IDFB->ClearUInt(0);
-        Renderer::BeginScene(camera);
-        m_PickingPassActive = true;
-    }
+        BeginFrame(packet.Width, packet.Height);
 
-    void RendererPipeline::EndPickingPass() {
-        if (!m_PickingPassActive) return;
-        Renderer::EndScene();
-        m_PickingPassActive = false;
-    }
+        const int cascades = std::min(packet.CascadeCount, (int)MaxCascades);
+        if (cascades > 0) {
+            AddShadowPass(packet.ShadowSize, packet.LightMatrices, packet.CascadeSplits, (uint32_t)cascades,
+                [&](uint32_t) {
+                    Renderer::CurrentStats().Submitted += (uint32_t)packet.ShadowCasters.size();
+                    Renderer::DrawSorted(packet.ShadowCasters, m_ShadowDepthMaterial);
+                });
+        }
 
-    uint32_t RendererPipeline::ReadPickingID(uint32_t mouseX, uint32_t mouseY) const {
-        if (!m_IDFB) return 0;
-        if (mouseX >= m_Width || mouseY >= m_Height) return 0;
+        AddScenePass(packet.Camera, [&]() {
+            // culling happened at extraction, on the simulation thread
+            Renderer::CurrentStats().Submitted += (uint32_t)packet.Draws.size();
+            Renderer::CurrentStats().Culled += packet.CulledDraws;
 
-        uint32_t x = mouseX;
-        uint32_t y = (m_Height - 1) - mouseY; // top-left -> bottom-left
-        return m_IDFB->ReadPixelUInt(x, y);
+            if (packet.HasLight)
+                Renderer::SetDirectionalLight(packet.LightDir, packet.LightColor);
+            else
+                Renderer::ClearLights();
+
+            if (packet.DrawSkybox)
+                Renderer::SubmitSkybox(packet.Camera);
+
+            Renderer::DrawScene(packet.Draws);
+            });
+
+        AddPresentPass();
+        EndFrame();
+
+        if (m_PassTimingEnabled)
+            m_TimerSlot = (m_TimerSlot + 1) % QueryLatency;
     }
 
-    // ---------------- Compose + Present ----------------
+    const char* RendererPipeline::GetPassName(Pass pass) {
+        switch (pass) {
+        case Pass::Shadow:  return "Shadow";
+        case Pass::Scene:   return "Scene";
+        case Pass::Present: return "Present";
+        default:            return "?";
+        }
+    }
 
-    void RendererPipeline::Compose() {
-        if (!m_SceneFB || !m_ScreenShader || !m_ScreenQuadVAO) return;
-        EnsureCompositeResources(m_Width, m_Height);
+    void RendererPipeline::BeginPassTimer(Pass pass) {
+        if (!m_PassTimingEnabled) return;
 
-        m_CompositeFB->Bind();
-        RenderCommand::SetViewport(0, 0, m_Width, m_Height);
-        RenderCommand::SetClearColor(0.f, 0.f, 0.f, 1.f);
-        RenderCommand::Clear();
+        if (m_TimerQueries[0][0] == 0)
+            glGenQueries((GLsizei)(QueryLatency * PassCount), &m_TimerQueries[0][0]);
 
-        glDisable(GL_DEPTH_TEST);
-        DrawFullscreen();
-        glEnable(GL_DEPTH_TEST);
+        glBeginQuery(GL_TIME_ELAPSED, m_TimerQueries[m_TimerSlot][(uint32_t)pass]);
+        m_PassStart = std::chrono::steady_clock::now();
     }
 
-    uint32_t RendererPipeline::GetCompositeTexture() const {
-        return m_CompositeFB ? m_CompositeFB->GetColorAttachmentRendererID() : 0;
+    void RendererPipeline::EndPassTimer(Pass pass) {
+        if (!m_PassTimingEnabled) return;
+
+        const uint32_t p = (uint32_t)pass;
+        m_TimerPending[m_TimerSlot].CpuMs[p] =
+            std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - m_PassStart).count();
+
+        glEndQuery(GL_TIME_ELAPSED);
+        m_TimerIssued[m_TimerSlot] |= 1u << p;
     }
 
-    void RendererPipeline::PresentToScreen() {
-        if (!m_SceneFB || !m_ScreenShader || !m_ScreenQuadVAO) return;
+    void RendererPipeline::ResolvePassTimers() {
+        const uint32_t slot = m_TimerSlot;
+        if (!m_TimerIssued[slot]) return;
 
-        Framebuffer::BindDefault();
-        RenderCommand::SetViewport(0, 0, m_Width, m_Height);
-        RenderCommand::SetClearColor(0.f, 0.f, 0.f, 1.f);
-        RenderCommand::Clear();
+        // issued QueryLatency frames ago, so this normally doesn't wait
+        PassTimings& pending = m_TimerPending[slot];
+        for (uint32_t p = 0; p < PassCount; p++) {
+            if (!(m_TimerIssued[slot] & (1u << p))) continue;
 
-        glDisable(GL_DEPTH_TEST);
-        DrawFullscreen();
-        glEnable(GL_DEPTH_TEST);
+            GLuint64 ns = 0;
+            glGetQueryObjectui64v(m_TimerQueries[slot][p], GL_QUERY_RESULT, &ns);
+            pending.GpuMs[p] = (float)((double)ns / 1.0e6);
+        }
+
+        m_TimerIssued[slot] = 0;
+        m_PassTimings = pending;
     }
 
-    void RendererPipeline::DrawFullscreen() {
+    void RendererPipeline::DrawFullscreen(uint32_t sceneTexture, float uvScaleX, float uvScaleY) {
         m_ScreenShader->Bind();
         m_ScreenShader->SetFloat("u_Exposure", m_Exposure);
         m_ScreenShader->SetInt("u_Tonemap", m_Tonemap);
         m_ScreenShader->SetFloat("u_Vignette", m_Vignette);
 
         glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, m_SceneFB->GetColorAttachmentRendererID());
+        glBindTexture(GL_TEXTURE_2D, sceneTexture);
         m_ScreenShader->SetInt("u_Scene", 0);
-
-        glActiveTexture(GL_TEXTURE1);
-        if (m_IDFB)
-            glBindTexture(GL_TEXTURE_2D, m_IDFB->GetColorAttachmentRendererID());
-        else
-            glBindTexture(GL_TEXTURE_2D, 0);
-        m_ScreenShader->SetInt("u_ID", 1);
+        m_ScreenShader->SetFloat2("u_UVScale", uvScaleX, uvScaleY);
+        Renderer::CurrentStats().TextureBinds++;
 
         m_ScreenShader->SetUInt("u_SelectedID", m_SelectedID);
         m_ScreenShader->SetFloat3("u_OutlineColor", 1.0f, 0.85f, 0.1f);
@@ -164,16 +370,6 @@ namespace Engine {
         RenderCommand::DrawIndexed(m_ScreenQuadVAO->GetIndexBuffer()->GetCount());
     }
 
-    void RendererPipeline::BeginOverlayPass() {
-        if (!m_SceneFB) return;
-        m_SceneFB->Bind();
-        RenderCommand::SetViewport(0, 0, m_Width, m_Height);
-    }
-
-    void RendererPipeline::EndOverlayPass() {
-        // no-op; scene FB stays bound until Compose() binds its own FB anyway
-    }
-
     void RendererPipeline::EnsureShadowResources(uint32_t shadowSize) {
         m_ShadowSize = shadowSize;
 
@@ -188,6 +384,8 @@ namespace Engine {
             (m_ShadowAllocCascades != m_ShadowCascadeCount);
 
         if (needAlloc) {
+            MemoryTracker::TrackGpuFree(GpuMemoryKind::ShadowMap, ShadowArrayBytes(m_ShadowAllocSize, m_ShadowAllocCascades));
+            MemoryTracker::TrackGpuAlloc(GpuMemoryKind::ShadowMap, ShadowArrayBytes(m_ShadowSize, m_ShadowCascadeCount));
             glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT24,
                 m_ShadowSize, m_ShadowSize, m_ShadowCascadeCount,
                 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
@@ -210,27 +408,23 @@ namespace Engine {
         glReadBuffer(GL_NONE);
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
-        if (!m_ShadowDepthShader) {
-            m_ShadowDepthShader = std::make_shared<Shader>("Assets/Shaders/ShadowDepth.shader");
-            m_ShadowDepthMaterial = std::make_shared<Material>(m_ShadowDepthShader);
-        }
+        EnsureShadowDepthMaterial();
     }
 
-    void RendererPipeline::BeginShadowPass(uint32_t shadowSize,
-        const glm::mat4& lightViewProj,
-        uint32_t cascadeIndex,
-        uint32_t cascadeCount)
-    {
-        m_ShadowCascadeCount = std::min<uint32_t>(cascadeCount, MaxCascades);
-        EnsureShadowResources(shadowSize);
-
-        if (m_ShadowCascadeCount == 0)
-            return;
+    void RendererPipeline::EnsureShadowDepthMaterial() {
+        if (m_ShadowDepthShader) return;
+        m_ShadowDepthShader = ShaderLibrary::Get().Load("Assets/Shaders/ShadowDepth.shader");
+        m_ShadowDepthMaterial = std::make_shared<Material>(m_ShadowDepthShader);
+        m_ShadowDepthMaterial->SetReceiveShadows(false); // no per-draw cascade uniforms
+    }
 
+    bool RendererPipeline::BeginShadowCascade(const glm::mat4& lightViewProj, uint32_t cascadeIndex) {
         // IMPORTANT: clamp layer index
         cascadeIndex = std::min(cascadeIndex, m_ShadowCascadeCount - 1);
 
+        Renderer::SetStatsPass(RenderStats::Shadow);
         glBindFramebuffer(GL_FRAMEBUFFER, m_ShadowFBO);
+        Renderer::CurrentStats().FramebufferBinds++;
 
         glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
             m_ShadowDepthTexArray, 0, (GLint)cascadeIndex);
@@ -241,7 +435,8 @@ namespace Engine {
             // put your logging/assert here
             // e.g. std::cout << "Shadow FBO incomplete: " << status << "\n";
             glBindFramebuffer(GL_FRAMEBUFFER, 0);
-            return;
+            Renderer::SetStatsPass(RenderStats::Other);
+            return false;
         }
 
         glViewport(0, 0, m_ShadowSize, m_ShadowSize);
@@ -269,20 +464,19 @@ namespace Engine {
         glPolygonOffset(1.0f, 2.0f); // tweak if needed
 
         Renderer::BeginScene(lightViewProj);
-        m_ShadowPassActive = true;
+        return true;
     }
 
-    void RendererPipeline::EndShadowPass() {
-        if (!m_ShadowPassActive) return;
-
+    void RendererPipeline::EndShadowCascade() {
         Renderer::EndScene();
-        m_ShadowPassActive = false;
 
         glEnable(GL_CULL_FACE);
         glCullFace(GL_BACK);
         glDisable(GL_POLYGON_OFFSET_FILL);
 
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        Renderer::CurrentStats().FramebufferBinds++;
+        Renderer::SetStatsPass(RenderStats::Other);
     }
 
 } // namespace Engine
\ No newline at end of file
@@ -1,7 +1,15 @@
 #include "pch.h"
 #include "Engine/Renderer/Shader.h"
+#include "Engine/Renderer/RenderCommand.h"
+#include "Engine/Renderer/Renderer.h"
+#include "Engine/Renderer/ShaderCache.h"
+#include "Engine/Renderer/ShaderKeywords.h"
+#include "Engine/Renderer/Buffer.h"
+#include "Engine/Renderer/Material.h"
 
-#include <glad/glad.h>
+#include "GLExtensions.h"
+
+#include <algorithm>
 #include <vector>
 #include <iostream>
 #include <fstream>
@@ -31,10 +39,110 @@ namespace Engine {
         return ss.str();
     }
 
-    void Shader::ParseShaderFile(const std::string& source, std::string& outVertex, std::string& outFragment) {
+    namespace {
+
+        struct KeywordName {
+            const char* Name;
+            uint32_t Bits;
+        };
+
+        constexpr KeywordName kKeywords[] = {
+            { "HAS_TEXTURE0",       ShaderKeyword::HasTexture0 },
+            { "HAS_TEXTURE0_ARRAY", ShaderKeyword::HasTexture0Array },
+            { "USE_LIGHTING",       ShaderKeyword::UseLighting },
+            { "RECEIVE_SHADOWS",    ShaderKeyword::ReceiveShadows },
+            { "CASCADE_COUNT",      ShaderKeyword::CascadeMask },
+        };
+
+        uint32_t ParseKeywords(const std::string& source) {
+            const std::string pragma = "#pragma keywords";
+            uint32_t keywords = 0;
+
+            for (size_t pos = source.find(pragma); pos != std::string::npos; pos = source.find(pragma, pos)) {
+                pos += pragma.size();
+                const size_t eol = std::min(source.find_first_of("\r\n", pos), source.size());
+
+                std::istringstream names(source.substr(pos, eol - pos));
+                std::string name;
+                while (names >> name) {
+                    auto it = std::find_if(std::begin(kKeywords), std::end(kKeywords),
+                        [&](const KeywordName& k) { return name == k.Name; });
+                    if (it == std::end(kKeywords))
+                        throw std::runtime_error("Shader parse error: unknown keyword '" + name + "'");
+                    keywords |= it->Bits;
+                }
+            }
+            return keywords;
+        }
+
+        // "HAS_TEXTURE0 CASCADE_COUNT=2", for logs
+        std::string DescribePermutation(uint32_t keywords, uint32_t permutation) {
+            std::string text;
+            for (const auto& k : kKeywords) {
+                if (!(keywords & k.Bits)) continue;
+                if (k.Bits == ShaderKeyword::CascadeMask) {
+                    text += std::string(text.empty() ? "" : " ") + k.Name + "="
+                        + std::to_string(ShaderKeyword::GetCascadeCount(permutation));
+                }
+                else if (permutation & k.Bits) {
+                    text += std::string(text.empty() ? "" : " ") + k.Name;
+                }
+            }
+            return text;
+        }
+
+    } // namespace
+
+    std::string Shader::ExpandIncludes(const std::string& source, const std::string& filepath,
+        std::vector<std::string>& stack, std::vector<std::string>& outIncludes) {
+        if (std::find(stack.begin(), stack.end(), filepath) != stack.end())
+            throw std::runtime_error("Shader parse error: recursive #include of " + filepath);
+        stack.push_back(filepath);
+
+        // #include "path" is relative to the including file
+        const std::filesystem::path dir = std::filesystem::path(filepath).parent_path();
+        const std::string includeToken = "#include";
+
+        std::string out;
+        out.reserve(source.size());
+
+        size_t lineStart = 0;
+        while (lineStart < source.size()) {
+            const size_t eol = std::min(source.find('\n', lineStart), source.size());
+            const size_t first = source.find_first_not_of(" \t", lineStart);
+
+            if (first < eol && source.compare(first, includeToken.size(), includeToken) == 0) {
+                const size_t open = source.find('"', first + includeToken.size());
+                const size_t close = open < eol ? source.find('"', open + 1) : std::string::npos;
+                if (close >= eol)
+                    throw std::runtime_error("Shader parse error: malformed #include in " + filepath);
+
+                const std::string path = (dir / source.substr(open + 1, close - open - 1)).lexically_normal().generic_string();
+                if (std::find(outIncludes.begin(), outIncludes.end(), path) == outIncludes.end())
+                    outIncludes.push_back(path);
+
+                out += ExpandIncludes(ReadFile(path), path, stack, outIncludes);
+                out += '\n';
+            }
+            else {
+                out.append(source, lineStart, eol - lineStart);
+                if (eol < source.size()) out += '\n';
+            }
+            lineStart = eol + 1;
+        }
+
+        stack.pop_back();
+        return out;
+    }
+
+    Shader::Source Shader::ParseShaderFile(const std::string& filepath) {
+        const std::string source = ReadFile(filepath);
         const std::string typeToken = "#type";
         size_t pos = 0;
 
+        Source out;
+        out.Keywords = ParseKeywords(source.substr(0, source.find(typeToken)));
+
         while ((pos = source.find(typeToken, pos)) != std::string::npos) {
             size_t eol = source.find_first_of("\r\n", pos);
             if (eol == std::string::npos) throw std::runtime_error("Shader parse error: missing EOL after #type");
@@ -49,49 +157,111 @@ namespace Engine {
             size_t nextType = source.find(typeToken, nextLine);
             std::string body = source.substr(nextLine, nextType - nextLine);
 
-            if (type == "vertex") outVertex = body;
-            else if (type == "fragment") outFragment = body;
+            // each stage expands its own includes, so a shared file can go in both
+            std::vector<std::string> stack;
+            body = ExpandIncludes(body, filepath, stack, out.Includes);
+
+            if (type == "vertex") out.Vertex = std::move(body);
+            else if (type == "fragment") out.Fragment = std::move(body);
             else throw std::runtime_error("Shader parse error: unknown type '" + type + "'");
 
             pos = nextType;
         }
+        return out;
+    }
+
+    std::string Shader::InjectDefines(const std::string& stage, uint32_t keywords, uint32_t permutation) {
+        if (keywords == 0)
+            return stage;
+
+        permutation &= keywords;
+        std::string defines;
+        for (const auto& k : kKeywords) {
+            if (!(keywords & k.Bits)) continue;
+            if (k.Bits == ShaderKeyword::CascadeMask)
+                defines += "#define CASCADE_COUNT " + std::to_string(ShaderKeyword::GetCascadeCount(permutation)) + "\n";
+            else if (permutation & k.Bits)
+                defines += std::string("#define ") + k.Name + "\n";
+        }
+
+        // GLSL wants #version first
+        size_t insertAt = 0;
+        if (size_t version = stage.find("#version"); version != std::string::npos) {
+            const size_t eol = stage.find('\n', version);
+            insertAt = eol == std::string::npos ? stage.size() : eol + 1;
+        }
+        return stage.substr(0, insertAt) + defines + stage.substr(insertAt);
     }
 
-    uint32_t Shader::CompileStage(uint32_t type, const std::string& src) {
+    static uint32_t CompileStage(uint32_t type, const std::string& src) {
+        // no status query here: that would wait for the compile we want to overlap
         uint32_t id = glCreateShader(type);
         const char* cstr = src.c_str();
         glShaderSource(id, 1, &cstr, nullptr);
         glCompileShader(id);
+        return id;
+    }
 
+    static bool CheckStage(uint32_t id) {
         int ok = 0;
         glGetShaderiv(id, GL_COMPILE_STATUS, &ok);
         if (!ok) {
             std::cerr << "Shader compile failed:\n";
             PrintShaderLog(id, false);
-            glDeleteShader(id);
-            throw std::runtime_error("Shader compile failed");
         }
-        return id;
+        return ok != 0;
     }
 
-    uint32_t Shader::CreateProgram(const std::string& vertexSrc, const std::string& fragmentSrc) {
-        uint32_t vs = CompileStage(GL_VERTEX_SHADER, vertexSrc);
-        uint32_t fs = CompileStage(GL_FRAGMENT_SHADER, fragmentSrc);
+    Shader::Build Shader::BeginBuild(const std::string& vertexSrc, const std::string& fragmentSrc) {
+        Build build;
+        build.CacheKey = ShaderCache::MakeKey(vertexSrc, fragmentSrc);
+        if ((build.Program = ShaderCache::Load(build.CacheKey)) != 0)
+            return build;
+
+        // compile both stages and link before checking anything, so with
+        // KHR_parallel_shader_compile the driver works on all of it at once
+        build.VertexStage = CompileStage(GL_VERTEX_SHADER, vertexSrc);
+        build.FragmentStage = CompileStage(GL_FRAGMENT_SHADER, fragmentSrc);
+
+        build.Program = glCreateProgram();
+        glAttachShader(build.Program, build.VertexStage);
+        glAttachShader(build.Program, build.FragmentStage);
+        ShaderCache::PrepareForLink(build.Program);
+        glLinkProgram(build.Program);
+        return build;
+    }
+
+    bool Shader::IsBuildComplete(const Build& build) {
+        if (!build.VertexStage || !GLExtensions::HasParallelShaderCompile)
+            return true; // cache hit, or FinishBuild is going to block either way
+
+        int done = 0;
+        glGetProgramiv(build.Program, GL_COMPLETION_STATUS_KHR, &done);
+        return done != 0;
+    }
+
+    uint32_t Shader::FinishBuild(Build& build, const std::string& name) {
+        uint32_t program = build.Program;
+        const uint32_t vs = build.VertexStage, fs = build.FragmentStage;
+        const uint64_t cacheKey = build.CacheKey;
+        build = {};
 
-        uint32_t program = glCreateProgram();
-        glAttachShader(program, vs);
-        glAttachShader(program, fs);
-        glLinkProgram(program);
+        if (!vs) return program; // from ShaderCache, already linked
 
         int ok = 0;
         glGetProgramiv(program, GL_LINK_STATUS, &ok);
         if (!ok) {
-            std::cerr << "Program link failed:\n";
-            PrintShaderLog(program, true);
+            // a stage that didn't compile is the real error; the link log just repeats it
+            const bool stagesOk = CheckStage(vs) & CheckStage(fs);
+            if (stagesOk) {
+                std::cerr << "Program link failed:\n";
+                PrintShaderLog(program, true);
+            }
+            std::cerr << "  in " << name << "\n";
             glDeleteProgram(program);
             glDeleteShader(vs);
             glDeleteShader(fs);
-            throw std::runtime_error("Program link failed");
+            return 0;
         }
 
         glDetachShader(program, vs);
@@ -99,60 +269,232 @@ namespace Engine {
         glDeleteShader(vs);
         glDeleteShader(fs);
 
+        ShaderCache::Store(cacheKey, program);
         return program;
     }
 
+    uint32_t Shader::CreateProgram(const std::string& vertexSrc, const std::string& fragmentSrc) {
+        Build build = BeginBuild(vertexSrc, fragmentSrc);
+        uint32_t program = FinishBuild(build, m_Name);
+        if (!program)
+            throw std::runtime_error("Shader build failed: " + m_Name);
+        return program;
+    }
+
+    Shader::Build Shader::BeginVariantBuild(uint32_t permutation) const {
+        return BeginBuild(InjectDefines(m_Source.Vertex, m_Source.Keywords, permutation),
+            InjectDefines(m_Source.Fragment, m_Source.Keywords, permutation));
+    }
+
+    std::filesystem::file_time_type Shader::GetSourceTime() const {
+        std::error_code ec;
+        auto newest = std::filesystem::last_write_time(m_FilePath, ec);
+        for (const auto& include : m_Source.Includes) {
+            const auto time = std::filesystem::last_write_time(include, ec);
+            if (!ec && time > newest) newest = time;
+        }
+        return newest;
+    }
+
     Shader::Shader(const std::string& filepath) {
         m_Name = filepath;
+        m_FilePath = filepath;
+        m_Source = ParseShaderFile(filepath);
+        m_FileTime = GetSourceTime();
 
-        std::string src = ReadFile(filepath);
-        std::string vertex, fragment;
-        ParseShaderFile(src, vertex, fragment);
-
-        m_RendererID = CreateProgram(vertex, fragment);
+        SetProgram(CreateProgram(InjectDefines(m_Source.Vertex, m_Source.Keywords, 0),
+            InjectDefines(m_Source.Fragment, m_Source.Keywords, 0)));
     }
 
     Shader::Shader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc)
         : m_Name(name) {
-        m_RendererID = CreateProgram(vertexSrc, fragmentSrc);
+        SetProgram(CreateProgram(vertexSrc, fragmentSrc));
+    }
+
+    std::shared_ptr<Shader> Shader::CreateAsync(const std::string& filepath) {
+        std::shared_ptr<Shader> shader(new Shader());
+        shader->m_Name = filepath;
+        shader->m_FilePath = filepath;
+
+        try {
+            shader->m_Source = ParseShaderFile(filepath);
+            shader->m_Pending = shader->BeginVariantBuild(0);
+            shader->m_State = State::Pending;
+        }
+        catch (const std::exception& e) {
+            std::cout << "[Shader] " << e.what() << " (" << filepath << ")\n";
+            shader->m_State = State::Failed;
+        }
+        shader->m_FileTime = shader->GetSourceTime();
+        return shader;
     }
 
     Shader::~Shader() {
-        glDeleteProgram(m_RendererID);
+        const uint32_t ids[] = { m_RendererID.load(), m_Pending.Program, m_Reload.Program };
+        const uint32_t stages[] = { m_Pending.VertexStage, m_Pending.FragmentStage, m_Reload.VertexStage, m_Reload.FragmentStage };
+        RenderCommand::ReleaseOnRenderThread([=]() {
+            for (uint32_t id : ids) if (id) glDeleteProgram(id);
+            for (uint32_t id : stages) if (id) glDeleteShader(id);
+        });
+    }
+
+    void Shader::FinishPending() const {
+        const uint32_t program = FinishBuild(m_Pending, m_Name);
+        SetProgram(program);
+        m_State = program ? State::Ready : State::Failed;
+    }
+
+    bool Shader::IsReady() {
+        if (m_State == State::Pending && IsBuildComplete(m_Pending))
+            FinishPending();
+
+        if (m_Reload.Program && IsBuildComplete(m_Reload)) {
+            if (const uint32_t program = FinishBuild(m_Reload, m_Name)) {
+                const uint32_t previous = m_RendererID;
+                SetProgram(program);
+                glDeleteProgram(previous);
+                m_State = State::Ready;
+                std::cout << "[Shader] Reloaded " << m_Name << "\n";
+            }
+            else {
+                std::cout << "[Shader] Reload failed, keeping the previous program: " << m_Name << "\n";
+            }
+        }
+
+        for (auto& [key, variant] : m_Variants)
+            variant->IsReady();
+
+        return m_State == State::Ready;
+    }
+
+    bool Shader::IsBuilding() const {
+        if (m_State == State::Pending || m_Reload.Program)
+            return true;
+        for (const auto& [key, variant] : m_Variants)
+            if (variant->IsBuilding())
+                return true;
+        return false;
+    }
+
+    Shader& Shader::GetVariant(uint32_t permutation) {
+        const uint32_t key = permutation & m_Source.Keywords;
+        if (key == 0)
+            return *this;
+
+        if (auto it = m_Variants.find(key); it != m_Variants.end())
+            return *it->second;
+
+        std::unique_ptr<Shader> variant(new Shader());
+        variant->m_Name = m_Name + " [" + DescribePermutation(m_Source.Keywords, key) + "]";
+        variant->m_Pending = BeginVariantBuild(key);
+        variant->m_State = State::Pending;
+        return *m_Variants.emplace(key, std::move(variant)).first->second;
+    }
+
+    bool Shader::ReloadIfChanged() {
+        // a change made while builds are in flight is picked up once they finish
+        if (m_FilePath.empty() || IsBuilding())
+            return false;
+
+        const auto time = GetSourceTime();
+        if (time == m_FileTime)
+            return false;
+        m_FileTime = time;
+
+        try {
+            Source source = ParseShaderFile(m_FilePath);
+            if (source.Keywords != m_Source.Keywords)
+                m_Variants.clear(); // different variant set; rebuilt as draws ask for them
+            m_Source = std::move(source);
+
+            m_Reload = BeginVariantBuild(0);
+            for (auto& [key, variant] : m_Variants)
+                variant->m_Reload = BeginVariantBuild(key);
+        }
+        catch (const std::exception& e) {
+            // editors often save in two steps; the next write retries
+            std::cout << "[Shader] " << e.what() << " (" << m_FilePath << ")\n";
+            return false;
+        }
+        return true;
+    }
+
+    void Shader::SetProgram(uint32_t program) const {
+        m_RendererID = program;
+        m_HasMaterialBlock = false;
+        if (!program)
+            return;
+
+        const GLuint block = glGetUniformBlockIndex(program, "MaterialBlock");
+        if (block != GL_INVALID_INDEX) {
+            glUniformBlockBinding(program, block, UniformBinding::Material);
+            m_HasMaterialBlock = true;
+        }
+
+        GLint previous = 0;
+        glGetIntegerv(GL_CURRENT_PROGRAM, &previous);
+        glUseProgram(program);
+        for (uint32_t slot = 0; slot < Material::MaxTextureSlots; slot++) {
+            const int loc = glGetUniformLocation(program, ("u_Texture" + std::to_string(slot)).c_str());
+            if (loc != -1) glUniform1i(loc, (int)slot);
+        }
+        glUseProgram((GLuint)previous);
     }
 
     void Shader::Bind() const {
+        if (m_State == State::Pending)
+            FinishPending();
         glUseProgram(m_RendererID);
+        Renderer::CurrentStats().ShaderBinds++;
     }
 
     void Shader::SetMat4(const std::string& name, const float* value4x4) const {
         int loc = glGetUniformLocation(m_RendererID, name.c_str());
-        if (loc != -1) glUniformMatrix4fv(loc, 1, GL_FALSE, value4x4);
+        if (loc == -1) return;
+        glUniformMatrix4fv(loc, 1, GL_FALSE, value4x4);
+        Renderer::CurrentStats().UniformUploads++;
     }
 
     void Shader::SetFloat4(const std::string& name, float x, float y, float z, float w) const {
         int loc = glGetUniformLocation(m_RendererID, name.c_str());
-        if (loc != -1) glUniform4f(loc, x, y, z, w);
+        if (loc == -1) return;
+        glUniform4f(loc, x, y, z, w);
+        Renderer::CurrentStats().UniformUploads++;
     }
 
     void Shader::SetInt(const std::string& name, int value) const {
         int loc = glGetUniformLocation(m_RendererID, name.c_str());
-        if (loc != -1) glUniform1i(loc, value);
+        if (loc == -1) return;
+        glUniform1i(loc, value);
+        Renderer::CurrentStats().UniformUploads++;
+    }
+
+    void Shader::SetFloat2(const std::string& name, float x, float y) const {
+        int loc = glGetUniformLocation(m_RendererID, name.c_str());
+        if (loc == -1) return;
+        glUniform2f(loc, x, y);
+        Renderer::CurrentStats().UniformUploads++;
     }
 
     void Shader::SetFloat3(const std::string& name, float x, float y, float z) const {
         int loc = glGetUniformLocation(m_RendererID, name.c_str());
-        if (loc != -1) glUniform3f(loc, x, y, z);
+        if (loc == -1) return;
+        glUniform3f(loc, x, y, z);
+        Renderer::CurrentStats().UniformUploads++;
     }
 
     void Shader::SetUInt(const std::string& name, uint32_t value) const {
         int loc = glGetUniformLocation(m_RendererID, name.c_str());
-        if (loc != -1) glUniform1ui(loc, value);
+        if (loc == -1) return;
+        glUniform1ui(loc, value);
+        Renderer::CurrentStats().UniformUploads++;
     }
 
     void Shader::SetFloat(const std::string& name, float value) const {
         int loc = glGetUniformLocation(m_RendererID, name.c_str());
-        if (loc != -1) glUniform1f(loc, value);
+        if (loc == -1) return;
+        glUniform1f(loc, value);
+        Renderer::CurrentStats().UniformUploads++;
     }
 
 } // namespace Engine
\ No newline at end of file
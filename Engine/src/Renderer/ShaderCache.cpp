@@ -0,0 +1,185 @@
+#include "pch.h"
+#include "Engine/Renderer/ShaderCache.h"
+
+#include "GLExtensions.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace Engine {
+
+    std::string ShaderCache::s_Directory = "Cache/Shaders";
+    bool ShaderCache::s_Enabled = true;
+    ShaderCache::Stats ShaderCache::s_Stats;
+
+    namespace {
+
+        constexpr char     kMagic[4] = { 'E', '3', 'P', 'B' };
+        constexpr uint32_t kVersion = 1;
+
+        struct FileHeader {
+            char Magic[4];
+            uint32_t Version;
+            uint64_t Key;
+            uint32_t Format;  // GLenum binaryFormat
+            uint32_t Length;
+        };
+
+        // FNV-1a, 64-bit
+        uint64_t Hash(const void* data, size_t size, uint64_t h = 14695981039346656037ull) {
+            const auto* bytes = static_cast<const uint8_t*>(data);
+            for (size_t i = 0; i < size; i++) {
+                h ^= bytes[i];
+                h *= 1099511628211ull;
+            }
+            return h;
+        }
+
+        uint64_t Hash(const std::string& s, uint64_t h) {
+            // length first so ("ab","c") and ("a","bc") differ
+            const uint64_t len = s.size();
+            h = Hash(&len, sizeof(len), h);
+            return Hash(s.data(), s.size(), h);
+        }
+
+        uint64_t DriverHash() {
+            static const uint64_t hash = [] {
+                uint64_t h = Hash(nullptr, 0);
+                for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION }) {
+                    const char* s = (const char*)glGetString(name);
+                    h = Hash(std::string(s ? s : ""), h);
+                }
+                return h;
+            }();
+            return hash;
+        }
+
+    } // namespace
+
+    bool ShaderCache::IsAvailable() {
+        return s_Enabled && GLExtensions::HasProgramBinary;
+    }
+
+    uint64_t ShaderCache::MakeKey(const std::string& vertexSrc, const std::string& fragmentSrc) {
+        uint64_t h = DriverHash();
+        h = Hash(vertexSrc, h);
+        h = Hash(fragmentSrc, h);
+        return h;
+    }
+
+    std::string ShaderCache::GetPath(uint64_t key) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.bin", (unsigned long long)key);
+        return (std::filesystem::path(s_Directory) / name).string();
+    }
+
+    uint32_t ShaderCache::Load(uint64_t key) {
+        if (!IsAvailable())
+            return 0;
+
+        const std::string path = GetPath(key);
+        std::ifstream in(path, std::ios::in | std::ios::binary);
+        if (!in) {
+            s_Stats.Misses++;
+            return 0;
+        }
+
+        FileHeader header{};
+        in.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+        std::vector<char> binary;
+        bool ok = in && std::memcmp(header.Magic, kMagic, sizeof(kMagic)) == 0
+            && header.Version == kVersion && header.Key == key && header.Length > 0;
+        if (ok) {
+            binary.resize(header.Length);
+            in.read(binary.data(), (std::streamsize)binary.size());
+            ok = (bool)in;
+        }
+        in.close();
+
+        GLuint program = 0;
+        if (ok) {
+            program = glCreateProgram();
+            GLExtensions::ProgramBinary(program, (GLenum)header.Format, binary.data(), (GLsizei)binary.size());
+
+            GLint linked = 0;
+            glGetProgramiv(program, GL_LINK_STATUS, &linked);
+            ok = linked != 0;
+        }
+
+        if (!ok) {
+            // driver changed its mind (or the file is damaged): drop it, rebuild from source
+            if (program) glDeleteProgram(program);
+            std::error_code ec;
+            std::filesystem::remove(path, ec);
+            s_Stats.Rejected++;
+            return 0;
+        }
+
+        s_Stats.Hits++;
+        return program;
+    }
+
+    void ShaderCache::PrepareForLink(uint32_t program) {
+        if (IsAvailable())
+            GLExtensions::ProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+
+    void ShaderCache::Store(uint64_t key, uint32_t program) {
+        if (!IsAvailable())
+            return;
+
+        GLint length = 0;
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0)
+            return;
+
+        std::vector<char> binary((size_t)length);
+        GLenum format = 0;
+        GLsizei written = 0;
+        GLExtensions::GetProgramBinary(program, length, &written, &format, binary.data());
+        if (written <= 0)
+            return;
+
+        std::error_code ec;
+        std::filesystem::create_directories(s_Directory, ec);
+
+        // write a temp file and rename it over, so a second process (Editor + Sandbox)
+        // never reads a half-written binary
+        const std::string path = GetPath(key);
+        const std::string temp = path + "." + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + ".tmp";
+        {
+            std::ofstream out(temp, std::ios::out | std::ios::trunc | std::ios::binary);
+            if (!out) {
+                std::cout << "[ShaderCache] Can't write " << temp << "\n";
+                return;
+            }
+
+            FileHeader header{};
+            std::memcpy(header.Magic, kMagic, sizeof(kMagic));
+            header.Version = kVersion;
+            header.Key = key;
+            header.Format = (uint32_t)format;
+            header.Length = (uint32_t)written;
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.write(binary.data(), written);
+            if (!out) {
+                out.close();
+                std::filesystem::remove(temp, ec);
+                return;
+            }
+        }
+
+        std::filesystem::rename(temp, path, ec);
+        if (ec) {
+            std::filesystem::remove(temp, ec);
+            return;
+        }
+        s_Stats.Stored++;
+    }
+
+} // namespace Engine
@@ -2,23 +2,63 @@
 #include "Engine/Renderer/ShaderLibrary.h"
 #include "Engine/Renderer/Shader.h"
 
+#include "Engine/Core/Content.h"
+
 namespace Engine {
 
+    ShaderLibrary& ShaderLibrary::Get() {
+        static ShaderLibrary s_Instance;
+        return s_Instance;
+    }
+
     void ShaderLibrary::Add(const std::shared_ptr<Shader>& shader) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
         m_Shaders[shader->GetName()] = shader;
     }
 
     std::shared_ptr<Shader> ShaderLibrary::Load(const std::string& filepath) {
-        auto shader = std::make_shared<Shader>(filepath);
-        Add(shader);
+        // "Assets/Shaders/X.shader" and "Shaders/X.shader" are the same program
+        const std::string path = Content::Resolve(filepath);
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (auto it = m_Shaders.find(path); it != m_Shaders.end())
+            return it->second;
+
+        auto shader = Shader::CreateAsync(path);
+        m_Shaders[path] = shader;
         return shader;
     }
 
     std::shared_ptr<Shader> ShaderLibrary::Get(const std::string& name) const {
+        std::lock_guard<std::mutex> lock(m_Mutex);
         auto it = m_Shaders.find(name);
         if (it == m_Shaders.end())
             throw std::runtime_error("Shader not found: " + name);
         return it->second;
     }
 
-} // namespace Engine
\ No newline at end of file
+    bool ShaderLibrary::Exists(const std::string& name) const {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_Shaders.find(name) != m_Shaders.end();
+    }
+
+    uint32_t ShaderLibrary::ReloadChanged() {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        uint32_t started = 0;
+        for (auto& [name, shader] : m_Shaders)
+            if (shader->ReloadIfChanged())
+                started++;
+        return started;
+    }
+
+    bool ShaderLibrary::PollBuilds() {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        bool building = false;
+        for (auto& [name, shader] : m_Shaders) {
+            shader->IsReady();
+            building |= shader->IsBuilding();
+        }
+        return building;
+    }
+
+} // namespace Engine
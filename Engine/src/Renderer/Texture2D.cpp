@@ -1,5 +1,8 @@
 #include "pch.h"
 #include "Engine/Renderer/Texture2D.h"
+#include "Engine/Renderer/RenderCommand.h"
+#include "Engine/Renderer/Renderer.h"
+#include "Engine/Core/MemoryTracker.h"
 
 #include <glad/glad.h>
 
@@ -59,8 +62,10 @@ namespace Engine {
     }
 
     Texture2D::~Texture2D() {
-        if (m_RendererID)
-            glDeleteTextures(1, &m_RendererID);
+        if (m_RendererID) {
+            MemoryTracker::TrackGpuFree(GpuMemoryKind::Texture2D, GetGPUMemoryBytes());
+            RenderCommand::ReleaseOnRenderThread([id = m_RendererID]() { glDeleteTextures(1, &id); });
+        }
     }
 
     void Texture2D::UploadRGBA8(const uint8_t* rgbaPixels, int width, int height) {
@@ -76,11 +81,14 @@ namespace Engine {
         glGenerateMipmap(GL_TEXTURE_2D);
 
         glBindTexture(GL_TEXTURE_2D, 0);
+
+        MemoryTracker::TrackGpuAlloc(GpuMemoryKind::Texture2D, GetGPUMemoryBytes());
     }
 
     void Texture2D::Bind(uint32_t slot) const {
         glActiveTexture(GL_TEXTURE0 + slot);
         glBindTexture(GL_TEXTURE_2D, m_RendererID);
+        Renderer::CurrentStats().TextureBinds++;
     }
 
     // ---- NEW: Create from compressed bytes (PNG/JPG inside GLB) ----
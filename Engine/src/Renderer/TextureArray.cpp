@@ -0,0 +1,60 @@
+#include "pch.h"
+#include "Engine/Renderer/TextureArray.h"
+#include "Engine/Renderer/RenderCommand.h"
+#include "Engine/Renderer/Renderer.h"
+#include "Engine/Core/MemoryTracker.h"
+
+#include <glad/glad.h>
+
+namespace Engine {
+
+    TextureArray::TextureArray(const std::string& debugName, uint32_t width, uint32_t height, uint32_t layers)
+        : m_Width(width), m_Height(height), m_Layers(layers), m_DebugName(debugName) {
+        glGenTextures(1, &m_RendererID);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, m_RendererID);
+
+        // same sampling as Texture2D
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, (GLsizei)width, (GLsizei)height, (GLsizei)layers,
+            0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+        MemoryTracker::TrackGpuAlloc(GpuMemoryKind::TextureArray, GetGPUMemoryBytes());
+    }
+
+    TextureArray::~TextureArray() {
+        if (m_RendererID) {
+            MemoryTracker::TrackGpuFree(GpuMemoryKind::TextureArray, GetGPUMemoryBytes());
+            RenderCommand::ReleaseOnRenderThread([id = m_RendererID]() { glDeleteTextures(1, &id); });
+        }
+    }
+
+    void TextureArray::SetLayerRGBA8(uint32_t layer, const uint8_t* rgbaPixels) {
+        if (layer >= m_Layers) {
+            std::cout << "[TextureArray] Layer " << layer << " out of range in " << m_DebugName << "\n";
+            return;
+        }
+        glBindTexture(GL_TEXTURE_2D_ARRAY, m_RendererID);
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, (GLint)layer, (GLsizei)m_Width, (GLsizei)m_Height, 1,
+            GL_RGBA, GL_UNSIGNED_BYTE, rgbaPixels);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    }
+
+    void TextureArray::GenerateMipmaps() {
+        glBindTexture(GL_TEXTURE_2D_ARRAY, m_RendererID);
+        glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    }
+
+    void TextureArray::Bind(uint32_t slot) const {
+        glActiveTexture(GL_TEXTURE0 + slot);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, m_RendererID);
+        Renderer::CurrentStats().TextureBinds++;
+    }
+
+} // namespace Engine
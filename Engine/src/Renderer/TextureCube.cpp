@@ -1,5 +1,8 @@
 #include "pch.h"
 #include "Engine/Renderer/TextureCube.h"
+#include "Engine/Renderer/RenderCommand.h"
+#include "Engine/Renderer/Renderer.h"
+#include "Engine/Core/MemoryTracker.h"
 
 #include <glad/glad.h>
 
@@ -28,6 +31,9 @@ namespace Engine {
             GLenum fmt = (c == 4) ? GL_RGBA : GL_RGB;
             glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, fmt, w, h, 0, fmt, GL_UNSIGNED_BYTE, data);
             stbi_image_free(data);
+
+            // drivers pad RGB8 to 4 bytes per texel
+            m_GPUMemoryBytes += (size_t)w * (size_t)h * 4;
         }
 
         glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
@@ -37,15 +43,21 @@ namespace Engine {
         glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
 
         glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+
+        MemoryTracker::TrackGpuAlloc(GpuMemoryKind::TextureCube, m_GPUMemoryBytes);
     }
 
     TextureCube::~TextureCube() {
-        if (m_RendererID) glDeleteTextures(1, &m_RendererID);
+        if (m_RendererID) {
+            MemoryTracker::TrackGpuFree(GpuMemoryKind::TextureCube, m_GPUMemoryBytes);
+            RenderCommand::ReleaseOnRenderThread([id = m_RendererID]() { glDeleteTextures(1, &id); });
+        }
     }
 
     void TextureCube::Bind(uint32_t slot) const {
         glActiveTexture(GL_TEXTURE0 + slot);
         glBindTexture(GL_TEXTURE_CUBE_MAP, m_RendererID);
+        Renderer::CurrentStats().TextureBinds++;
     }
 
 } // namespace Engine
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "pch.h"
 #include "Engine/Renderer/VertexArray.h"
+#include "Engine/Renderer/RenderCommand.h"
+#include "Engine/Renderer/Renderer.h"
 
 #include <glad/glad.h>
 
@@ -22,11 +24,12 @@ namespace Engine {
     }
 
     VertexArray::~VertexArray() {
-        glDeleteVertexArrays(1, &m_RendererID);
+        RenderCommand::ReleaseOnRenderThread([id = m_RendererID]() { glDeleteVertexArrays(1, &id); });
     }
 
     void VertexArray::Bind() const {
         glBindVertexArray(m_RendererID);
+        Renderer::CurrentStats().VaoBinds++;
     }
 
     void VertexArray::AddVertexBuffer(const std::shared_ptr<VertexBuffer>& vb) {
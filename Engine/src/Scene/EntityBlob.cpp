@@ -0,0 +1,344 @@
+#include "pch.h"
+#include "Engine/Scene/EntityBlob.h"
+
+#include "Engine/Scene/Scene.h"
+#include "Engine/Scene/Components.h"
+
+#include "SceneBinaryFormat.h"
+
+#include <cstring>
+#include <unordered_map>
+
+// Blob layout (native endian, read with memcpy so no alignment is assumed):
+//
+//   BlobHeader
+//   AssetHandle            if Flag_Mesh
+//   PackedLight            if Flag_Light
+//   PackedWarp             if Flag_Warp   (string indices into the table below)
+//   uint32 Lengths[StringCount], char Bytes[]
+//
+// String 0 is always the tag.
+
+namespace Engine {
+
+    namespace {
+
+        using SceneBinary::PackedLight;
+        using SceneBinary::PackedWarp;
+
+        enum BlobFlags : uint32_t {
+            Flag_Mesh  = 1u << 0,
+            Flag_Light = 1u << 1,
+            Flag_Spawn = 1u << 2,
+            Flag_Warp  = 1u << 3,
+        };
+
+        struct BlobHeader {
+            uint32_t Flags;
+            uint32_t StringCount;
+            UUID ID;
+            TransformComponent Transform;
+        };
+
+        // Decoded form; only lives for the duration of one call
+        struct BlobContents {
+            UUID ID = 0;
+            std::string Tag;
+            TransformComponent Transform;
+
+            bool HasMesh = false;
+            AssetHandle Model = InvalidAssetHandle;
+
+            bool HasLight = false;
+            DirectionalLightComponent Light;
+
+            bool IsSpawn = false;
+
+            bool HasWarp = false;
+            SceneWarpComponent Warp;
+        };
+
+        template<typename T>
+        void Put(EntityBlob& out, const T& v) {
+            const size_t at = out.size();
+            out.resize(at + sizeof(T));
+            std::memcpy(out.data() + at, &v, sizeof(T));
+        }
+
+        template<typename T>
+        T Take(const EntityBlob& in, size_t& at) {
+            T v;
+            std::memcpy(&v, in.data() + at, sizeof(T));
+            at += sizeof(T);
+            return v;
+        }
+
+        EntityBlob Encode(const BlobContents& c) {
+            std::vector<const std::string*> strings{ &c.Tag };
+            auto addString = [&](const std::string& s) {
+                strings.push_back(&s);
+                return (uint32_t)(strings.size() - 1);
+                };
+
+            uint32_t flags = 0;
+            if (c.HasMesh)  flags |= Flag_Mesh;
+            if (c.HasLight) flags |= Flag_Light;
+            if (c.IsSpawn)  flags |= Flag_Spawn;
+            if (c.HasWarp)  flags |= Flag_Warp;
+
+            PackedWarp warp{};
+            if (c.HasWarp) {
+                warp.TargetScene = addString(c.Warp.TargetScene);
+                warp.TargetSpawnTag = addString(c.Warp.TargetSpawnTag);
+                warp.TargetWarpTag = addString(c.Warp.TargetWarpTag);
+                warp.TriggerRadius = c.Warp.TriggerRadius;
+            }
+
+            size_t stringBytes = 0;
+            for (const auto* s : strings) stringBytes += s->size();
+
+            EntityBlob out;
+            out.reserve(sizeof(BlobHeader) + sizeof(AssetHandle) + sizeof(PackedLight) + sizeof(PackedWarp)
+                + strings.size() * sizeof(uint32_t) + stringBytes);
+
+            Put(out, BlobHeader{ flags, (uint32_t)strings.size(), c.ID, c.Transform });
+
+            if (c.HasMesh)
+                Put(out, c.Model);
+            if (c.HasLight)
+                Put(out, PackedLight{ { c.Light.Color.x, c.Light.Color.y, c.Light.Color.z } });
+            if (c.HasWarp)
+                Put(out, warp);
+
+            for (const auto* s : strings)
+                Put(out, (uint32_t)s->size());
+            for (const auto* s : strings)
+                out.insert(out.end(), s->begin(), s->end());
+
+            out.shrink_to_fit();
+            return out;
+        }
+
+        bool Decode(const EntityBlob& in, BlobContents& c) {
+            if (in.size() < sizeof(BlobHeader))
+                return false;
+
+            size_t at = 0;
+            const auto h = Take<BlobHeader>(in, at);
+            c.ID = h.ID;
+            c.Transform = h.Transform;
+
+            const size_t fixed = (h.Flags & Flag_Mesh ? sizeof(AssetHandle) : 0)
+                + (h.Flags & Flag_Light ? sizeof(PackedLight) : 0)
+                + (h.Flags & Flag_Warp ? sizeof(PackedWarp) : 0);
+            if (h.StringCount == 0 || in.size() < at + fixed + (size_t)h.StringCount * sizeof(uint32_t))
+                return false;
+
+            c.HasMesh = (h.Flags & Flag_Mesh) != 0;
+            if (c.HasMesh)
+                c.Model = Take<AssetHandle>(in, at);
+
+            c.HasLight = (h.Flags & Flag_Light) != 0;
+            if (c.HasLight) {
+                const auto l = Take<PackedLight>(in, at);
+                c.Light.Color = { l.Color[0], l.Color[1], l.Color[2] };
+            }
+
+            c.IsSpawn = (h.Flags & Flag_Spawn) != 0;
+
+            PackedWarp warp{};
+            c.HasWarp = (h.Flags & Flag_Warp) != 0;
+            if (c.HasWarp)
+                warp = Take<PackedWarp>(in, at);
+
+            std::vector<std::string> strings(h.StringCount);
+            size_t bytesAt = at + (size_t)h.StringCount * sizeof(uint32_t);
+            for (auto& s : strings) {
+                const auto len = Take<uint32_t>(in, at);
+                if (bytesAt + len > in.size())
+                    return false;
+                s.assign(reinterpret_cast<const char*>(in.data() + bytesAt), len);
+                bytesAt += len;
+            }
+
+            c.Tag = std::move(strings[0]);
+
+            if (c.HasWarp) {
+                if (warp.TargetScene >= strings.size() || warp.TargetSpawnTag >= strings.size() || warp.TargetWarpTag >= strings.size())
+                    return false;
+                c.Warp.TargetScene = strings[warp.TargetScene];
+                c.Warp.TargetSpawnTag = strings[warp.TargetSpawnTag];
+                c.Warp.TargetWarpTag = strings[warp.TargetWarpTag];
+                c.Warp.TriggerRadius = warp.TriggerRadius;
+            }
+
+            return true;
+        }
+
+    } // namespace
+
+    EntityBlob CaptureEntityBlob(const Scene& scene, Entity entity) {
+        if (!entity) return {};
+
+        const auto& reg = scene.Registry();
+        const entt::entity e = entity.GetHandle();
+
+        BlobContents c;
+        if (const auto* idc = reg.try_get<IDComponent>(e))        c.ID = idc->ID;
+        if (const auto* tc = reg.try_get<TagComponent>(e))        c.Tag = tc->Tag;
+        if (const auto* xf = reg.try_get<TransformComponent>(e))  c.Transform = *xf;
+
+        if (const auto* mrc = reg.try_get<MeshRendererComponent>(e)) {
+            c.HasMesh = true;
+            c.Model = mrc->Model;
+        }
+
+        if (const auto* dl = reg.try_get<DirectionalLightComponent>(e)) {
+            c.HasLight = true;
+            c.Light = *dl;
+        }
+
+        c.IsSpawn = reg.any_of<SpawnPointComponent>(e);
+
+        if (const auto* sw = reg.try_get<SceneWarpComponent>(e)) {
+            c.HasWarp = true;
+            c.Warp = *sw;
+        }
+
+        return Encode(c);
+    }
+
+    Entity RestoreEntityBlob(Scene& scene, const EntityBlob& blob) {
+        BlobContents c;
+        if (!Decode(blob, c))
+            return {};
+
+        if (Entity existing = scene.FindEntityByUUID(c.ID))
+            return existing;
+
+        Entity e = scene.CreateEntityWithUUID(c.ID, c.Tag.c_str());
+        e.GetComponent<TransformComponent>() = c.Transform;
+
+        if (c.HasMesh)
+            e.AddComponent<MeshRendererComponent>(c.Model);
+
+        if (c.HasLight) {
+            // Direction is derived from the transform at render time
+            e.AddComponent<DirectionalLightComponent>(glm::vec3(0.4f, 0.8f, -0.3f), c.Light.Color);
+        }
+
+        if (c.IsSpawn)
+            e.AddComponent<SpawnPointComponent>();
+
+        if (c.HasWarp)
+            e.AddComponent<SceneWarpComponent>(c.Warp);
+
+        return e;
+    }
+
+    std::vector<entt::entity> RestoreEntityBlobs(Scene& scene, const std::vector<EntityBlob>& blobs) {
+        auto& reg = scene.Registry();
+        std::vector<entt::entity> result(blobs.size(), entt::null);
+
+        // decode everything first; `rows` maps new entities back to their blob
+        std::vector<BlobContents> contents;
+        std::vector<size_t> rows;
+        contents.reserve(blobs.size());
+        rows.reserve(blobs.size());
+
+        std::unordered_map<UUID, size_t> firstRow;          // same UUID twice in one batch -> one entity
+        std::vector<std::pair<size_t, size_t>> repeats;     // (blob index, blob index of first)
+        for (size_t i = 0; i < blobs.size(); i++) {
+            BlobContents c;
+            if (!Decode(blobs[i], c))
+                continue;
+
+            if (Entity existing = scene.FindEntityByUUID(c.ID)) {
+                result[i] = existing.GetHandle();
+                continue;
+            }
+
+            auto [it, inserted] = firstRow.emplace(c.ID, i);
+            if (!inserted) {
+                repeats.emplace_back(i, it->second);
+                continue;
+            }
+
+            rows.push_back(i);
+            contents.push_back(std::move(c));
+        }
+
+        const size_t count = contents.size();
+        if (count > 0) {
+            std::vector<entt::entity> entities(count);
+            reg.create(entities.begin(), entities.end());
+
+            std::vector<IDComponent> ids;
+            std::vector<TagComponent> tags;
+            std::vector<TransformComponent> transforms;
+            ids.reserve(count);
+            tags.reserve(count);
+            transforms.reserve(count);
+            for (auto& c : contents) {
+                ids.emplace_back(c.ID);
+                tags.emplace_back(std::move(c.Tag));
+                transforms.push_back(c.Transform);
+            }
+
+            reg.insert<IDComponent>(entities.begin(), entities.end(), ids.begin());
+            reg.insert<TransformComponent>(entities.begin(), entities.end(), transforms.begin());
+            reg.insert<TagComponent>(entities.begin(), entities.end(), std::make_move_iterator(tags.begin()));
+
+            std::vector<entt::entity> sub;
+            std::vector<MeshRendererComponent> meshes;
+            std::vector<DirectionalLightComponent> lights;
+            std::vector<SceneWarpComponent> warps;
+
+            for (size_t i = 0; i < count; i++)
+                if (contents[i].HasMesh) { sub.push_back(entities[i]); meshes.emplace_back(contents[i].Model); }
+            reg.insert<MeshRendererComponent>(sub.begin(), sub.end(), meshes.begin());
+
+            sub.clear();
+            for (size_t i = 0; i < count; i++)
+                if (contents[i].HasLight) { sub.push_back(entities[i]); lights.emplace_back(glm::vec3(0.4f, 0.8f, -0.3f), contents[i].Light.Color); }
+            reg.insert<DirectionalLightComponent>(sub.begin(), sub.end(), lights.begin());
+
+            sub.clear();
+            for (size_t i = 0; i < count; i++)
+                if (contents[i].IsSpawn) sub.push_back(entities[i]);
+            reg.insert<SpawnPointComponent>(sub.begin(), sub.end());
+
+            sub.clear();
+            for (size_t i = 0; i < count; i++)
+                if (contents[i].HasWarp) { sub.push_back(entities[i]); warps.push_back(std::move(contents[i].Warp)); }
+            reg.insert<SceneWarpComponent>(sub.begin(), sub.end(), std::make_move_iterator(warps.begin()));
+
+            for (size_t i = 0; i < count; i++)
+                result[rows[i]] = entities[i];
+        }
+
+        for (const auto& [index, first] : repeats)
+            result[index] = result[first];
+
+        return result;
+    }
+
+    UUID GetEntityBlobID(const EntityBlob& blob) {
+        if (blob.size() < sizeof(BlobHeader))
+            return 0;
+
+        size_t at = 0;
+        return Take<BlobHeader>(blob, at).ID;
+    }
+
+    EntityBlob RetargetEntityBlob(const EntityBlob& blob, UUID newID, const std::string& newTag) {
+        BlobContents c;
+        if (!Decode(blob, c))
+            return {};
+
+        c.ID = newID;
+        c.Tag = newTag;
+        return Encode(c);
+    }
+
+} // namespace Engine
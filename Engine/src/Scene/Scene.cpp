@@ -9,18 +9,91 @@
 #include "Engine/Renderer/Model.h"
 #include "Engine/Renderer/Material.h"
 #include "Engine/Renderer/PerspectiveCamera.h"
+#include "Engine/Renderer/VertexArray.h"
+#include "Engine/Renderer/FramePacket.h"
 
 #include "Engine/Renderer/Frustum.h"
+#include "Engine/Core/MemoryTracker.h"
 
 #include <cmath>
+#include <algorithm>
+#include <iostream>
 
 namespace Engine {
 
+    template<typename... Components>
+    void Scene::ConnectChangeSignals() {
+        ((m_Registry.on_construct<Components>().template connect<&Scene::OnComponentChanged>(*this),
+          m_Registry.on_update<Components>().template connect<&Scene::OnComponentChanged>(*this),
+          m_Registry.on_destroy<Components>().template connect<&Scene::OnComponentChanged>(*this)), ...);
+    }
+
+    Scene::Scene() {
+        ConnectChangeSignals<TagComponent, TransformComponent, MeshRendererComponent,
+            DirectionalLightComponent, SpawnPointComponent, SceneWarpComponent>();
+
+        // IDComponent is added first on create and is the entity's identity on destroy
+        m_Registry.on_construct<IDComponent>().connect<&Scene::OnComponentChanged>(*this);
+        m_Registry.on_destroy<IDComponent>().connect<&Scene::OnEntityDestroyed>(*this);
+
+        m_Registry.on_construct<IDComponent>().connect<&Scene::OnIDConstruct>(*this);
+        m_Registry.on_destroy<IDComponent>().connect<&Scene::OnIDDestroy>(*this);
+        m_Registry.on_construct<TagComponent>().connect<&Scene::OnTagConstruct>(*this);
+        m_Registry.on_update<TagComponent>().connect<&Scene::OnTagUpdate>(*this);
+        m_Registry.on_destroy<TagComponent>().connect<&Scene::OnTagDestroy>(*this);
+    }
+
+    void Scene::OnComponentChanged(entt::registry& reg, entt::entity e) {
+        m_ChangeVersion++;
+        if (!m_TrackChanges) return;
+
+        // entities without an ID aren't serialized; during destroy the ID pool
+        // may already be gone, and OnEntityDestroyed handles that case
+        const auto* idc = reg.try_get<IDComponent>(e);
+        if (!idc) return;
+
+        m_DirtyEntities[idc->ID] = e;
+        m_DestroyedEntities.erase(idc->ID);
+    }
+
+    void Scene::OnEntityDestroyed(entt::registry& reg, entt::entity e) {
+        m_ChangeVersion++;
+        if (!m_TrackChanges) return;
+
+        const UUID id = reg.get<IDComponent>(e).ID;
+        m_DirtyEntities.erase(id);
+        m_DestroyedEntities.insert(id);
+    }
+
+    void Scene::MarkEntityDirty(Entity entity) {
+        if (!entity) return;
+        OnComponentChanged(m_Registry, entity.GetHandle());
+    }
+
+    void Scene::MarkEntitiesDirty(const std::vector<entt::entity>& entities) {
+        if (!m_TrackChanges) {
+            m_ChangeVersion++;
+            return;
+        }
+
+        m_DirtyEntities.reserve(m_DirtyEntities.size() + entities.size());
+        for (entt::entity e : entities) {
+            if (e != entt::null)
+                OnComponentChanged(m_Registry, e);
+        }
+    }
+
+    void Scene::ClearTrackedChanges() {
+        m_DirtyEntities.clear();
+        m_DestroyedEntities.clear();
+    }
+
     Entity Scene::CreateEntity(const char* name) {
         return CreateEntityWithUUID(GenerateUUID(), name);
     }
 
     Entity Scene::CreateEntityWithUUID(UUID id, const char* name) {
+        MemoryScope memScope(MemoryTag::Scene);
         entt::entity e = m_Registry.create();
         Entity entity(e, &m_Registry);
 
@@ -35,8 +108,162 @@ namespace Engine {
         m_Registry.destroy(entity.GetHandle());
     }
 
+    std::vector<entt::entity> Scene::FindEntitiesByUUID(const std::vector<UUID>& ids) const {
+        std::vector<entt::entity> out(ids.size(), entt::null);
+        for (size_t i = 0; i < ids.size(); i++) {
+            auto it = m_EntityByUUID.find(ids[i]);
+            if (it != m_EntityByUUID.end())
+                out[i] = it->second;
+        }
+        return out;
+    }
+
+    void Scene::DestroyEntities(const std::vector<UUID>& ids) {
+        std::vector<entt::entity> entities = FindEntitiesByUUID(ids);
+        entities.erase(std::remove(entities.begin(), entities.end(), entt::entity(entt::null)), entities.end());
+
+        // same UUID listed twice must not destroy twice
+        std::sort(entities.begin(), entities.end());
+        entities.erase(std::unique(entities.begin(), entities.end()), entities.end());
+
+        m_Registry.destroy(entities.begin(), entities.end());
+    }
+
     void Scene::Clear() {
+        m_IndexingSuspended = true;
         m_Registry.clear();
+        m_IndexingSuspended = false;
+        ResetIndices();
+        m_ChangeVersion++;
+    }
+
+    // ---------------- Lookup indices ----------------
+
+    uint32_t Scene::PickIDFromUUID(UUID id) {
+        uint32_t v = (uint32_t)(id ^ (id >> 32));
+        return v == 0 ? 1u : v;
+    }
+
+    void Scene::OnIDConstruct(entt::registry& reg, entt::entity e) {
+        if (m_IndexingSuspended) return;
+
+        const UUID id = reg.get<IDComponent>(e).ID;
+        auto [it, inserted] = m_EntityByUUID.emplace(id, e);
+        if (!inserted) {
+            std::cout << "[Scene] Duplicate UUID " << id << ", lookups now resolve to the newer entity\n";
+            it->second = e;
+        }
+
+        const uint32_t pickID = PickIDFromUUID(id);
+        if (auto cit = m_PickIDCollisions.find(pickID); cit != m_PickIDCollisions.end()) {
+            cit->second.push_back(e);
+            return;
+        }
+
+        auto [pit, fresh] = m_EntityByPickID.emplace(pickID, e);
+        if (!fresh) {
+            std::cout << "[Scene] Pick ID collision: " << pickID << " (UUID " << id
+                << "); clicks on these entities won't select them\n";
+            m_PickIDCollisions[pickID] = { pit->second, e };
+            m_EntityByPickID.erase(pit);
+        }
+    }
+
+    void Scene::OnIDDestroy(entt::registry& reg, entt::entity e) {
+        if (m_IndexingSuspended) return;
+
+        const UUID id = reg.get<IDComponent>(e).ID;
+        if (auto it = m_EntityByUUID.find(id); it != m_EntityByUUID.end() && it->second == e)
+            m_EntityByUUID.erase(it);
+
+        const uint32_t pickID = PickIDFromUUID(id);
+        if (auto cit = m_PickIDCollisions.find(pickID); cit != m_PickIDCollisions.end()) {
+            auto& sharers = cit->second;
+            sharers.erase(std::remove(sharers.begin(), sharers.end(), e), sharers.end());
+            if (sharers.size() == 1) {
+                m_EntityByPickID[pickID] = sharers.front();
+                m_PickIDCollisions.erase(cit);
+            }
+            return;
+        }
+
+        if (auto pit = m_EntityByPickID.find(pickID); pit != m_EntityByPickID.end() && pit->second == e)
+            m_EntityByPickID.erase(pit);
+    }
+
+    uint32_t Scene::InternTag(const std::string& tag) {
+        if (auto it = m_TagIDs.find(std::string_view(tag)); it != m_TagIDs.end())
+            return it->second;
+
+        const uint32_t tagID = (uint32_t)m_TagNames.size();
+        m_TagNames.push_back(tag);
+        m_TagIDs.emplace(std::string_view(m_TagNames.back()), tagID);
+        m_EntitiesByTag.emplace_back();
+        return tagID;
+    }
+
+    void Scene::IndexTag(entt::entity e, uint32_t tagID) {
+        const size_t slot = (size_t)entt::to_entity(e);
+        if (slot >= m_TagSlots.size())
+            m_TagSlots.resize(slot + 1);
+
+        auto& list = m_EntitiesByTag[tagID];
+        m_TagSlots[slot] = { tagID, (uint32_t)list.size() };
+        list.push_back(e);
+    }
+
+    void Scene::UnindexTag(entt::entity e) {
+        const size_t slot = (size_t)entt::to_entity(e);
+        if (slot >= m_TagSlots.size() || m_TagSlots[slot].TagID == UINT32_MAX)
+            return;
+
+        // swap-remove, then fix up the moved entity's slot
+        auto& ts = m_TagSlots[slot];
+        auto& list = m_EntitiesByTag[ts.TagID];
+        const entt::entity moved = list.back();
+        list[ts.Index] = moved;
+        m_TagSlots[(size_t)entt::to_entity(moved)].Index = ts.Index;
+        list.pop_back();
+
+        ts = TagSlot{};
+    }
+
+    void Scene::OnTagConstruct(entt::registry& reg, entt::entity e) {
+        if (m_IndexingSuspended) return;
+        IndexTag(e, InternTag(reg.get<TagComponent>(e).Tag));
+    }
+
+    void Scene::OnTagUpdate(entt::registry& reg, entt::entity e) {
+        if (m_IndexingSuspended) return;
+
+        const uint32_t tagID = InternTag(reg.get<TagComponent>(e).Tag);
+        const size_t slot = (size_t)entt::to_entity(e);
+        if (slot < m_TagSlots.size() && m_TagSlots[slot].TagID == tagID)
+            return;
+
+        UnindexTag(e);
+        IndexTag(e, tagID);
+    }
+
+    void Scene::OnTagDestroy(entt::registry& /*reg*/, entt::entity e) {
+        if (m_IndexingSuspended) return;
+        UnindexTag(e);
+    }
+
+    void Scene::ResetIndices() {
+        m_EntityByUUID.clear();
+        m_EntityByPickID.clear();
+        m_PickIDCollisions.clear();
+
+        m_TagNames.clear();
+        m_TagIDs.clear();
+        m_EntitiesByTag.clear();
+        m_TagSlots.clear();
+    }
+
+    void Scene::SetEntityTag(Entity entity, const std::string& tag) {
+        if (!entity) return;
+        m_Registry.patch<TagComponent>(entity.GetHandle(), [&](TagComponent& tc) { tc.Tag = tag; });
     }
 
     void Scene::OnUpdate(float /*dt*/) {
@@ -44,37 +271,17 @@ namespace Engine {
     }
 
     void Scene::OnRender(const PerspectiveCamera& camera) {
+        MemoryScope memScope(MemoryTag::Scene);
         auto& assets = AssetManager::Get();
 
         // --- Lighting: pick first directional light, or use a default ---
         Renderer::ClearLights();
 
-        bool foundLight = false;
-        auto lightView = m_Registry.view<TransformComponent, DirectionalLightComponent>();
-        for (auto e : lightView) {
-            auto& tc = lightView.get<TransformComponent>(e);
-            auto& dl = lightView.get<DirectionalLightComponent>(e);
-
-            // Transform rotation -> forward dir (-Z baseline)
-            glm::vec3 dir{
-                cosf(tc.Rotation.x) * sinf(tc.Rotation.y),
-                sinf(tc.Rotation.x),
-                -cosf(tc.Rotation.x) * cosf(tc.Rotation.y)
-            };
-
-            if (glm::length(dir) < 0.0001f)
-                dir = dl.Direction;
-
-            Renderer::SetDirectionalLight(glm::normalize(dir), dl.Color);
-
-            // Optional: keep component Direction in sync with what rotation means
-            dl.Direction = glm::normalize(dir);
-
-            foundLight = true;
-            break;
+        glm::vec3 lightDir, lightColor;
+        if (GetMainDirectionalLight(lightDir, lightColor)) {
+            Renderer::SetDirectionalLight(lightDir, lightColor);
         }
-
-        if (!foundLight) {
+        else {
             // Keep lighting mode "on" so you don't get the confusing unlit-albedo look.
             Renderer::SetDirectionalLight(glm::vec3(0.4f, 0.8f, -0.3f), glm::vec3(1.0f));
         }
@@ -82,7 +289,7 @@ namespace Engine {
         Engine::Frustum fr = Engine::ExtractFrustum(camera.GetViewProjection());
 
 
-        Renderer::DrawSkybox(camera);
+        Renderer::SubmitSkybox(camera); // drawn after the meshes by EndScene
         // --- Render meshes (submit only; pipeline owns BeginScene/EndScene) ---
         auto renderView = m_Registry.view<TransformComponent, MeshRendererComponent>();
         renderView.each([&](auto /*entity*/, TransformComponent& tc, MeshRendererComponent& mrc) {
@@ -104,8 +311,10 @@ namespace Engine {
                 glm::vec3 worldCenter = glm::vec3(world * glm::vec4(b.Center, 1.0f));
                 float worldRadius = b.Radius * maxScale;
 
-                if (!Engine::SphereInFrustum(fr, worldCenter, worldRadius))
+                if (!Engine::SphereInFrustum(fr, worldCenter, worldRadius)) {
+                    Renderer::CurrentStats().Culled++;
                     continue;
+                }
 
                 Renderer::Submit(sm.MaterialPtr, sm.MeshPtr->GetVertexArray(), world);
             }
@@ -113,45 +322,42 @@ namespace Engine {
     }
 
     Entity Scene::FindEntityByUUID(UUID id) {
-        auto view = m_Registry.view<IDComponent>();
-        for (auto e : view) {
-            const auto& idc = view.get<IDComponent>(e);
-            if (idc.ID == id)
-                return Entity(e, &m_Registry);
-        }
-        return {};
+        auto it = m_EntityByUUID.find(id);
+        if (it == m_EntityByUUID.end())
+            return {};
+        return Entity(it->second, &m_Registry);
     }
 
     Entity Scene::FindEntityByTag(const std::string& tag) {
-        auto view = m_Registry.view<TagComponent>();
-        for (auto e : view) {
-            const auto& tc = view.get<TagComponent>(e);
-            if (tc.Tag == tag)
-                return Entity(e, &m_Registry);
-        }
-        return {};
+        const auto& list = GetEntitiesWithTag(tag);
+        if (list.empty())
+            return {};
+        return Entity(list.front(), &m_Registry);
     }
 
-    Entity Scene::FindEntityByPickID(uint32_t pickID) {
-        if (pickID == 0) return {};
+    const std::vector<entt::entity>& Scene::GetEntitiesWithTag(const std::string& tag) const {
+        static const std::vector<entt::entity> s_None;
 
-        auto view = m_Registry.view<IDComponent>();
-        for (auto e : view) {
-            const auto& idc = view.get<IDComponent>(e);
-            uint32_t folded = (uint32_t)(idc.ID ^ (idc.ID >> 32));
-            if (folded == 0) folded = 1u;
-            if (folded == pickID)
-                return Entity(e, &m_Registry);
-        }
-        return {};
+        auto it = m_TagIDs.find(std::string_view(tag));
+        if (it == m_TagIDs.end())
+            return s_None;
+        return m_EntitiesByTag[it->second];
     }
 
-    static uint32_t ToPickID(Engine::UUID id) {
-        uint32_t v = (uint32_t)(id ^ (id >> 32));
-        return v == 0 ? 1u : v;
+    Entity Scene::FindEntityByPickID(uint32_t pickID, bool* outCollision) {
+        if (outCollision) *outCollision = false;
+        if (pickID == 0) return {};
+
+        if (auto it = m_EntityByPickID.find(pickID); it != m_EntityByPickID.end())
+            return Entity(it->second, &m_Registry);
+
+        if (outCollision && m_PickIDCollisions.count(pickID))
+            *outCollision = true;
+        return {};
     }
 
     void Scene::OnRenderPicking(const PerspectiveCamera& /*camera*/, const std::shared_ptr<Material>& idMaterial) {
+        MemoryScope memScope(MemoryTag::Scene);
         auto& assets = AssetManager::Get();
 
         auto view = m_Registry.view<IDComponent, TransformComponent, MeshRendererComponent>();
@@ -161,7 +367,7 @@ namespace Engine {
             auto model = assets.GetModel(mrc.Model);
             if (!model) return;
 
-            uint32_t pickID = ToPickID(idc.ID);
+            uint32_t pickID = PickIDFromUUID(idc.ID);
             glm::mat4 world = tc.GetTransform();
 
             for (const auto& sm : model->GetSubMeshes()) {
@@ -172,6 +378,7 @@ namespace Engine {
     }
 
     Entity Scene::DuplicateEntity(Entity src) {
+        MemoryScope memScope(MemoryTag::Scene);
         if (!src) return {};
 
         std::string name = "Entity Copy";
@@ -220,7 +427,65 @@ namespace Engine {
         return false;
     }
 
+    void Scene::ExtractFramePacket(FramePacket& packet) {
+        MemoryScope memScope(MemoryTag::Scene);
+        auto& assets = AssetManager::Get();
+
+        // same light selection as OnRender
+        packet.HasLight = true;
+        if (!GetMainDirectionalLight(packet.LightDir, packet.LightColor)) {
+            packet.LightDir = glm::normalize(glm::vec3(0.4f, 0.8f, -0.3f));
+            packet.LightColor = glm::vec3(1.0f);
+        }
+
+        const Engine::Frustum fr = Engine::ExtractFrustum(packet.Camera.GetViewProjection());
+
+        auto renderView = m_Registry.view<TransformComponent, MeshRendererComponent>();
+        renderView.each([&](auto /*entity*/, TransformComponent& tc, MeshRendererComponent& mrc) {
+            if (mrc.Model == InvalidAssetHandle) return;
+
+            auto model = assets.GetModel(mrc.Model);
+            if (!model) return;
+
+            const glm::mat4 world = tc.GetTransform();
+            const float maxScale = std::max(tc.Scale.x, std::max(tc.Scale.y, tc.Scale.z));
+
+            for (const auto& sm : model->GetSubMeshes()) {
+                if (!sm.MeshPtr) continue;
+                const auto& vao = sm.MeshPtr->GetVertexArray();
+
+                // casters aren't culled against the camera (OnRenderShadow doesn't either)
+                DrawPacket caster;
+                caster.SortKey = vao->GetRendererID();
+                caster.VaoPtr = vao;
+                caster.Model = world;
+                packet.ShadowCasters.push_back(std::move(caster));
+
+                if (!sm.MaterialPtr || !sm.MaterialPtr->GetShader()) continue;
+
+                const auto& b = sm.MeshPtr->GetBounds();
+                glm::vec3 worldCenter = glm::vec3(world * glm::vec4(b.Center, 1.0f));
+                if (!Engine::SphereInFrustum(fr, worldCenter, b.Radius * maxScale)) {
+                    packet.CulledDraws++;
+                    continue;
+                }
+
+                DrawPacket draw;
+                draw.SortKey = Renderer::MakeSortKey(*sm.MaterialPtr, *vao);
+                draw.MaterialPtr = sm.MaterialPtr;
+                draw.VaoPtr = vao;
+                draw.Model = world;
+                packet.Draws.push_back(std::move(draw));
+            }
+            });
+
+        auto byKey = [](const DrawPacket& a, const DrawPacket& b) { return a.SortKey < b.SortKey; };
+        std::sort(packet.Draws.begin(), packet.Draws.end(), byKey);
+        std::sort(packet.ShadowCasters.begin(), packet.ShadowCasters.end(), byKey);
+    }
+
     void Scene::OnRenderShadow(const std::shared_ptr<Material>& shadowDepthMat) {
+        MemoryScope memScope(MemoryTag::Scene);
         auto& assets = AssetManager::Get();
         auto renderView = m_Registry.view<TransformComponent, MeshRendererComponent>();
 
@@ -0,0 +1,30 @@
+#pragma once
+// Internal: component encodings shared by the .sceneb columns (SceneSerializerBinary.cpp)
+// and single-entity blobs (EntityBlob.cpp). Strings are indices into whatever string
+// table the container carries.
+
+#include "Engine/Scene/Components.h"
+
+#include <cstdint>
+#include <type_traits>
+
+namespace Engine::SceneBinary {
+
+    struct PackedLight {
+        float Color[3];
+    };
+
+    struct PackedWarp {
+        uint32_t TargetScene;
+        uint32_t TargetSpawnTag;
+        uint32_t TargetWarpTag;
+        float TriggerRadius;
+    };
+
+    // IDs and transforms are copied as raw bytes (the .sceneb loader inserts them straight from the mapping)
+    static_assert(sizeof(IDComponent) == sizeof(UUID) && std::is_trivially_copyable_v<IDComponent>,
+        "IDComponent must stay a plain UUID for the binary scene format");
+    static_assert(sizeof(TransformComponent) == 9 * sizeof(float) && std::is_trivially_copyable_v<TransformComponent>,
+        "TransformComponent must stay 9 packed floats for the binary scene format");
+
+} // namespace Engine::SceneBinary
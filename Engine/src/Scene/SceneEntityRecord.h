@@ -0,0 +1,98 @@
+#pragma once
+// Internal to the scene serializers: one entity as it appears on disk
+// (asset paths instead of runtime asset handles).
+
+#include "Engine/Scene/Components.h"
+
+#include <entt/entt.hpp>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace Engine {
+
+    class Scene;
+
+    struct SceneEntityRecord {
+        UUID ID = 0;
+        std::string Tag = "Entity";
+        TransformComponent Transform;
+
+        bool HasMeshRenderer = false;
+        std::string ModelPath;
+        std::string ShaderPath;
+
+        bool HasDirectionalLight = false;
+        glm::vec3 LightColor{ 1.0f };
+
+        bool IsSpawnPoint = false;
+
+        bool HasSceneWarp = false;
+        SceneWarpComponent Warp;
+    };
+
+    // JSON <-> record (same keys the .scene files have always used)
+    nlohmann::json EntityRecordToJson(const SceneEntityRecord& rec);
+    SceneEntityRecord EntityRecordFromJson(const nlohmann::json& e);
+
+    // registry -> record (resolves asset handles to paths via AssetManager)
+    SceneEntityRecord CaptureEntityRecord(const entt::registry& reg, entt::entity entity);
+
+    // Struct-of-arrays form of a scene, ready for one registry insert per component type.
+    // Dense columns cover what every entity has; the rest are row-indexed, and each
+    // unique (model, shader) pair is stored once in AssetRefs.
+    struct SceneColumns {
+        std::vector<IDComponent> IDs;
+        std::vector<TagComponent> Tags;
+        std::vector<TransformComponent> Transforms;
+
+        struct AssetRef {
+            std::string ModelPath;
+            std::string ShaderPath;
+        };
+        std::vector<AssetRef> AssetRefs;
+        std::unordered_map<std::string, uint32_t> AssetRefIndex; // "model\nshader" -> AssetRefs
+
+        std::vector<uint32_t> MeshRows;
+        std::vector<uint32_t> MeshRefs; // index into AssetRefs, parallel to MeshRows
+
+        std::vector<uint32_t> LightRows;
+        std::vector<DirectionalLightComponent> Lights;
+
+        std::vector<uint32_t> SpawnRows;
+
+        std::vector<uint32_t> WarpRows;
+        std::vector<SceneWarpComponent> Warps;
+
+        size_t Size() const { return IDs.size(); }
+    };
+
+    void AppendEntityRecord(SceneColumns& cols, SceneEntityRecord&& rec);
+    std::vector<SceneEntityRecord> ColumnsToRecords(SceneColumns&& cols);
+
+    // Streaming (SAX) parse of a JSON scene file straight into columns, plus its ".delta"
+    // journal if the journal matches the file's revision.
+    bool LoadJsonSceneColumns(const std::string& filepath, SceneColumns& out, uint64_t* outRevision = nullptr);
+    bool LoadJsonSceneRecords(const std::string& filepath, std::vector<SceneEntityRecord>& out,
+        uint64_t* outRevision = nullptr);
+
+    // Bulk create + one insert per component type; all assets go through one
+    // AssetManager::LoadModels batch. Appends to whatever the scene already holds.
+    void InstantiateSceneColumns(Scene& scene, SceneColumns&& cols);
+
+    // Loads replace the whole scene; they aren't edits and mustn't show up as dirty entities.
+    class ChangeTrackingPause {
+    public:
+        explicit ChangeTrackingPause(Scene& scene);
+        ~ChangeTrackingPause();
+
+        ChangeTrackingPause(const ChangeTrackingPause&) = delete;
+        ChangeTrackingPause& operator=(const ChangeTrackingPause&) = delete;
+
+    private:
+        Scene& m_Scene;
+        bool m_WasEnabled;
+    };
+
+} // namespace Engine
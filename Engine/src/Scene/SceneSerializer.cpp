@@ -5,11 +5,19 @@
 #include "Engine/Scene/Components.h"
 
 #include "Engine/Assets/AssetManager.h"
+#include "Engine/Core/MappedFile.h"
+#include "Engine/Core/MemoryTracker.h"
+
+#include "SceneEntityRecord.h"
 
 #include <nlohmann/json.hpp>
+#include <cmath>
 #include <fstream>
 #include <filesystem>
 #include <iostream>
+#include <optional>
+#include <unordered_map>
+#include <vector>
 
 namespace Engine {
 
@@ -25,84 +33,637 @@ namespace Engine {
         return { a[0].get<float>(), a[1].get<float>(), a[2].get<float>() };
     }
 
-    SceneSerializer::SceneSerializer(Scene& scene)
-        : m_Scene(scene) {
+    // ---------------- Entity records ----------------
+
+    json EntityRecordToJson(const SceneEntityRecord& rec) {
+        json e;
+        e["ID"] = rec.ID;
+        e["Tag"] = rec.Tag;
+
+        e["Transform"]["Translation"] = Vec3ToJson(rec.Transform.Translation);
+        e["Transform"]["Rotation"] = Vec3ToJson(rec.Transform.Rotation);
+        e["Transform"]["Scale"] = Vec3ToJson(rec.Transform.Scale);
+
+        if (rec.HasMeshRenderer) {
+            e["MeshRenderer"]["ModelPath"] = rec.ModelPath;
+            e["MeshRenderer"]["ShaderPath"] = rec.ShaderPath;
+        }
+
+        if (rec.HasDirectionalLight) {
+            e["DirectionalLight"]["Color"] = Vec3ToJson(rec.LightColor);
+            // Direction comes from Transform rotation; don't serialize lc.Direction
+        }
+
+        if (rec.IsSpawnPoint) {
+            e["SpawnPoint"] = true;
+        }
+
+        if (rec.HasSceneWarp) {
+            e["SceneWarp"]["TargetScene"] = rec.Warp.TargetScene;
+            e["SceneWarp"]["TargetSpawnTag"] = rec.Warp.TargetSpawnTag;
+            e["SceneWarp"]["TargetWarpTag"] = rec.Warp.TargetWarpTag;
+            e["SceneWarp"]["TriggerRadius"] = rec.Warp.TriggerRadius;
+        }
+
+        return e;
     }
 
-    bool SceneSerializer::Serialize(const std::string& filepath) {
-        try {
-            std::filesystem::path p(filepath);
-            if (p.has_parent_path())
-                std::filesystem::create_directories(p.parent_path());
+    SceneEntityRecord EntityRecordFromJson(const json& e) {
+        SceneEntityRecord rec;
+        rec.ID = e.value("ID", (UUID)0);
+        rec.Tag = e.value("Tag", "Entity");
 
-            json root;
-            root["Scene"] = "Untitled";
-            root["Entities"] = json::array();
+        if (e.contains("Transform")) {
+            const auto& t = e["Transform"];
+            if (t.contains("Translation")) rec.Transform.Translation = JsonToVec3(t["Translation"]);
+            if (t.contains("Rotation"))    rec.Transform.Rotation = JsonToVec3(t["Rotation"]);
+            if (t.contains("Scale"))       rec.Transform.Scale = JsonToVec3(t["Scale"]);
+        }
 
-            auto& reg = m_Scene.Registry();
-            auto view = reg.view<IDComponent>();
+        if (e.contains("MeshRenderer")) {
+            const auto& mr = e["MeshRenderer"];
+            rec.ModelPath = mr.value("ModelPath", "");
+            rec.ShaderPath = mr.value("ShaderPath", "");
+            rec.HasMeshRenderer = !rec.ModelPath.empty() && !rec.ShaderPath.empty();
+        }
+
+        if (e.contains("DirectionalLight")) {
+            const auto& dl = e["DirectionalLight"];
+            rec.HasDirectionalLight = true;
+            rec.LightColor = dl.contains("Color") ? JsonToVec3(dl["Color"]) : glm::vec3(1.0f);
+        }
+
+        if (e.contains("SpawnPoint") && e["SpawnPoint"].get<bool>()) {
+            rec.IsSpawnPoint = true;
+        }
+
+        if (e.contains("SceneWarp")) {
+            const auto& j = e["SceneWarp"];
+            rec.HasSceneWarp = true;
+            rec.Warp.TargetScene = j.value("TargetScene", "");
+            rec.Warp.TargetSpawnTag = j.value("TargetSpawnTag", "");
+            rec.Warp.TargetWarpTag = j.value("TargetWarpTag", "");
+            rec.Warp.TriggerRadius = j.value("TriggerRadius", 1.0f); // NEW
+        }
+
+        return rec;
+    }
+
+    SceneEntityRecord CaptureEntityRecord(const entt::registry& reg, entt::entity entity) {
+        SceneEntityRecord rec;
+
+        if (reg.any_of<IDComponent>(entity))
+            rec.ID = reg.get<IDComponent>(entity).ID;
+
+        if (reg.any_of<TagComponent>(entity))
+            rec.Tag = reg.get<TagComponent>(entity).Tag;
 
-            auto& assets = AssetManager::Get();
+        if (reg.any_of<TransformComponent>(entity))
+            rec.Transform = reg.get<TransformComponent>(entity);
 
-            view.each([&](auto entity, IDComponent& idc) {
-                json e;
-                e["ID"] = idc.ID;
+        if (reg.any_of<MeshRendererComponent>(entity)) {
+            const auto& mrc = reg.get<MeshRendererComponent>(entity);
+            if (mrc.Model != InvalidAssetHandle) {
+                auto& assets = AssetManager::Get();
+                auto info = assets.GetModelInfo(mrc.Model);
+                rec.HasMeshRenderer = true;
+                rec.ModelPath = info.Path;
+                rec.ShaderPath = assets.GetShaderPath(info.ShaderHandle);
+            }
+        }
+
+        if (reg.any_of<DirectionalLightComponent>(entity)) {
+            rec.HasDirectionalLight = true;
+            rec.LightColor = reg.get<DirectionalLightComponent>(entity).Color;
+        }
+
+        rec.IsSpawnPoint = reg.any_of<SpawnPointComponent>(entity);
+
+        if (reg.any_of<SceneWarpComponent>(entity)) {
+            rec.HasSceneWarp = true;
+            rec.Warp = reg.get<SceneWarpComponent>(entity);
+        }
 
-                // Tag (optional)
-                if (reg.any_of<TagComponent>(entity)) {
-                    e["Tag"] = reg.get<TagComponent>(entity).Tag;
+        return rec;
+    }
+
+    ChangeTrackingPause::ChangeTrackingPause(Scene& scene)
+        : m_Scene(scene), m_WasEnabled(scene.IsChangeTrackingEnabled()) {
+        m_Scene.SetChangeTrackingEnabled(false);
+    }
+
+    ChangeTrackingPause::~ChangeTrackingPause() {
+        m_Scene.SetChangeTrackingEnabled(m_WasEnabled);
+    }
+
+    // ---------------- Delta journal ----------------
+    //
+    // "<scene>.delta" is JSON lines, appended on every incremental save:
+    //   {"Base":<revision>}            first line; must match the base file's "Revision"
+    //   {"Upsert":{<entity record>}}   entity created or changed (whole record)
+    //   {"Destroy":<uuid>}             entity removed
+    // Later lines win. A journal whose Base doesn't match is stale (left over from
+    // before a full rewrite) and is ignored.
+
+    static void ApplySceneJournal(const std::string& deltaPath, uint64_t revision,
+        std::vector<SceneEntityRecord>& records) {
+        std::ifstream in(deltaPath, std::ios::in);
+        if (!in) return;
+
+        std::unordered_map<UUID, size_t> index;
+        index.reserve(records.size());
+        for (size_t i = 0; i < records.size(); i++)
+            index[records[i].ID] = i;
+
+        std::vector<bool> removed(records.size(), false);
+
+        std::string line;
+        size_t lineNo = 0;
+        while (std::getline(in, line)) {
+            lineNo++;
+            if (line.empty()) continue;
+
+            json op = json::parse(line, nullptr, false);
+            if (op.is_discarded() || !op.is_object()) {
+                // a torn last line from an interrupted save; everything before it is good
+                std::cerr << "[SceneSerializer] Stopping at bad journal line " << lineNo << " in " << deltaPath << "\n";
+                break;
+            }
+
+            if (lineNo == 1) {
+                if (op.value("Base", (uint64_t)0) != revision) {
+                    std::cerr << "[SceneSerializer] Ignoring stale journal " << deltaPath << "\n";
+                    return;
                 }
+                continue;
+            }
 
-                // Transform (optional)
-                if (reg.any_of<TransformComponent>(entity)) {
-                    const auto& tc = reg.get<TransformComponent>(entity);
-                    e["Transform"]["Translation"] = Vec3ToJson(tc.Translation);
-                    e["Transform"]["Rotation"] = Vec3ToJson(tc.Rotation);
-                    e["Transform"]["Scale"] = Vec3ToJson(tc.Scale);
+            if (op.contains("Upsert")) {
+                SceneEntityRecord rec = EntityRecordFromJson(op["Upsert"]);
+                auto it = index.find(rec.ID);
+                if (it != index.end()) {
+                    records[it->second] = std::move(rec);
+                    removed[it->second] = false;
                 }
+                else {
+                    index[rec.ID] = records.size();
+                    records.push_back(std::move(rec));
+                    removed.push_back(false);
+                }
+            }
+            else if (op.contains("Destroy")) {
+                auto it = index.find(op["Destroy"].get<UUID>());
+                if (it != index.end())
+                    removed[it->second] = true;
+            }
+        }
 
-                // MeshRenderer (optional)
-                if (reg.any_of<MeshRendererComponent>(entity)) {
-                    const auto& mrc = reg.get<MeshRendererComponent>(entity);
-                    if (mrc.Model != InvalidAssetHandle) {
-                        auto info = assets.GetModelInfo(mrc.Model);
-                        e["MeshRenderer"]["ModelPath"] = info.Path;
-                        e["MeshRenderer"]["ShaderPath"] = assets.GetShaderPath(info.ShaderHandle);
+        size_t w = 0;
+        for (size_t i = 0; i < records.size(); i++) {
+            if (removed[i]) continue;
+            if (w != i) records[w] = std::move(records[i]);
+            w++;
+        }
+        records.resize(w);
+    }
+
+    // ---------------- Columns ----------------
+
+    void AppendEntityRecord(SceneColumns& cols, SceneEntityRecord&& rec) {
+        const uint32_t row = (uint32_t)cols.IDs.size();
+
+        cols.IDs.emplace_back(rec.ID);
+        cols.Tags.emplace_back();
+        cols.Tags.back().Tag = std::move(rec.Tag);
+        cols.Transforms.push_back(rec.Transform);
+
+        if (rec.HasMeshRenderer) {
+            std::string key = rec.ModelPath + '\n' + rec.ShaderPath;
+            auto [it, inserted] = cols.AssetRefIndex.emplace(std::move(key), (uint32_t)cols.AssetRefs.size());
+            if (inserted)
+                cols.AssetRefs.push_back({ std::move(rec.ModelPath), std::move(rec.ShaderPath) });
+
+            cols.MeshRows.push_back(row);
+            cols.MeshRefs.push_back(it->second);
+        }
+
+        if (rec.HasDirectionalLight) {
+            // Direction will be derived from Transform rotation at runtime,
+            // but keep a reasonable default for the component field:
+            cols.LightRows.push_back(row);
+            cols.Lights.emplace_back(glm::vec3(0.4f, 0.8f, -0.3f), rec.LightColor);
+        }
+
+        if (rec.IsSpawnPoint)
+            cols.SpawnRows.push_back(row);
+
+        if (rec.HasSceneWarp) {
+            cols.WarpRows.push_back(row);
+            cols.Warps.push_back(std::move(rec.Warp));
+        }
+    }
+
+    std::vector<SceneEntityRecord> ColumnsToRecords(SceneColumns&& cols) {
+        std::vector<SceneEntityRecord> records(cols.Size());
+        for (size_t i = 0; i < records.size(); i++) {
+            records[i].ID = cols.IDs[i].ID;
+            records[i].Tag = std::move(cols.Tags[i].Tag);
+            records[i].Transform = cols.Transforms[i];
+        }
+
+        for (size_t i = 0; i < cols.MeshRows.size(); i++) {
+            auto& rec = records[cols.MeshRows[i]];
+            const auto& ref = cols.AssetRefs[cols.MeshRefs[i]];
+            rec.HasMeshRenderer = true;
+            rec.ModelPath = ref.ModelPath;
+            rec.ShaderPath = ref.ShaderPath;
+        }
+
+        for (size_t i = 0; i < cols.LightRows.size(); i++) {
+            auto& rec = records[cols.LightRows[i]];
+            rec.HasDirectionalLight = true;
+            rec.LightColor = cols.Lights[i].Color;
+        }
+
+        for (uint32_t row : cols.SpawnRows)
+            records[row].IsSpawnPoint = true;
+
+        for (size_t i = 0; i < cols.WarpRows.size(); i++) {
+            auto& rec = records[cols.WarpRows[i]];
+            rec.HasSceneWarp = true;
+            rec.Warp = std::move(cols.Warps[i]);
+        }
+
+        return records;
+    }
+
+    // ---------------- Streaming JSON parse ----------------
+    //
+    // SAX handler for the .scene layout: fills one SceneEntityRecord at a time and
+    // appends it to the columns, so there is never a DOM of the whole file.
+    // Unknown keys are skipped (including nested objects/arrays), like the DOM loader did.
+
+    namespace {
+
+        class SceneSaxHandler final : public nlohmann::json_sax<json> {
+        public:
+            explicit SceneSaxHandler(SceneColumns& out) : m_Out(out) {}
+
+            bool SawEntities() const { return m_SawEntities; }
+            uint64_t GetRevision() const { return m_Revision; }
+            const std::string& GetError() const { return m_Error; }
+
+            bool null() override { return true; }
+            bool binary(binary_t&) override { return true; }
+
+            bool boolean(bool val) override {
+                if (Top() == Frame::Entity && m_Key == "SpawnPoint")
+                    m_Rec.IsSpawnPoint = val;
+                return true;
+            }
+
+            bool number_integer(number_integer_t val) override {
+                return Number((double)val, val >= 0 ? std::optional<uint64_t>((uint64_t)val) : std::nullopt);
+            }
+            bool number_unsigned(number_unsigned_t val) override { return Number((double)val, val); }
+            bool number_float(number_float_t val, const string_t&) override {
+                // only whole numbers in uint64 range have an unsigned form (the cast is UB otherwise)
+                const bool whole = val >= 0.0 && val < 18446744073709551616.0 && val == std::floor(val);
+                return Number(val, whole ? std::optional<uint64_t>((uint64_t)val) : std::nullopt);
+            }
+
+            bool string(string_t& val) override {
+                switch (Top()) {
+                case Frame::Entity:
+                    if (m_Key == "Tag") m_Rec.Tag = std::move(val);
+                    break;
+                case Frame::MeshRenderer:
+                    if (m_Key == "ModelPath")       m_Rec.ModelPath = std::move(val);
+                    else if (m_Key == "ShaderPath") m_Rec.ShaderPath = std::move(val);
+                    break;
+                case Frame::SceneWarp:
+                    if (m_Key == "TargetScene")         m_Rec.Warp.TargetScene = std::move(val);
+                    else if (m_Key == "TargetSpawnTag") m_Rec.Warp.TargetSpawnTag = std::move(val);
+                    else if (m_Key == "TargetWarpTag")  m_Rec.Warp.TargetWarpTag = std::move(val);
+                    break;
+                default:
+                    break;
+                }
+                return true;
+            }
+
+            bool key(string_t& val) override {
+                m_Key.swap(val);
+                return true;
+            }
+
+            bool start_object(std::size_t) override {
+                if (m_Stack.empty()) {
+                    m_Stack.push_back(Frame::Root);
+                    return true;
+                }
+
+                Frame next = Frame::Skip;
+                if (Top() == Frame::Entities) {
+                    m_Rec = SceneEntityRecord{};
+                    next = Frame::Entity;
+                }
+                else if (Top() == Frame::Entity) {
+                    if (m_Key == "Transform") {
+                        next = Frame::Transform;
                     }
+                    else if (m_Key == "MeshRenderer") {
+                        next = Frame::MeshRenderer;
+                    }
+                    else if (m_Key == "DirectionalLight") {
+                        m_Rec.HasDirectionalLight = true;
+                        next = Frame::DirectionalLight;
+                    }
+                    else if (m_Key == "SceneWarp") {
+                        m_Rec.HasSceneWarp = true;
+                        next = Frame::SceneWarp;
+                    }
+                }
+
+                m_Stack.push_back(next);
+                return true;
+            }
+
+            bool end_object() override {
+                if (Top() == Frame::Entity) {
+                    m_Rec.HasMeshRenderer = !m_Rec.ModelPath.empty() && !m_Rec.ShaderPath.empty();
+                    AppendEntityRecord(m_Out, std::move(m_Rec));
                 }
+                m_Stack.pop_back();
+                return true;
+            }
 
-                // DirectionalLight (optional)
-                if (reg.any_of<DirectionalLightComponent>(entity)) {
-                    const auto& lc = reg.get<DirectionalLightComponent>(entity);
-                    e["DirectionalLight"]["Color"] = Vec3ToJson(lc.Color);
-                    // Direction comes from Transform rotation; don't serialize lc.Direction
+            bool start_array(std::size_t) override {
+                if (m_Stack.empty()) {
+                    m_Error = "root is not an object";
+                    return false;
                 }
 
-                // Spawn
-                if (reg.any_of<SpawnPointComponent>(entity)) {
-                    e["SpawnPoint"] = true;
+                Frame next = Frame::Skip;
+                if (Top() == Frame::Root && m_Key == "Entities") {
+                    m_SawEntities = true;
+                    next = Frame::Entities;
+                }
+                else if (Top() == Frame::Transform) {
+                    if (m_Key == "Translation")   next = BeginVec3(m_Rec.Transform.Translation);
+                    else if (m_Key == "Rotation") next = BeginVec3(m_Rec.Transform.Rotation);
+                    else if (m_Key == "Scale")    next = BeginVec3(m_Rec.Transform.Scale);
                 }
+                else if (Top() == Frame::DirectionalLight && m_Key == "Color") {
+                    next = BeginVec3(m_Rec.LightColor);
+                }
+
+                m_Stack.push_back(next);
+                return true;
+            }
+
+            bool end_array() override {
+                m_Stack.pop_back();
+                return true;
+            }
 
-                if (reg.any_of<SceneWarpComponent>(entity)) {
-                    const auto& sw = reg.get<SceneWarpComponent>(entity);
-                    e["SceneWarp"]["TargetScene"] = sw.TargetScene;
-                    e["SceneWarp"]["TargetSpawnTag"] = sw.TargetSpawnTag;
-                    e["SceneWarp"]["TargetWarpTag"] = sw.TargetWarpTag;
+            bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) override {
+                m_Error = ex.what();
+                return false;
+            }
+
+        private:
+            enum class Frame { Root, Entities, Entity, Transform, MeshRenderer, DirectionalLight, SceneWarp, Vec3, Skip };
+
+            Frame Top() const { return m_Stack.empty() ? Frame::Skip : m_Stack.back(); }
 
-                    e["SceneWarp"]["TriggerRadius"] = sw.TriggerRadius; // NEW
-                    
+            Frame BeginVec3(glm::vec3& target) {
+                m_Vec = &target;
+                m_VecIndex = 0;
+                return Frame::Vec3;
+            }
+
+            // u: the value as an unsigned integer, when it is one (IDs, revision)
+            bool Number(double d, std::optional<uint64_t> u) {
+                switch (Top()) {
+                case Frame::Vec3:
+                    if (m_VecIndex < 3) (*m_Vec)[m_VecIndex++] = (float)d;
+                    break;
+                case Frame::Root:
+                    if (m_Key == "Revision" && u) m_Revision = *u;
+                    break;
+                case Frame::Entity:
+                    if (m_Key == "ID" && u) m_Rec.ID = (UUID)*u;
+                    break;
+                case Frame::SceneWarp:
+                    if (m_Key == "TriggerRadius") m_Rec.Warp.TriggerRadius = (float)d;
+                    break;
+                default:
+                    break;
                 }
+                return true;
+            }
+
+        private:
+            SceneColumns& m_Out;
+
+            std::vector<Frame> m_Stack;
+            std::string m_Key;
+            SceneEntityRecord m_Rec;
+
+            glm::vec3* m_Vec = nullptr;
+            int m_VecIndex = 0;
+
+            bool m_SawEntities = false;
+            uint64_t m_Revision = 0;
+            std::string m_Error;
+        };
+
+    } // namespace
+
+    bool LoadJsonSceneColumns(const std::string& filepath, SceneColumns& out, uint64_t* outRevision) {
+        MappedFile file;
+        if (!file.Open(filepath)) {
+            std::cerr << "[SceneSerializer] Failed to open for read: " << filepath << "\n";
+            return false;
+        }
+
+        out = SceneColumns{};
+
+        const char* begin = reinterpret_cast<const char*>(file.Data());
+        SceneSaxHandler handler(out);
+        if (!json::sax_parse(begin, begin + file.Size(), &handler)) {
+            std::cerr << "[SceneSerializer] Invalid scene file " << filepath << ": " << handler.GetError() << "\n";
+            return false;
+        }
+
+        if (!handler.SawEntities()) {
+            std::cerr << "[SceneSerializer] Invalid scene file (no Entities array)\n";
+            return false;
+        }
+
+        // files written before the journal existed have no revision and never get one applied
+        const uint64_t revision = handler.GetRevision();
+        if (revision != 0) {
+            std::error_code ec;
+            const std::string deltaPath = SceneSerializer::GetDeltaPath(filepath);
+            if (std::filesystem::file_size(deltaPath, ec) > 0 && !ec) {
+                // journals are small (compaction keeps them so); round-trip through records
+                auto records = ColumnsToRecords(std::move(out));
+                ApplySceneJournal(deltaPath, revision, records);
+
+                out = SceneColumns{};
+                for (auto& rec : records)
+                    AppendEntityRecord(out, std::move(rec));
+            }
+        }
+
+        if (outRevision) *outRevision = revision;
+        return true;
+    }
+
+    bool LoadJsonSceneRecords(const std::string& filepath, std::vector<SceneEntityRecord>& out,
+        uint64_t* outRevision) {
+        SceneColumns cols;
+        if (!LoadJsonSceneColumns(filepath, cols, outRevision))
+            return false;
+
+        out = ColumnsToRecords(std::move(cols));
+        return true;
+    }
+
+    void InstantiateSceneColumns(Scene& scene, SceneColumns&& cols) {
+        auto& reg = scene.Registry();
+        const size_t count = cols.Size();
+
+        std::vector<entt::entity> entities(count);
+        reg.create(entities.begin(), entities.end());
+
+        reg.insert<IDComponent>(entities.begin(), entities.end(), cols.IDs.begin());
+        reg.insert<TransformComponent>(entities.begin(), entities.end(), cols.Transforms.begin());
+        reg.insert<TagComponent>(entities.begin(), entities.end(), std::make_move_iterator(cols.Tags.begin()));
+
+        std::vector<entt::entity> rows;
+        auto gatherRows = [&](const std::vector<uint32_t>& src) {
+            rows.resize(src.size());
+            for (size_t i = 0; i < src.size(); i++)
+                rows[i] = entities[src[i]];
+            };
+
+        if (!cols.MeshRows.empty()) {
+            std::vector<AssetManager::ModelLoadRequest> requests;
+            requests.reserve(cols.AssetRefs.size());
+            for (auto& ref : cols.AssetRefs)
+                requests.push_back({ std::move(ref.ModelPath), std::move(ref.ShaderPath) });
+
+            const auto handles = AssetManager::Get().LoadModels(requests);
+
+            std::vector<MeshRendererComponent> meshes;
+            meshes.reserve(cols.MeshRefs.size());
+            for (uint32_t ref : cols.MeshRefs)
+                meshes.emplace_back(handles[ref]);
+
+            gatherRows(cols.MeshRows);
+            reg.insert<MeshRendererComponent>(rows.begin(), rows.end(), meshes.begin());
+        }
+
+        if (!cols.LightRows.empty()) {
+            gatherRows(cols.LightRows);
+            reg.insert<DirectionalLightComponent>(rows.begin(), rows.end(), cols.Lights.begin());
+        }
+
+        if (!cols.SpawnRows.empty()) {
+            gatherRows(cols.SpawnRows);
+            reg.insert<SpawnPointComponent>(rows.begin(), rows.end());
+        }
+
+        if (!cols.WarpRows.empty()) {
+            gatherRows(cols.WarpRows);
+            reg.insert<SceneWarpComponent>(rows.begin(), rows.end(), std::make_move_iterator(cols.Warps.begin()));
+        }
+    }
+
+    // ---------------- SceneSerializer ----------------
+
+    SceneSerializer::SceneSerializer(Scene& scene)
+        : m_Scene(scene) {
+    }
+
+    bool SceneSerializer::IsBinaryScenePath(const std::string& filepath) {
+        return std::filesystem::path(filepath).extension() == ".sceneb";
+    }
+
+    std::string SceneSerializer::GetDeltaPath(const std::string& filepath) {
+        return filepath + ".delta";
+    }
+
+    void SceneSerializer::SetBaseFile(const std::string& filepath, uint64_t revision) {
+        std::error_code ec;
+        m_BasePath = filepath;
+        m_BaseRevision = revision;
+        m_BaseSize = std::filesystem::file_size(filepath, ec);
+        if (ec) m_BasePath.clear();
+    }
 
-                root["Entities"].push_back(e);
+    bool SceneSerializer::Serialize(const std::string& filepath) {
+        bool ok = false;
+        if (IsBinaryScenePath(filepath)) {
+            ok = SerializeBinary(filepath);
+            m_BasePath.clear();
+        }
+        else {
+            ok = SerializeJson(filepath);
+        }
+
+        if (ok)
+            m_Scene.ClearTrackedChanges();
+        return ok;
+    }
+
+    bool SceneSerializer::SerializeJson(const std::string& filepath) {
+        try {
+            std::filesystem::path p(filepath);
+            if (p.has_parent_path())
+                std::filesystem::create_directories(p.parent_path());
+
+            // a fresh revision orphans any journal written against the old contents,
+            // even if removing it below fails
+            UUID revision = GenerateUUID();
+            if (revision == 0) revision = 1;
+
+            json root;
+            root["Scene"] = "Untitled";
+            root["Revision"] = revision;
+            root["Entities"] = json::array();
+
+            auto& reg = m_Scene.Registry();
+            auto view = reg.view<IDComponent>();
+
+            view.each([&](auto entity, IDComponent& /*idc*/) {
+                root["Entities"].push_back(EntityRecordToJson(CaptureEntityRecord(reg, entity)));
                 });
 
-            std::ofstream out(filepath, std::ios::out | std::ios::trunc);
-            if (!out) {
-                std::cerr << "[SceneSerializer] Failed to open for write: " << filepath << "\n";
-                return false;
+            const std::string tmpPath = filepath + ".tmp";
+            {
+                std::ofstream out(tmpPath, std::ios::out | std::ios::trunc);
+                if (!out) {
+                    std::cerr << "[SceneSerializer] Failed to open for write: " << tmpPath << "\n";
+                    return false;
+                }
+
+                out << root.dump(2);
+                if (!out) {
+                    std::cerr << "[SceneSerializer] Write failed: " << tmpPath << "\n";
+                    return false;
+                }
             }
 
-            out << root.dump(2);
+            std::filesystem::rename(tmpPath, filepath);
+
+            std::error_code ec;
+            std::filesystem::remove(GetDeltaPath(filepath), ec);
+
+            SetBaseFile(filepath, revision);
             return true;
         }
         catch (const std::exception& ex) {
@@ -111,84 +672,108 @@ namespace Engine {
         }
     }
 
-    bool SceneSerializer::Deserialize(const std::string& filepath) {
-        try {
-            std::ifstream in(filepath, std::ios::in);
-            if (!in) {
-                std::cerr << "[SceneSerializer] Failed to open for read: " << filepath << "\n";
-                return false;
-            }
+    bool SceneSerializer::SerializeDelta(const std::string& filepath) {
+        if (IsBinaryScenePath(filepath))
+            return Serialize(filepath);
 
-            json root;
-            in >> root;
+        // the journal only makes sense on top of the exact file we loaded or wrote
+        std::error_code ec;
+        const uintmax_t baseSize = std::filesystem::file_size(filepath, ec);
+        if (ec || filepath != m_BasePath || m_BaseRevision == 0 || baseSize != m_BaseSize)
+            return Serialize(filepath);
 
-            if (!root.contains("Entities") || !root["Entities"].is_array()) {
-                std::cerr << "[SceneSerializer] Invalid scene file (no Entities array)\n";
-                return false;
-            }
+        if (!m_Scene.HasTrackedChanges())
+            return true;
 
-            // Clear scene registry
-            m_Scene.Clear();
+        try {
+            const std::string deltaPath = GetDeltaPath(filepath);
+            const uintmax_t deltaSize = std::filesystem::file_size(deltaPath, ec);
+            const bool fresh = ec || deltaSize == 0;
+
+            // lines appended after a torn one would never be replayed; start over
+            if (!fresh) {
+                std::ifstream tail(deltaPath, std::ios::in | std::ios::binary);
+                tail.seekg(-1, std::ios::end);
+                if (tail.get() != '\n')
+                    return Serialize(filepath);
+            }
 
-            auto& assets = AssetManager::Get();
+            std::string lines;
+            if (fresh)
+                lines += json{ { "Base", m_BaseRevision } }.dump() + "\n";
 
-            for (const auto& e : root["Entities"]) {
-                UUID id = e.value("ID", (UUID)0);
-                std::string tag = e.value("Tag", "Entity");
+            const auto& reg = m_Scene.Registry();
+            for (const auto& [id, entity] : m_Scene.GetDirtyEntities()) {
+                const auto* idc = reg.valid(entity) ? reg.try_get<IDComponent>(entity) : nullptr;
+                if (!idc || idc->ID != id) continue;
 
-                Entity ent = m_Scene.CreateEntityWithUUID(id, tag.c_str());
+                lines += json{ { "Upsert", EntityRecordToJson(CaptureEntityRecord(reg, entity)) } }.dump();
+                lines += '\n';
+            }
+            for (UUID id : m_Scene.GetDestroyedEntities()) {
+                lines += json{ { "Destroy", id } }.dump();
+                lines += '\n';
+            }
 
-                // Transform
-                if (e.contains("Transform")) {
-                    auto& tc = ent.GetComponent<TransformComponent>();
-                    const auto& t = e["Transform"];
-                    if (t.contains("Translation")) tc.Translation = JsonToVec3(t["Translation"]);
-                    if (t.contains("Rotation"))    tc.Rotation = JsonToVec3(t["Rotation"]);
-                    if (t.contains("Scale"))       tc.Scale = JsonToVec3(t["Scale"]);
+            {
+                std::ofstream out(deltaPath, std::ios::out | std::ios::app | std::ios::binary);
+                if (!out) {
+                    std::cerr << "[SceneSerializer] Failed to open for write: " << deltaPath << "\n";
+                    return false;
+                }
+                out.write(lines.data(), (std::streamsize)lines.size());
+                if (!out) {
+                    std::cerr << "[SceneSerializer] Write failed: " << deltaPath << "\n";
+                    return false;
                 }
+            }
 
-                // MeshRenderer
-                if (e.contains("MeshRenderer")) {
-                    const auto& mr = e["MeshRenderer"];
-                    std::string modelPath = mr.value("ModelPath", "");
-                    std::string shaderPath = mr.value("ShaderPath", "");
+            m_Scene.ClearTrackedChanges();
 
-                    if (!modelPath.empty() && !shaderPath.empty()) {
-                        AssetHandle sh = assets.LoadShader(shaderPath);
-                        AssetHandle mo = assets.LoadModel(modelPath, sh);
-                        ent.AddComponent<MeshRendererComponent>(mo);
-                    }
-                }
+            // the base is pretty-printed and the journal isn't: at a quarter of the base
+            // size the journal already rewrites a good part of the scene on every load
+            const uintmax_t journalSize = (fresh ? 0 : deltaSize) + lines.size();
+            if (journalSize > m_BaseSize / 4)
+                return Serialize(filepath);
+
+            return true;
+        }
+        catch (const std::exception& ex) {
+            std::cerr << "[SceneSerializer] SerializeDelta exception: " << ex.what() << "\n";
+            return false;
+        }
+    }
 
-                // DirectionalLight
-                if (e.contains("DirectionalLight")) {
-                    const auto& dl = e["DirectionalLight"];
-                    glm::vec3 col = dl.contains("Color") ? JsonToVec3(dl["Color"]) : glm::vec3(1.0f);
+    bool SceneSerializer::Deserialize(const std::string& filepath) {
+        MemoryScope memScope(MemoryTag::Scene);
+        m_BasePath.clear();
 
-                    // Direction will be derived from Transform rotation at runtime,
-                    // but keep a reasonable default for the component field:
-                    glm::vec3 dir = glm::vec3(0.4f, 0.8f, -0.3f);
+        if (IsBinaryScenePath(filepath)) {
+            if (!DeserializeBinary(filepath))
+                return false;
+            m_Scene.ClearTrackedChanges();
+            return true;
+        }
 
-                    ent.AddComponent<DirectionalLightComponent>(dir, col);
-                }
+        try {
+            SceneColumns cols;
+            uint64_t revision = 0;
+            if (!LoadJsonSceneColumns(filepath, cols, &revision))
+                return false;
 
-                // Spawn
-                if (e.contains("SpawnPoint") && e["SpawnPoint"].get<bool>()) {
-                    ent.AddComponent<SpawnPointComponent>();
-                }
+            {
+                ChangeTrackingPause pause(m_Scene);
 
-                if (e.contains("SceneWarp")) {
-                    auto& sw = ent.AddComponent<SceneWarpComponent>();
-                    const auto& j = e["SceneWarp"];
-                    sw.TargetScene = j.value("TargetScene", "");
-                    sw.TargetSpawnTag = j.value("TargetSpawnTag", "");
-                    sw.TargetWarpTag = j.value("TargetWarpTag", "");
+                // Clear scene registry
+                m_Scene.Clear();
 
-                    sw.TriggerRadius = j.value("TriggerRadius", 1.0f); // NEW
-                    
-                }
+                InstantiateSceneColumns(m_Scene, std::move(cols));
             }
+            m_Scene.ClearTrackedChanges();
+            SetBaseFile(filepath, revision);
 
+            // one registry write for the whole scene instead of one per mesh
+            AssetManager::Get().FlushRegistry();
             return true;
         }
         catch (const std::exception& ex) {
@@ -197,4 +782,4 @@ namespace Engine {
         }
     }
 
-} // namespace Engine
\ No newline at end of file
+} // namespace Engine
@@ -0,0 +1,671 @@
+#include "pch.h"
+#include "Engine/Scene/SceneSerializer.h"
+
+#include "Engine/Scene/Scene.h"
+#include "Engine/Scene/Components.h"
+
+#include "Engine/Assets/AssetManager.h"
+#include "Engine/Core/MappedFile.h"
+
+#include "SceneEntityRecord.h"
+#include "SceneBinaryFormat.h"
+
+#include <nlohmann/json.hpp>
+#include <fstream>
+#include <filesystem>
+#include <iostream>
+#include <vector>
+#include <unordered_map>
+#include <string_view>
+#include <cstring>
+#include <type_traits>
+#include <algorithm>
+
+// .sceneb layout (little endian, every chunk 16-byte aligned)
+//
+//   FileHeader
+//   ChunkDesc[ChunkCount]
+//   chunks...
+//
+//   STRS  uint32 Count, uint32 Offsets[Count + 1], char Bytes[]      (not NUL terminated)
+//   ASET  uint32 Count, uint32 pad, AssetRefEntry[Count]              (indices into STRS)
+//   IDS_  UUID[EntityCount]                                           (dense)
+//   TAG_  uint32[EntityCount]                                         (dense, STRS index)
+//   XFRM  TransformComponent[EntityCount]                             (dense, 9 floats)
+//   MESH  sparse: uint32 AssetRef
+//   DLIT  sparse: PackedLight
+//   SPWN  sparse: rows only
+//   WARP  sparse: PackedWarp
+//
+// Sparse chunks: uint32 Count, uint32 pad, uint32 Rows[Count], pad to 8, Data[Count].
+// Unknown chunks are skipped so older builds can still read newer files.
+
+namespace Engine {
+
+    namespace {
+
+        constexpr uint32_t FourCC(const char (&s)[5]) {
+            return (uint32_t)s[0] | ((uint32_t)s[1] << 8) | ((uint32_t)s[2] << 16) | ((uint32_t)s[3] << 24);
+        }
+
+        constexpr char     kMagic[4] = { 'E', '3', 'S', 'B' };
+        constexpr uint32_t kVersion = 1;
+
+        constexpr uint32_t Chunk_Strings    = FourCC("STRS");
+        constexpr uint32_t Chunk_AssetRefs  = FourCC("ASET");
+        constexpr uint32_t Chunk_IDs        = FourCC("IDS_");
+        constexpr uint32_t Chunk_Tags       = FourCC("TAG_");
+        constexpr uint32_t Chunk_Transforms = FourCC("XFRM");
+        constexpr uint32_t Chunk_Mesh       = FourCC("MESH");
+        constexpr uint32_t Chunk_Light      = FourCC("DLIT");
+        constexpr uint32_t Chunk_Spawn      = FourCC("SPWN");
+        constexpr uint32_t Chunk_Warp       = FourCC("WARP");
+
+        struct FileHeader {
+            char Magic[4];
+            uint32_t Version;
+            uint32_t EntityCount;
+            uint32_t ChunkCount;
+            uint64_t Reserved[2];
+        };
+
+        struct ChunkDesc {
+            uint32_t Tag;
+            uint32_t Reserved;
+            uint64_t Offset;   // from start of file
+            uint64_t Size;
+        };
+
+        struct AssetRefEntry {
+            uint32_t ModelPath;
+            uint32_t ShaderPath;
+        };
+
+        using SceneBinary::PackedLight;
+        using SceneBinary::PackedWarp;
+
+        static_assert(sizeof(FileHeader) == 32, "FileHeader layout changed");
+        static_assert(sizeof(ChunkDesc) == 24, "ChunkDesc layout changed");
+
+        constexpr size_t AlignUp(size_t v, size_t a) { return (v + a - 1) & ~(a - 1); }
+
+        // ------------------------------------------------------------------
+        // Writer
+        // ------------------------------------------------------------------
+        class BinarySceneWriter {
+        public:
+            uint32_t AddString(const std::string& s) {
+                if (auto it = m_StringIndex.find(s); it != m_StringIndex.end())
+                    return it->second;
+                uint32_t idx = (uint32_t)m_Strings.size();
+                m_Strings.push_back(s);
+                m_StringIndex.emplace(s, idx);
+                return idx;
+            }
+
+            uint32_t AddAssetRef(const std::string& modelPath, const std::string& shaderPath) {
+                AssetRefEntry ref{ AddString(modelPath), AddString(shaderPath) };
+                uint64_t key = ((uint64_t)ref.ModelPath << 32) | ref.ShaderPath;
+                if (auto it = m_AssetRefIndex.find(key); it != m_AssetRefIndex.end())
+                    return it->second;
+                uint32_t idx = (uint32_t)m_AssetRefs.size();
+                m_AssetRefs.push_back(ref);
+                m_AssetRefIndex.emplace(key, idx);
+                return idx;
+            }
+
+            void AddRecord(const SceneEntityRecord& rec) {
+                uint32_t row = (uint32_t)m_IDs.size();
+
+                m_IDs.push_back(rec.ID);
+                m_Tags.push_back(AddString(rec.Tag));
+                m_Transforms.push_back(rec.Transform);
+
+                if (rec.HasMeshRenderer) {
+                    m_MeshRows.push_back(row);
+                    m_MeshRefs.push_back(AddAssetRef(rec.ModelPath, rec.ShaderPath));
+                }
+                if (rec.HasDirectionalLight) {
+                    m_LightRows.push_back(row);
+                    m_Lights.push_back({ { rec.LightColor.x, rec.LightColor.y, rec.LightColor.z } });
+                }
+                if (rec.IsSpawnPoint) {
+                    m_SpawnRows.push_back(row);
+                }
+                if (rec.HasSceneWarp) {
+                    m_WarpRows.push_back(row);
+                    m_Warps.push_back({
+                        AddString(rec.Warp.TargetScene),
+                        AddString(rec.Warp.TargetSpawnTag),
+                        AddString(rec.Warp.TargetWarpTag),
+                        rec.Warp.TriggerRadius });
+                }
+            }
+
+            bool WriteFile(const std::string& filepath) {
+                std::vector<Chunk> chunks;
+                chunks.push_back(BuildStrings());
+                chunks.push_back(BuildAssetRefs());
+                chunks.push_back(Dense(Chunk_IDs, m_IDs));
+                chunks.push_back(Dense(Chunk_Tags, m_Tags));
+                chunks.push_back(Dense(Chunk_Transforms, m_Transforms));
+                chunks.push_back(Sparse(Chunk_Mesh, m_MeshRows, m_MeshRefs));
+                chunks.push_back(Sparse(Chunk_Light, m_LightRows, m_Lights));
+                chunks.push_back(Sparse(Chunk_Spawn, m_SpawnRows, std::vector<uint8_t>{}));
+                chunks.push_back(Sparse(Chunk_Warp, m_WarpRows, m_Warps));
+
+                FileHeader header{};
+                std::memcpy(header.Magic, kMagic, sizeof(kMagic));
+                header.Version = kVersion;
+                header.EntityCount = (uint32_t)m_IDs.size();
+                header.ChunkCount = (uint32_t)chunks.size();
+
+                std::vector<ChunkDesc> descs(chunks.size());
+                size_t offset = AlignUp(sizeof(FileHeader) + sizeof(ChunkDesc) * chunks.size(), 16);
+                for (size_t i = 0; i < chunks.size(); i++) {
+                    descs[i] = { chunks[i].Tag, 0, (uint64_t)offset, (uint64_t)chunks[i].Bytes.size() };
+                    offset = AlignUp(offset + chunks[i].Bytes.size(), 16);
+                }
+
+                std::filesystem::path p(filepath);
+                if (p.has_parent_path())
+                    std::filesystem::create_directories(p.parent_path());
+
+                const std::string tmpPath = filepath + ".tmp";
+                {
+                    std::ofstream out(tmpPath, std::ios::out | std::ios::trunc | std::ios::binary);
+                    if (!out) {
+                        std::cerr << "[SceneSerializer] Failed to open for write: " << tmpPath << "\n";
+                        return false;
+                    }
+
+                    size_t written = 0;
+                    auto put = [&](const void* data, size_t size) {
+                        out.write(static_cast<const char*>(data), (std::streamsize)size);
+                        written += size;
+                        };
+                    auto padTo = [&](size_t target) {
+                        static const char zeros[16] = {};
+                        while (written < target) put(zeros, std::min<size_t>(16, target - written));
+                        };
+
+                    put(&header, sizeof(header));
+                    put(descs.data(), sizeof(ChunkDesc) * descs.size());
+
+                    for (size_t i = 0; i < chunks.size(); i++) {
+                        padTo((size_t)descs[i].Offset);
+                        put(chunks[i].Bytes.data(), chunks[i].Bytes.size());
+                    }
+
+                    if (!out) {
+                        std::cerr << "[SceneSerializer] Write failed: " << tmpPath << "\n";
+                        return false;
+                    }
+                }
+
+                std::error_code ec;
+                std::filesystem::rename(tmpPath, filepath, ec);
+                if (ec) {
+                    std::cerr << "[SceneSerializer] Rename failed: " << tmpPath << " (" << ec.message() << ")\n";
+                    return false;
+                }
+                return true;
+            }
+
+        private:
+            struct Chunk {
+                uint32_t Tag;
+                std::vector<uint8_t> Bytes;
+            };
+
+            template<typename T>
+            static void Append(std::vector<uint8_t>& bytes, const T* data, size_t count) {
+                static_assert(std::is_trivially_copyable_v<T>);
+                if (count == 0) return;
+                size_t at = bytes.size();
+                bytes.resize(at + sizeof(T) * count);
+                std::memcpy(bytes.data() + at, data, sizeof(T) * count);
+            }
+
+            template<typename T>
+            static Chunk Dense(uint32_t tag, const std::vector<T>& column) {
+                Chunk c{ tag, {} };
+                Append(c.Bytes, column.data(), column.size());
+                return c;
+            }
+
+            template<typename T>
+            static Chunk Sparse(uint32_t tag, const std::vector<uint32_t>& rows, const std::vector<T>& data) {
+                Chunk c{ tag, {} };
+                uint32_t head[2] = { (uint32_t)rows.size(), 0 };
+                Append(c.Bytes, head, 2);
+                Append(c.Bytes, rows.data(), rows.size());
+                c.Bytes.resize(AlignUp(c.Bytes.size(), 8), 0);
+                Append(c.Bytes, data.data(), data.size());
+                return c;
+            }
+
+            Chunk BuildStrings() const {
+                Chunk c{ Chunk_Strings, {} };
+                std::vector<uint32_t> offsets;
+                offsets.reserve(m_Strings.size() + 1);
+
+                uint32_t at = 0;
+                for (const auto& s : m_Strings) {
+                    offsets.push_back(at);
+                    at += (uint32_t)s.size();
+                }
+                offsets.push_back(at);
+
+                uint32_t count = (uint32_t)m_Strings.size();
+                Append(c.Bytes, &count, 1);
+                Append(c.Bytes, offsets.data(), offsets.size());
+                for (const auto& s : m_Strings)
+                    Append(c.Bytes, s.data(), s.size());
+                return c;
+            }
+
+            Chunk BuildAssetRefs() const {
+                Chunk c{ Chunk_AssetRefs, {} };
+                uint32_t head[2] = { (uint32_t)m_AssetRefs.size(), 0 };
+                Append(c.Bytes, head, 2);
+                Append(c.Bytes, m_AssetRefs.data(), m_AssetRefs.size());
+                return c;
+            }
+
+        private:
+            std::vector<std::string> m_Strings;
+            std::unordered_map<std::string, uint32_t> m_StringIndex;
+
+            std::vector<AssetRefEntry> m_AssetRefs;
+            std::unordered_map<uint64_t, uint32_t> m_AssetRefIndex;
+
+            std::vector<UUID> m_IDs;
+            std::vector<uint32_t> m_Tags;
+            std::vector<TransformComponent> m_Transforms;
+
+            std::vector<uint32_t> m_MeshRows, m_MeshRefs;
+            std::vector<uint32_t> m_LightRows;
+            std::vector<PackedLight> m_Lights;
+            std::vector<uint32_t> m_SpawnRows;
+            std::vector<uint32_t> m_WarpRows;
+            std::vector<PackedWarp> m_Warps;
+        };
+
+        // ------------------------------------------------------------------
+        // Reader: validates the mapping once, then hands out typed pointers into it
+        // ------------------------------------------------------------------
+        struct SparseColumn {
+            uint32_t Count = 0;
+            const uint32_t* Rows = nullptr;
+            const uint8_t* Data = nullptr;
+
+            template<typename T>
+            const T* As() const { return reinterpret_cast<const T*>(Data); }
+        };
+
+        struct BinarySceneView {
+            uint32_t EntityCount = 0;
+
+            uint32_t StringCount = 0;
+            const uint32_t* StringOffsets = nullptr;
+            const char* StringBytes = nullptr;
+
+            uint32_t AssetRefCount = 0;
+            const AssetRefEntry* AssetRefs = nullptr;
+
+            const IDComponent* IDs = nullptr;
+            const uint32_t* Tags = nullptr;
+            const TransformComponent* Transforms = nullptr;
+
+            SparseColumn Mesh, Light, Spawn, Warp;
+
+            std::string_view String(uint32_t i) const {
+                return std::string_view(StringBytes + StringOffsets[i], StringOffsets[i + 1] - StringOffsets[i]);
+            }
+        };
+
+        static bool ParseSparse(const uint8_t* chunk, uint64_t size, size_t elemSize, uint32_t entityCount,
+            SparseColumn& out) {
+            if (size < 8) return false;
+            uint32_t count;
+            std::memcpy(&count, chunk, 4);
+
+            size_t rowsEnd = 8 + (size_t)count * 4;
+            size_t dataStart = AlignUp(rowsEnd, 8);
+            if (rowsEnd > size || (elemSize > 0 && dataStart + elemSize * count > size)) return false;
+
+            out.Count = count;
+            out.Rows = reinterpret_cast<const uint32_t*>(chunk + 8);
+            out.Data = chunk + dataStart;
+
+            for (uint32_t i = 0; i < count; i++)
+                if (out.Rows[i] >= entityCount) return false;
+            return true;
+        }
+
+        static bool ParseBinaryScene(const uint8_t* data, size_t size, BinarySceneView& v, std::string& err) {
+            if (size < sizeof(FileHeader)) { err = "file too small"; return false; }
+
+            const FileHeader* header = reinterpret_cast<const FileHeader*>(data);
+            if (std::memcmp(header->Magic, kMagic, sizeof(kMagic)) != 0) { err = "bad magic"; return false; }
+            if (header->Version != kVersion) { err = "unsupported version " + std::to_string(header->Version); return false; }
+
+            size_t descEnd = sizeof(FileHeader) + (size_t)header->ChunkCount * sizeof(ChunkDesc);
+            if (descEnd > size) { err = "truncated chunk table"; return false; }
+
+            const uint32_t n = header->EntityCount;
+            v.EntityCount = n;
+
+            const ChunkDesc* descs = reinterpret_cast<const ChunkDesc*>(data + sizeof(FileHeader));
+            for (uint32_t i = 0; i < header->ChunkCount; i++) {
+                const ChunkDesc& d = descs[i];
+                if (d.Offset % 16 != 0 || d.Offset > size || d.Size > size - d.Offset) {
+                    err = "chunk out of bounds";
+                    return false;
+                }
+
+                const uint8_t* chunk = data + d.Offset;
+
+                switch (d.Tag) {
+                case Chunk_Strings: {
+                    if (d.Size < 4) { err = "bad string table"; return false; }
+                    std::memcpy(&v.StringCount, chunk, 4);
+                    size_t offsetsEnd = 4 + ((size_t)v.StringCount + 1) * 4;
+                    if (offsetsEnd > d.Size) { err = "bad string table"; return false; }
+
+                    v.StringOffsets = reinterpret_cast<const uint32_t*>(chunk + 4);
+                    v.StringBytes = reinterpret_cast<const char*>(chunk + offsetsEnd);
+
+                    size_t bytesSize = (size_t)d.Size - offsetsEnd;
+                    for (uint32_t s = 0; s < v.StringCount; s++) {
+                        if (v.StringOffsets[s] > v.StringOffsets[s + 1] || v.StringOffsets[s + 1] > bytesSize) {
+                            err = "bad string offsets";
+                            return false;
+                        }
+                    }
+                    break;
+                }
+                case Chunk_AssetRefs: {
+                    if (d.Size < 8) { err = "bad asset table"; return false; }
+                    std::memcpy(&v.AssetRefCount, chunk, 4);
+                    if (8 + (size_t)v.AssetRefCount * sizeof(AssetRefEntry) > d.Size) { err = "bad asset table"; return false; }
+                    v.AssetRefs = reinterpret_cast<const AssetRefEntry*>(chunk + 8);
+                    break;
+                }
+                case Chunk_IDs:
+                    if (d.Size < (size_t)n * sizeof(IDComponent)) { err = "short ID column"; return false; }
+                    v.IDs = reinterpret_cast<const IDComponent*>(chunk);
+                    break;
+                case Chunk_Tags:
+                    if (d.Size < (size_t)n * sizeof(uint32_t)) { err = "short Tag column"; return false; }
+                    v.Tags = reinterpret_cast<const uint32_t*>(chunk);
+                    break;
+                case Chunk_Transforms:
+                    if (d.Size < (size_t)n * sizeof(TransformComponent)) { err = "short Transform column"; return false; }
+                    v.Transforms = reinterpret_cast<const TransformComponent*>(chunk);
+                    break;
+                case Chunk_Mesh:
+                    if (!ParseSparse(chunk, d.Size, sizeof(uint32_t), n, v.Mesh)) { err = "bad MeshRenderer column"; return false; }
+                    break;
+                case Chunk_Light:
+                    if (!ParseSparse(chunk, d.Size, sizeof(PackedLight), n, v.Light)) { err = "bad DirectionalLight column"; return false; }
+                    break;
+                case Chunk_Spawn:
+                    if (!ParseSparse(chunk, d.Size, 0, n, v.Spawn)) { err = "bad SpawnPoint column"; return false; }
+                    break;
+                case Chunk_Warp:
+                    if (!ParseSparse(chunk, d.Size, sizeof(PackedWarp), n, v.Warp)) { err = "bad SceneWarp column"; return false; }
+                    break;
+                default:
+                    break; // unknown chunk: skip
+                }
+            }
+
+            if (n > 0 && (!v.IDs || !v.Tags || !v.Transforms)) { err = "missing required column"; return false; }
+
+            // Cross-references into the string / asset tables
+            auto badString = [&](uint32_t s) { return !v.StringOffsets || s >= v.StringCount; };
+
+            for (uint32_t i = 0; i < n; i++)
+                if (badString(v.Tags[i])) { err = "tag string out of range"; return false; }
+
+            for (uint32_t i = 0; i < v.AssetRefCount; i++)
+                if (badString(v.AssetRefs[i].ModelPath) || badString(v.AssetRefs[i].ShaderPath)) { err = "asset path out of range"; return false; }
+
+            const uint32_t* meshRefs = v.Mesh.As<uint32_t>();
+            for (uint32_t i = 0; i < v.Mesh.Count; i++)
+                if (meshRefs[i] >= v.AssetRefCount) { err = "asset ref out of range"; return false; }
+
+            const PackedWarp* warps = v.Warp.As<PackedWarp>();
+            for (uint32_t i = 0; i < v.Warp.Count; i++)
+                if (badString(warps[i].TargetScene) || badString(warps[i].TargetSpawnTag) || badString(warps[i].TargetWarpTag)) {
+                    err = "warp string out of range";
+                    return false;
+                }
+
+            return true;
+        }
+
+        static std::vector<SceneEntityRecord> ReadRecords(const BinarySceneView& v) {
+            std::vector<SceneEntityRecord> recs(v.EntityCount);
+
+            for (uint32_t i = 0; i < v.EntityCount; i++) {
+                recs[i].ID = v.IDs[i].ID;
+                recs[i].Tag = std::string(v.String(v.Tags[i]));
+                recs[i].Transform = v.Transforms[i];
+            }
+
+            const uint32_t* meshRefs = v.Mesh.As<uint32_t>();
+            for (uint32_t i = 0; i < v.Mesh.Count; i++) {
+                auto& rec = recs[v.Mesh.Rows[i]];
+                const AssetRefEntry& ref = v.AssetRefs[meshRefs[i]];
+                rec.HasMeshRenderer = true;
+                rec.ModelPath = std::string(v.String(ref.ModelPath));
+                rec.ShaderPath = std::string(v.String(ref.ShaderPath));
+            }
+
+            const PackedLight* lights = v.Light.As<PackedLight>();
+            for (uint32_t i = 0; i < v.Light.Count; i++) {
+                auto& rec = recs[v.Light.Rows[i]];
+                rec.HasDirectionalLight = true;
+                rec.LightColor = { lights[i].Color[0], lights[i].Color[1], lights[i].Color[2] };
+            }
+
+            for (uint32_t i = 0; i < v.Spawn.Count; i++)
+                recs[v.Spawn.Rows[i]].IsSpawnPoint = true;
+
+            const PackedWarp* warps = v.Warp.As<PackedWarp>();
+            for (uint32_t i = 0; i < v.Warp.Count; i++) {
+                auto& rec = recs[v.Warp.Rows[i]];
+                rec.HasSceneWarp = true;
+                rec.Warp.TargetScene = std::string(v.String(warps[i].TargetScene));
+                rec.Warp.TargetSpawnTag = std::string(v.String(warps[i].TargetSpawnTag));
+                rec.Warp.TargetWarpTag = std::string(v.String(warps[i].TargetWarpTag));
+                rec.Warp.TriggerRadius = warps[i].TriggerRadius;
+            }
+
+            return recs;
+        }
+
+    } // namespace
+
+    bool SceneSerializer::SerializeBinary(const std::string& filepath) {
+        try {
+            BinarySceneWriter writer;
+
+            auto& reg = m_Scene.Registry();
+            auto view = reg.view<IDComponent>();
+            view.each([&](auto entity, IDComponent& /*idc*/) {
+                writer.AddRecord(CaptureEntityRecord(reg, entity));
+                });
+
+            return writer.WriteFile(filepath);
+        }
+        catch (const std::exception& ex) {
+            std::cerr << "[SceneSerializer] SerializeBinary exception: " << ex.what() << "\n";
+            return false;
+        }
+    }
+
+    bool SceneSerializer::DeserializeBinary(const std::string& filepath) {
+        try {
+            MappedFile file;
+            if (!file.Open(filepath)) {
+                std::cerr << "[SceneSerializer] Failed to open for read: " << filepath << "\n";
+                return false;
+            }
+
+            BinarySceneView v;
+            std::string err;
+            if (!ParseBinaryScene(file.Data(), file.Size(), v, err)) {
+                std::cerr << "[SceneSerializer] Invalid binary scene " << filepath << ": " << err << "\n";
+                return false;
+            }
+
+            ChangeTrackingPause pause(m_Scene);
+            m_Scene.Clear();
+
+            auto& reg = m_Scene.Registry();
+            auto& assets = AssetManager::Get();
+
+            // One bulk create + one insert per dense column, straight from the mapping
+            std::vector<entt::entity> entities(v.EntityCount);
+            reg.create(entities.begin(), entities.end());
+
+            reg.insert<IDComponent>(entities.begin(), entities.end(), v.IDs);
+            reg.insert<TransformComponent>(entities.begin(), entities.end(), v.Transforms);
+
+            {
+                std::vector<TagComponent> tags;
+                tags.reserve(v.EntityCount);
+                for (uint32_t i = 0; i < v.EntityCount; i++)
+                    tags.emplace_back(std::string(v.String(v.Tags[i])));
+                reg.insert<TagComponent>(entities.begin(), entities.end(), std::make_move_iterator(tags.begin()));
+            }
+
+            std::vector<entt::entity> rows;
+            auto gatherRows = [&](const SparseColumn& col) {
+                rows.resize(col.Count);
+                for (uint32_t i = 0; i < col.Count; i++)
+                    rows[i] = entities[col.Rows[i]];
+                };
+
+            // Assets: each unique (model, shader) pair is loaded once, imports run in parallel
+            if (v.Mesh.Count > 0) {
+                std::vector<AssetManager::ModelLoadRequest> requests(v.AssetRefCount);
+                for (uint32_t i = 0; i < v.AssetRefCount; i++) {
+                    requests[i].ModelPath = std::string(v.String(v.AssetRefs[i].ModelPath));
+                    requests[i].ShaderPath = std::string(v.String(v.AssetRefs[i].ShaderPath));
+                }
+                const auto refHandles = assets.LoadModels(requests);
+
+                const uint32_t* refs = v.Mesh.As<uint32_t>();
+                std::vector<MeshRendererComponent> meshes;
+                meshes.reserve(v.Mesh.Count);
+                for (uint32_t i = 0; i < v.Mesh.Count; i++)
+                    meshes.emplace_back(refHandles[refs[i]]);
+
+                gatherRows(v.Mesh);
+                reg.insert<MeshRendererComponent>(rows.begin(), rows.end(), meshes.begin());
+            }
+
+            if (v.Light.Count > 0) {
+                const PackedLight* src = v.Light.As<PackedLight>();
+                std::vector<DirectionalLightComponent> lights;
+                lights.reserve(v.Light.Count);
+                for (uint32_t i = 0; i < v.Light.Count; i++)
+                    lights.emplace_back(glm::vec3(0.4f, 0.8f, -0.3f), glm::vec3(src[i].Color[0], src[i].Color[1], src[i].Color[2]));
+
+                gatherRows(v.Light);
+                reg.insert<DirectionalLightComponent>(rows.begin(), rows.end(), lights.begin());
+            }
+
+            if (v.Spawn.Count > 0) {
+                gatherRows(v.Spawn);
+                reg.insert<SpawnPointComponent>(rows.begin(), rows.end());
+            }
+
+            if (v.Warp.Count > 0) {
+                const PackedWarp* src = v.Warp.As<PackedWarp>();
+                std::vector<SceneWarpComponent> warps(v.Warp.Count);
+                for (uint32_t i = 0; i < v.Warp.Count; i++) {
+                    warps[i].TargetScene = std::string(v.String(src[i].TargetScene));
+                    warps[i].TargetSpawnTag = std::string(v.String(src[i].TargetSpawnTag));
+                    warps[i].TargetWarpTag = std::string(v.String(src[i].TargetWarpTag));
+                    warps[i].TriggerRadius = src[i].TriggerRadius;
+                }
+
+                gatherRows(v.Warp);
+                reg.insert<SceneWarpComponent>(rows.begin(), rows.end(), std::make_move_iterator(warps.begin()));
+            }
+
+            assets.FlushRegistry();
+            return true;
+        }
+        catch (const std::exception& ex) {
+            std::cerr << "[SceneSerializer] DeserializeBinary exception: " << ex.what() << "\n";
+            return false;
+        }
+    }
+
+    bool SceneSerializer::ConvertJsonToBinary(const std::string& jsonPath, const std::string& binaryPath) {
+        try {
+            // base file + pending journal, so the binary matches what the editor shows
+            std::vector<SceneEntityRecord> records;
+            if (!LoadJsonSceneRecords(jsonPath, records))
+                return false;
+
+            BinarySceneWriter writer;
+            for (const auto& rec : records)
+                writer.AddRecord(rec);
+
+            return writer.WriteFile(binaryPath);
+        }
+        catch (const std::exception& ex) {
+            std::cerr << "[SceneSerializer] ConvertJsonToBinary exception: " << ex.what() << "\n";
+            return false;
+        }
+    }
+
+    bool SceneSerializer::ConvertBinaryToJson(const std::string& binaryPath, const std::string& jsonPath) {
+        try {
+            MappedFile file;
+            if (!file.Open(binaryPath)) {
+                std::cerr << "[SceneSerializer] Failed to open for read: " << binaryPath << "\n";
+                return false;
+            }
+
+            BinarySceneView v;
+            std::string err;
+            if (!ParseBinaryScene(file.Data(), file.Size(), v, err)) {
+                std::cerr << "[SceneSerializer] Invalid binary scene " << binaryPath << ": " << err << "\n";
+                return false;
+            }
+
+            nlohmann::json root;
+            root["Scene"] = "Untitled";
+            root["Entities"] = nlohmann::json::array();
+            for (const auto& rec : ReadRecords(v))
+                root["Entities"].push_back(EntityRecordToJson(rec));
+
+            std::filesystem::path p(jsonPath);
+            if (p.has_parent_path())
+                std::filesystem::create_directories(p.parent_path());
+
+            std::ofstream out(jsonPath, std::ios::out | std::ios::trunc);
+            if (!out) {
+                std::cerr << "[SceneSerializer] Failed to open for write: " << jsonPath << "\n";
+                return false;
+            }
+
+            out << root.dump(2);
+            return true;
+        }
+        catch (const std::exception& ex) {
+            std::cerr << "[SceneSerializer] ConvertBinaryToJson exception: " << ex.what() << "\n";
+            return false;
+        }
+    }
+
+} // namespace Engine
@@ -1,3 +1,5 @@
+#pragma keywords HAS_TEXTURE0
+
 #type vertex
 #version 330 core
 
@@ -20,14 +22,21 @@ void main()
 
 in vec2 v_TexCoord;
 
+#ifdef HAS_TEXTURE0
 uniform sampler2D u_Texture0;
-uniform int u_UseTexture;
-uniform vec4 u_Color;
+#endif
+layout(std140) uniform MaterialBlock {
+    vec4 u_Color;
+};
 
 out vec4 o_Color;
 
 void main()
 {
-    vec4 tex = (u_UseTexture != 0) ? texture(u_Texture0, v_TexCoord) : vec4(1.0);
+#ifdef HAS_TEXTURE0
+    vec4 tex = texture(u_Texture0, v_TexCoord);
+#else
+    vec4 tex = vec4(1.0);
+#endif
     o_Color = tex * u_Color;
 }
\ No newline at end of file
@@ -13,7 +13,9 @@ void main() {
 #type fragment
 #version 330 core
 
-uniform vec4 u_Color;
+layout(std140) uniform MaterialBlock {
+    vec4 u_Color;
+};
 out vec4 FragColor;
 
 void main() {
@@ -2,6 +2,9 @@
 
 #include <Engine/Renderer/Renderer.h>
 #include <Engine/Renderer/RendererPipeline.h>
+#include <Engine/Renderer/RenderThread.h>
+#include <Engine/Renderer/RenderCommand.h>
+#include <Engine/Renderer/FramePacket.h>
 #include <Engine/Renderer/CameraController.h>
 #include <Engine/Renderer/Model.h>
 
@@ -10,6 +13,17 @@
 #include <Engine/Scene/SceneSerializer.h>
 
 #include <Engine/Assets/AssetManager.h>
+#include <Engine/Core/JobSystem.h>
+#include <Engine/Core/FrameScheduler.h>
+#include <Engine/Core/FrameTimings.h>
+#include <Engine/Core/Input.h>
+#include <Engine/Core/InputRecording.h>
+#include <Engine/Core/MemoryTracker.h>
+#include <Engine/Renderer/CameraPath.h>
+#include <Engine/Renderer/ShaderCache.h>
+#include <Engine/Renderer/ShaderLibrary.h>
+#include <Engine/Physics/CollisionWorld.h>
+#include <Engine/Physics/TriggerSystem.h>
 #include <Engine/Project/ProjectSettings.h>
 
 #include <Engine/Events/Event.h>
@@ -23,9 +37,15 @@
 
 #include <chrono>
 #include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <algorithm>
+#include <mutex>
+#include <thread>
 #include <array>
 #include <cmath>
+#include <cstring>
+#include <string>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
@@ -145,96 +165,6 @@ static glm::mat4 BuildCascadeLightMatrix(
     return lightProj * lightView;
 }
 
-static glm::vec3 ResolveCameraSphereVsScene(
-    Engine::Scene& scene,
-    const glm::vec3& desiredPos,
-    float camRadius)
-{
-    auto& assets = Engine::AssetManager::Get();
-    glm::vec3 pWS = desiredPos;
-
-    const float skin = 0.002f; // tiny gap to prevent jitter
-
-    for (int iter = 0; iter < 4; iter++) {
-        bool anyHit = false;
-
-        auto view = scene.Registry().view<Engine::TransformComponent, Engine::MeshRendererComponent>();
-        view.each([&](auto, Engine::TransformComponent& tc, Engine::MeshRendererComponent& mrc) {
-            if (mrc.Model == Engine::InvalidAssetHandle) return;
-
-            auto model = assets.GetModel(mrc.Model);
-            if (!model) return;
-
-            glm::mat4 world = tc.GetTransform();
-            glm::mat4 invWorld = glm::inverse(world);
-
-            // camera in local space of this entity
-            glm::vec3 pLS = glm::vec3(invWorld * glm::vec4(pWS, 1.0f));
-
-            for (const auto& sm : model->GetSubMeshes()) {
-                if (!sm.MeshPtr) continue;
-
-                const auto& b = sm.MeshPtr->GetBounds();
-
-                // IMPORTANT: you need b.Min and b.Max to exist for this
-                const glm::vec3 bmin = b.Min;
-                const glm::vec3 bmax = b.Max;
-
-                // closest point on AABB to sphere center
-                glm::vec3 q = glm::clamp(pLS, bmin, bmax);
-                glm::vec3 v = pLS - q;
-                float d2 = glm::dot(v, v);
-
-                if (d2 >= camRadius * camRadius)
-                    continue;
-
-                // If outside box, push out along v
-                if (d2 > 1e-10f) {
-                    float d = std::sqrt(d2);
-                    glm::vec3 n = v / d;
-                    pLS = q + n * (camRadius + skin);
-                }
-                else {
-                    // Sphere center is INSIDE the box => push to nearest face
-                    float toMinX = pLS.x - bmin.x;
-                    float toMaxX = bmax.x - pLS.x;
-                    float toMinY = pLS.y - bmin.y;
-                    float toMaxY = bmax.y - pLS.y;
-                    float toMinZ = pLS.z - bmin.z;
-                    float toMaxZ = bmax.z - pLS.z;
-
-                    float m = toMinX;
-                    int axis = 0; // 0=x,1=y,2=z
-                    int dir = -1; // -1 = toward min face, +1 = toward max face
-
-                    auto check = [&](float dist, int ax, int ddir) {
-                        if (dist < m) { m = dist; axis = ax; dir = ddir; }
-                        };
-
-                    check(toMaxX, 0, +1);
-                    check(toMinY, 1, -1);
-                    check(toMaxY, 1, +1);
-                    check(toMinZ, 2, -1);
-                    check(toMaxZ, 2, +1);
-
-                    if (axis == 0) pLS.x = (dir < 0) ? (bmin.x - camRadius - skin) : (bmax.x + camRadius + skin);
-                    if (axis == 1) pLS.y = (dir < 0) ? (bmin.y - camRadius - skin) : (bmax.y + camRadius + skin);
-                    if (axis == 2) pLS.z = (dir < 0) ? (bmin.z - camRadius - skin) : (bmax.z + camRadius + skin);
-                }
-
-                // update world-space camera position after a push
-                pWS = glm::vec3(world * glm::vec4(pLS, 1.0f));
-                anyHit = true;
-            }
-            });
-
-        if (!anyHit)
-            break;
-    }
-
-    return pWS;
-}
-
 // Warp Helpers
 static bool ApplySpawn(Scene& scene, CameraController& cam, const std::string& preferredTag)
 {
@@ -242,14 +172,11 @@ static bool ApplySpawn(Scene& scene, CameraController& cam, const std::string& p
 
     // If tag is provided, try to find that entity tag
     if (!preferredTag.empty()) {
-        auto view = reg.view<TagComponent, TransformComponent, SpawnPointComponent>();
-        for (auto e : view) {
-            auto& tag = view.get<TagComponent>(e).Tag;
-            if (tag == preferredTag) {
-                auto& tc = view.get<TransformComponent>(e);
-                cam.SetTransform(tc.Translation, tc.Rotation.y, tc.Rotation.x);
-                return true;
-            }
+        for (auto e : scene.GetEntitiesWithTag(preferredTag)) {
+            if (!reg.all_of<TransformComponent, SpawnPointComponent>(e)) continue;
+            auto& tc = reg.get<TransformComponent>(e);
+            cam.SetTransform(tc.Translation, tc.Rotation.y, tc.Rotation.x);
+            return true;
         }
     }
 
@@ -282,15 +209,12 @@ static bool ApplyWarpDestination(Scene& scene, CameraController& cam,
     // 1) Try warp-to-warp
     if (!targetWarpTag.empty()) {
         auto& reg = scene.Registry();
-        auto view = reg.view<TagComponent, TransformComponent, SceneWarpComponent>();
 
-        for (auto e : view) {
-            const auto& tag = view.get<TagComponent>(e).Tag;
-            if (tag == targetWarpTag) {
-                const auto& tc = view.get<TransformComponent>(e);
-                cam.SetTransform(tc.Translation, tc.Rotation.y, tc.Rotation.x);
-                return true;
-            }
+        for (auto e : scene.GetEntitiesWithTag(targetWarpTag)) {
+            if (!reg.all_of<TransformComponent, SceneWarpComponent>(e)) continue;
+            const auto& tc = reg.get<TransformComponent>(e);
+            cam.SetTransform(tc.Translation, tc.Rotation.y, tc.Rotation.x);
+            return true;
         }
     }
 
@@ -299,36 +223,29 @@ static bool ApplyWarpDestination(Scene& scene, CameraController& cam,
 }
 
 
-static bool TryWarp(Scene& scene, CameraController& cam, float dt, std::string& currentScenePath)
+static bool TryWarp(Scene& scene, TriggerSystem& triggers, CameraController& cam, float dt, std::string& currentScenePath)
 {
-    static float cooldown = 0.0f;
-    if (cooldown > 0.0f) { cooldown -= dt; return false; } // block ALL warps during cooldown
-
-    auto& reg = scene.Registry();
-    auto view = reg.view<IDComponent, TransformComponent, SceneWarpComponent>();
-
-    glm::vec3 camPos = cam.GetPosition();
+    for (const auto& ev : triggers.Update(cam.GetPosition(), dt)) {
+        if (ev.Type != TriggerSystem::EventType::Enter) continue;
 
-    for (auto e : view) {
-        auto& tc = view.get<TransformComponent>(e);
-        auto& sw = view.get<SceneWarpComponent>(e);
+        const auto* warp = scene.Registry().try_get<SceneWarpComponent>(ev.Trigger);
+        if (!warp) continue;
 
-        float r = std::max(0.05f, sw.TriggerRadius);
-        glm::vec3 d = camPos - tc.Translation;
-        if (glm::dot(d, d) > r * r) continue;
+        // copy: a reload destroys the component
+        const SceneWarpComponent sw = *warp;
 
         // --- SAME SCENE warp (no reload) ---
         if (sw.TargetScene.empty() || sw.TargetScene == currentScenePath) {
             ApplyWarpDestination(scene, cam, sw.TargetWarpTag, sw.TargetSpawnTag);
-            cooldown = 0.75f;
+            triggers.ResetOccupancy(cam.GetPosition());
             return true;
         }
 
         // --- DIFFERENT SCENE warp (reload) ---
         SceneSerializer serializer(scene);
         if (!serializer.Deserialize(sw.TargetScene)) {
+            // still inside the warp, so it won't retry until the player steps out and back in
             std::cout << "[Warp] Failed to load target scene: " << sw.TargetScene << "\n";
-            cooldown = 0.5f;
             return true;
         }
 
@@ -336,8 +253,8 @@ static bool TryWarp(Scene& scene, CameraController& cam, float dt, std::string&
 
         // Go to target warp tag if possible, else fallback to spawnpoint
         ApplyWarpDestination(scene, cam, sw.TargetWarpTag, sw.TargetSpawnTag);
+        triggers.ResetOccupancy(cam.GetPosition());
 
-        cooldown = 0.75f;
         std::cout << "[Warp] Loaded: " << sw.TargetScene << "\n";
         return true;
     }
@@ -345,8 +262,119 @@ static bool TryWarp(Scene& scene, CameraController& cam, float dt, std::string&
     return false;
 }
 
-int main() {
-    auto window = Window::Create({ "Engine3D - Sandbox", 1280, 720 });
+// Perf-run samples, appended in FrameIndex order. Flat reserved vectors rather than
+// maps so recording them doesn't show up in the per-frame allocation count.
+using FrameTimeList = std::vector<std::pair<uint64_t, float>>;
+using PassTimingList = std::vector<RendererPipeline::PassTimings>;
+
+static const float* FindFrameTime(const FrameTimeList& frames, uint64_t frame) {
+    auto it = std::lower_bound(frames.begin(), frames.end(), frame,
+        [](const std::pair<uint64_t, float>& f, uint64_t index) { return f.first < index; });
+    return it != frames.end() && it->first == frame ? &it->second : nullptr;
+}
+
+static const RendererPipeline::PassTimings* FindPassTimings(const PassTimingList& passes, uint64_t frame) {
+    auto it = std::lower_bound(passes.begin(), passes.end(), frame,
+        [](const RendererPipeline::PassTimings& pt, uint64_t index) { return pt.FrameIndex < index; });
+    return it != passes.end() && it->FrameIndex == frame ? &*it : nullptr;
+}
+
+// Per-frame CSV for diffing two builds on the same replay / flythrough:
+// frame, frame_ms, then cpu/gpu ms per render pass (empty where not resolved)
+static void WriteFrameCsv(const std::string& path, const FrameTimeList& frameMs, const PassTimingList& passes)
+{
+    std::ofstream out(path, std::ios::out | std::ios::trunc);
+    if (!out) {
+        std::cout << "[Sandbox] Can't write " << path << "\n";
+        return;
+    }
+
+    out << "frame,frame_ms";
+    for (uint32_t p = 0; p < RendererPipeline::PassCount; p++) {
+        const char* name = RendererPipeline::GetPassName((RendererPipeline::Pass)p);
+        out << "," << name << "_cpu_ms," << name << "_gpu_ms";
+    }
+    out << "\n";
+
+    for (const auto& [frame, ms] : frameMs) {
+        out << frame << "," << ms;
+        const RendererPipeline::PassTimings* pt = FindPassTimings(passes, frame);
+        for (uint32_t p = 0; p < RendererPipeline::PassCount; p++) {
+            if (pt)
+                out << "," << pt->CpuMs[p] << "," << pt->GpuMs[p];
+            else
+                out << ",,";
+        }
+        out << "\n";
+    }
+    std::cout << "[Sandbox] Wrote " << frameMs.size() << " frames to " << path << "\n";
+}
+
+int main(int argc, char** argv) {
+    // --headless: offscreen EGL context (build agents without a display)
+    // --frames N: render N frames, print the frame-time summary and exit
+    // --record file.e3ir: record input + dt per frame, saved on exit
+    // --replay file.e3ir: drive the camera / events from a recording, exit at its end
+    // --flythrough: fly a spline through the SpawnPoint and SceneWarps, exit at its end
+    // --fly-speed u/s, --fixed-dt seconds (flythrough defaults to 1/60; replay uses the recorded dts)
+    // --timings-out file.csv: per-frame times with cpu/gpu per render pass
+    // --no-shader-cache: always compile shaders from source (cold-start comparisons)
+    // --depth-prepass: depth-only pre-pass before the lit scene pass (prints the samples saved)
+    WindowProps props{ "Engine3D - Sandbox", 1280, 720 };
+    uint64_t frameLimit = 0;
+    std::string recordPath, replayPath, timingsPath;
+    bool flythrough = false;
+    bool depthPrepass = false;
+    float flySpeed = 6.0f;
+    float fixedDt = 0.0f;
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        try {
+            if (std::strcmp(argv[i], "--headless") == 0)
+                props.Headless = true;
+            else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+                frameLimit = std::stoull(argv[++i]);
+            else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc)
+                recordPath = argv[++i];
+            else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc)
+                replayPath = argv[++i];
+            else if (std::strcmp(argv[i], "--flythrough") == 0)
+                flythrough = true;
+            else if (std::strcmp(argv[i], "--fly-speed") == 0 && i + 1 < argc)
+                flySpeed = std::stof(argv[++i]);
+            else if (std::strcmp(argv[i], "--fixed-dt") == 0 && i + 1 < argc)
+                fixedDt = std::stof(argv[++i]);
+            else if (std::strcmp(argv[i], "--timings-out") == 0 && i + 1 < argc)
+                timingsPath = argv[++i];
+            else if (std::strcmp(argv[i], "--no-shader-cache") == 0)
+                ShaderCache::SetEnabled(false);
+            else if (std::strcmp(argv[i], "--depth-prepass") == 0)
+                depthPrepass = true;
+        }
+        catch (const std::exception&) { // std::stoull / stof: not a number, out of range
+            std::cout << "[Sandbox] Bad value for " << arg << ": " << argv[i] << "\n"
+                << "Usage: Sandbox [--headless] [--frames N] [--record file] [--replay file] [--flythrough]\n"
+                << "               [--fly-speed u/s] [--fixed-dt s] [--timings-out file.csv]\n"
+                << "               [--no-shader-cache] [--depth-prepass]\n";
+            return 2;
+        }
+    }
+
+    InputReplayer replayer;
+    const bool replaying = !replayPath.empty() && replayer.Load(replayPath);
+    if (!replayPath.empty() && !replaying)
+        return 1;
+
+    const bool recording = !recordPath.empty() && !replaying && !flythrough;
+    if (flythrough && fixedDt <= 0.0f)
+        fixedDt = 1.0f / 60.0f;
+    if (replaying)
+        replayer.SetFixedTimestep(fixedDt);
+
+    // a perf run: timings are collected and printed at exit
+    const bool measuring = frameLimit > 0 || replaying || flythrough;
+
+    auto window = Window::Create(props);
 
     Renderer::Init();
     Renderer::SetSkybox(std::make_shared<TextureCube>(std::array<std::string, 6>{
@@ -373,8 +401,18 @@ int main() {
     cam.SetTransform(glm::vec3(0.0f, 2.0f, 6.0f), -3.1415926f, -0.2f);
     cam.SetActive(true);
 
+    // Game loop: a frame every vsync while focused; unfocused it sleeps in the event wait
+    FrameScheduler scheduler(*window);
+    scheduler.SetContinuous(true);
+
     // --- Events (focus + ESC) ---
-    window->SetEventCallback([&](Event& e) {
+    InputRecorder recorder;
+    if (recording)
+        recorder.Begin(window->GetWidth(), window->GetHeight());
+
+    Window::EventCallbackFn handleEvent = [&](Event& e) {
+        scheduler.OnEvent(e);
+
         EventDispatcher d(e);
 
         d.Dispatch<WindowCloseEvent>([&](WindowCloseEvent&) {
@@ -410,8 +448,23 @@ int main() {
             });
 
         return;
+        };
+
+    window->SetEventCallback([&](Event& e) {
+        if (replaying) {
+            // the recording owns input; only let the window be closed
+            if (e.GetEventType() == EventType::WindowClose)
+                running = false;
+            return;
+        }
+        if (recording)
+            recorder.OnEvent(e);
+        handleEvent(e);
         });
 
+    if (replaying)
+        replayer.Start();
+
     // --- Scene load ---
     Scene scene;
     SceneSerializer serializer(scene);
@@ -469,23 +522,143 @@ int main() {
         }
     }
 
+    // Tracks MeshRenderer entities through registry signals, including warps that reload the scene
+    CollisionWorld collision(scene);
+    TriggerSystem triggers(scene);
+    triggers.ResetOccupancy(cam.GetPosition()); // starting on a warp shouldn't fire it
+
+    CameraPath flyPath;
+    float flyTime = 0.0f;
+    if (flythrough) {
+        flyPath = CameraPath::FromScene(scene);
+        flyPath.SetSpeed(flySpeed);
+        std::cout << "[Sandbox] Flythrough: " << flyPath.GetPointCount() << " points, "
+            << flyPath.GetLength() << " units, " << flyPath.GetDuration() << " s\n";
+        if (flyPath.GetDuration() <= 0.0f) {
+            std::cout << "[Sandbox] Flythrough needs a SpawnPoint and at least one SceneWarp\n";
+            return 1;
+        }
+    }
+
+    // render-thread side of the timings, keyed by FramePacket::FrameIndex
+    std::mutex passMutex;
+    PassTimingList passTimings;
+    FrameTimeList frameTimes;
+    const size_t expectedFrames = frameLimit > 0 ? (size_t)frameLimit + 8 : 16384;
+    passTimings.reserve(expectedFrames);
+    frameTimes.reserve(expectedFrames);
+    RenderStats statsSum;
+    uint64_t statsFrames = 0, prepassFrames = 0;
+    pipeline.SetPassTimingEnabled(measuring);
+    pipeline.SetDepthPrepassEnabled(depthPrepass);
+
+    // GL context moves to the render thread from here on: this loop only simulates and
+    // extracts a FramePacket, the render thread draws the previous one meanwhile
+    RenderThread renderThread(*window, [&](const FramePacket& packet) {
+        pipeline.RenderFramePacket(packet);
+        Renderer::EndStatsFrame();
+
+        const auto& pt = pipeline.GetPassTimings();
+        if (measuring && pt.FrameIndex != 0) {
+            std::lock_guard<std::mutex> lock(passMutex);
+            if (passTimings.empty() || pt.FrameIndex > passTimings.back().FrameIndex)
+                passTimings.push_back(pt);
+        }
+        if (measuring) {
+            const auto& stats = Renderer::GetStats();
+            std::lock_guard<std::mutex> lock(passMutex);
+            for (uint32_t p = 0; p < RenderStats::PassCount; p++)
+                statsSum.Passes[p] += stats.Passes[p];
+            statsFrames++;
+
+            if (stats.DepthPrepass.Frame != 0) {
+                statsSum.DepthPrepass.DepthSamples += stats.DepthPrepass.DepthSamples;
+                statsSum.DepthPrepass.ShadedSamples += stats.DepthPrepass.ShadedSamples;
+                prepassFrames++;
+            }
+        }
+        });
+
+    FrameTimings timings;
+    timings.Reserve((size_t)frameLimit);
+    bool startupFrame = true;
+    float frameMs = 0.0f; // wall time of the frame being built, 0 = not measured
+
+    // heap allocations over the measured frames (all threads)
+    uint64_t frameAllocs = 0, maxFrameAllocs = 0, framesAllocating = 0;
+
+    // shaders build asynchronously and draws skip them until they link; finish them
+    // here so the first measured frames draw the whole scene
+    RenderCommand::RunOnRenderThread([]() {
+        while (ShaderLibrary::Get().PollBuilds() | AssetManager::Get().PollShaderBuilds())
+            std::this_thread::yield();
+        });
+
+    {
+        const auto& sc = ShaderCache::GetStats();
+        std::cout << "[Sandbox.ShaderCache] " << (ShaderCache::IsAvailable() ? "on" : "off")
+            << " hits=" << sc.Hits << " misses=" << sc.Misses
+            << " rejected=" << sc.Rejected << " stored=" << sc.Stored << "\n";
+    }
+
     auto last = std::chrono::high_resolution_clock::now();
 
     while (running && !window->ShouldClose()) {
+        const bool drawFrame = scheduler.WaitForFrame(); // polls events
+        JobSystem::Get().RunMainThreadJobs();
+
         auto now = std::chrono::high_resolution_clock::now();
         float dt = std::chrono::duration<float>(now - last).count();
         last = now;
 
-        if (!hasFocus) {
-            window->OnUpdate();
+        // a replay carries its own focus events
+        if (!drawFrame || (!hasFocus && !replaying))
             continue;
-        }
 
-        if (dt > 0.1f) dt = 0.1f;
+        if (replaying && replayer.IsFinished())
+            break;
+        if (flythrough && flyTime >= flyPath.GetDuration())
+            break;
 
-        if (captureMouse) {
+        // frame-to-frame time: the render thread runs concurrently, so this is the
+        // slower of simulate+extract and render+swap
+        frameMs = 0.0f;
+        if (measuring) {
+            if (startupFrame) {
+                startupFrame = false; // that dt was loading, not a frame
+            }
+            else {
+                frameMs = dt * 1000.0f;
+                timings.Add(frameMs);
+            }
+
+            if (frameLimit > 0 && timings.GetCount() >= frameLimit)
+                break;
+        }
+
+        // simulation step: wall clock for play, fixed or recorded for perf runs
+        float simDt = std::min(dt, 0.1f);
+        if (replaying)
+            simDt = replayer.NextFrame(handleEvent); // sets Input, dispatches the frame's events
+        else if (fixedDt > 0.0f)
+            simDt = fixedDt;
+
+        if (recording)
+            recorder.RecordFrame(simDt);
+
+        const glm::vec3 camPrev = cam.GetPosition();
+
+        if (flythrough) {
+            // the path owns the camera: no look / move input, collision or warps
+            flyTime += simDt;
+            glm::vec3 pos;
+            float yaw = 0.0f, pitch = 0.0f;
+            if (flyPath.Sample(flyTime, pos, yaw, pitch))
+                cam.SetTransform(pos, yaw, pitch);
+        }
+        else if (captureMouse) {
             cam.SetActive(true);
-            cam.OnUpdate(dt);
+            cam.OnUpdate(simDt);
         }
         else {
             cam.SetActive(false);
@@ -493,10 +666,10 @@ int main() {
         }
 
         // ---- Camera collision (do this BEFORE computing CSM / rendering) ----
-        {
+        if (!flythrough) {
             glm::vec3 desired = cam.GetPosition();
             const float camRadius = 0.30f; // tweak 0.25 - 0.40
-            glm::vec3 resolved = ResolveCameraSphereVsScene(scene, desired, camRadius);
+            glm::vec3 resolved = collision.MoveSphere(camPrev, desired, camRadius);
 
             glm::vec3 d = resolved - desired;
             if (glm::dot(d, d) > 1e-10f) {
@@ -506,24 +679,26 @@ int main() {
 
         uint32_t w = window->GetWidth();
         uint32_t h = window->GetHeight();
-        if (w == 0 || h == 0) {
-            window->OnUpdate();
+        if (w == 0 || h == 0)
             continue;
-        }
 
         // NOW try warp BEFORE building shadows / rendering
-        if (TryWarp(scene, cam, dt, currentScenePath)) {
+        if (!flythrough && TryWarp(scene, triggers, cam, simDt, currentScenePath)) {
             // scene got replaced; skip this frame so everything recomputes clean next frame
-            window->OnUpdate();
             continue;
         }
 
-        glm::vec3 lightDir, lightColor;
-        bool hasLight = scene.GetMainDirectionalLight(lightDir, lightColor);
-        if (!hasLight) { lightDir = { 0.4f,0.8f,-0.3f }; lightColor = { 1,1,1 }; }
+        // ---- Extract (waits only if the render thread is a whole frame behind) ----
+        FramePacket& packet = renderThread.BeginFrame();
+        packet.Width = w;
+        packet.Height = h;
+        packet.Camera = cam.GetCamera();
+        scene.ExtractFramePacket(packet); // light, culled draws, shadow casters
+
+        if (frameMs > 0.0f)
+            frameTimes.emplace_back(packet.FrameIndex, frameMs);
 
-        glm::mat4 lightMats[CSM_CASCADES];
-        float splits[CSM_CASCADES];
+        float* splits = packet.CascadeSplits;
 
         // quick splits (tweak later)
         splits[0] = 15.0f;
@@ -543,27 +718,101 @@ int main() {
             float sliceNear = (i == 0) ? camNear : splits[i - 1];
             float sliceFar = splits[i];
 
-            lightMats[i] = BuildCascadeLightMatrix(pc, lightDir, sliceNear, sliceFar, SHADOW_SIZE);
+            packet.LightMatrices[i] = BuildCascadeLightMatrix(pc, packet.LightDir, sliceNear, sliceFar, SHADOW_SIZE);
         }
 
-        // render each cascade into its layer
-        for (int i = 0; i < CSM_CASCADES; i++) {
-            pipeline.BeginShadowPass(SHADOW_SIZE, lightMats[i], (uint32_t)i, CSM_CASCADES);
-            scene.OnRenderShadow(pipeline.GetShadowDepthMaterial());
-            pipeline.EndShadowPass();
-        }
+        packet.ShadowSize = SHADOW_SIZE;
+        packet.CascadeCount = CSM_CASCADES;
+
+        // shadows, scene pass, present and swap all happen on the render thread
+        renderThread.SubmitFrame();
+
+        // in-flight packets hold their own refs -> safe to drop unreferenced assets
+        AssetManager::Get().OnFrameEnd();
 
-        pipeline.BeginScenePass(w, h, cam.GetCamera());
-        Renderer::SetDirectionalLight(lightDir, lightColor);
-        Renderer::SetCSMShadowMap(pipeline.GetShadowDepthTextureArray(), lightMats, splits, CSM_CASCADES);
+        MemoryTracker::EndFrame();
+        if (frameMs > 0.0f) {
+            const uint64_t allocs = MemoryTracker::GetFrameAllocations();
+            frameAllocs += allocs;
+            maxFrameAllocs = std::max(maxFrameAllocs, allocs);
+            framesAllocating += allocs > 0 ? 1 : 0;
+        }
+    }
 
+    if (replaying)
+        replayer.Stop();
+    if (recording)
+        recorder.Save(recordPath);
+
+    if (measuring) {
+        std::cout << timings.Summary("Sandbox") << "\n";
+
+        const auto heap = MemoryTracker::GetHeapTotal();
+        const auto gpu = MemoryTracker::GetGpuTotal();
+        const double mib = 1024.0 * 1024.0;
+        std::cout << "[Sandbox.Memory] heap=" << heap.Bytes / mib << " peak=" << heap.PeakBytes / mib
+            << " gpu=" << gpu.Bytes / mib << " peak=" << gpu.PeakBytes / mib << " MiB";
+        if (MemoryTracker::IsHeapTrackingEnabled()) {
+            std::cout << " allocs/frame avg=" << (timings.GetCount() ? (double)frameAllocs / timings.GetCount() : 0.0)
+                << " max=" << maxFrameAllocs
+                << " frames_allocating=" << framesAllocating << "/" << timings.GetCount();
+        }
+        else {
+            std::cout << " (heap tracking off: build with ENGINE_MEMORY_TRACKING)";
+        }
+        std::cout << "\n";
 
+        PassTimingList passes;
+        {
+            std::lock_guard<std::mutex> lock(passMutex);
+            passes = passTimings;
+        }
 
-        scene.OnRender(cam.GetCamera());
-        pipeline.EndScenePass();
+        // the render pass split, over the same frames
+        for (uint32_t p = 0; p < RendererPipeline::PassCount; p++) {
+            FrameTimings cpu, gpu;
+            for (const auto& pt : passes) {
+                if (!FindFrameTime(frameTimes, pt.FrameIndex)) continue;
+                cpu.Add(pt.CpuMs[p]);
+                gpu.Add(pt.GpuMs[p]);
+            }
+            const std::string name = RendererPipeline::GetPassName((RendererPipeline::Pass)p);
+            std::cout << cpu.Summary("Sandbox." + name + ".cpu") << "\n";
+            std::cout << gpu.Summary("Sandbox." + name + ".gpu") << "\n";
+        }
 
-        pipeline.PresentToScreen();
-        window->OnUpdate();
+        if (!timingsPath.empty())
+            WriteFrameCsv(timingsPath, frameTimes, passes);
+
+        // average renderer work per rendered frame
+        std::lock_guard<std::mutex> lock(passMutex);
+        if (statsFrames > 0) {
+            for (uint32_t p = 0; p < RenderStats::PassCount; p++) {
+                const auto& c = statsSum.Passes[p];
+                const double n = (double)statsFrames;
+                std::cout << "[Sandbox.Stats." << RenderStats::GetPassName((RenderStats::Pass)p) << "]"
+                    << " submitted=" << c.Submitted / n
+                    << " culled=" << c.Culled / n
+                    << " drawn=" << c.Drawn / n
+                    << " draws=" << c.DrawCalls / n
+                    << " batches=" << c.Batches / n
+                    << " tris=" << c.Triangles / n
+                    << " shader=" << c.ShaderBinds / n
+                    << " vao=" << c.VaoBinds / n
+                    << " tex=" << c.TextureBinds / n
+                    << " uniforms=" << c.UniformUploads / n
+                    << " fb=" << c.FramebufferBinds / n << "\n";
+            }
+        }
+        if (prepassFrames > 0) {
+            const auto& dp = statsSum.DepthPrepass;
+            const double n = (double)prepassFrames;
+            std::cout << "[Sandbox.DepthPrepass]"
+                << " depth_samples=" << dp.DepthSamples / n
+                << " shaded_samples=" << dp.ShadedSamples / n
+                << " saved=" << dp.SavedSamples() / n
+                << " saved_pct=" << (dp.DepthSamples ? 100.0 * dp.SavedSamples() / dp.DepthSamples : 0.0) << "\n";
+        }
     }
 
     return 0;